@@ -571,7 +571,30 @@ install(TARGETS onnx_test_runner
         RUNTIME  DESTINATION ${CMAKE_INSTALL_BINDIR})
 
 if(onnxruntime_BUILD_BENCHMARKS)
-  add_executable(onnxruntime_benchmark ${TEST_SRC_DIR}/onnx/microbenchmark/main.cc ${TEST_SRC_DIR}/onnx/microbenchmark/modeltest.cc)
+  set(onnxruntime_benchmark_src_dir ${TEST_SRC_DIR}/onnx/microbenchmark)
+  add_executable(onnxruntime_benchmark
+    ${onnxruntime_benchmark_src_dir}/main.cc
+    ${onnxruntime_benchmark_src_dir}/arena.cc
+    ${onnxruntime_benchmark_src_dir}/attention.cc
+    ${onnxruntime_benchmark_src_dir}/broadcast.cc
+    ${onnxruntime_benchmark_src_dir}/data_movement.cc
+    ${onnxruntime_benchmark_src_dir}/modeltest.cc
+    ${onnxruntime_benchmark_src_dir}/non_max_suppression.cc
+    ${onnxruntime_benchmark_src_dir}/single_node_model.h
+    ${onnxruntime_benchmark_src_dir}/single_node_model.cc
+    ${onnxruntime_benchmark_src_dir}/label_encoder.cc
+    ${onnxruntime_benchmark_src_dir}/linear.cc
+    ${onnxruntime_benchmark_src_dir}/lstm.cc
+    ${onnxruntime_benchmark_src_dir}/reduction.cc
+    ${onnxruntime_benchmark_src_dir}/resize.cc
+    ${onnxruntime_benchmark_src_dir}/softmax.cc
+    ${onnxruntime_benchmark_src_dir}/svm.cc
+    ${onnxruntime_benchmark_src_dir}/tfidf_vectorizer.cc
+    ${onnxruntime_benchmark_src_dir}/threadpool.cc
+    ${onnxruntime_benchmark_src_dir}/topk.cc
+    ${onnxruntime_benchmark_src_dir}/transpose.cc
+    ${onnxruntime_benchmark_src_dir}/tree_ensemble.cc
+    ${onnxruntime_benchmark_src_dir}/zipmap.cc)
   target_include_directories(onnxruntime_benchmark PRIVATE ${ONNXRUNTIME_ROOT} ${onnxruntime_graph_header} benchmark)
   if(WIN32)
     target_compile_options(onnxruntime_benchmark PRIVATE "$<$<COMPILE_LANGUAGE:CUDA>:-Xcompiler /wd4141>"
@@ -6,6 +6,7 @@
 #include <vector>
 #include <functional>
 #include <memory>
+#include <cstddef>
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -25,6 +26,17 @@ namespace onnxruntime {
 
 namespace concurrency {
 
+/**
+ * Estimated cost of one iteration of a parallel loop. Used by ThreadPool::ParallelFor to pick the number of
+ * threads and the size of the blocks the loop is split into. compute_cycles is the number of cycles spent
+ * computing, the bytes loaded and stored are converted to cycles by the cost model.
+ */
+struct TensorOpCost {
+  double bytes_loaded;
+  double bytes_stored;
+  double compute_cycles;
+};
+
 /**
  * Generic class for instantiating thread pools.
  * Don't put any object of this type into a global variable in a Win32 DLL.
@@ -56,45 +68,42 @@ class ThreadPool {
   */
   void ParallelForRange(int64_t first, int64_t last, std::function<void(int64_t, int64_t)> fn);
 
+  /*
+  Calls fn(first, last) on blocks covering [0, total). The block size is derived from cost_per_unit so that a
+  block amortizes the cost of scheduling it, and loops too cheap to be worth it run inline. The calling thread
+  processes blocks too, the other threads of the pool claim the remaining blocks one at a time so a slow block
+  does not hold back the rest of the loop. Returns once every block has completed.
+  Nested calls made from within fn are safe: a thread only waits for blocks that are already running.
+  */
+  void ParallelFor(std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                   const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
+
+  void ParallelFor(std::ptrdiff_t total, double cost_per_unit,
+                   const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
+    ParallelFor(total, TensorOpCost{0, 0, cost_per_unit}, fn);
+  }
+
   // This is not supported until the latest Eigen
   // void SetStealPartitions(const std::vector<std::pair<unsigned, unsigned>>& partitions);
 
   /**
-  Tries to call the given function in parallel, with calls split into (num_batches) batches.
+  Calls fn(first, last) over [0, total) on tp, see ParallelFor. If tp is nullptr the whole range is processed by
+  the calling thread, or split between the OpenMP threads in an OpenMP build.
   **/
-  template <typename F>
-  inline static void TryBatchParallelFor(concurrency::ThreadPool* tp, int32_t total, F&& fn, int32_t num_batches = 0) {
-    if (tp != nullptr) {
-      if (num_batches <= 0) {
-        num_batches = tp->NumThreads() + 1;
-      }
-      tp->BatchParallelFor(total, std::forward<F>(fn), num_batches);
-    } else {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-      for (int32_t i = 0; i < total; ++i) {
-        fn(i);
-      }
-    }
+  static void TryParallelFor(concurrency::ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                             const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
+
+  static void TryParallelFor(concurrency::ThreadPool* tp, std::ptrdiff_t total, double cost_per_unit,
+                             const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
+    TryParallelFor(tp, total, TensorOpCost{0, 0, cost_per_unit}, fn);
   }
 
   /**
-  Tries to call the given function in parallel.
+  Number of blocks ParallelFor splits a loop of total iterations into, 1 when the loop runs inline.
+  num_threads includes the calling thread. Exposed for testing.
   **/
-  template <typename F>
-  inline static void TryParallelFor(concurrency::ThreadPool* tp, int32_t total, F&& fn) {
-    if (tp != nullptr) {
-      tp->ParallelFor(total, std::forward<F>(fn));
-    } else {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-      for (int32_t i = 0; i < total; ++i) {
-        fn(i);
-      }
-    }
-  }
+  static std::ptrdiff_t CalculateParallelForBlockCount(std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                                                       int num_threads);
 
   int NumThreads() const;
 
@@ -7,8 +7,18 @@
 #include <memory>
 #include "core/common/common.h"
 #include "core/common/status.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
+/**
+   Sizes of the thread pools owned by an Environment and shared by the sessions created in it.
+   A value of 0 picks the same default as a session would for its own thread pools.
+*/
+struct ThreadingOptions {
+  int intra_op_num_threads = 0;
+  int inter_op_num_threads = 0;
+};
+
 /**
    Provides the runtime environment for onnxruntime.
    Create one instance for the duration of execution.
@@ -17,8 +27,10 @@ class Environment {
  public:
   /**
      Create and initialize the runtime environment.
+     @param tp_options If not null, the environment creates intra-op and inter-op thread pools that sessions
+     created with SessionOptions::use_per_session_threads == false use instead of their own.
   */
-  static Status Create(std::unique_ptr<Environment>& environment);
+  static Status Create(std::unique_ptr<Environment>& environment, const ThreadingOptions* tp_options = nullptr);
 
   /**
      This function will call ::google::protobuf::ShutdownProtobufLibrary
@@ -30,12 +42,29 @@ class Environment {
   */
   static bool IsInitialized() { return is_initialized_; }
 
+  /**
+     Returns whether the environment owns thread pools sessions can share.
+  */
+  bool EnvCreatedWithGlobalThreadPools() const { return create_global_thread_pools_; }
+
+  /**
+     The shared thread pools. They are nullptr if the environment was created without global thread pools, and
+     the intra-op pool is also nullptr when a single thread was requested as the calling thread does all the work.
+     The environment must outlive the sessions using them.
+  */
+  concurrency::ThreadPool* GetIntraOpThreadPool() const { return intra_op_thread_pool_.get(); }
+  concurrency::ThreadPool* GetInterOpThreadPool() const { return inter_op_thread_pool_.get(); }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Environment);
 
   Environment() = default;
-  Status Initialize();
+  Status Initialize(const ThreadingOptions* tp_options);
 
   static std::atomic<bool> is_initialized_;
+
+  bool create_global_thread_pools_{false};
+  std::unique_ptr<concurrency::ThreadPool> intra_op_thread_pool_;
+  std::unique_ptr<concurrency::ThreadPool> inter_op_thread_pool_;
 };
 }  // namespace onnxruntime
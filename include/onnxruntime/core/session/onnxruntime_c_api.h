@@ -7,7 +7,7 @@
 #include <string.h>
 
 // This value is used in structures passed to ORT so that a newer version of ORT will still work with
-#define ORT_API_VERSION 1
+#define ORT_API_VERSION 2
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,6 +19,7 @@ extern "C" {
 #define _In_opt_
 #define _Out_
 #define _Outptr_
+#define _Outptr_result_maybenull_
 #define _Out_opt_
 #define _Inout_
 #define _Inout_opt_
@@ -156,6 +157,8 @@ ORT_RUNTIME_CLASS(TypeInfo);
 ORT_RUNTIME_CLASS(TensorTypeAndShapeInfo);
 ORT_RUNTIME_CLASS(SessionOptions);
 ORT_RUNTIME_CLASS(CustomOpDomain);
+ORT_RUNTIME_CLASS(ThreadingOptions);
+ORT_RUNTIME_CLASS(IoBinding);
 
 // When passing in an allocator to any ORT function, be sure that the allocator object
 // is not destroyed until the last allocated object using it is freed.
@@ -646,6 +649,95 @@ struct OrtApi {
   ORT_CLASS_RELEASE(TensorTypeAndShapeInfo);
   ORT_CLASS_RELEASE(SessionOptions);
   ORT_CLASS_RELEASE(CustomOpDomain);
+
+  // End of Version 1 - DO NOT MODIFY ABOVE
+
+  /**
+   * Creates an environment owning an intra-op and an inter-op thread pool that are shared by all the sessions
+   * created with per session threads disabled (see DisablePerSessionThreads). This bounds the number of threads
+   * of a process hosting many sessions.
+   * \param t_options sizes of the thread pools, use CreateThreadingOptions to create it.
+   * \param out Should be freed by `OrtReleaseEnv` after use
+   */
+  OrtStatus*(ORT_API_CALL* CreateEnvWithGlobalThreadPools)(OrtLoggingLevel default_logging_level, _In_ const char* logid,
+                                                           _In_ const OrtThreadingOptions* t_options, _Outptr_ OrtEnv** out)
+      NO_EXCEPTION ORT_ALL_ARGS_NONNULL;
+
+  // Sessions created with these options use the thread pools of the environment instead of creating their own.
+  // Creating the session fails if the environment was not created with CreateEnvWithGlobalThreadPools.
+  OrtStatus*(ORT_API_CALL* DisablePerSessionThreads)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /**
+   * \param out Should be freed by `OrtReleaseThreadingOptions` after use
+   */
+  OrtStatus*(ORT_API_CALL* CreateThreadingOptions)(_Outptr_ OrtThreadingOptions** out)NO_EXCEPTION;
+
+  // A value of 0 lets onnxruntime pick the size of the thread pool, like SetIntraOpNumThreads/SetInterOpNumThreads
+  OrtStatus*(ORT_API_CALL* SetGlobalIntraOpNumThreads)(_Inout_ OrtThreadingOptions* tp_options, int intra_op_num_threads)NO_EXCEPTION;
+  OrtStatus*(ORT_API_CALL* SetGlobalInterOpNumThreads)(_Inout_ OrtThreadingOptions* tp_options, int inter_op_num_threads)NO_EXCEPTION;
+
+  ORT_CLASS_RELEASE(ThreadingOptions);
+
+  // Keeps a per-thread cache of small blocks in front of the CPU memory arena of the sessions created with these
+  // options, which reduces the contention on the arena when Run is called concurrently on a session.
+  OrtStatus*(ORT_API_CALL* EnableCpuMemArenaThreadCache)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /**
+   * Creates an IO binding for the session. The inputs and outputs are bound to it once, and the session is then run
+   * with RunWithBinding as many times as needed. Unlike Run, RunWithBinding only looks up and validates the names
+   * and values again after they have been rebound. An IO binding must not be used by concurrent RunWithBinding calls.
+   * \param out Should be freed by `OrtReleaseIoBinding` after use
+   */
+  OrtStatus*(ORT_API_CALL* CreateIoBinding)(_Inout_ OrtSession* session, _Outptr_ OrtIoBinding** out)NO_EXCEPTION;
+
+  ORT_CLASS_RELEASE(IoBinding);
+
+  /**
+   * Binds val_ptr to the model input name, replacing the value bound to name before if any. The binding keeps a
+   * reference to the value, so new data written to its buffer is used by the next RunWithBinding. A value on another
+   * device than the one of the nodes consuming the input is copied to that device by every RunWithBinding.
+   * val_ptr is required, a null value returns ORT_INVALID_ARGUMENT.
+   */
+  OrtStatus*(ORT_API_CALL* BindInput)(_Inout_ OrtIoBinding* binding_ptr, _In_ const char* name,
+                                      _In_ const OrtValue* val_ptr)NO_EXCEPTION;
+
+  /**
+   * Binds the model output name. When val_ptr is a tensor, RunWithBinding writes the output into it, so its shape
+   * must match the one of the output. When val_ptr is null, every RunWithBinding allocates the output.
+   */
+  OrtStatus*(ORT_API_CALL* BindOutput)(_Inout_ OrtIoBinding* binding_ptr, _In_ const char* name,
+                                       _In_opt_ const OrtValue* val_ptr)NO_EXCEPTION;
+
+  /**
+   * Returns the values of the bound outputs, in the order they were bound, as set by the last RunWithBinding.
+   * \param output is allocated with allocator and should be freed with it, null when no output is bound.
+   *        Each of its values should be freed by `OrtReleaseValue` after use.
+   */
+  OrtStatus*(ORT_API_CALL* GetBoundOutputValues)(_In_ const OrtIoBinding* binding_ptr, _Inout_ OrtAllocator* allocator,
+                                                 _Outptr_result_maybenull_ OrtValue*** output,
+                                                 _Out_ size_t* output_count)NO_EXCEPTION;
+
+  void(ORT_API_CALL* ClearBoundInputs)(_Inout_ OrtIoBinding* binding_ptr)NO_EXCEPTION;
+  void(ORT_API_CALL* ClearBoundOutputs)(_Inout_ OrtIoBinding* binding_ptr)NO_EXCEPTION;
+
+  OrtStatus*(ORT_API_CALL* RunWithBinding)(_Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                                           _Inout_ OrtIoBinding* binding_ptr)NO_EXCEPTION;
+
+  // The model outputs produced by a ZipMap node in the sessions created with these options hold the scores as a
+  // float tensor, one row per map, instead of a sequence of maps. Use SessionGetOutputZipMapLabels to get the class
+  // labels of the columns. A ZipMap output that is also an input of another node of the graph keeps returning a
+  // sequence of maps, and SessionGetOutputZipMapLabels returns null for it.
+  OrtStatus*(ORT_API_CALL* EnableColumnarZipMap)(_Inout_ OrtSessionOptions* options)NO_EXCEPTION;
+
+  /**
+   * Returns the class labels of the columns of the output index when it was produced by a ZipMap node and the
+   * session was created with EnableColumnarZipMap, as a 1-D string or int64 tensor.
+   * \param out is null when the output is not a ZipMap output returned as a float tensor, otherwise it should be freed by `OrtReleaseValue`
+   *        after use. The tensor is allocated with allocator.
+   */
+  OrtStatus*(ORT_API_CALL* SessionGetOutputZipMapLabels)(_In_ const OrtSession* sess, size_t index,
+                                                         _Inout_ OrtAllocator* allocator,
+                                                         _Outptr_result_maybenull_ OrtValue** out)NO_EXCEPTION;
 };
 
 /*
@@ -71,6 +71,8 @@ ORT_DEFINE_RELEASE(SessionOptions);
 ORT_DEFINE_RELEASE(TensorTypeAndShapeInfo);
 ORT_DEFINE_RELEASE(TypeInfo);
 ORT_DEFINE_RELEASE(Value);
+ORT_DEFINE_RELEASE(ThreadingOptions);
+ORT_DEFINE_RELEASE(IoBinding);
 
 // This is used internally by the C++ API. This is the common base class used by the wrapper objects.
 template <typename T>
@@ -118,11 +120,22 @@ struct MemoryInfo;
 struct Env;
 struct TypeInfo;
 struct Value;
+struct IoBinding;
+
+struct ThreadingOptions : Base<OrtThreadingOptions> {
+  explicit ThreadingOptions(std::nullptr_t) {}
+  ThreadingOptions();
+
+  ThreadingOptions& SetGlobalIntraOpNumThreads(int intra_op_num_threads);
+  ThreadingOptions& SetGlobalInterOpNumThreads(int inter_op_num_threads);
+};
 
 struct Env : Base<OrtEnv> {
   Env(std::nullptr_t) {}
   Env(OrtLoggingLevel default_logging_level = ORT_LOGGING_LEVEL_WARNING, _In_ const char* logid = "");
   Env(OrtLoggingLevel default_logging_level, const char* logid, OrtLoggingFunction logging_function, void* logger_param);
+  // Environment with thread pools shared by the sessions created with SessionOptions::DisablePerSessionThreads
+  Env(const OrtThreadingOptions* tp_options, OrtLoggingLevel default_logging_level = ORT_LOGGING_LEVEL_WARNING, _In_ const char* logid = "");
   explicit Env(OrtEnv* p) : Base<OrtEnv>{p} {}
 
   Env& EnableTelemetryEvents();
@@ -166,10 +179,13 @@ struct SessionOptions : Base<OrtSessionOptions> {
 
   SessionOptions& SetIntraOpNumThreads(int intra_op_num_threads);
   SessionOptions& SetInterOpNumThreads(int inter_op_num_threads);
+  SessionOptions& DisablePerSessionThreads();
   SessionOptions& SetGraphOptimizationLevel(GraphOptimizationLevel graph_optimization_level);
 
   SessionOptions& EnableCpuMemArena();
   SessionOptions& DisableCpuMemArena();
+  SessionOptions& EnableCpuMemArenaThreadCache();
+  SessionOptions& EnableColumnarZipMap();
 
   SessionOptions& SetOptimizedModelFilePath(const ORTCHAR_T* optimized_model_file);
 
@@ -197,6 +213,8 @@ struct Session : Base<OrtSession> {
   // Run for when there is a list of prealloated outputs
   void Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
            const char* const* output_names, Value* output_values, size_t output_count);
+  // Run with the inputs and outputs bound to io_binding
+  void Run(const RunOptions& run_options, IoBinding& io_binding);
 
   size_t GetInputCount() const;
   size_t GetOutputCount() const;
@@ -209,6 +227,9 @@ struct Session : Base<OrtSession> {
   TypeInfo GetInputTypeInfo(size_t index) const;
   TypeInfo GetOutputTypeInfo(size_t index) const;
   TypeInfo GetOverridableInitializerTypeInfo(size_t index) const;
+
+  // class labels of an output returned as a score tensor by EnableColumnarZipMap, a null Value for other outputs
+  Value GetOutputZipMapLabels(size_t index, OrtAllocator* allocator) const;
 };
 
 struct TensorTypeAndShapeInfo : Base<OrtTensorTypeAndShapeInfo> {
@@ -270,6 +291,24 @@ struct Value : Base<OrtValue> {
   TensorTypeAndShapeInfo GetTensorTypeAndShapeInfo() const;
 };
 
+// Inputs and outputs bound once to a session and reused by every Session::Run with the binding
+struct IoBinding : public Base<OrtIoBinding> {
+  explicit IoBinding(std::nullptr_t) {}
+  explicit IoBinding(Session& session);
+
+  void BindInput(const char* name, const Value& value);
+  // the output is written into value by every run
+  void BindOutput(const char* name, const Value& value);
+  // the output is allocated by every run
+  void BindOutput(const char* name);
+
+  std::vector<Value> GetOutputValues() const;
+  std::vector<Value> GetOutputValues(OrtAllocator* allocator) const;
+
+  void ClearBoundInputs();
+  void ClearBoundOutputs();
+};
+
 struct AllocatorWithDefaultOptions {
   AllocatorWithDefaultOptions();
 
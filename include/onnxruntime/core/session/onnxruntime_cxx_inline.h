@@ -84,6 +84,24 @@ inline Env::Env(OrtLoggingLevel default_warning_level, const char* logid, OrtLog
   ThrowOnError(Global<void>::api_.CreateEnvWithCustomLogger(logging_function, logger_param, default_warning_level, logid, &p_));
 }
 
+inline Env::Env(const OrtThreadingOptions* tp_options, OrtLoggingLevel default_warning_level, _In_ const char* logid) {
+  ThrowOnError(Global<void>::api_.CreateEnvWithGlobalThreadPools(default_warning_level, logid, tp_options, &p_));
+}
+
+inline ThreadingOptions::ThreadingOptions() {
+  ThrowOnError(Global<void>::api_.CreateThreadingOptions(&p_));
+}
+
+inline ThreadingOptions& ThreadingOptions::SetGlobalIntraOpNumThreads(int intra_op_num_threads) {
+  ThrowOnError(Global<void>::api_.SetGlobalIntraOpNumThreads(p_, intra_op_num_threads));
+  return *this;
+}
+
+inline ThreadingOptions& ThreadingOptions::SetGlobalInterOpNumThreads(int inter_op_num_threads) {
+  ThrowOnError(Global<void>::api_.SetGlobalInterOpNumThreads(p_, inter_op_num_threads));
+  return *this;
+}
+
 inline Env& Env::EnableTelemetryEvents() {
   ThrowOnError(Global<void>::api_.EnableTelemetryEvents(p_));
   return *this;
@@ -163,6 +181,11 @@ inline SessionOptions& SessionOptions::SetInterOpNumThreads(int inter_op_num_thr
   return *this;
 }
 
+inline SessionOptions& SessionOptions::DisablePerSessionThreads() {
+  ThrowOnError(Global<void>::api_.DisablePerSessionThreads(p_));
+  return *this;
+}
+
 inline SessionOptions& SessionOptions::SetGraphOptimizationLevel(GraphOptimizationLevel graph_optimization_level) {
   ThrowOnError(Global<void>::api_.SetSessionGraphOptimizationLevel(p_, graph_optimization_level));
   return *this;
@@ -203,6 +226,16 @@ inline SessionOptions& SessionOptions::DisableCpuMemArena() {
   return *this;
 }
 
+inline SessionOptions& SessionOptions::EnableCpuMemArenaThreadCache() {
+  ThrowOnError(Global<void>::api_.EnableCpuMemArenaThreadCache(p_));
+  return *this;
+}
+
+inline SessionOptions& SessionOptions::EnableColumnarZipMap() {
+  ThrowOnError(Global<void>::api_.EnableColumnarZipMap(p_));
+  return *this;
+}
+
 inline SessionOptions& SessionOptions::SetExecutionMode(ExecutionMode execution_mode) {
   ThrowOnError(Global<void>::api_.SetSessionExecutionMode(p_, execution_mode));
   return *this;
@@ -242,6 +275,55 @@ inline void Session::Run(const RunOptions& run_options, const char* const* input
   ThrowOnError(Global<void>::api_.Run(p_, run_options, input_names, ort_input_values, input_count, output_names, output_count, ort_output_values));
 }
 
+inline void Session::Run(const RunOptions& run_options, IoBinding& io_binding) {
+  ThrowOnError(Global<void>::api_.RunWithBinding(p_, run_options, io_binding));
+}
+
+inline IoBinding::IoBinding(Session& session) {
+  ThrowOnError(Global<void>::api_.CreateIoBinding(session, &p_));
+}
+
+inline void IoBinding::BindInput(const char* name, const Value& value) {
+  ThrowOnError(Global<void>::api_.BindInput(p_, name, value));
+}
+
+inline void IoBinding::BindOutput(const char* name, const Value& value) {
+  ThrowOnError(Global<void>::api_.BindOutput(p_, name, value));
+}
+
+inline void IoBinding::BindOutput(const char* name) {
+  ThrowOnError(Global<void>::api_.BindOutput(p_, name, nullptr));
+}
+
+inline std::vector<Value> IoBinding::GetOutputValues() const {
+  AllocatorWithDefaultOptions allocator;
+  return GetOutputValues(allocator);
+}
+
+inline std::vector<Value> IoBinding::GetOutputValues(OrtAllocator* allocator) const {
+  OrtValue** output_values = nullptr;
+  size_t output_count = 0;
+  ThrowOnError(Global<void>::api_.GetBoundOutputValues(p_, allocator, &output_values, &output_count));
+
+  std::vector<Value> result;
+  result.reserve(output_count);
+  for (size_t i = 0; i < output_count; ++i) {
+    result.emplace_back(output_values[i]);
+  }
+  if (output_values != nullptr) {
+    allocator->Free(allocator, output_values);
+  }
+  return result;
+}
+
+inline void IoBinding::ClearBoundInputs() {
+  Global<void>::api_.ClearBoundInputs(p_);
+}
+
+inline void IoBinding::ClearBoundOutputs() {
+  Global<void>::api_.ClearBoundOutputs(p_);
+}
+
 inline size_t Session::GetInputCount() const {
   size_t out;
   ThrowOnError(Global<void>::api_.SessionGetInputCount(p_, &out));
@@ -296,6 +378,12 @@ inline TypeInfo Session::GetOverridableInitializerTypeInfo(size_t index) const {
   return TypeInfo{out};
 }
 
+inline Value Session::GetOutputZipMapLabels(size_t index, OrtAllocator* allocator) const {
+  OrtValue* out;
+  ThrowOnError(Global<void>::api_.SessionGetOutputZipMapLabels(p_, index, allocator, &out));
+  return Value{out};
+}
+
 inline ONNXTensorElementDataType TensorTypeAndShapeInfo::GetElementType() const {
   ONNXTensorElementDataType out;
   ThrowOnError(Global<void>::api_.GetTensorElementType(p_, &out));
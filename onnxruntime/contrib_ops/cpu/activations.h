@@ -43,25 +43,20 @@ class Gelu : public OpKernel {
     if (nullptr != tp) {
       const T* input = X->template Data<T>();
       T* output = Y->template MutableData<T>();
-      int task_count = tp->NumThreads() + 1;
       int64_t elem_count = X->Shape().Size();
-      if (elem_count > task_count) {
-        tp->ParallelFor(task_count, [input,
-                                     output,
-                                     elem_count,
-                                     task_count](int32_t i) {
-          int64_t elem_inx_start = i * elem_count / task_count;
-          int64_t elem_inx_end = (i + 1) * elem_count / task_count;
-          for (int64_t elem_inx = elem_inx_start; elem_inx < elem_inx_end; elem_inx++) {
-            output[elem_inx] = input[elem_inx] * static_cast<float>(M_SQRT1_2);
-          }
-          MlasComputeErf(output + elem_inx_start, output + elem_inx_start, elem_inx_end - elem_inx_start);
-          for (int64_t elem_inx = elem_inx_start; elem_inx < elem_inx_end; elem_inx++) {
-            output[elem_inx] = 0.5f * input[elem_inx] * (output[elem_inx] + 1.0f);
-          }
-        });
-        return Status::OK();
-      }
+      // MlasComputeErf is about 20 cycles per element
+      const concurrency::TensorOpCost cost{static_cast<double>(2 * sizeof(T)), static_cast<double>(2 * sizeof(T)), 25.0};
+      tp->ParallelFor(static_cast<std::ptrdiff_t>(elem_count), cost,
+                      [input, output](std::ptrdiff_t first, std::ptrdiff_t last) {
+                        for (std::ptrdiff_t elem_inx = first; elem_inx < last; elem_inx++) {
+                          output[elem_inx] = input[elem_inx] * static_cast<float>(M_SQRT1_2);
+                        }
+                        MlasComputeErf(output + first, output + first, static_cast<size_t>(last - first));
+                        for (std::ptrdiff_t elem_inx = first; elem_inx < last; elem_inx++) {
+                          output[elem_inx] = 0.5f * input[elem_inx] * (output[elem_inx] + 1.0f);
+                        }
+                      });
+      return Status::OK();
     }
 
     EIGEN_X_VAR(xm);
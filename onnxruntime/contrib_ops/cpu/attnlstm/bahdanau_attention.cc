@@ -3,6 +3,7 @@
 
 #include "bahdanau_attention.h"
 #include "core/providers/cpu/rnn/rnn_helpers.h"
+#include "core/mlas/inc/mlas.h"
 
 #include <stdexcept>
 #include <memory.h>
@@ -79,27 +80,14 @@ void BahdanauAttention<T>::PrepareMemory(
                   keys_.data(), attn_depth_, ttp_);
 }
 
-template <typename T>
-static void SoftmaxInplace(const gsl::span<T>& alignments) {
-  T* x = alignments.data();
+// The alignments are shifted by their maximum before the exponentials so the sum is at least 1 and no longer
+// overflows or underflows to zero.
+static void SoftmaxInplace(const gsl::span<float>& alignments) {
+  float* x = alignments.data();
   size_t len = alignments.size();
 
-  double sum = 0.0;
-
-  for (size_t i = 0; i < len; i++) {
-    T e = exp(x[i]);
-    sum += e;
-    x[i] = e;
-  }
-
-  if (sum == 0.0) {
-    for (size_t i = 0; i < len; i++) {
-      x[i] = static_cast<T>(1.0 / len);
-    }
-  } else {
-    for (size_t i = 0; i < len; i++) {
-      x[i] = static_cast<T>(x[i] / sum);
-    }
+  if (len > 0) {
+    MlasComputeSoftmax(x, x, 1, len, false, nullptr);
   }
 }
 
@@ -472,10 +472,8 @@ void UniDirectionalAttnLstm<T>::GateComputations(span_T_iter& out, span_T_iter&
 
 template <typename T>
 void UniDirectionalAttnLstm<T>::SetNumThreads() {
-  int threads = std::thread::hardware_concurrency() - 1;
-
-  if (threads < 1)
-    threads = 1;
+  // the calling thread takes part in the work
+  int threads = ttp_ == nullptr ? 1 : ttp_->NumThreads() + 1;
 
   int hmt = threads;
   batch_parallel_ = false;
@@ -2,7 +2,11 @@
 // Licensed under the MIT License.
 
 #include "attention.h"
+
+#include <algorithm>
+
 #include "core/framework/tensorprotoutils.h"
+#include "core/mlas/inc/mlas.h"
 #include "onnx/defs/schema.h"
 #include "core/util/eigen_common_wrapper.h"
 #include "core/util/math.h"
@@ -27,10 +31,18 @@ namespace contrib {
 
 REGISTER_KERNEL_TYPED(float)
 
+namespace {
+// queries and keys of a block of the fused softmax(Q x K') x V, its scores take 32KB
+constexpr int kQueryBlockSize = 64;
+constexpr int kKeyBlockSize = 128;
+}  // namespace
+
 AttentionBase::AttentionBase(const OpKernelInfo& info) {
   int64_t num_heads = 0;
   ORT_ENFORCE(info.GetAttr("num_heads", &num_heads).IsOK() && num_heads > 0);
   num_heads_ = static_cast<int>(num_heads);
+
+  is_unidirectional_ = info.GetAttrOrDefault<int64_t>("unidirectional", 0) == 1;
 }
 
 Status AttentionBase::CheckInputs(const OpKernelContext* context) const {
@@ -39,7 +51,9 @@ Status AttentionBase::CheckInputs(const OpKernelContext* context) const {
   //   Input 1 - weights     : (hidden_size, 3 * hidden_size)
   //   Input 2 - bias        : (3 * hidden_size)
   //   Input 3 - mask_index  : (batch_size)
-  //   Output                : (batch_size, sequence_length, hidden_size)
+  //   Input 4 - past        : (2, batch_size, num_heads, past_sequence_length, head_size)
+  //   Output 0              : (batch_size, sequence_length, hidden_size)
+  //   Output 1 - present    : (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size)
 
   const Tensor* input = context->Input<Tensor>(0);
   const auto dims = input->Shape().GetDims();
@@ -91,6 +105,20 @@ Status AttentionBase::CheckInputs(const OpKernelContext* context) const {
                            "Inputs 3 and 0 shall have same length at dimension 0");
   }
 
+  const Tensor* past = context->Input<Tensor>(4);
+  if (past != nullptr) {
+    const auto past_dims = past->Shape().GetDims();
+    if (past_dims.size() != 5) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 4 is expected to have 5 dimensions, got ", past_dims.size());
+    }
+    if (past_dims[0] != 2 || static_cast<int>(past_dims[1]) != batch_size ||
+        static_cast<int>(past_dims[2]) != num_heads_ || static_cast<int>(past_dims[4]) != hidden_size / num_heads_) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Input 4 shall have shape (2, batch_size, num_heads, past_sequence_length, head_size)");
+    }
+  }
+
   return Status::OK();
 }
 
@@ -105,196 +133,238 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   const Tensor* weights = context->Input<Tensor>(1);
   const Tensor* bias = context->Input<Tensor>(2);
   const Tensor* mask_index = context->Input<Tensor>(3);
+  const Tensor* past = context->Input<Tensor>(4);
 
   const auto dims = input->Shape().GetDims();
   const int batch_size = static_cast<int>(dims[0]);
   const int sequence_length = static_cast<int>(dims[1]);
   const int hidden_size = static_cast<int>(dims[2]);
   const int head_size = hidden_size / num_heads_;
+  const int past_sequence_length = past == nullptr ? 0 : static_cast<int>(past->Shape()[3]);
+  const int all_sequence_length = past_sequence_length + sequence_length;
 
   TensorShape output_shape(dims);
   Tensor* output = context->Output(0, output_shape);
 
+  std::vector<int64_t> present_dims{2, batch_size, num_heads_, all_sequence_length, head_size};
+  Tensor* present = context->Output(1, TensorShape(present_dims));
+
   constexpr size_t element_size = sizeof(T);
 
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
-  // STEP.1: gemm_data(BS, 3NH) = input(BS, NH) x weights(NH, 3NH) + bias(3NH)
-  auto gemm_data = allocator->Alloc(batch_size * sequence_length * 3 * hidden_size * element_size);
-  BufferUniquePtr gemm_buffer(gemm_data, BufferDeleter(allocator));
-  auto Q = reinterpret_cast<T*>(gemm_data);
-  auto K = Q + batch_size * sequence_length * hidden_size;
-  auto V = K + batch_size * sequence_length * hidden_size;
+  // Q(B, N, S, H) of the input, and K and V of the past and input positions in the layout of present:
+  // K(B, N, S*, H) then V(B, N, S*, H) with S* = past_sequence_length + sequence_length.
+  auto q_data = allocator->Alloc(batch_size * sequence_length * hidden_size * element_size);
+  BufferUniquePtr q_buffer(q_data, BufferDeleter(allocator));
+  BufferUniquePtr kv_buffer(nullptr, BufferDeleter(allocator));
+  T* kv_data = nullptr;
+  if (present != nullptr) {
+    kv_data = present->template MutableData<T>();
+  } else {
+    kv_buffer.reset(allocator->Alloc(2 * batch_size * all_sequence_length * hidden_size * element_size));
+    kv_data = reinterpret_cast<T*>(kv_buffer.get());
+  }
 
-  T* QKV[3] = {Q, K, V};
+  auto Q = reinterpret_cast<T*>(q_data);
+  auto K = kv_data;
+  auto V = kv_data + batch_size * all_sequence_length * hidden_size;
+
+  // STEP.0: K and V of the past positions, at the start of each (B.N.)S* x H block.
+  // The blocks move to higher addresses and are copied from the last one, so the caller may bind present to the
+  // buffer of past grown in place. A block already at its place isn't copied.
+  if (past != nullptr) {
+    const T* past_data = past->template Data<T>();
+    const int past_block_size = past_sequence_length * head_size;
+    const int present_block_size = all_sequence_length * head_size;
+    for (int i = 2 * batch_size * num_heads_ - 1; i >= 0; i--) {
+      const T* src = past_data + past_block_size * i;
+      T* dest = kv_data + present_block_size * i;
+      if (src != dest) {
+        memmove(dest, src, past_block_size * sizeof(T));
+      }
+    }
+  }
 
+  // STEP.1: gemm_data(BS, 3NH) = input(BS, NH) x weights(NH, 3NH) + bias(3NH)
+  //         Q is written to (B, N, S, H), K and V after the past positions of (B, N, S*, H)
   {
     const int loop_len = 3 * batch_size * num_heads_;
     const auto input_data = input->template Data<T>();
     const auto weights_data = weights->template Data<T>();
     const auto bias_data = bias->template Data<T>();
 
-    concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), loop_len, [&](int32_t i) {
-      const int batch_index = (i / 3) / num_heads_;
-      const int head_index = (i / 3) % num_heads_;
-      const int qkv_index = i % 3;
-
-      int input_offset = batch_index * sequence_length * hidden_size;
-      int weights_offset = qkv_index * hidden_size + head_index * head_size;
-      T* qkv_dest = QKV[qkv_index];
-      int qkv_offset = (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
-
-      // broadcast 3NH -> (3.B.N.S.H)
-      const T* broadcast_data_src = bias_data + weights_offset;
-      T* broadcast_data_dest = QKV[qkv_index] + qkv_offset;
-      for (int seq_index = 0; seq_index < sequence_length; seq_index++) {
-        memcpy(broadcast_data_dest, broadcast_data_src, head_size * sizeof(T));
-        broadcast_data_dest += head_size;
-      }
-
-      //                   original           transposed            iteration
-      // A: input          (BxSxNxH)          (B.)S x NH            S x NH
-      // B: weights        (NxHx3xNxH)        NH  x (3.N.)H         NH x H
-      // C: QKV[qkv_index] (3xBxNxSxH)        (3.B.N.)S x H         S x H
-
-      math::GemmEx<float, concurrency::ThreadPool>(CblasNoTrans,                   // TransA = no
-                                                   CblasNoTrans,                   // TransB = no
-                                                   sequence_length,                // M      = S
-                                                   head_size,                      // N      = H
-                                                   hidden_size,                    // K      = NH
-                                                   1.0f,                           // alpha
-                                                   input_data + input_offset,      // A
-                                                   hidden_size,                    // lda    = NH
-                                                   weights_data + weights_offset,  // B
-                                                   3 * hidden_size,                // ldb    = 3NH
-                                                   1.0f,                           // beta
-                                                   qkv_dest + qkv_offset,          // C
-                                                   head_size,                      // ldc
-                                                   nullptr                         // use single-thread
-      );
-    });
+    // each task computes a S x H block of Q, K or V: S x NH x H multiply-adds
+    const double cost = static_cast<double>(sequence_length) * hidden_size * head_size * 2;
+    concurrency::ThreadPool::TryParallelFor(
+        context->GetOperatorThreadPool(), loop_len, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t task_idx = first; task_idx < last; ++task_idx) {
+            const int i = static_cast<int>(task_idx);
+            const int batch_index = (i / 3) / num_heads_;
+            const int head_index = (i / 3) % num_heads_;
+            const int qkv_index = i % 3;
+
+            int input_offset = batch_index * sequence_length * hidden_size;
+            int weights_offset = qkv_index * hidden_size + head_index * head_size;
+            T* qkv_dest = nullptr;
+            if (qkv_index == 0) {
+              qkv_dest = Q + (batch_index * num_heads_ + head_index) * (sequence_length * head_size);
+            } else {
+              qkv_dest = (qkv_index == 1 ? K : V) +
+                         (batch_index * num_heads_ + head_index) * (all_sequence_length * head_size) +
+                         past_sequence_length * head_size;
+            }
+
+            // broadcast 3NH -> (3.B.N.S.H)
+            const T* broadcast_data_src = bias_data + weights_offset;
+            T* broadcast_data_dest = qkv_dest;
+            for (int seq_index = 0; seq_index < sequence_length; seq_index++) {
+              memcpy(broadcast_data_dest, broadcast_data_src, head_size * sizeof(T));
+              broadcast_data_dest += head_size;
+            }
+
+            //                   original           transposed            iteration
+            // A: input          (BxSxNxH)          (B.)S x NH            S x NH
+            // B: weights        (NxHx3xNxH)        NH  x (3.N.)H         NH x H
+            // C: Q, K or V      (BxNxSxH)          (B.N.)S x H           S x H
+
+            math::GemmEx<float, concurrency::ThreadPool>(CblasNoTrans,                   // TransA = no
+                                                         CblasNoTrans,                   // TransB = no
+                                                         sequence_length,                // M      = S
+                                                         head_size,                      // N      = H
+                                                         hidden_size,                    // K      = NH
+                                                         1.0f,                           // alpha
+                                                         input_data + input_offset,      // A
+                                                         hidden_size,                    // lda    = NH
+                                                         weights_data + weights_offset,  // B
+                                                         3 * hidden_size,                // ldb    = 3NH
+                                                         1.0f,                           // beta
+                                                         qkv_dest,                       // C
+                                                         head_size,                      // ldc
+                                                         nullptr                         // use single-thread
+            );
+          }
+        });
   }
 
-  // STEP.2: scratch(B, N, S, S) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S, H -> B, N, H, S) + 1 x mask_index(B -> B, 1, 1, 1)
-  auto scratch_data = allocator->Alloc(batch_size * num_heads_ * sequence_length * sequence_length * element_size);
-  BufferUniquePtr scratch_buffer(scratch_data, BufferDeleter(allocator));
-
+  // STEP.2: out(B, S, N, H) = Softmax(1/sqrt(H) x Q(B, N, S, H) x K'(B, N, S*, H -> B, N, H, S*) + mask) x V(B, N, S*, H)
+  //         The queries are processed by blocks of kQueryBlockSize, which walk the keys and values by blocks of
+  //         kKeyBlockSize with an online softmax: the running sum and output of a query are rescaled whenever the
+  //         maximum of its scores grows. The scores take kQueryBlockSize x kKeyBlockSize floats per thread instead of
+  //         B x N x S x S*.
   {
-    auto scratch_broadcast_data = allocator->Alloc(batch_size * sequence_length * element_size);
-    BufferUniquePtr scratch_broadcast_buffer(scratch_broadcast_data, BufferDeleter(allocator));
-    memset(scratch_broadcast_data, 0, batch_size * sequence_length * element_size);
-    T* p_scratch_broadcast_current_data = reinterpret_cast<T*>(scratch_broadcast_data);
-    for (int b_i = 0; b_i < batch_size; b_i++) {
-      // TODO: mask_index can be used in softmax to save some calculation.
-      int mask = mask_index->template Data<int32_t>()[b_i];
-      for (int m_i = mask; m_i < sequence_length; m_i++) {
-        p_scratch_broadcast_current_data[m_i] = static_cast<T>(-10000.0);
-      }
-      p_scratch_broadcast_current_data += sequence_length;
-    }
-
-    const int loop_len = batch_size * num_heads_;
+    const int query_blocks = (sequence_length + kQueryBlockSize - 1) / kQueryBlockSize;
+    const int loop_len = batch_size * num_heads_ * query_blocks;
     const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
-
-    concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), loop_len, [&](int32_t i) {
-      const int batch_index = i / num_heads_;
-      // broadcast masks (B) -> (B.N.)S.S
-      const T* broadcast_data_src = reinterpret_cast<T*>(scratch_broadcast_data) + batch_index * sequence_length;
-      T* broadcast_data_dest = reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i;
-      for (int seq_index = 0; seq_index < sequence_length; seq_index++) {
-        memcpy(broadcast_data_dest, broadcast_data_src, sequence_length * sizeof(T));
-        broadcast_data_dest += sequence_length;
-      }
-
-      // gemm
-
-      //                   original           transposed            iteration
-      // A: Q              (BxNxSxH)          (B.N.)S x H            S x H
-      // B: K'             (BxNxSxH)          (B.N.)H x S            H x S
-      // C: scratch_data   (BxNxSxS)          (B.N.)S x S            S x S
-
-      math::Gemm<T, concurrency::ThreadPool>(
-          CblasNoTrans,
-          CblasTrans,
-          sequence_length,
-          sequence_length,
-          head_size,
-          alpha,
-          Q + sequence_length * head_size * i,
-          K + sequence_length * head_size * i,
-          1.0,
-          reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i,
-          nullptr);
-    });
-  }
-
-  // STEP.3: P(B, N, S, S) = Softmax(scratch)
-  {
-    const int N = batch_size * num_heads_ * sequence_length;
-    const int D = sequence_length;
-
-    concurrency::ThreadPool::TryBatchParallelFor(context->GetOperatorThreadPool(), N, [&](int j) {
-      float* x = reinterpret_cast<T*>(scratch_data) + j * D;
-      float* y = x;
-
-      // e^x is represented as infinity if x is large enough, like 100.f.
-      // Infinity divided by Infinity is a NAN. Thus, softmax gets a NAN if one or more item are large enough.
-      // a math transform as below is leveraged to get a stable softmax:
-      // e^xi/(e^x1 + ...e^xn) = e^(xi - max) / (e^(x1 - max) + ... + e^(xn - max))
-      float max = -std::numeric_limits<float>::infinity();
-      for (int i = 0; i < D; i++) {
-        if (max < x[i]) max = x[i];
-      }
-      for (int i = 0; i < D; i++) {
-        y[i] = expf(x[i] - max);
-      }
-
-      double sum = 0.0;
-
-      for (int i = 0; i < D; i++) {
-        sum += x[i];
-      }
-
-      if (sum == 0) {
-        for (int i = 0; i < D; i++) {
-          y[i] = 1.0f / (float)D;
-        }
-      } else {
-        for (int i = 0; i < D; i++) {
-          y[i] = x[i] / (float)sum;
-        }
-      }
-    });
+    const int32_t* mask_data = mask_index->template Data<int32_t>();
+    T* output_data = output->template MutableData<T>();
+
+    // each task computes the scores and the output of a block of queries: 2 x S x S* x H multiply-adds and S x S*
+    // exponentials of about 25 cycles
+    const double cost = static_cast<double>(std::min(sequence_length, kQueryBlockSize)) * all_sequence_length *
+                        (head_size * 4 + 30);
+    concurrency::ThreadPool::TryParallelFor(
+        context->GetOperatorThreadPool(), loop_len, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          auto block_data = allocator->Alloc(
+              (kQueryBlockSize * kKeyBlockSize + kQueryBlockSize * head_size + 2 * kQueryBlockSize) * element_size);
+          BufferUniquePtr block_buffer(block_data, BufferDeleter(allocator));
+          T* scores = reinterpret_cast<T*>(block_data);
+          T* accumulator = scores + kQueryBlockSize * kKeyBlockSize;
+          T* row_max = accumulator + kQueryBlockSize * head_size;
+          T* row_sum = row_max + kQueryBlockSize;
+
+          for (std::ptrdiff_t task_idx = first; task_idx < last; ++task_idx) {
+            const int i = static_cast<int>(task_idx) / query_blocks;
+            const int batch_index = i / num_heads_;
+            const int head_index = i % num_heads_;
+            const int query_start = (static_cast<int>(task_idx) % query_blocks) * kQueryBlockSize;
+            const int query_count = std::min(kQueryBlockSize, sequence_length - query_start);
+
+            // The positions from mask, and in unidirectional mode the ones after each query, get -10000. Their
+            // weights are 0 so the blocks of keys masked for every query are skipped, unless all the positions are
+            // masked: the scores are then all shifted by -10000 and every position counts.
+            const int mask = std::min(std::max(mask_data[batch_index], 0), all_sequence_length);
+            int key_end = all_sequence_length;
+            if (mask > 0) {
+              key_end = mask;
+              if (is_unidirectional_) {
+                key_end = std::min(key_end, past_sequence_length + query_start + query_count);
+              }
+            }
+
+            const T* q = Q + (i * sequence_length + query_start) * head_size;
+            const T* k = K + i * all_sequence_length * head_size;
+            const T* v = V + i * all_sequence_length * head_size;
+
+            std::fill_n(row_max, query_count, -std::numeric_limits<T>::infinity());
+            std::fill_n(row_sum, query_count, static_cast<T>(0));
+            std::fill_n(accumulator, query_count * head_size, static_cast<T>(0));
+
+            for (int key_start = 0; key_start < key_end; key_start += kKeyBlockSize) {
+              const int key_count = std::min(kKeyBlockSize, key_end - key_start);
+
+              //                   original           transposed            iteration
+              // A: Q              (BxNxSxH)          (B.N.)S x H            S_q x H
+              // B: K'             (BxNxS*xH)         (B.N.)H x S*           H x S_k
+              // C: scores                                                   S_q x S_k
+
+              math::GemmEx<float, concurrency::ThreadPool>(CblasNoTrans, CblasTrans,
+                                                           query_count, key_count, head_size,
+                                                           alpha,
+                                                           q, head_size,
+                                                           k + key_start * head_size, head_size,
+                                                           0.0f,
+                                                           scores, kKeyBlockSize,
+                                                           nullptr);
+
+              for (int r = 0; r < query_count; r++) {
+                T* row = scores + r * kKeyBlockSize;
+                int masked_start = mask;
+                if (is_unidirectional_) {
+                  masked_start = std::min(masked_start, past_sequence_length + query_start + r + 1);
+                }
+                for (int m_i = std::max(masked_start, key_start); m_i < key_start + key_count; m_i++) {
+                  row[m_i - key_start] += static_cast<T>(-10000.0);
+                }
+
+                // e^(x - max) with the maximum of the scores seen so far, the previous terms are scaled by
+                // e^(previous max - max)
+                const T new_max = std::max(row_max[r], MlasReduceMaximum(row, static_cast<size_t>(key_count)));
+                const T scale = std::exp(row_max[r] - new_max);
+                row_sum[r] = row_sum[r] * scale + MlasComputeSumExp(row, row, static_cast<size_t>(key_count), -new_max);
+                row_max[r] = new_max;
+                if (scale != static_cast<T>(1)) {
+                  EigenVectorArrayMap<T>(accumulator + r * head_size, head_size) *= scale;
+                }
+              }
+
+              //                   original           transposed            iteration
+              // A: weights                                                  S_q x S_k
+              // B: V              (BxNxS*xH)         (B.N.)S* x H           S_k x H
+              // C: accumulator                                              S_q x H
+
+              math::GemmEx<float, concurrency::ThreadPool>(CblasNoTrans, CblasNoTrans,
+                                                           query_count, head_size, key_count,
+                                                           1.0f,
+                                                           scores, kKeyBlockSize,
+                                                           v + key_start * head_size, head_size,
+                                                           1.0f,
+                                                           accumulator, head_size,
+                                                           nullptr);
+            }
+
+            // transpose: out(B, S, N, H) = accumulator(B, N, S, H) / sum
+            for (int r = 0; r < query_count; r++) {
+              T* dest = output_data +
+                        ((batch_index * sequence_length + query_start + r) * num_heads_ + head_index) * head_size;
+              EigenVectorArrayMap<T>(dest, head_size) =
+                  ConstEigenVectorArrayMap<T>(accumulator + r * head_size, head_size) / row_sum[r];
+            }
+          }
+        });
   }
 
-  // STEP.4: out_tmp(B, N, S, H) = P(B, N, S, S) x V(B, N, S, H)
-  auto out_tmp_data = allocator->Alloc(batch_size * num_heads_ * sequence_length * head_size * element_size);
-  BufferUniquePtr out_tmp_buffer(out_tmp_data, BufferDeleter(allocator));
-
-  concurrency::ThreadPool::TryParallelFor(context->GetOperatorThreadPool(), batch_size * num_heads_, [&](int i) {
-    T* current_tmp_data = reinterpret_cast<T*>(out_tmp_data) + sequence_length * head_size * i;
-    math::MatMul<T>(
-        sequence_length,
-        head_size,
-        sequence_length,
-        reinterpret_cast<T*>(scratch_data) + sequence_length * sequence_length * i,
-        V + sequence_length * head_size * i,
-        current_tmp_data,
-        nullptr);
-
-    // transpose: out(B, S, N, H) = transpose out_tmp(B, N, S, H)
-    const int batch_index = i / num_heads_;
-    const int head_index = i % num_heads_;
-    T* src = current_tmp_data;
-    T* dest = output->template MutableData<T>() + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
-    for (int j = 0; j < sequence_length; j++) {
-      memcpy(dest, src, head_size * sizeof(T));
-      src += head_size;
-      dest += hidden_size;
-    }
-  });
-
   return Status::OK();
 }
 
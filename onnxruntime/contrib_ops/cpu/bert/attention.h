@@ -14,7 +14,8 @@ class AttentionBase {
   AttentionBase(const OpKernelInfo& info);
   Status CheckInputs(const OpKernelContext* context) const;
 
-  int num_heads_;  // number of attention heads
+  int num_heads_;            // number of attention heads
+  bool is_unidirectional_;  // whether every position attends only to the positions up to it
 };
 
 template <typename T>
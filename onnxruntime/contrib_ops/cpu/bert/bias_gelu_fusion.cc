@@ -50,25 +50,31 @@ Status BiasGelu<T>::Compute(OpKernelContext* ctx) const {
   T* Y_data = Y->template MutableData<T>();
   int64_t task_count = X->Shape().Size() / bias_len;
 
-  concurrency::ThreadPool::TryBatchParallelFor(ctx->GetOperatorThreadPool(),
-                                               static_cast<int32_t>(task_count),
-                                               [&](int32_t task_idx) {
-                                                 const T* p_input = X_data + task_idx * bias_len;
-                                                 T* p_output = Y_data + task_idx * bias_len;
-                                                 T* p_output_tmp = tmp_data + task_idx * bias_len;
+  // erf is about 20 cycles per element
+  const concurrency::TensorOpCost cost{static_cast<double>(bias_len * 4 * sizeof(T)),
+                                       static_cast<double>(bias_len * 3 * sizeof(T)),
+                                       static_cast<double>(bias_len * 25)};
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(task_count), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t task_idx = first; task_idx < last; ++task_idx) {
+          const T* p_input = X_data + task_idx * bias_len;
+          T* p_output = Y_data + task_idx * bias_len;
+          T* p_output_tmp = tmp_data + task_idx * bias_len;
 
-                                                 for (int64_t h = 0; h < bias_len; h++) {
-                                                   T value = p_input[h] + B_data[h];
-                                                   p_output[h] = value * static_cast<T>(M_SQRT1_2);
-                                                   p_output_tmp[h] = value * 0.5f;
-                                                 }
+          for (int64_t h = 0; h < bias_len; h++) {
+            T value = p_input[h] + B_data[h];
+            p_output[h] = value * static_cast<T>(M_SQRT1_2);
+            p_output_tmp[h] = value * 0.5f;
+          }
 
-                                                 MlasComputeErf(p_output, p_output, bias_len);
+          MlasComputeErf(p_output, p_output, bias_len);
 
-                                                 for (int64_t h = 0; h < bias_len; h++) {
-                                                   p_output[h] = p_output_tmp[h] * (p_output[h] + 1.0f);
-                                                 }
-                                               });
+          for (int64_t h = 0; h < bias_len; h++) {
+            p_output[h] = p_output_tmp[h] * (p_output[h] + 1.0f);
+          }
+        }
+      });
 
   return Status::OK();
 }
@@ -60,116 +60,123 @@ void CropAndResizeForward(const TensorShape& output_shape,
   int64_t pooled_height = output_shape[2];
   int64_t pooled_width = output_shape[3];
 
-  ThreadPool::TryBatchParallelFor(ttp, static_cast<int32_t>(n_rois), [&](int32_t n) {
-    int64_t index_n = n * channels * pooled_width * pooled_height;
-
-    const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
-    const auto roi_batch_ind = batch_indices_ptr[n];
-
-    T roi_start_w = offset_bottom_rois[1];
-    T roi_start_h = offset_bottom_rois[0];
-    T roi_end_w = offset_bottom_rois[3];
-    T roi_end_h = offset_bottom_rois[2];
-
-    T height_scale = (pooled_height > 1)
-                         ? (roi_end_h - roi_start_h) * (height - 1) / (pooled_height - 1)
-                         : 0;
-    T width_scale = (pooled_width > 1)
-                        ? (roi_end_w - roi_start_w) * (width - 1) / (pooled_width - 1)
-                        : 0;
-
-    for (auto ph = 0; ph < pooled_height; ph++) {
-      T in_y = static_cast<T>((pooled_height > 1)
-                                  ? roi_start_h * (height - 1) + ph * height_scale
-                                  : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-      if (ph == pooled_height - 1) {
-        in_y = static_cast<T>((pooled_height > 1)
-                                  ? roi_end_h * (height - 1)
-                                  : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-      }
-      if (ph == 0) {
-        in_y = static_cast<T>((pooled_height > 1)
-                                  ? roi_start_h * (height - 1)
-                                  : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
-      }
-      if (in_y < 0 || in_y > height - 1) {
-        for (int64_t pw = 0; pw < pooled_width; pw++) {
-          for (int64_t c = 0; c < channels; c++) {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            top_data[index] = extrapolation_value;
-          }
-        }
-        continue;
-      }
-
-      const int top_y_index = static_cast<int>(floorf(static_cast<float>(in_y)));
-      const int bottom_y_index = static_cast<int>(ceilf(static_cast<float>(in_y)));
-      const float y_lerp = static_cast<float>(in_y - top_y_index);
-
-      for (auto pw = 0; pw < pooled_width; pw++) {
-        T in_x = static_cast<T>((pooled_width > 1)
-                                    ? roi_start_w * (width - 1) + pw * width_scale
-                                    : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-        if (pw == pooled_width - 1) {
-          in_x = static_cast<T>((pooled_width > 1)
-                                    ? roi_end_w * (width - 1)
-                                    : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-        }
-        if (pw == 0) {
-          in_x = static_cast<T>((pooled_width > 1)
-                                    ? roi_start_w * (width - 1)
-                                    : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
-        }
-        if (in_x < 0 || in_x > width - 1) {
-          for (int64_t c = 0; c < channels; c++) {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            top_data[index] = extrapolation_value;
-          }
-          continue;
-        }
-
-        T output_val = extrapolation_value;
-        if (mode == "bilinear") {
-          const int left_x_index = static_cast<int>(floorf(static_cast<float>(in_x)));
-          const int right_x_index = static_cast<int>(ceilf(static_cast<float>(in_x)));
-          const float x_lerp = static_cast<float>(in_x - left_x_index);
-          auto top_left_index = top_y_index * width + left_x_index;
-          auto top_right_index = top_y_index * width + right_x_index;
-          auto bottom_left_index = bottom_y_index * width + left_x_index;
-          auto bottom_right_index = bottom_y_index * width + right_x_index;
-
-          for (auto c = 0; c < channels; c++) {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            const T* offset_bottom_data =
-                bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-            const float top_left(static_cast<float>(offset_bottom_data[top_left_index]));
-            const float top_right(static_cast<float>(offset_bottom_data[top_right_index]));
-            const float bottom_left(static_cast<float>(offset_bottom_data[bottom_left_index]));
-            const float bottom_right(static_cast<float>(offset_bottom_data[bottom_right_index]));
-            const float top = top_left + (top_right - top_left) * x_lerp;
-            const float bottom = bottom_left + (bottom_right - bottom_left) * x_lerp;
-            output_val = top + (bottom - top) * y_lerp;
-            top_data[index] = output_val;
-          }
-        } else {  // mode == "nearest"
-          const int closest_x_index = static_cast<int>(roundf(static_cast<float>(in_x)));
-          const int closest_y_index = static_cast<int>(roundf(static_cast<float>(in_y)));
-          auto closest_index = closest_y_index * width + closest_x_index;
-
-          for (auto c = 0; c < channels; c++) {
-            int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-            int64_t index = index_n_c + ph * pooled_width + pw;
-            const T* offset_bottom_data =
-                bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-            top_data[index] = static_cast<float>(offset_bottom_data[closest_index]);
-          }
-        }
-      }  // for pw
-    }    // for ph
-  });    // for n
+  // every output value of a roi is interpolated from 4 input values
+  const TensorOpCost cost{static_cast<double>(channels * pooled_height * pooled_width * 4 * sizeof(T)),
+                          static_cast<double>(channels * pooled_height * pooled_width * sizeof(T)),
+                          static_cast<double>(channels * pooled_height * pooled_width * 8)};
+  ThreadPool::TryParallelFor(
+      ttp, static_cast<std::ptrdiff_t>(n_rois), cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t n = first; n < last; ++n) {
+          int64_t index_n = n * channels * pooled_width * pooled_height;
+
+          const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
+          const auto roi_batch_ind = batch_indices_ptr[n];
+
+          T roi_start_w = offset_bottom_rois[1];
+          T roi_start_h = offset_bottom_rois[0];
+          T roi_end_w = offset_bottom_rois[3];
+          T roi_end_h = offset_bottom_rois[2];
+
+          T height_scale = (pooled_height > 1)
+                               ? (roi_end_h - roi_start_h) * (height - 1) / (pooled_height - 1)
+                               : 0;
+          T width_scale = (pooled_width > 1)
+                              ? (roi_end_w - roi_start_w) * (width - 1) / (pooled_width - 1)
+                              : 0;
+
+          for (auto ph = 0; ph < pooled_height; ph++) {
+            T in_y = static_cast<T>((pooled_height > 1)
+                                        ? roi_start_h * (height - 1) + ph * height_scale
+                                        : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
+            if (ph == pooled_height - 1) {
+              in_y = static_cast<T>((pooled_height > 1)
+                                        ? roi_end_h * (height - 1)
+                                        : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
+            }
+            if (ph == 0) {
+              in_y = static_cast<T>((pooled_height > 1)
+                                        ? roi_start_h * (height - 1)
+                                        : 0.5 * (roi_start_h + roi_end_h) * (height - 1));
+            }
+            if (in_y < 0 || in_y > height - 1) {
+              for (int64_t pw = 0; pw < pooled_width; pw++) {
+                for (int64_t c = 0; c < channels; c++) {
+                  int64_t index_n_c = index_n + c * pooled_width * pooled_height;
+                  int64_t index = index_n_c + ph * pooled_width + pw;
+                  top_data[index] = extrapolation_value;
+                }
+              }
+              continue;
+            }
+
+            const int top_y_index = static_cast<int>(floorf(static_cast<float>(in_y)));
+            const int bottom_y_index = static_cast<int>(ceilf(static_cast<float>(in_y)));
+            const float y_lerp = static_cast<float>(in_y - top_y_index);
+
+            for (auto pw = 0; pw < pooled_width; pw++) {
+              T in_x = static_cast<T>((pooled_width > 1)
+                                          ? roi_start_w * (width - 1) + pw * width_scale
+                                          : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
+              if (pw == pooled_width - 1) {
+                in_x = static_cast<T>((pooled_width > 1)
+                                          ? roi_end_w * (width - 1)
+                                          : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
+              }
+              if (pw == 0) {
+                in_x = static_cast<T>((pooled_width > 1)
+                                          ? roi_start_w * (width - 1)
+                                          : 0.5 * (roi_start_w + roi_end_w) * (width - 1));
+              }
+              if (in_x < 0 || in_x > width - 1) {
+                for (int64_t c = 0; c < channels; c++) {
+                  int64_t index_n_c = index_n + c * pooled_width * pooled_height;
+                  int64_t index = index_n_c + ph * pooled_width + pw;
+                  top_data[index] = extrapolation_value;
+                }
+                continue;
+              }
+
+              T output_val = extrapolation_value;
+              if (mode == "bilinear") {
+                const int left_x_index = static_cast<int>(floorf(static_cast<float>(in_x)));
+                const int right_x_index = static_cast<int>(ceilf(static_cast<float>(in_x)));
+                const float x_lerp = static_cast<float>(in_x - left_x_index);
+                auto top_left_index = top_y_index * width + left_x_index;
+                auto top_right_index = top_y_index * width + right_x_index;
+                auto bottom_left_index = bottom_y_index * width + left_x_index;
+                auto bottom_right_index = bottom_y_index * width + right_x_index;
+
+                for (auto c = 0; c < channels; c++) {
+                  int64_t index_n_c = index_n + c * pooled_width * pooled_height;
+                  int64_t index = index_n_c + ph * pooled_width + pw;
+                  const T* offset_bottom_data =
+                      bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
+                  const float top_left(static_cast<float>(offset_bottom_data[top_left_index]));
+                  const float top_right(static_cast<float>(offset_bottom_data[top_right_index]));
+                  const float bottom_left(static_cast<float>(offset_bottom_data[bottom_left_index]));
+                  const float bottom_right(static_cast<float>(offset_bottom_data[bottom_right_index]));
+                  const float top = top_left + (top_right - top_left) * x_lerp;
+                  const float bottom = bottom_left + (bottom_right - bottom_left) * x_lerp;
+                  output_val = top + (bottom - top) * y_lerp;
+                  top_data[index] = output_val;
+                }
+              } else {  // mode == "nearest"
+                const int closest_x_index = static_cast<int>(roundf(static_cast<float>(in_x)));
+                const int closest_y_index = static_cast<int>(roundf(static_cast<float>(in_y)));
+                auto closest_index = closest_y_index * width + closest_x_index;
+
+                for (auto c = 0; c < channels; c++) {
+                  int64_t index_n_c = index_n + c * pooled_width * pooled_height;
+                  int64_t index = index_n_c + ph * pooled_width + pw;
+                  const T* offset_bottom_data =
+                      bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
+                  top_data[index] = static_cast<float>(offset_bottom_data[closest_index]);
+                }
+              }
+            }  // for pw
+          }    // for ph
+        }      // for n
+      });
 }
 
 template <typename T>
@@ -87,30 +87,35 @@ Status LayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
     inv_std_var_data = static_cast<T*>(inv_std_var_data_buf_ptr.get());
   }
 
-  concurrency::ThreadPool::TryBatchParallelFor(p_ctx->GetOperatorThreadPool(),
-                                               static_cast<int32_t>(norm_count),
-                                               [&](int32_t task_idx) {
-                                                 const T* p_input = X_data + task_idx * norm_size;
-                                                 T* p_output = Y_data + task_idx * norm_size;
-
-                                                 T mean = 0;
-                                                 T mean_square = 0;
-
-                                                 for (int64_t h = 0; h < norm_size; h++) {
-                                                   mean += p_input[h];
-                                                   mean_square += p_input[h] * p_input[h];
-                                                 }
-
-                                                 mean = mean / norm_size;
-                                                 mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon_);
-
-                                                 for (int64_t h = 0; h < norm_size; h++) {
-                                                   p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
-                                                 }
-
-                                                 mean_data[task_idx] = mean;
-                                                 inv_std_var_data[task_idx] = mean_square;
-                                               });
+  concurrency::ThreadPool::TryParallelFor(
+      p_ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(norm_count),
+      concurrency::TensorOpCost{static_cast<double>(norm_size * 4 * sizeof(T)),
+                                static_cast<double>(norm_size * sizeof(T)),
+                                static_cast<double>(norm_size * 7)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t task_idx = first; task_idx < last; ++task_idx) {
+          const T* p_input = X_data + task_idx * norm_size;
+          T* p_output = Y_data + task_idx * norm_size;
+
+          T mean = 0;
+          T mean_square = 0;
+
+          for (int64_t h = 0; h < norm_size; h++) {
+            mean += p_input[h];
+            mean_square += p_input[h] * p_input[h];
+          }
+
+          mean = mean / norm_size;
+          mean_square = sqrt(mean_square / norm_size - mean * mean + epsilon_);
+
+          for (int64_t h = 0; h < norm_size; h++) {
+            p_output[h] = (p_input[h] - mean) / mean_square * scale_data[h] + bias_data[h];
+          }
+
+          mean_data[task_idx] = mean;
+          inv_std_var_data[task_idx] = mean_square;
+        }
+      });
 
   return Status::OK();
 }
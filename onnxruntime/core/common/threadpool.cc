@@ -4,7 +4,17 @@
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <limits>
+#include <mutex>
+
+#ifdef USE_OPENMP
+#include <omp.h>
+#endif
 
 #if defined(__GNUC__)
 #pragma GCC diagnostic push
@@ -110,6 +120,182 @@ void ThreadPool::ParallelForRange(int64_t first, int64_t last, std::function<voi
   barrier.Wait();
 }
 
+namespace {
+// Cost model of Eigen's TensorCostModel: memory accesses are converted to cycles, a loop is worth running on
+// an extra thread once it costs more than kPerThreadCycles and a block should cost about kTaskSize cycles.
+constexpr double kLoadCycles = 1.0 / 64 * 11;
+constexpr double kStoreCycles = 1.0 / 64 * 11;
+constexpr double kStartupCycles = 100000;
+constexpr double kPerThreadCycles = 100000;
+constexpr double kTaskSize = 40000;
+
+double TotalCost(std::ptrdiff_t total, const TensorOpCost& cost_per_unit) {
+  return static_cast<double>(total) * (kLoadCycles * cost_per_unit.bytes_loaded +
+                                       kStoreCycles * cost_per_unit.bytes_stored + cost_per_unit.compute_cycles);
+}
+
+// Number of threads worth using for the loop, between 1 and max_threads.
+int CostModelNumThreads(std::ptrdiff_t total, const TensorOpCost& cost_per_unit, int max_threads) {
+  double threads = (TotalCost(total, cost_per_unit) - kStartupCycles) / kPerThreadCycles + 0.9;
+  threads = std::min<double>(threads, std::numeric_limits<int>::max());
+  return std::min(max_threads, std::max(1, static_cast<int>(threads)));
+}
+
+std::ptrdiff_t DivUp(std::ptrdiff_t x, std::ptrdiff_t y) { return (x + y - 1) / y; }
+
+// Size of the blocks the loop is split into. As in Eigen's ThreadPoolDevice a block costs at least kTaskSize
+// cycles, the loop is split into no more than 4 blocks per thread, and the block size is then coarsened as long
+// as it does not lower the fraction of the threads kept busy in the last round of blocks.
+std::ptrdiff_t CalculateParallelForBlockSize(std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                                             int num_threads) {
+  const double unit_cost = TotalCost(1, cost_per_unit);
+  const double min_block_size = unit_cost > 0 ? kTaskSize / unit_cost : static_cast<double>(total);
+  const std::ptrdiff_t max_oversharding_factor = 4;
+  std::ptrdiff_t block_size = static_cast<std::ptrdiff_t>(std::min<double>(
+      static_cast<double>(total),
+      std::max<double>(static_cast<double>(DivUp(total, max_oversharding_factor * num_threads)), min_block_size)));
+  block_size = std::max<std::ptrdiff_t>(block_size, 1);
+  const std::ptrdiff_t max_block_size = std::min(total, 2 * block_size);
+
+  std::ptrdiff_t block_count = DivUp(total, block_size);
+  double max_efficiency = static_cast<double>(block_count) / (DivUp(block_count, num_threads) * num_threads);
+  for (std::ptrdiff_t prev_block_count = block_count; max_efficiency < 1.0 && prev_block_count > 1;) {
+    const std::ptrdiff_t coarser_block_size = DivUp(total, prev_block_count - 1);
+    if (coarser_block_size > max_block_size) {
+      break;
+    }
+    const std::ptrdiff_t coarser_block_count = DivUp(total, coarser_block_size);
+    prev_block_count = coarser_block_count;
+    const double coarser_efficiency =
+        static_cast<double>(coarser_block_count) / (DivUp(coarser_block_count, num_threads) * num_threads);
+    if (coarser_efficiency + 0.01 >= max_efficiency) {
+      block_size = coarser_block_size;
+      block_count = coarser_block_count;
+      max_efficiency = std::max(max_efficiency, coarser_efficiency);
+    }
+  }
+  return block_size;
+}
+
+// Shared between the caller of ParallelFor and the helper tasks it scheduled. The helpers may start after the
+// loop is over, so they own a reference to the state and only touch fn while blocks are left to claim.
+struct ParallelForState {
+  ParallelForState(std::ptrdiff_t total_in, std::ptrdiff_t block_size_in,
+                   const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn_in)
+      : total(total_in), block_size(block_size_in), block_count(DivUp(total_in, block_size_in)), fn(&fn_in) {}
+
+  // Claims and runs blocks until none are left.
+  void RunBlocks() {
+    for (;;) {
+      const std::ptrdiff_t block = next_block.fetch_add(1, std::memory_order_relaxed);
+      if (block >= block_count) {
+        return;
+      }
+      const std::ptrdiff_t first = block * block_size;
+      const std::ptrdiff_t last = std::min(total, first + block_size);
+      try {
+        (*fn)(first, last);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!exception) {
+          exception = std::current_exception();
+        }
+      }
+      if (completed_blocks.fetch_add(1, std::memory_order_acq_rel) + 1 == block_count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        done.notify_all();
+      }
+    }
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]() { return completed_blocks.load(std::memory_order_acquire) == block_count; });
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+  }
+
+  const std::ptrdiff_t total;
+  const std::ptrdiff_t block_size;
+  const std::ptrdiff_t block_count;
+  const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>* fn;
+  std::atomic<std::ptrdiff_t> next_block{0};
+  std::atomic<std::ptrdiff_t> completed_blocks{0};
+  std::mutex mutex;
+  std::condition_variable done;
+  std::exception_ptr exception;
+};
+}  // namespace
+
+std::ptrdiff_t ThreadPool::CalculateParallelForBlockCount(std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                                                          int num_threads) {
+  if (total <= 1 || num_threads <= 1 || CostModelNumThreads(total, cost_per_unit, num_threads) == 1) {
+    return total > 0 ? 1 : 0;
+  }
+  return DivUp(total, CalculateParallelForBlockSize(total, cost_per_unit, num_threads));
+}
+
+void ThreadPool::ParallelFor(std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                             const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
+  if (total <= 0)
+    return;
+
+  // the calling thread takes part in the loop
+  const int num_threads = NumThreads() + 1;
+  const int threads_to_use = total == 1 ? 1 : CostModelNumThreads(total, cost_per_unit, num_threads);
+  if (threads_to_use == 1) {
+    fn(0, total);
+    return;
+  }
+
+  const std::ptrdiff_t block_size = CalculateParallelForBlockSize(total, cost_per_unit, num_threads);
+  auto state = std::make_shared<ParallelForState>(total, block_size, fn);
+  if (state->block_count == 1) {
+    fn(0, total);
+    return;
+  }
+
+  // The blocks are not bound to threads: every helper keeps claiming blocks until none are left, so the threads
+  // that get to run first pick up the work of the ones still busy elsewhere. The caller only waits for the blocks
+  // that have been claimed, which keeps nested loops from waiting on tasks queued behind them.
+  const std::ptrdiff_t helpers = std::min<std::ptrdiff_t>(threads_to_use - 1, state->block_count - 1);
+  for (std::ptrdiff_t i = 0; i < helpers; ++i) {
+    Schedule([state]() { state->RunBlocks(); });
+  }
+  state->RunBlocks();
+  state->Wait();
+}
+
+void ThreadPool::TryParallelFor(concurrency::ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
+                                const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
+  if (tp != nullptr) {
+    tp->ParallelFor(total, cost_per_unit, fn);
+    return;
+  }
+
+  if (total <= 0)
+    return;
+
+#ifdef USE_OPENMP
+  const std::ptrdiff_t block_count = CalculateParallelForBlockCount(total, cost_per_unit, omp_get_max_threads());
+  if (block_count > 1) {
+    const std::ptrdiff_t block_size = DivUp(total, block_count);
+#pragma omp parallel for
+    for (std::ptrdiff_t block = 0; block < block_count; ++block) {
+      const std::ptrdiff_t first = block * block_size;
+      if (first < total) {
+        fn(first, std::min(total, first + block_size));
+      }
+    }
+    return;
+  }
+#else
+  ORT_UNUSED_PARAMETER(cost_per_unit);
+#endif
+  fn(0, total);
+}
+
 // void ThreadPool::SetStealPartitions(const std::vector<std::pair<unsigned, unsigned>>& partitions) {
 //   impl_->SetStealPartitions(partitions);
 // }
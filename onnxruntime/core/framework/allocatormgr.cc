@@ -4,6 +4,7 @@
 #include "core/framework/allocatormgr.h"
 #include "core/framework/bfc_arena.h"
 #include "core/framework/mimalloc_arena.h"
+#include "core/framework/thread_caching_arena.h"
 #include <mutex>
 #include <sstream>
 #include <unordered_map>
@@ -22,6 +23,10 @@ using namespace ::onnxruntime::common;
 AllocatorPtr CreateAllocator(DeviceAllocatorRegistrationInfo info, int device_id) {
   auto device_allocator = std::unique_ptr<IDeviceAllocator>(info.factory(device_id));
   if (device_allocator->AllowsArena()) {
+    if (info.use_thread_cache) {
+      return std::shared_ptr<IArenaAllocator>(
+          onnxruntime::make_unique<ThreadCachingArena>(std::move(device_allocator), info.max_mem));
+    }
     return std::shared_ptr<IArenaAllocator>(
           onnxruntime::make_unique<TArenaAllocator>(std::move(device_allocator), info.max_mem));
   }
@@ -14,6 +14,8 @@ struct DeviceAllocatorRegistrationInfo {
   OrtMemType mem_type;
   DeviceAllocatorFactory factory;
   size_t max_mem;
+  // put a ThreadCachingArena in front of the arena, see thread_caching_arena.h
+  bool use_thread_cache = false;
 };
 
 AllocatorPtr CreateAllocator(DeviceAllocatorRegistrationInfo info, int device_id = 0);
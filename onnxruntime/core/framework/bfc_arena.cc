@@ -247,6 +247,37 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   return nullptr;
 }
 
+size_t BFCArena::AllocBatch(size_t size, size_t count, void** ptrs) {
+  if (size == 0) {
+    return 0;
+  }
+  size_t rounded_bytes = RoundedBytes(size);
+  BinNum bin_num = BinNumForSize(rounded_bytes);
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  size_t allocated = 0;
+  for (; allocated < count; ++allocated) {
+    void* ptr = FindChunkPtr(bin_num, rounded_bytes, size);
+    if (ptr == nullptr && Extend(rounded_bytes)) {
+      ptr = FindChunkPtr(bin_num, rounded_bytes, size);
+    }
+    if (ptr == nullptr) {
+      break;
+    }
+    ptrs[allocated] = ptr;
+  }
+  return allocated;
+}
+
+void BFCArena::FreeBatch(void* const* ptrs, size_t count) {
+  std::lock_guard<OrtMutex> lock(lock_);
+  for (size_t i = 0; i < count; ++i) {
+    if (ptrs[i] != nullptr) {
+      DeallocateRawInternal(ptrs[i]);
+    }
+  }
+}
+
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
@@ -85,6 +85,14 @@ class BFCArena : public IArenaAllocator {
 
   size_t AllocatedSize(const void* ptr);
 
+  // Allocates up to count chunks of size bytes each under a single acquisition of the lock, for front-ends caching
+  // the chunks (see ThreadCachingArena). Returns the number of chunks allocated to ptrs, which is less than count
+  // when the arena runs out of memory.
+  size_t AllocBatch(size_t size, size_t count, void** ptrs);
+
+  // Frees count chunks returned by Alloc or AllocBatch under a single acquisition of the lock.
+  void FreeBatch(void* const* ptrs, size_t count);
+
  private:
   void* AllocateRawInternal(size_t num_bytes, bool dump_log_on_failure);
   void DeallocateRawInternal(void* ptr);
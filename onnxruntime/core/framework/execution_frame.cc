@@ -278,19 +278,18 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       // if block not found, fall back to default behavior
       if (block) {
         auto it = buffers_.find(location);
-        // if the block is not correct, log message then fall back to default behavior
-        if (it != buffers_.end() && block->size_ == size) {
+        // if the block is not correct, log message then fall back to default behavior.
+        // a larger block is fine, the pattern may have been planned for larger shapes of the same bucket.
+        if (it != buffers_.end() && block->size_ >= size) {
           void* buffer = it->second.get();
           auto status = AllocateTensorWithPreAllocateBufferHelper(
               ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
               shape);
           return status;
         }
-        if (block->size_ != size) {
+        if (block->size_ < size) {
           // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
           // fed in, so use VERBOSE as the log level as it's expected.
-          // TODO: Should we re-use the block if the size is large enough? Would probably need to allow it
-          // to be freed if the size difference was too large so our memory usage doesn't stick at a high water mark
           LOGS_DEFAULT(VERBOSE) << "For ort_value with index: " << ort_value_index
                                 << ", block in memory pattern size is: " << block->size_
                                 << " but the actually size is: " << size
@@ -73,6 +73,8 @@ class FeedsFetchesManager {
 
   const DeviceCopyChecks& GetDeviceCopyChecks() const { return device_copy_checks_; }
   void SetDeviceCopyChecks(DeviceCopyCheck input_copy_needed, DeviceCopyCheck output_copy_needed);
+  // forget the checks of a previous execution, e.g. when a manager cached by an IOBinding is reused
+  void ResetDeviceCopyChecks() { device_copy_checks_ = {}; }
 
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(FeedsFetchesManager);
@@ -0,0 +1,105 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_cache.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+
+MemoryPatternCache::MemoryPatternCache(size_t capacity, int64_t dim_bucket_size)
+    : capacity_(capacity),
+      dim_bucket_size_(dim_bucket_size > 1 ? dim_bucket_size : 0),
+      entries_(std::make_shared<const EntryMap>()) {
+}
+
+size_t MemoryPatternCache::KeyHash::operator()(const std::vector<int64_t>& key) const {
+  size_t hash = key.size();
+  for (auto value : key) {
+    hash ^= std::hash<int64_t>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+  return hash;
+}
+
+void MemoryPatternCache::MakeKey(const InputShapes& input_shapes, std::vector<int64_t>& key,
+                                 std::vector<int64_t>& dims) const {
+  for (const auto& shape : input_shapes) {
+    const auto& shape_dims = shape.get().GetDims();
+    dims.push_back(static_cast<int64_t>(shape_dims.size()));
+    dims.insert(dims.end(), shape_dims.begin(), shape_dims.end());
+  }
+
+  key = dims;
+  if (dim_bucket_size_ > 0) {
+    size_t i = 0;
+    while (i < key.size()) {
+      size_t rank = static_cast<size_t>(key[i++]);
+      for (size_t end = i + rank; i < end; ++i) {
+        key[i] = (key[i] + dim_bucket_size_ - 1) / dim_bucket_size_ * dim_bucket_size_;
+      }
+    }
+  }
+}
+
+bool MemoryPatternCache::Covers(const std::vector<int64_t>& pattern_dims, const std::vector<int64_t>& dims) const {
+  // without bucketing equal keys mean equal shapes
+  if (dim_bucket_size_ == 0) return true;
+
+  // the keys are equal so the ranks are at the same positions in both
+  return std::equal(dims.begin(), dims.end(), pattern_dims.begin(),
+                    [](int64_t dim, int64_t pattern_dim) { return dim <= pattern_dim; });
+}
+
+std::shared_ptr<const MemoryPatternGroup> MemoryPatternCache::Find(const InputShapes& input_shapes) const {
+  std::vector<int64_t> key, dims;
+  MakeKey(input_shapes, key, dims);
+
+  auto entries = std::atomic_load(&entries_);
+  auto it = entries->find(key);
+  if (it == entries->end() || !Covers(it->second->dims, dims)) {
+    ++misses_;
+    return nullptr;
+  }
+
+  ++hits_;
+  it->second->last_use.store(++use_clock_, std::memory_order_relaxed);
+  return it->second->patterns;
+}
+
+void MemoryPatternCache::Insert(const InputShapes& input_shapes, std::unique_ptr<MemoryPatternGroup> mem_patterns) {
+  std::vector<int64_t> key, dims;
+  MakeKey(input_shapes, key, dims);
+
+  std::lock_guard<OrtMutex> lock(insert_lock_);
+  auto entries = std::atomic_load(&entries_);
+  auto it = entries->find(key);
+  if (it != entries->end() && Covers(it->second->dims, dims)) {
+    // another Run with the same shapes got there first
+    return;
+  }
+
+  auto updated = std::make_shared<EntryMap>(*entries);
+  if (it == entries->end() && capacity_ > 0 && updated->size() >= capacity_) {
+    auto lru = std::min_element(updated->begin(), updated->end(),
+                                [](const EntryMap::value_type& a, const EntryMap::value_type& b) {
+                                  return a.second->last_use.load(std::memory_order_relaxed) <
+                                         b.second->last_use.load(std::memory_order_relaxed);
+                                });
+    updated->erase(lru);
+    ++evictions_;
+  }
+
+  (*updated)[key] = std::make_shared<Entry>(std::move(dims), std::move(mem_patterns), ++use_clock_);
+  std::atomic_store(&entries_, std::shared_ptr<const EntryMap>(std::move(updated)));
+}
+
+MemoryPatternCacheStats MemoryPatternCache::Stats() const {
+  MemoryPatternCacheStats stats;
+  stats.hits = hits_.load();
+  stats.misses = misses_.load();
+  stats.evictions = evictions_.load();
+  stats.size = std::atomic_load(&entries_)->size();
+  return stats;
+}
+
+}  // namespace onnxruntime
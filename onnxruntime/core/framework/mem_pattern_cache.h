@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/tensor_shape.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+struct MemoryPatternCacheStats {
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+  // number of patterns currently cached
+  size_t size = 0;
+};
+
+/**
+ * Bounded cache of the memory patterns of a SessionState, keyed by the shapes of the inputs of a Run.
+ * Lookups don't take a lock: they read an immutable snapshot of the entries which Insert replaces (copy on write)
+ * under a mutex, so the Runs only contend when a new pattern is added. Once the capacity is reached the least
+ * recently used pattern is evicted; a Run holds on to its pattern through a shared_ptr so the eviction is safe.
+ *
+ * With a dim_bucket_size, the dimensions of the key are rounded up to a multiple of it so nearby shapes share one
+ * pattern. A bucket keeps the pattern traced for the largest shapes seen in it: it's used for the smaller shapes,
+ * whose tensors fit in its blocks, and replaced when a Run has shapes bigger than the ones it was traced for.
+ */
+class MemoryPatternCache {
+ public:
+  using InputShapes = std::vector<std::reference_wrapper<const TensorShape>>;
+
+  // A capacity of 0 is unbounded. A dim_bucket_size of 0 or 1 disables the bucketing.
+  MemoryPatternCache(size_t capacity, int64_t dim_bucket_size);
+
+  // Returns nullptr if there is no pattern usable for these input shapes.
+  std::shared_ptr<const MemoryPatternGroup> Find(const InputShapes& input_shapes) const;
+
+  // Adds the pattern traced by a Run with these input shapes, unless one usable for them was added meanwhile.
+  void Insert(const InputShapes& input_shapes, std::unique_ptr<MemoryPatternGroup> mem_patterns);
+
+  MemoryPatternCacheStats Stats() const;
+
+  size_t Capacity() const { return capacity_; }
+  int64_t DimBucketSize() const { return dim_bucket_size_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MemoryPatternCache);
+
+  struct Entry {
+    Entry(std::vector<int64_t> dims_in, std::unique_ptr<MemoryPatternGroup> patterns_in, uint64_t use)
+        : dims(std::move(dims_in)), patterns(std::move(patterns_in)), last_use(use) {}
+
+    // rank and dimensions of the input shapes the pattern was traced for, in the layout of the key
+    const std::vector<int64_t> dims;
+    const std::shared_ptr<const MemoryPatternGroup> patterns;
+    std::atomic<uint64_t> last_use;
+  };
+
+  struct KeyHash {
+    size_t operator()(const std::vector<int64_t>& key) const;
+  };
+
+  using EntryMap = std::unordered_map<std::vector<int64_t>, std::shared_ptr<Entry>, KeyHash>;
+
+  // Flattens the input shapes into their rank followed by their dimensions. The key has the dimensions rounded up
+  // to the bucket size, dims has them as they are.
+  void MakeKey(const InputShapes& input_shapes, std::vector<int64_t>& key, std::vector<int64_t>& dims) const;
+  // A pattern traced for pattern_dims can serve a Run with dims.
+  bool Covers(const std::vector<int64_t>& pattern_dims, const std::vector<int64_t>& dims) const;
+
+  const size_t capacity_;
+  const int64_t dim_bucket_size_;
+
+  // current snapshot, read with std::atomic_load and replaced with std::atomic_store
+  std::shared_ptr<const EntryMap> entries_;
+  OrtMutex insert_lock_;
+
+  mutable std::atomic<uint64_t> use_clock_{0};
+  mutable std::atomic<uint64_t> hits_{0};
+  mutable std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> evictions_{0};
+};
+
+}  // namespace onnxruntime
@@ -33,11 +33,24 @@ struct SessionOptions {
   // See class 'OrtValuePatternPlanner'.
   bool enable_mem_pattern = true;
 
+  // maximum number of memory patterns kept, one per distinct set of input shapes (or of buckets of input shapes).
+  // The least recently used pattern is evicted first. 0 keeps them all.
+  size_t mem_pattern_cache_capacity = 64;
+
+  // when greater than 1, the input dimensions are rounded up to a multiple of this value to look up the memory
+  // patterns so nearby shapes (e.g. variable sequence lengths) share one pattern, planned for the largest shapes
+  // of the bucket seen so far. 0 looks up the patterns by the exact input shapes.
+  int64_t mem_pattern_dim_bucket_size = 0;
+
   // enable the memory arena on CPU
   // Arena may pre-allocate memory for future usage.
   // set this option to false if you don't want it.
   bool enable_cpu_mem_arena = true;
 
+  // keep a per-thread cache of the small blocks in front of the memory arena on CPU, which reduces the contention
+  // on the arena between concurrent Run calls. Only used when enable_cpu_mem_arena is set.
+  bool enable_cpu_mem_arena_thread_cache = false;
+
   // the prefix of the profile file. The current time will be appended to the file name.
   std::basic_string<ORTCHAR_T> profile_file_prefix = ORT_TSTR("onnxruntime_profile_");
 
@@ -61,8 +74,18 @@ struct SessionOptions {
   // configuring this makes sense only when you're using parallel executor
   int inter_op_num_threads = 0;
 
+  // when false the session doesn't create its own thread pools and uses the ones of the Environment it is created
+  // in instead, which must then have been created with global thread pools.
+  bool use_per_session_threads = true;
+
   // For models with free input dimensions (most commonly batch size), specifies a set of values to override those
   // free dimensions with, keyed by dimension denotation.
   std::vector<FreeDimensionOverride> free_dimension_overrides;
+
+  // when set, the ZipMap nodes producing a model output are removed at load time and the output returns their
+  // input scores as a float tensor instead of a sequence of maps, one row per map. The class labels shared by all the
+  // rows are available from InferenceSession::GetColumnarZipMapLabels. A ZipMap output also read by another node
+  // keeps its sequence of maps and has no labels.
+  bool columnar_zipmap = false;
 };
 }  // namespace onnxruntime
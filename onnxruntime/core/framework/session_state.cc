@@ -148,36 +148,15 @@ void SessionState::SetProfiler(profiling::Profiler& profiler) { profiler_ = &pro
 
 ::onnxruntime::profiling::Profiler& SessionState::Profiler() const { return *profiler_; }
 
-static int64_t CalculateMemoryPatternsKey(const std::vector<std::reference_wrapper<const TensorShape>>& shapes) {
-  int64_t key = 0;
-  for (auto shape : shapes) {
-    for (auto dim : shape.get().GetDims()) key ^= dim;
-  }
-  return key;
-}
-
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
+std::shared_ptr<const MemoryPatternGroup> SessionState::GetMemoryPatternGroup(
     const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
-
-  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) return nullptr;
-
-  return it->second.get();
+  return mem_pattern_cache_.Find(input_shapes);
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(
     const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes,
     std::unique_ptr<MemoryPatternGroup> mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(input_shapes);
-
-  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
-    mem_patterns_[key] = std::move(mem_patterns);
-  }
-
+  mem_pattern_cache_.Insert(input_shapes, std::move(mem_patterns));
   return Status::OK();
 }
 
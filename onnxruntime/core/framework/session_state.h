@@ -19,6 +19,7 @@
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
+#include "core/framework/mem_pattern_cache.h"
 #include "core/framework/ml_value.h"
 #include "core/framework/callback.h"
 #include "core/framework/ort_value_name_idx_map.h"
@@ -52,9 +53,12 @@ class SessionState {
   SessionState(const ExecutionProviders& execution_providers,
                bool enable_mem_pattern,
                concurrency::ThreadPool* thread_pool,
-               concurrency::ThreadPool* inter_op_thread_pool)
+               concurrency::ThreadPool* inter_op_thread_pool,
+               size_t mem_pattern_cache_capacity = 0,
+               int64_t mem_pattern_dim_bucket_size = 0)
       : execution_providers_(execution_providers),
         enable_mem_pattern_(enable_mem_pattern),
+        mem_pattern_cache_(mem_pattern_cache_capacity, mem_pattern_dim_bucket_size),
         thread_pool_(thread_pool),
         inter_op_thread_pool_(inter_op_thread_pool) {
   }
@@ -142,9 +146,10 @@ class SessionState {
   profiling::Profiler& Profiler() const;
 
   /**
-  Get cached memory pattern based on input shapes
+  Get cached memory pattern based on input shapes.
+  The pattern may be evicted from the cache while it's in use, the returned pointer keeps it alive.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternGroup> GetMemoryPatternGroup(
       const std::vector<std::reference_wrapper<const TensorShape>>& input_shapes) const;
 
   /**
@@ -159,6 +164,12 @@ class SessionState {
   */
   bool GetEnableMemoryPattern() const;
 
+  /**
+  Get the hit/miss counters of the memory pattern cache
+  */
+  MemoryPatternCacheStats GetMemoryPatternCacheStats() const { return mem_pattern_cache_.Stats(); }
+  const MemoryPatternCache& GetMemoryPatternCache() const { return mem_pattern_cache_; }
+
   struct NodeInfo {
     /**
      *
@@ -244,10 +255,8 @@ class SessionState {
 
   // switch for enable memory pattern optimization or not.
   const bool enable_mem_pattern_;
-  // lock for the mem_patterns_
-  mutable OrtMutex mem_patterns_lock_;
   // cache for the generated mem_patterns. key is calculated based on input shapes.
-  mutable std::map<int64_t, std::unique_ptr<MemoryPatternGroup>> mem_patterns_;
+  mutable MemoryPatternCache mem_pattern_cache_;
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -0,0 +1,205 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/thread_caching_arena.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+#include "core/common/make_unique.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// size class recorded in the header of the blocks which aren't cached
+constexpr int kUncached = -1;
+
+// bytes of a size class a thread keeps at most, with at most kMaxCachedBlocksPerClass blocks
+constexpr size_t kMaxCachedBytesPerClass = 128 * 1024;
+constexpr size_t kMaxCachedBlocksPerClass = 64;
+
+inline void SetHeader(void* block, int size_class) {
+  *static_cast<int*>(block) = size_class;
+}
+
+inline int GetHeader(const void* block) {
+  return *static_cast<const int*>(block);
+}
+
+}  // namespace
+
+constexpr size_t ThreadCachingArena::kHeaderSize;
+constexpr size_t ThreadCachingArena::kMinCachedBlockSize;
+constexpr size_t ThreadCachingArena::kMaxCachedBlockSize;
+constexpr int ThreadCachingArena::kNumSizeClasses;
+
+std::atomic<uint64_t> ThreadCachingArena::next_id_{1};
+
+ThreadCachingArena::ThreadCachingArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory)
+    : shared_(std::make_shared<Shared>()),
+      id_(next_id_++) {
+  shared_->arena = onnxruntime::make_unique<BFCArena>(std::move(resource_allocator), total_memory);
+}
+
+ThreadCachingArena::~ThreadCachingArena() {
+  // the threads still running keep their (now empty) caches until they exit
+  std::lock_guard<OrtMutex> lock(shared_->mutex);
+  for (auto* cache : shared_->caches) {
+    for (auto& blocks : cache->blocks) {
+      shared_->arena->FreeBatch(blocks.data(), blocks.size());
+      blocks.clear();
+    }
+  }
+  shared_->caches.clear();
+}
+
+void ThreadCachingArena::Shared::Release(ThreadCache* cache) {
+  std::lock_guard<OrtMutex> lock(mutex);
+  if (caches.erase(cache) == 0) {
+    return;
+  }
+  for (auto& blocks : cache->blocks) {
+    arena->FreeBatch(blocks.data(), blocks.size());
+    blocks.clear();
+  }
+}
+
+ThreadCachingArena::CacheHolder::~CacheHolder() {
+  if (cache == nullptr) {
+    return;
+  }
+  if (auto owner = shared.lock()) {
+    owner->Release(cache.get());
+  }
+}
+
+int ThreadCachingArena::SizeClass(size_t block_size) {
+  int size_class = 0;
+  for (size_t class_size = kMinCachedBlockSize; class_size < block_size; class_size <<= 1) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+size_t ThreadCachingArena::ClassBlockSize(int size_class) {
+  return kMinCachedBlockSize << size_class;
+}
+
+size_t ThreadCachingArena::MaxCachedBlocks(int size_class) {
+  return std::max<size_t>(2, std::min(kMaxCachedBlocksPerClass, kMaxCachedBytesPerClass / ClassBlockSize(size_class)));
+}
+
+ThreadCachingArena::ThreadCache& ThreadCachingArena::GetThreadCache() {
+  // caches of the calling thread by arena id, with the last one used in front of the map
+  static thread_local std::unordered_map<uint64_t, CacheHolder> caches;
+  static thread_local uint64_t last_id = 0;
+  static thread_local ThreadCache* last_cache = nullptr;
+
+  if (last_id == id_) {
+    return *last_cache;
+  }
+
+  auto it = caches.find(id_);
+  if (it == caches.end()) {
+    // forget the caches of the arenas destroyed since, their blocks were returned already
+    for (auto expired = caches.begin(); expired != caches.end();) {
+      if (expired->second.shared.expired()) {
+        expired = caches.erase(expired);
+      } else {
+        ++expired;
+      }
+    }
+
+    CacheHolder holder;
+    holder.shared = shared_;
+    holder.cache = onnxruntime::make_unique<ThreadCache>();
+    for (int size_class = 0; size_class < kNumSizeClasses; ++size_class) {
+      holder.cache->blocks[size_class].reserve(MaxCachedBlocks(size_class) + 1);
+    }
+    {
+      std::lock_guard<OrtMutex> lock(shared_->mutex);
+      shared_->caches.insert(holder.cache.get());
+    }
+    it = caches.emplace(id_, std::move(holder)).first;
+  }
+
+  last_id = id_;
+  last_cache = it->second.cache.get();
+  return *last_cache;
+}
+
+void* ThreadCachingArena::Alloc(size_t size) {
+  if (size == 0 || size > std::numeric_limits<size_t>::max() - kHeaderSize) {
+    return nullptr;
+  }
+
+  const size_t block_size = size + kHeaderSize;
+  if (block_size > kMaxCachedBlockSize) {
+    void* block = shared_->arena->Alloc(block_size);
+    if (block == nullptr) {
+      return nullptr;
+    }
+    SetHeader(block, kUncached);
+    return static_cast<char*>(block) + kHeaderSize;
+  }
+
+  const int size_class = SizeClass(block_size);
+  auto& blocks = GetThreadCache().blocks[size_class];
+  if (blocks.empty()) {
+    const size_t batch = MaxCachedBlocks(size_class) / 2;
+    blocks.resize(batch);
+    blocks.resize(shared_->arena->AllocBatch(ClassBlockSize(size_class), batch, blocks.data()));
+    if (blocks.empty()) {
+      return nullptr;
+    }
+  }
+
+  void* block = blocks.back();
+  blocks.pop_back();
+  SetHeader(block, size_class);
+  return static_cast<char*>(block) + kHeaderSize;
+}
+
+void ThreadCachingArena::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  void* block = static_cast<char*>(p) - kHeaderSize;
+  const int size_class = GetHeader(block);
+  if (size_class == kUncached) {
+    shared_->arena->Free(block);
+    return;
+  }
+
+  ORT_ENFORCE(size_class >= 0 && size_class < kNumSizeClasses, "Invalid block freed to the thread caching arena");
+  auto& blocks = GetThreadCache().blocks[size_class];
+  blocks.push_back(block);
+  const size_t max_blocks = MaxCachedBlocks(size_class);
+  if (blocks.size() > max_blocks) {
+    const size_t keep = max_blocks / 2;
+    shared_->arena->FreeBatch(blocks.data() + keep, blocks.size() - keep);
+    blocks.resize(keep);
+  }
+}
+
+void* ThreadCachingArena::Reserve(size_t size) {
+  if (size == 0 || size > std::numeric_limits<size_t>::max() - kHeaderSize) {
+    return nullptr;
+  }
+
+  void* block = shared_->arena->Reserve(size + kHeaderSize);
+  if (block == nullptr) {
+    return nullptr;
+  }
+  SetHeader(block, kUncached);
+  return static_cast<char*>(block) + kHeaderSize;
+}
+
+void ThreadCachingArena::GetStats(AllocatorStats* stats) {
+  shared_->arena->GetStats(stats);
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,113 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/arena.h"
+#include "core/framework/bfc_arena.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+/**
+ * Front-end of a BFCArena keeping a per-thread cache of small blocks, so the concurrent Runs of a session don't
+ * serialize on the lock of the arena for every small tensor.
+ *
+ * Allocations up to kMaxCachedBlockSize bytes (header included) are rounded up to a power of 2 size class. Each
+ * thread keeps a free list per size class: Alloc pops a block from it and Free pushes the block to the list of the
+ * calling thread, whichever thread allocated it. An empty list is refilled with a batch of blocks taken from the
+ * arena under one acquisition of its lock, a full one releases half of its blocks to the arena the same way.
+ * Larger allocations and Reserve go to the arena directly.
+ *
+ * Every block starts with a header recording its size class, so Free doesn't need to look the block up in the
+ * arena. The blocks cached by a thread are returned to the arena when the thread exits or the arena is destroyed.
+ */
+class ThreadCachingArena : public IArenaAllocator {
+ public:
+  ThreadCachingArena(std::unique_ptr<IDeviceAllocator> resource_allocator, size_t total_memory);
+
+  ~ThreadCachingArena() override;
+
+  void* Alloc(size_t size) override;
+
+  void Free(void* p) override;
+
+  void* Reserve(size_t size) override;
+
+  // the blocks cached by the threads are counted as used
+  size_t Used() const override {
+    return shared_->arena->Used();
+  }
+
+  size_t Max() const override {
+    return shared_->arena->Max();
+  }
+
+  const OrtMemoryInfo& Info() const override {
+    return shared_->arena->Info();
+  }
+
+  FencePtr CreateFence(const SessionState* session_state) override {
+    return shared_->arena->CreateFence(session_state);
+  }
+
+  void GetStats(AllocatorStats* stats);
+
+  // Bytes before every block returned by Alloc. The BFCArena chunks are 256 byte aligned, so the blocks returned are
+  // 64 byte aligned: the alignment of the default CPU allocator (MlasGetPreferredBufferAlignment), not the one of
+  // the arena.
+  static constexpr size_t kHeaderSize = 64;
+  static constexpr size_t kMinCachedBlockSize = 256;
+  static constexpr size_t kMaxCachedBlockSize = 64 * 1024;
+  static constexpr int kNumSizeClasses = 9;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadCachingArena);
+
+  struct ThreadCache {
+    std::array<std::vector<void*>, kNumSizeClasses> blocks;
+  };
+
+  // Owns the arena and tracks the caches holding its blocks. It's shared with the threads so a thread exiting while
+  // the ThreadCachingArena is being destroyed can still return its blocks.
+  struct Shared {
+    std::unique_ptr<BFCArena> arena;
+    OrtMutex mutex;
+    std::unordered_set<ThreadCache*> caches;
+
+    // returns the blocks of cache to the arena, unless the destruction of the ThreadCachingArena already did
+    void Release(ThreadCache* cache);
+  };
+
+  // The cache of a thread for one ThreadCachingArena, destroyed on thread exit.
+  struct CacheHolder {
+    std::weak_ptr<Shared> shared;
+    std::unique_ptr<ThreadCache> cache;
+
+    CacheHolder() = default;
+    CacheHolder(CacheHolder&&) = default;
+    ~CacheHolder();
+  };
+
+  ThreadCache& GetThreadCache();
+
+  // size class of a block of block_size bytes, header included
+  static int SizeClass(size_t block_size);
+  static size_t ClassBlockSize(int size_class);
+  // maximum number of blocks of a size class kept by a thread
+  static size_t MaxCachedBlocks(int size_class);
+
+  std::shared_ptr<Shared> shared_;
+  // identifies this arena in the caches of the threads, never reused
+  const uint64_t id_;
+  static std::atomic<uint64_t> next_id_;
+};
+
+}  // namespace onnxruntime
@@ -282,6 +282,9 @@ common::Status InitializeFeedFetchCopyInfo(const SessionState& session_state,
   if (cpu_only) {
     feeds_fetches_manager.SetDeviceCopyChecks(DeviceCopyCheck::NoCopy, DeviceCopyCheck::NoCopy);
   } else {
+    // the feeds and fetches may be on other devices than the ones of a previous execution with this manager
+    feeds_fetches_manager.ResetDeviceCopyChecks();
+
     // setup all the static info about where the graph inputs and outputs are located
     auto info = feeds_fetches_manager.GetFeedsFetchesInfo();
     auto& feed_copy_info = feeds_fetches_manager.GetMutableFeedsDeviceCopyInfo();
@@ -448,20 +448,62 @@ void RegisterNchwcSchemas() {
 }
 
 void RegisterBertSchemas() {
+  static const char* Attention_ver1_doc = R"DOC(
+Multi-Head Self Attention that can be either unidirectional (like GPT-2) or bidirectional (like BERT).
+The mask_index input is the number of valid positions of each batch: the positions after it are masked out.
+When the optional past input is given, the keys and values of the previous positions are taken from it instead of
+being computed again, and the present output holds them followed by the keys and values of the input, so the next
+call can take it as its past. In unidirectional mode, the input positions come after the past positions.)DOC";
+
   ONNX_CONTRIB_OPERATOR_SCHEMA(Attention)
       .SetDomain(kMSDomain)
       .SinceVersion(1)
       .SetSupportLevel(OpSchema::SupportType::EXPERIMENTAL)
-      .SetDoc("Multi-Head Self Attention")
+      .SetDoc(Attention_ver1_doc)
       .Attr("num_heads", "Number of attention heads", AttributeProto::INT)
+      .Attr("unidirectional",
+            "Whether every position attends only to itself and the positions before it. Default value is 0.",
+            AttributeProto::INT,
+            static_cast<int64_t>(0))
       .Input(0, "input", "3D input tensor with shape (batch_size, sequence_length, hidden_size), hidden_size = num_heads * head_size", "T")
       .Input(1, "weight", "2D input tensor with shape (hidden_size, 3 * hidden_size)", "T")
       .Input(2, "bias", "1D input tensor with shape (3 * hidden_size)", "T")
-      .Input(3, "mask_index", "Attention mask index with shape (batch_size)", "M")
+      .Input(3, "mask_index", "Attention mask index with shape (batch_size), the number of valid positions of past and input", "M")
+      .Input(4, "past", "past state for key and value with shape (2, batch_size, num_heads, past_sequence_length, head_size)", "T", OpSchema::Optional)
       .Output(0, "output", "3D output tensor with shape (batch_size, sequence_length, hidden_size)", "T")
+      .Output(1, "present", "present state for key and value with shape (2, batch_size, num_heads, past_sequence_length + sequence_length, head_size)", "T", OpSchema::Optional)
       .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float tensors.")
       .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask index to integer types")
-      .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput);
+      .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+        propagateElemTypeFromInputToOutput(ctx, 0, 0);
+        if (ctx.getNumOutputs() > 1) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 1);
+        }
+        if (!hasInputShape(ctx, 0))
+          return;
+
+        propagateShapeFromInputToOutput(ctx, 0, 0);
+
+        // present shape is past shape with sequence_length added to dimension 3
+        if (ctx.getNumOutputs() > 1 && hasInputShape(ctx, 4)) {
+          auto& input_shape = getInputShape(ctx, 0);
+          auto& past_shape = getInputShape(ctx, 4);
+          if (input_shape.dim_size() != 3 || past_shape.dim_size() != 5) {
+            fail_shape_inference("Inputs 0 and 4 shall be 3 and 5 dimensions");
+          }
+
+          ONNX_NAMESPACE::TensorShapeProto present_shape;
+          for (auto& dim : past_shape.dim()) {
+            *present_shape.add_dim() = dim;
+          }
+          if (input_shape.dim(1).has_dim_value() && past_shape.dim(3).has_dim_value()) {
+            present_shape.mutable_dim(3)->set_dim_value(input_shape.dim(1).dim_value() + past_shape.dim(3).dim_value());
+          } else {
+            present_shape.mutable_dim(3)->Clear();
+          }
+          updateOutputShape(ctx, 1, present_shape);
+        }
+      });
 
   static const char* EmbedLayerNormalization_ver1_doc = R"DOC(
 EmbedLayerNormalization is the fusion of embedding layer in BERT model, with optional mask processing.
@@ -128,6 +128,46 @@ MlasGemm(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Packed matrix B routines. A constant matrix B can be packed once with
+// MlasGemmPackB and passed to MlasGemm on every call.
+//
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K
+    );
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    );
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasGemm(
@@ -306,6 +346,82 @@ MlasComputeErf(
     size_t N
     );
 
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    );
+
+float
+MLASCALL
+MlasReduceMaximum(
+    const float* Input,
+    size_t N
+    );
+
+float
+MLASCALL
+MlasComputeSumExp(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    );
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Transpose routines.
+//
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t* B,
+    size_t ldb
+    );
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint32_t* A,
+    size_t lda,
+    uint32_t* B,
+    size_t ldb
+    );
+
+inline
+void
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const float* A,
+    size_t lda,
+    float* B,
+    size_t ldb
+    )
+{
+    MlasTranspose(M, N, reinterpret_cast<const uint32_t*>(A), lda,
+        reinterpret_cast<uint32_t*>(B), ldb);
+}
+
 //
 // Half-precision floating-point routines.
 //
@@ -424,3 +540,17 @@ MlasQuantizeLinear(
     float Scale,
     int8_t ZeroPoint
     );
+
+void
+MLASCALL
+MlasRequantizeOutput(
+    const int32_t* Input,
+    size_t InputLeadingDimension,
+    uint8_t* Output,
+    size_t OutputLeadingDimension,
+    const int32_t* Bias,
+    size_t M,
+    size_t N,
+    float Scale,
+    uint8_t ZeroPoint
+    );
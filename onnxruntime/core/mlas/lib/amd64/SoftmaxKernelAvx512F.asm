@@ -0,0 +1,380 @@
+;++
+;
+; Copyright (c) Microsoft Corporation. All rights reserved.
+;
+; Licensed under the MIT License.
+;
+; Module Name:
+;
+;   SoftmaxKernelAvx512F.asm
+;
+; Abstract:
+;
+;   This module implements the kernels for the exponential function, the sum
+;   of the exponentials and the reduction of the maximum value of the softmax
+;   operation.
+;
+;   This implementation uses AVX512F instructions.
+;
+;--
+
+        .xlist
+INCLUDE mlasi.inc
+        .list
+
+        EXTERN  MlasExpConstants:NEAR
+        EXTERN  MlasMinimumF32Value:NEAR
+
+;
+; Structure layout for the exponential constants block.
+;
+
+ExpConstants STRUCT
+
+        LowerRange DWORD ?
+        UpperRange DWORD ?
+        LowerRangeSumExp DWORD ?
+        RoundingBias DWORD ?
+        Log2Reciprocal DWORD ?
+        Log2High DWORD ?
+        Log2Low DWORD ?
+        poly_0 DWORD ?
+        poly_1 DWORD ?
+        poly_2 DWORD ?
+        poly_3 DWORD ?
+        poly_4 DWORD ?
+        poly_56 DWORD ?
+        MinimumExponent DWORD ?
+        MaximumExponent DWORD ?
+
+ExpConstants ENDS
+
+;++
+;
+; Routine Description:
+;
+;   This routine implements a vectorized kernel for the exponential function.
+;
+;   N.B. The kernel only uses the volatile registers zmm0-zmm5 and zmm16-zmm31.
+;
+; Arguments:
+;
+;   Input (rcx) - Supplies the input buffer.
+;
+;   Output (rdx) - Supplies the output buffer.
+;
+;   N (r8) - Supplies the number of elements to process.
+;
+; Return Value:
+;
+;   None.
+;
+;--
+
+        LEAF_ENTRY MlasExpKernelAvx512F, _TEXT
+
+        lea     rax,MlasExpConstants
+        vbroadcastss zmm16,ExpConstants.LowerRange[rax]
+        vbroadcastss zmm17,ExpConstants.UpperRange[rax]
+        vbroadcastss zmm18,ExpConstants.RoundingBias[rax]
+        vbroadcastss zmm19,ExpConstants.Log2Reciprocal[rax]
+        vbroadcastss zmm20,ExpConstants.Log2High[rax]
+        vbroadcastss zmm21,ExpConstants.Log2Low[rax]
+        vbroadcastss zmm22,ExpConstants.poly_0[rax]
+        vbroadcastss zmm23,ExpConstants.poly_1[rax]
+        vbroadcastss zmm24,ExpConstants.poly_2[rax]
+        vbroadcastss zmm25,ExpConstants.poly_3[rax]
+        vbroadcastss zmm26,ExpConstants.poly_4[rax]
+        vbroadcastss zmm27,ExpConstants.poly_56[rax]
+        vbroadcastss zmm28,ExpConstants.MinimumExponent[rax]
+        vbroadcastss zmm29,ExpConstants.MaximumExponent[rax]
+        mov     r9d,-1
+        kmovw   k1,r9d                          ; all elements of a full vector
+
+ExpComputeExpBy16Loop:
+        cmp     r8,16
+        jae     ExpProcessVector
+        test    r8,r8
+        jz      ExpExitKernel
+        mov     r10,rcx                         ; save input buffer
+        mov     ecx,r8d
+        mov     r9d,1
+        shl     r9d,cl
+        dec     r9d
+        kmovw   k1,r9d                          ; mask of the remaining elements
+        mov     rcx,r10
+        mov     r8d,16                          ; process the last vector
+
+ExpProcessVector:
+        vmovups zmm0{k1}{z},ZMMWORD PTR [rcx]
+        vminps  zmm0,zmm17,zmm0                 ; clamp upper bound
+        vmaxps  zmm0,zmm16,zmm0                 ; clamp lower bound
+        vmovaps zmm1,zmm18
+        vfmadd231ps zmm1,zmm0,zmm19             ; (x / ln2) plus rounding bias
+        vsubps  zmm2,zmm1,zmm18                 ; m = round(x / ln2)
+        vfmadd231ps zmm0,zmm2,zmm20             ; range reduce: x -= (m * ln2_high)
+        vfmadd231ps zmm0,zmm2,zmm21             ; range reduce: x -= (m * ln2_low)
+        vpslld  zmm1,zmm1,23                    ; shift m to exponent field
+        vpminsd zmm2,zmm1,zmm29                 ; clamp upper normal exponent to +127
+        vpmaxsd zmm2,zmm2,zmm28                 ; clamp lower normal exponent to -126
+        vpsubd  zmm1,zmm1,zmm2                  ; compute overflow exponent
+        vpaddd  zmm1,zmm1,zmm29                 ; add exponent bias to overflow scale
+        vpaddd  zmm2,zmm2,zmm29                 ; add exponent bias to normal scale
+        vmovaps zmm3,zmm22                      ; p = poly_0
+        vfmadd213ps zmm3,zmm0,zmm23             ; p = p * x + poly_1
+        vfmadd213ps zmm3,zmm0,zmm24             ; p = p * x + poly_2
+        vfmadd213ps zmm3,zmm0,zmm25             ; p = p * x + poly_3
+        vfmadd213ps zmm3,zmm0,zmm26             ; p = p * x + poly_4
+        vfmadd213ps zmm3,zmm0,zmm27             ; p = p * x + poly_5
+        vfmadd213ps zmm3,zmm0,zmm27             ; p = p * x + poly_6
+        vmulps  zmm3,zmm3,zmm1                  ; scale p with overflow exponent
+        vmulps  zmm3,zmm3,zmm2                  ; scale p with normal exponent
+        add     rcx,16*4                        ; advance input by 16 elements
+        vmovups ZMMWORD PTR [rdx]{k1},zmm3
+        add     rdx,16*4                        ; advance output by 16 elements
+        sub     r8,16
+        jmp     ExpComputeExpBy16Loop
+
+ExpExitKernel:
+        vzeroupper
+        ret
+
+        LEAF_END MlasExpKernelAvx512F, _TEXT
+
+;++
+;
+; Routine Description:
+;
+;   This routine implements a vectorized kernel for the sum of the exponential
+;   function of the elements of a buffer biased by the negative of their
+;   maximum value.
+;
+;   N.B. The kernel only uses the volatile registers zmm0-zmm5 and zmm16-zmm31.
+;
+; Arguments:
+;
+;   Input (rcx) - Supplies the input buffer.
+;
+;   Output (rdx) - Optionally supplies the output buffer. When used for Softmax,
+;       the output buffer is used to store the intermediate exp() results. When
+;       used for LogSoftmax, the intermediate exp() results are not required.
+;
+;   N (r8) - Supplies the number of elements to process.
+;
+;   NegativeMaximum (r9) - Supplies the address of the negative maximum value
+;       that is added to each element before computing the exponential.
+;
+; Return Value:
+;
+;   Returns the sum of the exponentials.
+;
+;--
+
+        LEAF_ENTRY MlasSumExpKernelAvx512F, _TEXT
+
+        lea     rax,MlasExpConstants
+        vbroadcastss zmm16,DWORD PTR [r9]       ; broadcast negative maximum value
+        vbroadcastss zmm17,ExpConstants.LowerRangeSumExp[rax]
+        vbroadcastss zmm18,ExpConstants.RoundingBias[rax]
+        vbroadcastss zmm19,ExpConstants.Log2Reciprocal[rax]
+        vbroadcastss zmm20,ExpConstants.Log2High[rax]
+        vbroadcastss zmm21,ExpConstants.Log2Low[rax]
+        vbroadcastss zmm22,ExpConstants.poly_0[rax]
+        vbroadcastss zmm23,ExpConstants.poly_1[rax]
+        vbroadcastss zmm24,ExpConstants.poly_2[rax]
+        vbroadcastss zmm25,ExpConstants.poly_3[rax]
+        vbroadcastss zmm26,ExpConstants.poly_4[rax]
+        vbroadcastss zmm27,ExpConstants.poly_56[rax]
+        vbroadcastss zmm28,ExpConstants.MaximumExponent[rax]
+        vpxord  zmm4,zmm4,zmm4                  ; clear exp() accumulators
+        vpxord  zmm5,zmm5,zmm5
+        mov     r9d,-1
+        kmovw   k1,r9d                          ; all elements of a full vector
+        cmp     r8,32
+        jb      SumExpComputeExpBy16Loop
+
+SumExpComputeExpBy32Loop:
+        vaddps  zmm0,zmm16,ZMMWORD PTR [rcx]    ; bias by negative maximum value
+        vaddps  zmm29,zmm16,ZMMWORD PTR [rcx+16*4]
+        vmaxps  zmm0,zmm17,zmm0                 ; clamp lower bound
+        vmaxps  zmm29,zmm17,zmm29
+        vmovaps zmm1,zmm18
+        vmovaps zmm30,zmm18
+        vfmadd231ps zmm1,zmm0,zmm19             ; (x / ln2) plus rounding bias
+        vfmadd231ps zmm30,zmm29,zmm19
+        vsubps  zmm2,zmm1,zmm18                 ; m = round(x / ln2)
+        vsubps  zmm31,zmm30,zmm18
+        vfmadd231ps zmm0,zmm2,zmm20             ; range reduce: x -= (m * ln2_high)
+        vfmadd231ps zmm29,zmm31,zmm20
+        vfmadd231ps zmm0,zmm2,zmm21             ; range reduce: x -= (m * ln2_low)
+        vfmadd231ps zmm29,zmm31,zmm21
+        vpslld  zmm1,zmm1,23                    ; shift m to exponent field
+        vpslld  zmm30,zmm30,23
+        vpaddd  zmm1,zmm1,zmm28                 ; add exponent bias to normal scale
+        vpaddd  zmm30,zmm30,zmm28
+        vmovaps zmm2,zmm22                      ; p = poly_0
+        vmovaps zmm31,zmm22
+        vfmadd213ps zmm2,zmm0,zmm23             ; p = p * x + poly_1
+        vfmadd213ps zmm31,zmm29,zmm23
+        vfmadd213ps zmm2,zmm0,zmm24             ; p = p * x + poly_2
+        vfmadd213ps zmm31,zmm29,zmm24
+        vfmadd213ps zmm2,zmm0,zmm25             ; p = p * x + poly_3
+        vfmadd213ps zmm31,zmm29,zmm25
+        vfmadd213ps zmm2,zmm0,zmm26             ; p = p * x + poly_4
+        vfmadd213ps zmm31,zmm29,zmm26
+        vfmadd213ps zmm2,zmm0,zmm27             ; p = p * x + poly_5
+        vfmadd213ps zmm31,zmm29,zmm27
+        vfmadd213ps zmm2,zmm0,zmm27             ; p = p * x + poly_6
+        vfmadd213ps zmm31,zmm29,zmm27
+        vmulps  zmm2,zmm2,zmm1                  ; scale p with normal exponent
+        vmulps  zmm31,zmm31,zmm30
+        vaddps  zmm4,zmm4,zmm2                  ; accumulate exp() results
+        vaddps  zmm5,zmm5,zmm31
+        add     rcx,32*4                        ; advance input by 32 elements
+        test    rdx,rdx
+        jz      SumExpSkipStoreResultsBy32
+        vmovups ZMMWORD PTR [rdx],zmm2
+        vmovups ZMMWORD PTR [rdx+16*4],zmm31
+        add     rdx,32*4                        ; advance output by 32 elements
+
+SumExpSkipStoreResultsBy32:
+        sub     r8,32
+        cmp     r8,32
+        jae     SumExpComputeExpBy32Loop
+
+SumExpComputeExpBy16Loop:
+        cmp     r8,16
+        jae     SumExpProcessVector
+        test    r8,r8
+        jz      SumExpReduceAccumulator
+        mov     r10,rcx                         ; save input buffer
+        mov     ecx,r8d
+        mov     r9d,1
+        shl     r9d,cl
+        dec     r9d
+        kmovw   k1,r9d                          ; mask of the remaining elements
+        mov     rcx,r10
+        mov     r8d,16                          ; process the last vector
+
+SumExpProcessVector:
+        vmovups zmm0{k1}{z},ZMMWORD PTR [rcx]
+        vaddps  zmm0,zmm16,zmm0                 ; bias by negative maximum value
+        vmaxps  zmm0,zmm17,zmm0                 ; clamp lower bound
+        vmovaps zmm1,zmm18
+        vfmadd231ps zmm1,zmm0,zmm19             ; (x / ln2) plus rounding bias
+        vsubps  zmm2,zmm1,zmm18                 ; m = round(x / ln2)
+        vfmadd231ps zmm0,zmm2,zmm20             ; range reduce: x -= (m * ln2_high)
+        vfmadd231ps zmm0,zmm2,zmm21             ; range reduce: x -= (m * ln2_low)
+        vpslld  zmm1,zmm1,23                    ; shift m to exponent field
+        vpaddd  zmm1,zmm1,zmm28                 ; add exponent bias to normal scale
+        vmovaps zmm2,zmm22                      ; p = poly_0
+        vfmadd213ps zmm2,zmm0,zmm23             ; p = p * x + poly_1
+        vfmadd213ps zmm2,zmm0,zmm24             ; p = p * x + poly_2
+        vfmadd213ps zmm2,zmm0,zmm25             ; p = p * x + poly_3
+        vfmadd213ps zmm2,zmm0,zmm26             ; p = p * x + poly_4
+        vfmadd213ps zmm2,zmm0,zmm27             ; p = p * x + poly_5
+        vfmadd213ps zmm2,zmm0,zmm27             ; p = p * x + poly_6
+        vmulps  zmm2,zmm2,zmm1                  ; scale p with normal exponent
+        vaddps  zmm4{k1},zmm4,zmm2              ; accumulate exp() results
+        add     rcx,16*4                        ; advance input by 16 elements
+        test    rdx,rdx
+        jz      SumExpSkipStoreResultsBy16
+        vmovups ZMMWORD PTR [rdx]{k1},zmm2
+        add     rdx,16*4                        ; advance output by 16 elements
+
+SumExpSkipStoreResultsBy16:
+        sub     r8,16
+        jmp     SumExpComputeExpBy16Loop
+
+SumExpReduceAccumulator:
+        vaddps  zmm0,zmm4,zmm5                  ; reduce to single scalar
+        vextractf64x4 ymm1,zmm0,1
+        vaddps  ymm0,ymm0,ymm1
+        vextractf128 xmm1,ymm0,1
+        vaddps  xmm0,xmm0,xmm1
+        vhaddps xmm0,xmm0,xmm0
+        vhaddps xmm0,xmm0,xmm0
+        vzeroupper
+        ret
+
+        LEAF_END MlasSumExpKernelAvx512F, _TEXT
+
+;++
+;
+; Routine Description:
+;
+;   This routine implements a vectorized kernel to find the maximum value of
+;   the supplied buffer.
+;
+; Arguments:
+;
+;   Input (rcx) - Supplies the input buffer.
+;
+;   N (rdx) - Supplies the number of elements to process.
+;
+; Return Value:
+;
+;   Returns the maximum value of the supplied buffer.
+;
+;--
+
+        LEAF_ENTRY MlasReduceMaximumKernelAvx512F, _TEXT
+
+        vbroadcastss zmm0,DWORD PTR [MlasMinimumF32Value]
+        test    rdx,rdx
+        jz      ReduceMaximumExitKernel
+        cmp     rdx,64
+        jb      ReduceMaximumProcessRemainingCountBy16
+        vmovaps zmm1,zmm0
+        vmovaps zmm2,zmm0
+        vmovaps zmm3,zmm0
+
+ReduceMaximumProcessRemainingCountBy64:
+        vmaxps  zmm0,zmm0,ZMMWORD PTR [rcx]
+        vmaxps  zmm1,zmm1,ZMMWORD PTR [rcx+16*4]
+        sub     rdx,64
+        vmaxps  zmm2,zmm2,ZMMWORD PTR [rcx+32*4]
+        vmaxps  zmm3,zmm3,ZMMWORD PTR [rcx+48*4]
+        add     rcx,64*4                        ; advance input by 64 elements
+        cmp     rdx,64
+        jae     ReduceMaximumProcessRemainingCountBy64
+        vmaxps  zmm0,zmm0,zmm1                  ; reduce to single vector
+        vmaxps  zmm2,zmm2,zmm3
+        vmaxps  zmm0,zmm0,zmm2
+
+ReduceMaximumProcessRemainingCountBy16:
+        cmp     rdx,16
+        jb      ReduceMaximumProcessRemainingCountLessThan16
+        vmaxps  zmm0,zmm0,ZMMWORD PTR [rcx]
+        sub     rdx,16
+        add     rcx,16*4                        ; advance input by 16 elements
+        jmp     ReduceMaximumProcessRemainingCountBy16
+
+ReduceMaximumProcessRemainingCountLessThan16:
+        test    rdx,rdx
+        jz      ReduceMaximumReduceVector
+        mov     r10,rcx                         ; save input buffer
+        mov     ecx,edx
+        mov     r9d,1
+        shl     r9d,cl
+        dec     r9d
+        kmovw   k1,r9d                          ; mask of the remaining elements
+        vmaxps  zmm0{k1},zmm0,ZMMWORD PTR [r10]
+
+ReduceMaximumReduceVector:
+        vextractf64x4 ymm1,zmm0,1               ; reduce to single scalar
+        vmaxps  ymm0,ymm0,ymm1
+        vextractf128 xmm1,ymm0,1
+        vmaxps  xmm0,xmm0,xmm1
+        vshufps xmm1,xmm0,xmm0,0EEh
+        vmaxps  xmm0,xmm0,xmm1
+        vshufps xmm1,xmm0,xmm0,055h
+        vmaxss  xmm0,xmm0,xmm1
+
+ReduceMaximumExitKernel:
+        vzeroupper
+        ret
+
+        LEAF_END MlasReduceMaximumKernelAvx512F, _TEXT
+
+        END
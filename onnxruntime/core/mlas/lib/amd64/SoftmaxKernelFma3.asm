@@ -0,0 +1,364 @@
+;++
+;
+; Copyright (c) Microsoft Corporation. All rights reserved.
+;
+; Licensed under the MIT License.
+;
+; Module Name:
+;
+;   SoftmaxKernelFma3.asm
+;
+; Abstract:
+;
+;   This module implements the kernels for the exponential function and the
+;   sum of the exponentials of the softmax operation.
+;
+;   This implementation uses AVX fused multiply/add instructions.
+;
+;--
+
+        .xlist
+INCLUDE mlasi.inc
+        .list
+
+        EXTERN  MlasMaskMoveAvx:NEAR
+        EXTERN  MlasExpConstants:NEAR
+
+;
+; Structure layout for the exponential constants block.
+;
+
+ExpConstants STRUCT
+
+        LowerRange DWORD ?
+        UpperRange DWORD ?
+        LowerRangeSumExp DWORD ?
+        RoundingBias DWORD ?
+        Log2Reciprocal DWORD ?
+        Log2High DWORD ?
+        Log2Low DWORD ?
+        poly_0 DWORD ?
+        poly_1 DWORD ?
+        poly_2 DWORD ?
+        poly_3 DWORD ?
+        poly_4 DWORD ?
+        poly_56 DWORD ?
+        MinimumExponent DWORD ?
+        MaximumExponent DWORD ?
+
+ExpConstants ENDS
+
+;
+; Stack frame layout for the softmax kernels.
+;
+
+SoftmaxKernelFrame STRUCT
+
+        SavedXmm6 OWORD ?
+        SavedXmm7 OWORD ?
+        SavedXmm8 OWORD ?
+        SavedXmm9 OWORD ?
+        SavedXmm10 OWORD ?
+        SavedXmm11 OWORD ?
+        SavedXmm12 OWORD ?
+        SavedXmm13 OWORD ?
+        SavedXmm14 OWORD ?
+        SavedXmm15 OWORD ?
+        Padding0 QWORD ?
+        Padding1 QWORD ?
+        CountN QWORD ?
+        ReturnAddress QWORD ?
+        PreviousP1Home QWORD ?
+        PreviousP2Home QWORD ?
+        PreviousP3Home QWORD ?
+        PreviousP4Home QWORD ?
+
+SoftmaxKernelFrame ENDS
+
+;++
+;
+; Routine Description:
+;
+;   This routine implements a vectorized kernel for the exponential function.
+;
+; Arguments:
+;
+;   Input (rcx) - Supplies the input buffer.
+;
+;   Output (rdx) - Supplies the output buffer.
+;
+;   N (r8) - Supplies the number of elements to process.
+;
+; Return Value:
+;
+;   None.
+;
+;--
+
+        NESTED_ENTRY MlasExpKernelFma3, _TEXT
+
+        alloc_stack (SoftmaxKernelFrame.ReturnAddress)
+
+        save_xmm128_avx xmm6,SoftmaxKernelFrame.SavedXmm6
+        save_xmm128_avx xmm7,SoftmaxKernelFrame.SavedXmm7
+        save_xmm128_avx xmm8,SoftmaxKernelFrame.SavedXmm8
+        save_xmm128_avx xmm9,SoftmaxKernelFrame.SavedXmm9
+        save_xmm128_avx xmm10,SoftmaxKernelFrame.SavedXmm10
+        save_xmm128_avx xmm11,SoftmaxKernelFrame.SavedXmm11
+        save_xmm128_avx xmm12,SoftmaxKernelFrame.SavedXmm12
+        save_xmm128_avx xmm13,SoftmaxKernelFrame.SavedXmm13
+        save_xmm128_avx xmm14,SoftmaxKernelFrame.SavedXmm14
+        save_xmm128_avx xmm15,SoftmaxKernelFrame.SavedXmm15
+
+        END_PROLOGUE
+
+        lea     rax,MlasExpConstants
+        vbroadcastss ymm4,ExpConstants.RoundingBias[rax]
+        vbroadcastss ymm5,ExpConstants.Log2Reciprocal[rax]
+        vbroadcastss ymm6,ExpConstants.Log2High[rax]
+        vbroadcastss ymm7,ExpConstants.Log2Low[rax]
+        vbroadcastss ymm8,ExpConstants.poly_0[rax]
+        vbroadcastss ymm9,ExpConstants.poly_1[rax]
+        vbroadcastss ymm10,ExpConstants.poly_2[rax]
+        vbroadcastss ymm11,ExpConstants.poly_3[rax]
+        vbroadcastss ymm12,ExpConstants.poly_4[rax]
+        vbroadcastss ymm13,ExpConstants.poly_56[rax]
+        vbroadcastss ymm14,ExpConstants.MinimumExponent[rax]
+        vbroadcastss ymm15,ExpConstants.MaximumExponent[rax]
+
+        sub     r8,8
+        jb      ExpProcessRemainingCount
+
+ExpComputeExpBy8Loop:
+        vbroadcastss ymm0,ExpConstants.UpperRange[rax]
+        vbroadcastss ymm1,ExpConstants.LowerRange[rax]
+        vminps  ymm0,ymm0,YMMWORD PTR [rcx]     ; clamp upper bound
+        vmaxps  ymm0,ymm1,ymm0                  ; clamp lower bound
+        vmovaps ymm1,ymm4
+        vfmadd231ps ymm1,ymm0,ymm5              ; (x / ln2) plus rounding bias
+        vsubps  ymm2,ymm1,ymm4                  ; m = round(x / ln2)
+        vfmadd231ps ymm0,ymm2,ymm6              ; range reduce: x -= (m * ln2_high)
+        vfmadd231ps ymm0,ymm2,ymm7              ; range reduce: x -= (m * ln2_low)
+        vpslld  ymm1,ymm1,23                    ; shift m to exponent field
+        vpminsd ymm2,ymm1,ymm15                 ; clamp upper normal exponent to +127
+        vpmaxsd ymm2,ymm2,ymm14                 ; clamp lower normal exponent to -126
+        vpsubd  ymm1,ymm1,ymm2                  ; compute overflow exponent
+        vpaddd  ymm1,ymm1,ymm15                 ; add exponent bias to overflow scale
+        vpaddd  ymm2,ymm2,ymm15                 ; add exponent bias to normal scale
+        vmovaps ymm3,ymm8                       ; p = poly_0
+        vfmadd213ps ymm3,ymm0,ymm9              ; p = p * x + poly_1
+        vfmadd213ps ymm3,ymm0,ymm10             ; p = p * x + poly_2
+        vfmadd213ps ymm3,ymm0,ymm11             ; p = p * x + poly_3
+        vfmadd213ps ymm3,ymm0,ymm12             ; p = p * x + poly_4
+        vfmadd213ps ymm3,ymm0,ymm13             ; p = p * x + poly_5
+        vfmadd213ps ymm3,ymm0,ymm13             ; p = p * x + poly_6
+        vmulps  ymm3,ymm3,ymm1                  ; scale p with overflow exponent
+        vmulps  ymm3,ymm3,ymm2                  ; scale p with normal exponent
+        add     rcx,8*4                         ; advance input by 8 elements
+        vmovups YMMWORD PTR [rdx],ymm3
+        add     rdx,8*4                         ; advance output by 8 elements
+        sub     r8,8
+        jae     ExpComputeExpBy8Loop
+
+ExpProcessRemainingCount:
+        add     r8,8                            ; correct for over-subtract above
+        jz      ExpExitKernel
+        mov     DWORD PTR SoftmaxKernelFrame.CountN[rsp],r8d
+        vbroadcastss ymm3,DWORD PTR SoftmaxKernelFrame.CountN[rsp]
+        vpcmpgtd ymm3,ymm3,YMMWORD PTR [MlasMaskMoveAvx]
+        vbroadcastss ymm0,ExpConstants.UpperRange[rax]
+        vbroadcastss ymm1,ExpConstants.LowerRange[rax]
+        vmaskmovps ymm2,ymm3,YMMWORD PTR [rcx]
+        vminps  ymm0,ymm0,ymm2                  ; clamp upper bound
+        vmaxps  ymm0,ymm1,ymm0                  ; clamp lower bound
+        vmovaps ymm1,ymm4
+        vfmadd231ps ymm1,ymm0,ymm5              ; (x / ln2) plus rounding bias
+        vsubps  ymm2,ymm1,ymm4                  ; m = round(x / ln2)
+        vfmadd231ps ymm0,ymm2,ymm6              ; range reduce: x -= (m * ln2_high)
+        vfmadd231ps ymm0,ymm2,ymm7              ; range reduce: x -= (m * ln2_low)
+        vpslld  ymm1,ymm1,23                    ; shift m to exponent field
+        vpminsd ymm2,ymm1,ymm15                 ; clamp upper normal exponent to +127
+        vpmaxsd ymm2,ymm2,ymm14                 ; clamp lower normal exponent to -126
+        vpsubd  ymm1,ymm1,ymm2                  ; compute overflow exponent
+        vpaddd  ymm1,ymm1,ymm15                 ; add exponent bias to overflow scale
+        vpaddd  ymm2,ymm2,ymm15                 ; add exponent bias to normal scale
+        vmovaps ymm4,ymm8                       ; p = poly_0
+        vfmadd213ps ymm4,ymm0,ymm9              ; p = p * x + poly_1
+        vfmadd213ps ymm4,ymm0,ymm10             ; p = p * x + poly_2
+        vfmadd213ps ymm4,ymm0,ymm11             ; p = p * x + poly_3
+        vfmadd213ps ymm4,ymm0,ymm12             ; p = p * x + poly_4
+        vfmadd213ps ymm4,ymm0,ymm13             ; p = p * x + poly_5
+        vfmadd213ps ymm4,ymm0,ymm13             ; p = p * x + poly_6
+        vmulps  ymm4,ymm4,ymm1                  ; scale p with overflow exponent
+        vmulps  ymm4,ymm4,ymm2                  ; scale p with normal exponent
+        vmaskmovps YMMWORD PTR [rdx],ymm3,ymm4
+
+ExpExitKernel:
+        vzeroupper
+        vmovaps xmm6,SoftmaxKernelFrame.SavedXmm6[rsp]
+        vmovaps xmm7,SoftmaxKernelFrame.SavedXmm7[rsp]
+        vmovaps xmm8,SoftmaxKernelFrame.SavedXmm8[rsp]
+        vmovaps xmm9,SoftmaxKernelFrame.SavedXmm9[rsp]
+        vmovaps xmm10,SoftmaxKernelFrame.SavedXmm10[rsp]
+        vmovaps xmm11,SoftmaxKernelFrame.SavedXmm11[rsp]
+        vmovaps xmm12,SoftmaxKernelFrame.SavedXmm12[rsp]
+        vmovaps xmm13,SoftmaxKernelFrame.SavedXmm13[rsp]
+        vmovaps xmm14,SoftmaxKernelFrame.SavedXmm14[rsp]
+        vmovaps xmm15,SoftmaxKernelFrame.SavedXmm15[rsp]
+        add     rsp,(SoftmaxKernelFrame.ReturnAddress)
+
+        BEGIN_EPILOGUE
+
+        ret
+
+        NESTED_END MlasExpKernelFma3, _TEXT
+
+;++
+;
+; Routine Description:
+;
+;   This routine implements a vectorized kernel for the sum of the exponential
+;   function of the elements of a buffer biased by the negative of their
+;   maximum value.
+;
+; Arguments:
+;
+;   Input (rcx) - Supplies the input buffer.
+;
+;   Output (rdx) - Optionally supplies the output buffer. When used for Softmax,
+;       the output buffer is used to store the intermediate exp() results. When
+;       used for LogSoftmax, the intermediate exp() results are not required.
+;
+;   N (r8) - Supplies the number of elements to process.
+;
+;   NegativeMaximum (r9) - Supplies the address of the negative maximum value
+;       that is added to each element before computing the exponential.
+;
+; Return Value:
+;
+;   Returns the sum of the exponentials.
+;
+;--
+
+        NESTED_ENTRY MlasSumExpKernelFma3, _TEXT
+
+        alloc_stack (SoftmaxKernelFrame.ReturnAddress)
+
+        save_xmm128_avx xmm6,SoftmaxKernelFrame.SavedXmm6
+        save_xmm128_avx xmm7,SoftmaxKernelFrame.SavedXmm7
+        save_xmm128_avx xmm8,SoftmaxKernelFrame.SavedXmm8
+        save_xmm128_avx xmm9,SoftmaxKernelFrame.SavedXmm9
+        save_xmm128_avx xmm10,SoftmaxKernelFrame.SavedXmm10
+        save_xmm128_avx xmm11,SoftmaxKernelFrame.SavedXmm11
+        save_xmm128_avx xmm12,SoftmaxKernelFrame.SavedXmm12
+        save_xmm128_avx xmm13,SoftmaxKernelFrame.SavedXmm13
+        save_xmm128_avx xmm14,SoftmaxKernelFrame.SavedXmm14
+        save_xmm128_avx xmm15,SoftmaxKernelFrame.SavedXmm15
+
+        END_PROLOGUE
+
+        lea     rax,MlasExpConstants
+        vbroadcastss ymm4,DWORD PTR [r9]        ; broadcast negative maximum value
+        vbroadcastss ymm5,ExpConstants.RoundingBias[rax]
+        vbroadcastss ymm6,ExpConstants.Log2Reciprocal[rax]
+        vbroadcastss ymm7,ExpConstants.Log2High[rax]
+        vbroadcastss ymm8,ExpConstants.Log2Low[rax]
+        vbroadcastss ymm9,ExpConstants.poly_0[rax]
+        vbroadcastss ymm10,ExpConstants.poly_1[rax]
+        vbroadcastss ymm11,ExpConstants.poly_2[rax]
+        vbroadcastss ymm12,ExpConstants.poly_3[rax]
+        vbroadcastss ymm13,ExpConstants.poly_4[rax]
+        vbroadcastss ymm14,ExpConstants.poly_56[rax]
+        vbroadcastss ymm15,ExpConstants.MaximumExponent[rax]
+        vxorps  xmm3,xmm3,xmm3                  ; clear exp() accumulator
+
+        sub     r8,8
+        jb      SumExpProcessRemainingCount
+
+SumExpComputeExpBy8Loop:
+        vbroadcastss ymm1,ExpConstants.LowerRangeSumExp[rax]
+        vaddps  ymm0,ymm4,YMMWORD PTR [rcx]     ; bias by negative maximum value
+        vmaxps  ymm0,ymm1,ymm0                  ; clamp lower bound
+        vmovaps ymm1,ymm5
+        vfmadd231ps ymm1,ymm0,ymm6              ; (x / ln2) plus rounding bias
+        vsubps  ymm2,ymm1,ymm5                  ; m = round(x / ln2)
+        vfmadd231ps ymm0,ymm2,ymm7              ; range reduce: x -= (m * ln2_high)
+        vfmadd231ps ymm0,ymm2,ymm8              ; range reduce: x -= (m * ln2_low)
+        vpslld  ymm1,ymm1,23                    ; shift m to exponent field
+        vpaddd  ymm1,ymm1,ymm15                 ; add exponent bias to normal scale
+        vmovaps ymm2,ymm9                       ; p = poly_0
+        vfmadd213ps ymm2,ymm0,ymm10             ; p = p * x + poly_1
+        vfmadd213ps ymm2,ymm0,ymm11             ; p = p * x + poly_2
+        vfmadd213ps ymm2,ymm0,ymm12             ; p = p * x + poly_3
+        vfmadd213ps ymm2,ymm0,ymm13             ; p = p * x + poly_4
+        vfmadd213ps ymm2,ymm0,ymm14             ; p = p * x + poly_5
+        vfmadd213ps ymm2,ymm0,ymm14             ; p = p * x + poly_6
+        vmulps  ymm2,ymm2,ymm1                  ; scale p with normal exponent
+        vaddps  ymm3,ymm3,ymm2                  ; accumulate exp() results
+        add     rcx,8*4                         ; advance input by 8 elements
+        test    rdx,rdx
+        jz      SumExpSkipStoreResultsBy8
+        vmovups YMMWORD PTR [rdx],ymm2
+        add     rdx,8*4                         ; advance output by 8 elements
+
+SumExpSkipStoreResultsBy8:
+        sub     r8,8
+        jae     SumExpComputeExpBy8Loop
+
+SumExpProcessRemainingCount:
+        add     r8,8                            ; correct for over-subtract above
+        jz      SumExpReduceAccumulator
+        mov     DWORD PTR SoftmaxKernelFrame.CountN[rsp],r8d
+        vbroadcastss ymm1,DWORD PTR SoftmaxKernelFrame.CountN[rsp]
+        vpcmpgtd ymm1,ymm1,YMMWORD PTR [MlasMaskMoveAvx]
+        vmaskmovps ymm0,ymm1,YMMWORD PTR [rcx]
+        vaddps  ymm0,ymm4,ymm0                  ; bias by negative maximum value
+        vmovaps ymm4,ymm1                       ; save remaining count mask
+        vbroadcastss ymm1,ExpConstants.LowerRangeSumExp[rax]
+        vmaxps  ymm0,ymm1,ymm0                  ; clamp lower bound
+        vmovaps ymm1,ymm5
+        vfmadd231ps ymm1,ymm0,ymm6              ; (x / ln2) plus rounding bias
+        vsubps  ymm2,ymm1,ymm5                  ; m = round(x / ln2)
+        vfmadd231ps ymm0,ymm2,ymm7              ; range reduce: x -= (m * ln2_high)
+        vfmadd231ps ymm0,ymm2,ymm8              ; range reduce: x -= (m * ln2_low)
+        vpslld  ymm1,ymm1,23                    ; shift m to exponent field
+        vpaddd  ymm1,ymm1,ymm15                 ; add exponent bias to normal scale
+        vmovaps ymm2,ymm9                       ; p = poly_0
+        vfmadd213ps ymm2,ymm0,ymm10             ; p = p * x + poly_1
+        vfmadd213ps ymm2,ymm0,ymm11             ; p = p * x + poly_2
+        vfmadd213ps ymm2,ymm0,ymm12             ; p = p * x + poly_3
+        vfmadd213ps ymm2,ymm0,ymm13             ; p = p * x + poly_4
+        vfmadd213ps ymm2,ymm0,ymm14             ; p = p * x + poly_5
+        vfmadd213ps ymm2,ymm0,ymm14             ; p = p * x + poly_6
+        vmulps  ymm2,ymm2,ymm1                  ; scale p with normal exponent
+        vandps  ymm2,ymm4,ymm2                  ; mask exp() results
+        vaddps  ymm3,ymm3,ymm2                  ; accumulate exp() results
+        test    rdx,rdx
+        jz      SumExpReduceAccumulator
+        vmaskmovps YMMWORD PTR [rdx],ymm4,ymm2
+
+SumExpReduceAccumulator:
+        vextractf128 xmm1,ymm3,1                ; reduce to single scalar
+        vaddps  xmm0,xmm3,xmm1
+        vhaddps xmm0,xmm0,xmm0
+        vhaddps xmm0,xmm0,xmm0
+        vzeroupper
+        vmovaps xmm6,SoftmaxKernelFrame.SavedXmm6[rsp]
+        vmovaps xmm7,SoftmaxKernelFrame.SavedXmm7[rsp]
+        vmovaps xmm8,SoftmaxKernelFrame.SavedXmm8[rsp]
+        vmovaps xmm9,SoftmaxKernelFrame.SavedXmm9[rsp]
+        vmovaps xmm10,SoftmaxKernelFrame.SavedXmm10[rsp]
+        vmovaps xmm11,SoftmaxKernelFrame.SavedXmm11[rsp]
+        vmovaps xmm12,SoftmaxKernelFrame.SavedXmm12[rsp]
+        vmovaps xmm13,SoftmaxKernelFrame.SavedXmm13[rsp]
+        vmovaps xmm14,SoftmaxKernelFrame.SavedXmm14[rsp]
+        vmovaps xmm15,SoftmaxKernelFrame.SavedXmm15[rsp]
+        add     rsp,(SoftmaxKernelFrame.ReturnAddress)
+
+        BEGIN_EPILOGUE
+
+        ret
+
+        NESTED_END MlasSumExpKernelFma3, _TEXT
+
+        END
@@ -0,0 +1,803 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    compute.cpp
+
+Abstract:
+
+    This module implements routines to compute the exponential function and
+    the softmax and log softmax of the rows of a matrix.
+
+    The exponential is computed by reducing the input to the range
+    [-ln(2)/2, ln(2)/2] with x = m * ln(2) + r, approximating exp(r) with a
+    polynomial and scaling the result by 2^m, which is built directly in the
+    exponent field of a float. The implementation below targets the base
+    instruction set (typically SSE2) while assembly implementations target
+    newer instruction sets (such as FMA3 and AVX512F).
+
+--*/
+
+#include "mlasi.h"
+
+#include <cmath>
+
+//
+// Bundles the floating point constants for use by kernels written in assembly.
+//
+
+MLAS_INTERNAL_DATA const struct {
+    float LowerRange;
+    float UpperRange;
+    float LowerRangeSumExp;
+    float RoundingBias;
+    float Log2Reciprocal;
+    float Log2High;
+    float Log2Low;
+    float poly_0;
+    float poly_1;
+    float poly_2;
+    float poly_3;
+    float poly_4;
+    float poly_56;
+    int32_t MinimumExponent;
+    int32_t MaximumExponent;
+} MlasExpConstants = {
+    -103.9720840454f,
+    88.7762626647950f,
+    -88.3762626647949f,
+    12582912.0f,
+    1.44269504088896341f,
+    -6.93145752e-1f,
+    -1.42860677e-6f,
+    1.37805939e-3f,
+    8.37312452e-3f,
+    4.16695364e-2f,
+    1.66664720e-1f,
+    4.99999851e-1f,
+    1.0f,
+    int32_t(0xC1000000),
+    int32_t(0x3F800000),
+};
+
+MLAS_INTERNAL_DATA const float MlasMinimumF32Value = std::numeric_limits<float>::lowest();
+
+//
+// Structure to pass the parameters of a softmax to the worker threads.
+//
+
+struct MLAS_SOFTMAX_WORK_BLOCK {
+    int32_t ThreadCountN;
+    bool LogSoftmax;
+    const float* Input;
+    float* Output;
+    size_t N;
+    size_t D;
+};
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeExpVector(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function of a vector, including the
+    inputs with a denormal result.
+
+Arguments:
+
+    Vector - Supplies the input vector.
+
+Return Value:
+
+    Returns the exponential of the input vector.
+
+--*/
+{
+    Vector = MlasMinimumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.UpperRange), Vector);
+    Vector = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.LowerRange), Vector);
+
+    //
+    // Reduce the input to the range [-ln(2)/2, ln(2)/2]. The rounding bias
+    // leaves the integer m in the low bits of the biased value.
+    //
+
+    const MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+    const MLAS_FLOAT32X4 Biased = MlasMultiplyAddFloat32x4(Vector,
+        MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), RoundingBias);
+    const MLAS_FLOAT32X4 m = MlasSubtractFloat32x4(Biased, RoundingBias);
+
+    Vector = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2High), Vector);
+    Vector = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2Low), Vector);
+
+    //
+    // Split 2^m into two normal floats so that the results below 2^-126 are
+    // built as the product of both.
+    //
+
+    const MLAS_INT32X4 MaximumExponent = MlasBroadcastInt32x4(MlasExpConstants.MaximumExponent);
+
+    MLAS_INT32X4 Overflow = MlasShiftLeftInt32x4<23>(MlasReinterpretAsInt32x4(Biased));
+    MLAS_INT32X4 Normal = MlasMinimumInt32x4(Overflow, MaximumExponent);
+    Normal = MlasMaximumInt32x4(Normal, MlasBroadcastInt32x4(MlasExpConstants.MinimumExponent));
+    Overflow = MlasSubtractInt32x4(Overflow, Normal);
+    Overflow = MlasAddInt32x4(Overflow, MaximumExponent);
+    Normal = MlasAddInt32x4(Normal, MaximumExponent);
+
+    MLAS_FLOAT32X4 p = MlasBroadcastFloat32x4(MlasExpConstants.poly_0);
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_1));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_2));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_3));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_4));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+
+    p = MlasMultiplyFloat32x4(p, MlasReinterpretAsFloat32x4(Overflow));
+    p = MlasMultiplyFloat32x4(p, MlasReinterpretAsFloat32x4(Normal));
+
+    return p;
+}
+
+MLAS_FORCEINLINE
+MLAS_FLOAT32X4
+MlasComputeSumExpVector(
+    MLAS_FLOAT32X4 Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function of a vector of values that
+    are not positive, as the inputs of a softmax after subtracting the maximum
+    value. The results below 2^-126 are not needed by a sum and are flushed
+    to zero.
+
+Arguments:
+
+    Vector - Supplies the input vector.
+
+Return Value:
+
+    Returns the exponential of the input vector.
+
+--*/
+{
+    Vector = MlasMaximumFloat32x4(MlasBroadcastFloat32x4(MlasExpConstants.LowerRangeSumExp), Vector);
+
+    const MLAS_FLOAT32X4 RoundingBias = MlasBroadcastFloat32x4(MlasExpConstants.RoundingBias);
+    const MLAS_FLOAT32X4 Biased = MlasMultiplyAddFloat32x4(Vector,
+        MlasBroadcastFloat32x4(MlasExpConstants.Log2Reciprocal), RoundingBias);
+    const MLAS_FLOAT32X4 m = MlasSubtractFloat32x4(Biased, RoundingBias);
+
+    Vector = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2High), Vector);
+    Vector = MlasMultiplyAddFloat32x4(m, MlasBroadcastFloat32x4(MlasExpConstants.Log2Low), Vector);
+
+    MLAS_INT32X4 Normal = MlasShiftLeftInt32x4<23>(MlasReinterpretAsInt32x4(Biased));
+    Normal = MlasAddInt32x4(Normal, MlasBroadcastInt32x4(MlasExpConstants.MaximumExponent));
+
+    MLAS_FLOAT32X4 p = MlasBroadcastFloat32x4(MlasExpConstants.poly_0);
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_1));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_2));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_3));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_4));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+    p = MlasMultiplyAddFloat32x4(p, Vector, MlasBroadcastFloat32x4(MlasExpConstants.poly_56));
+
+    p = MlasMultiplyFloat32x4(p, MlasReinterpretAsFloat32x4(Normal));
+
+    return p;
+}
+
+void
+MLASCALL
+MlasExpKernel(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasComputeExpVector(MlasLoadFloat32x4(Input)));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        MlasStoreLaneFloat32x4<0>(Output, MlasComputeExpVector(MlasBroadcastFloat32x4(Input)));
+
+        Input += 1;
+        Output += 1;
+        N -= 1;
+    }
+}
+
+float
+MLASCALL
+MlasSumExpKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the sum of the exponential
+    function of the elements of a buffer biased by the negative of their
+    maximum value.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the buffer to receive the exponentials.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the negative of the maximum value of the input
+        buffer.
+
+Return Value:
+
+    Returns the sum of the exponentials.
+
+--*/
+{
+    const MLAS_FLOAT32X4 Bias = MlasBroadcastFloat32x4(NegativeMaximum);
+
+    MLAS_FLOAT32X4 Accumulator = MlasZeroFloat32x4();
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasComputeSumExpVector(MlasAddFloat32x4(MlasLoadFloat32x4(Input), Bias));
+
+        if (Output != nullptr) {
+            MlasStoreFloat32x4(Output, Vector);
+            Output += 4;
+        }
+
+        Accumulator = MlasAddFloat32x4(Accumulator, Vector);
+
+        Input += 4;
+        N -= 4;
+    }
+
+    float Sum = MlasReduceAddFloat32x4(Accumulator);
+
+    while (N > 0) {
+
+        MLAS_FLOAT32X4 Vector = MlasComputeSumExpVector(MlasAddFloat32x4(MlasBroadcastFloat32x4(Input), Bias));
+
+        if (Output != nullptr) {
+            MlasStoreLaneFloat32x4<0>(Output, Vector);
+            Output += 1;
+        }
+
+        Sum += MlasExtractLaneFloat32x4<0>(Vector);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Sum;
+}
+
+float
+MLASCALL
+MlasReduceMaximumKernel(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the maximum value of a
+    buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum value of the buffer.
+
+--*/
+{
+    float Maximum = MlasMinimumF32Value;
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 MaximumVector0 = MlasBroadcastFloat32x4(Maximum);
+
+        if (N >= 16) {
+
+            MLAS_FLOAT32X4 MaximumVector1 = MaximumVector0;
+            MLAS_FLOAT32X4 MaximumVector2 = MaximumVector0;
+            MLAS_FLOAT32X4 MaximumVector3 = MaximumVector0;
+
+            while (N >= 16) {
+
+                MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MlasLoadFloat32x4(Input));
+                MaximumVector1 = MlasMaximumFloat32x4(MaximumVector1, MlasLoadFloat32x4(Input + 4));
+                MaximumVector2 = MlasMaximumFloat32x4(MaximumVector2, MlasLoadFloat32x4(Input + 8));
+                MaximumVector3 = MlasMaximumFloat32x4(MaximumVector3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                N -= 16;
+            }
+
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MaximumVector1);
+            MaximumVector2 = MlasMaximumFloat32x4(MaximumVector2, MaximumVector3);
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MaximumVector2);
+        }
+
+        while (N >= 4) {
+
+            MaximumVector0 = MlasMaximumFloat32x4(MaximumVector0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Maximum = MlasReduceMaximumFloat32x4(MaximumVector0);
+    }
+
+    while (N > 0) {
+
+        Maximum = (std::max)(Maximum, *Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Maximum;
+}
+
+void
+MLASCALL
+MlasSoftmaxOutputKernel(
+    float* Output,
+    size_t N,
+    const float* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the scaling of the
+    exponentials of a row to the output of a softmax.
+
+Arguments:
+
+    Output - Supplies the exponentials of the row, scaled in place.
+
+    N - Supplies the number of elements to process.
+
+    Parameters - Supplies the reciprocal of the sum of the exponentials.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float Scale = Parameters[0];
+    const MLAS_FLOAT32X4 ScaleVector = MlasBroadcastFloat32x4(Scale);
+
+    while (N >= 16) {
+
+        MLAS_FLOAT32X4 Vector0 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output));
+        MLAS_FLOAT32X4 Vector1 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 4));
+        MLAS_FLOAT32X4 Vector2 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 8));
+        MLAS_FLOAT32X4 Vector3 = MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output + 12));
+
+        MlasStoreFloat32x4(Output, Vector0);
+        MlasStoreFloat32x4(Output + 4, Vector1);
+        MlasStoreFloat32x4(Output + 8, Vector2);
+        MlasStoreFloat32x4(Output + 12, Vector3);
+
+        Output += 16;
+        N -= 16;
+    }
+
+    while (N >= 4) {
+
+        MlasStoreFloat32x4(Output, MlasMultiplyFloat32x4(ScaleVector, MlasLoadFloat32x4(Output)));
+
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output *= Scale;
+
+        Output += 1;
+        N -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasLogSoftmaxOutputKernel(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* Parameters
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the generic kernel for the output of a log
+    softmax.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+    Parameters - Supplies the negative of the maximum value of the row and the
+        logarithm of the sum of the exponentials.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const float NegativeMaximum = Parameters[0];
+    const float Logarithm = Parameters[1];
+    const MLAS_FLOAT32X4 NegativeMaximumVector = MlasBroadcastFloat32x4(NegativeMaximum);
+    const MLAS_FLOAT32X4 LogarithmVector = MlasBroadcastFloat32x4(Logarithm);
+
+    while (N >= 4) {
+
+        MLAS_FLOAT32X4 Vector = MlasAddFloat32x4(MlasLoadFloat32x4(Input), NegativeMaximumVector);
+        MlasStoreFloat32x4(Output, MlasSubtractFloat32x4(Vector, LogarithmVector));
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    while (N > 0) {
+
+        *Output = *Input + NegativeMaximum - Logarithm;
+
+        Input += 1;
+        Output += 1;
+        N -= 1;
+    }
+}
+
+void
+MlasComputeSoftmaxThreaded(
+    void* Context,
+    int32_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    softmax or log softmax operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_SOFTMAX_WORK_BLOCK*)Context;
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    //
+    // Compute the softmax or log softmax function.
+    //
+
+    const size_t D = WorkBlock->D;
+    const bool LogSoftmax = WorkBlock->LogSoftmax;
+
+    const float* Input = WorkBlock->Input + n * D;
+    float* Output = WorkBlock->Output + n * D;
+
+    while (CountN > 0) {
+
+#if defined(MLAS_TARGET_AMD64)
+        const float Maximum = MlasPlatform.ReduceMaximumKernelRoutine(Input, D);
+#else
+        const float Maximum = MlasReduceMaximumKernel(Input, D);
+#endif
+        const float NegativeMaximum = -Maximum;
+
+        if (LogSoftmax) {
+
+            //
+            // Compute the sum of the exponential functions for the row.
+            //
+
+#if defined(MLAS_TARGET_AMD64)
+            const float Accumulation = MlasPlatform.SumExpKernelRoutine(Input, nullptr, D, &NegativeMaximum);
+#else
+            const float Accumulation = MlasSumExpKernel(Input, nullptr, D, &NegativeMaximum);
+#endif
+
+            //
+            // Compute the log softmax output.
+            //
+
+            const float Parameters[] = { NegativeMaximum, std::log(Accumulation) };
+
+#if defined(MLAS_TARGET_AMD64)
+            MlasPlatform.LogSoftmaxOutputKernelRoutine(Input, Output, D, Parameters);
+#else
+            MlasLogSoftmaxOutputKernel(Input, Output, D, Parameters);
+#endif
+
+        } else {
+
+            //
+            // Compute the exponential function for each element of the row
+            // and the sum of these exponential functions.
+            //
+
+#if defined(MLAS_TARGET_AMD64)
+            const float Accumulation = MlasPlatform.SumExpKernelRoutine(Input, Output, D, &NegativeMaximum);
+#else
+            const float Accumulation = MlasSumExpKernel(Input, Output, D, &NegativeMaximum);
+#endif
+
+            //
+            // Normalize the softmax output.
+            //
+
+            const float Parameters[] = { 1.0f / Accumulation };
+
+#if defined(MLAS_TARGET_AMD64)
+            MlasPlatform.SoftmaxOutputKernelRoutine(Output, D, Parameters);
+#else
+            MlasSoftmaxOutputKernel(Output, D, Parameters);
+#endif
+        }
+
+        Input += D;
+        Output += D;
+        CountN--;
+    }
+}
+
+void
+MLASCALL
+MlasComputeExp(
+    const float* Input,
+    float* Output,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    MlasPlatform.ExpKernelRoutine(Input, Output, N);
+#else
+    MlasExpKernel(Input, Output, N);
+#endif
+}
+
+float
+MLASCALL
+MlasReduceMaximum(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the maximum value of a buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the maximum value of the buffer, or the lowest finite float if
+    the buffer is empty.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    return MlasPlatform.ReduceMaximumKernelRoutine(Input, N);
+#else
+    return MlasReduceMaximumKernel(Input, N);
+#endif
+}
+
+float
+MLASCALL
+MlasComputeSumExp(
+    const float* Input,
+    float* Output,
+    size_t N,
+    float NegativeMaximum
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the exponential function of the elements of a
+    buffer biased by the negative of their maximum value, and the sum of these
+    exponentials.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Optionally supplies the buffer to receive the exponentials. The
+        buffer may be the input buffer.
+
+    N - Supplies the number of elements to process.
+
+    NegativeMaximum - Supplies the negative of a value greater than or equal
+        to the maximum value of the input buffer.
+
+Return Value:
+
+    Returns the sum of the exponentials.
+
+--*/
+{
+#if defined(MLAS_TARGET_AMD64)
+    return MlasPlatform.SumExpKernelRoutine(Input, Output, N, &NegativeMaximum);
+#else
+    return MlasSumExpKernel(Input, Output, N, &NegativeMaximum);
+#endif
+}
+
+void
+MLASCALL
+MlasComputeSoftmax(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    bool LogSoftmax,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the softmax or log softmax function.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of columns per row to process.
+
+    LogSoftmax - Supplies true if this is a log softmax operation, else false
+        if this is a softmax operation.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_SOFTMAX_WORK_BLOCK WorkBlock;
+
+    //
+    // Capture the softmax parameters to the work block.
+    //
+
+    WorkBlock.LogSoftmax = LogSoftmax;
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+
+    //
+    // Compute the number of target threads given the complexity of the softmax
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    int32_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = int32_t(N);
+    }
+
+    const double Complexity = double(N) * double(D);
+
+    if (Complexity < double(ThreadCountN) * MLAS_SOFTMAX_THREAD_COMPLEXITY) {
+        ThreadCountN = int32_t(Complexity / MLAS_SOFTMAX_THREAD_COMPLEXITY) + 1;
+    }
+
+    WorkBlock.ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasComputeSoftmaxThreaded, &WorkBlock, ThreadCountN, ThreadPool);
+}
@@ -120,6 +120,14 @@ Abstract:
 #define MLAS_DGEMM_STRIDEN                          64
 #define MLAS_DGEMM_STRIDEK                          128
 
+//
+// Define the strides to step through slices of a packed matrix B. The K stride
+// is part of the packed buffer layout, the N stride must be a multiple of 16.
+//
+
+#define MLAS_SGEMM_PACKED_STRIDEN                   128
+#define MLAS_SGEMM_PACKED_STRIDEK                   256
+
 //
 // Define the alignment for segmenting a GEMM operation across multiple
 // threads.
@@ -451,6 +459,47 @@ void
 
 typedef MLAS_ELEMENTWISE_KERNEL_ROUTINE* PMLAS_ELEMENTWISE_KERNEL_ROUTINE;
 
+typedef
+float
+(MLASCALL MLAS_SUMEXP_KERNEL_ROUTINE)(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* NegativeMaximum
+    );
+
+typedef MLAS_SUMEXP_KERNEL_ROUTINE* PMLAS_SUMEXP_KERNEL_ROUTINE;
+
+typedef
+float
+(MLASCALL MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE)(
+    const float* Input,
+    size_t N
+    );
+
+typedef MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE* PMLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE;
+
+typedef
+void
+(MLASCALL MLAS_SOFTMAX_OUTPUT_KERNEL_ROUTINE)(
+    float* Output,
+    size_t N,
+    const float* Parameters
+    );
+
+typedef MLAS_SOFTMAX_OUTPUT_KERNEL_ROUTINE* PMLAS_SOFTMAX_OUTPUT_KERNEL_ROUTINE;
+
+typedef
+void
+(MLASCALL MLAS_LOGSOFTMAX_OUTPUT_KERNEL_ROUTINE)(
+    const float* Input,
+    float* Output,
+    size_t N,
+    const float* Parameters
+    );
+
+typedef MLAS_LOGSOFTMAX_OUTPUT_KERNEL_ROUTINE* PMLAS_LOGSOFTMAX_OUTPUT_KERNEL_ROUTINE;
+
 extern "C" {
 
 #if defined(MLAS_TARGET_AMD64_IX86)
@@ -544,10 +593,23 @@ extern "C" {
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasLogisticKernel;
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasTanhKernel;
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasErfKernel;
+    MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasExpKernel;
+    MLAS_SUMEXP_KERNEL_ROUTINE MlasSumExpKernel;
+    MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE MlasReduceMaximumKernel;
+    MLAS_SOFTMAX_OUTPUT_KERNEL_ROUTINE MlasSoftmaxOutputKernel;
+    MLAS_LOGSOFTMAX_OUTPUT_KERNEL_ROUTINE MlasLogSoftmaxOutputKernel;
 #if defined(MLAS_TARGET_AMD64)
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasLogisticKernelFma3;
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasTanhKernelFma3;
     MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasErfKernelFma3;
+    MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasExpKernelFma3;
+    MLAS_ELEMENTWISE_KERNEL_ROUTINE MlasExpKernelAvx512F;
+    MLAS_SUMEXP_KERNEL_ROUTINE MlasSumExpKernelFma3;
+    MLAS_SUMEXP_KERNEL_ROUTINE MlasSumExpKernelAvx512F;
+    MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE MlasReduceMaximumKernelAvx;
+    MLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE MlasReduceMaximumKernelAvx512F;
+    MLAS_SOFTMAX_OUTPUT_KERNEL_ROUTINE MlasSoftmaxOutputKernelAvx;
+    MLAS_LOGSOFTMAX_OUTPUT_KERNEL_ROUTINE MlasLogSoftmaxOutputKernelAvx;
 #endif
 
 }
@@ -578,6 +640,13 @@ extern "C" {
 #define MLAS_DGEMM_THREAD_COMPLEXITY                (64 * 1024)
 #define MLAS_QGEMM_THREAD_COMPLEXITY                (64 * 1024)
 
+//
+// Define the target number of per-thread elements of a softmax before using
+// another thread to process additional rows.
+//
+
+#define MLAS_SOFTMAX_THREAD_COMPLEXITY              (16 * 1024)
+
 //
 // Single-threaded single precision matrix/matrix multiply operation.
 //
@@ -631,6 +700,11 @@ struct MLAS_PLATFORM {
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE LogisticKernelRoutine;
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE TanhKernelRoutine;
     PMLAS_ELEMENTWISE_KERNEL_ROUTINE ErfKernelRoutine;
+    PMLAS_ELEMENTWISE_KERNEL_ROUTINE ExpKernelRoutine;
+    PMLAS_SUMEXP_KERNEL_ROUTINE SumExpKernelRoutine;
+    PMLAS_REDUCE_MAXIMUM_KERNEL_ROUTINE ReduceMaximumKernelRoutine;
+    PMLAS_SOFTMAX_OUTPUT_KERNEL_ROUTINE SoftmaxOutputKernelRoutine;
+    PMLAS_LOGSOFTMAX_OUTPUT_KERNEL_ROUTINE LogSoftmaxOutputKernelRoutine;
     uint32_t NchwcBlockSize;
     uint32_t PreferredBufferAlignment;
 #endif
@@ -1039,6 +1113,128 @@ MlasBroadcastInt32x4(int32_t Value)
 #endif
 }
 
+inline
+MLAS_INT32X4
+MlasReinterpretAsInt32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_s32_f32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castps_si128(Vector);
+#endif
+}
+
+inline
+MLAS_FLOAT32X4
+MlasReinterpretAsFloat32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vreinterpretq_f32_s32(Vector);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_castsi128_ps(Vector);
+#endif
+}
+
+template<unsigned ShiftCount>
+inline
+MLAS_INT32X4
+MlasShiftLeftInt32x4(MLAS_INT32X4 Vector)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vshlq_n_s32(Vector, ShiftCount);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_slli_epi32(Vector, ShiftCount);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasAddInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vaddq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_add_epi32(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasSubtractInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vsubq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    return _mm_sub_epi32(Vector1, Vector2);
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasMaximumInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vmaxq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE41_INTRINSICS)
+    return _mm_max_epi32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i Mask = _mm_cmpgt_epi32(Vector1, Vector2);
+    return _mm_or_si128(_mm_and_si128(Mask, Vector1), _mm_andnot_si128(Mask, Vector2));
+#endif
+}
+
+inline
+MLAS_INT32X4
+MlasMinimumInt32x4(MLAS_INT32X4 Vector1, MLAS_INT32X4 Vector2)
+{
+#if defined(MLAS_NEON_INTRINSICS)
+    return vminq_s32(Vector1, Vector2);
+#elif defined(MLAS_SSE41_INTRINSICS)
+    return _mm_min_epi32(Vector1, Vector2);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    __m128i Mask = _mm_cmpgt_epi32(Vector2, Vector1);
+    return _mm_or_si128(_mm_and_si128(Mask, Vector1), _mm_andnot_si128(Mask, Vector2));
+#endif
+}
+
+inline
+float
+MlasReduceAddFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    Vector = vpaddq_f32(Vector, Vector);
+    Vector = vpaddq_f32(Vector, Vector);
+    return vgetq_lane_f32(Vector, 0);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    float32x2_t VectorLow = vpadd_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    VectorLow = vpadd_f32(VectorLow, VectorLow);
+    return vget_lane_f32(VectorLow, 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_add_ps(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(1, 0, 3, 2)));
+    Vector = _mm_add_ps(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
+inline
+float
+MlasReduceMaximumFloat32x4(MLAS_FLOAT32X4 Vector)
+{
+#if defined(MLAS_NEON64_INTRINSICS)
+    Vector = vpmaxq_f32(Vector, Vector);
+    Vector = vpmaxq_f32(Vector, Vector);
+    return vgetq_lane_f32(Vector, 0);
+#elif defined(MLAS_NEON32_INTRINSICS)
+    float32x2_t VectorLow = vpmax_f32(vget_low_f32(Vector), vget_high_f32(Vector));
+    VectorLow = vpmax_f32(VectorLow, VectorLow);
+    return vget_lane_f32(VectorLow, 0);
+#elif defined(MLAS_SSE2_INTRINSICS)
+    Vector = _mm_max_ps(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(1, 0, 3, 2)));
+    Vector = _mm_max_ps(Vector, _mm_shuffle_ps(Vector, Vector, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(Vector);
+#endif
+}
+
 //
 // Cross-platform wrappers for 64-bit vector intrinsics.
 //
@@ -118,6 +118,11 @@ Return Value:
     this->LogisticKernelRoutine = MlasLogisticKernel;
     this->TanhKernelRoutine = MlasTanhKernel;
     this->ErfKernelRoutine = MlasErfKernel;
+    this->ExpKernelRoutine = MlasExpKernel;
+    this->SumExpKernelRoutine = MlasSumExpKernel;
+    this->ReduceMaximumKernelRoutine = MlasReduceMaximumKernel;
+    this->SoftmaxOutputKernelRoutine = MlasSoftmaxOutputKernel;
+    this->LogSoftmaxOutputKernelRoutine = MlasLogSoftmaxOutputKernel;
     this->NchwcBlockSize = 8;
     this->PreferredBufferAlignment = MLAS_DEFAULT_PREFERRED_BUFFER_ALIGNMENT;
 
@@ -159,6 +164,9 @@ Return Value:
             this->PoolFloatKernel[MlasMaximumPooling] = MlasPoolMaximumFloatKernelAvx;
             this->PoolFloatKernel[MlasAveragePoolingExcludePad] = MlasPoolAverageExcludePadFloatKernelAvx;
             this->PoolFloatKernel[MlasAveragePoolingIncludePad] = MlasPoolAverageIncludePadFloatKernelAvx;
+            this->ReduceMaximumKernelRoutine = MlasReduceMaximumKernelAvx;
+            this->SoftmaxOutputKernelRoutine = MlasSoftmaxOutputKernelAvx;
+            this->LogSoftmaxOutputKernelRoutine = MlasLogSoftmaxOutputKernelAvx;
 
             //
             // Check if the processor supports AVX2/FMA3 features.
@@ -190,6 +198,8 @@ Return Value:
                 this->LogisticKernelRoutine = MlasLogisticKernelFma3;
                 this->TanhKernelRoutine = MlasTanhKernelFma3;
                 this->ErfKernelRoutine = MlasErfKernelFma3;
+                this->ExpKernelRoutine = MlasExpKernelFma3;
+                this->SumExpKernelRoutine = MlasSumExpKernelFma3;
 
 #if !defined(MLAS_AVX512F_UNSUPPORTED)
 
@@ -209,6 +219,9 @@ Return Value:
                     this->PoolFloatKernel[MlasMaximumPooling] = MlasPoolMaximumFloatKernelAvx512F;
                     this->PoolFloatKernel[MlasAveragePoolingExcludePad] = MlasPoolAverageExcludePadFloatKernelAvx512F;
                     this->PoolFloatKernel[MlasAveragePoolingIncludePad] = MlasPoolAverageIncludePadFloatKernelAvx512F;
+                    this->ExpKernelRoutine = MlasExpKernelAvx512F;
+                    this->SumExpKernelRoutine = MlasSumExpKernelAvx512F;
+                    this->ReduceMaximumKernelRoutine = MlasReduceMaximumKernelAvx512F;
                     this->NchwcBlockSize = 16;
                     this->PreferredBufferAlignment = 64;
                     //
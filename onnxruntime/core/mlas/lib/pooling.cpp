@@ -1241,6 +1241,7 @@ Return Value:
 
     size_t InputSize = 1;
     size_t OutputSize = 1;
+    size_t KernelSize = 1;
 
     bool InputAndKernelShapeMatch = true;
     bool AllStridesAreOne = true;
@@ -1274,6 +1275,7 @@ Return Value:
 
         InputSize *= WorkBlock.InputShape[dim];
         OutputSize *= WorkBlock.OutputShape[dim];
+        KernelSize *= size_t(WorkBlock.KernelShape[dim]);
 
         InputAndKernelShapeMatch &= (WorkBlock.KernelShape[dim] == int64_t(WorkBlock.InputShape[dim]));
         AllStridesAreOne &= (WorkBlock.StrideShape[dim] == 1);
@@ -1323,13 +1325,23 @@ Return Value:
     MLAS_UNREFERENCED_PARAMETER(ThreadPool);
 #else
     //
-    // Use an external thread pool if one is provided.
-    // TODO: change to use MlasExecuteThreaded
+    // Use an external thread pool if one is provided. The channels are
+    // independent, each one reads its input plane once and visits the kernel
+    // window for every output element, so the cost model groups small planes
+    // into blocks and runs tiny pools inline.
+    //
+
+    if (ThreadPool != nullptr) {
+
+        const onnxruntime::concurrency::TensorOpCost ChannelCost = {
+            double(InputSize * sizeof(float)),
+            double(OutputSize * sizeof(float)),
+            double(OutputSize * KernelSize)
+        };
 
-    // TODO: revisit the strategy of multi-threading logic
-    if (0 && !(ThreadPool == nullptr)) {
-        std::function<void(int32_t)> WorkObject = [&](int64_t c) { PoolKernelRoutine(&WorkBlock, 1, Input + c * InputSize, Output + c * OutputSize); };
-        ThreadPool->ParallelFor((int32_t)TotalChannelCount, WorkObject);
+        ThreadPool->ParallelFor(std::ptrdiff_t(TotalChannelCount), ChannelCost, [&](std::ptrdiff_t First, std::ptrdiff_t Last) {
+            PoolKernelRoutine(&WorkBlock, size_t(Last - First), Input + First * InputSize, Output + First * OutputSize);
+        });
         return;
     }
 #endif
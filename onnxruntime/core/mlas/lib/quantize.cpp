@@ -16,6 +16,10 @@ Abstract:
 
         Output = Saturate(RoundToEven(Input / Scale) + ZeroPoint)
 
+    The int32 output of a quantized GEMM is requantized with:
+
+        Output = Saturate(RoundToEven((Input + Bias) * Scale) + ZeroPoint)
+
 --*/
 
 #include "mlasi.h"
@@ -183,6 +187,59 @@ MlasQuantizeLinearKernel(
     }
 }
 
+MLAS_FORCEINLINE
+void
+MlasRequantizeOutputKernel(
+    const int32_t* Input,
+    uint8_t* Output,
+    size_t N,
+    int32_t Bias,
+    float Scale,
+    int32_t ZeroPoint
+    )
+{
+    auto BiasVector = MlasBroadcastInt32x4(Bias);
+    auto ScaleVector = MlasBroadcastFloat32x4(Scale);
+    auto MinimumValueVector = MlasBroadcastFloat32x4(float(0 - ZeroPoint));
+    auto MaximumValueVector = MlasBroadcastFloat32x4(float(255 - ZeroPoint));
+    auto ZeroPointVector = MlasBroadcastInt32x4(ZeroPoint);
+
+    while (N >= 4) {
+
+#if defined(MLAS_NEON64_INTRINSICS)
+        auto IntegerVector = vaddq_s32(vld1q_s32(Input), BiasVector);
+        auto FloatVector = vcvtq_f32_s32(IntegerVector);
+        FloatVector = MlasMultiplyFloat32x4(FloatVector, ScaleVector);
+        FloatVector = vmaxnmq_f32(FloatVector, MinimumValueVector);
+        FloatVector = vminnmq_f32(FloatVector, MaximumValueVector);
+        IntegerVector = vaddq_s32(vcvtnq_s32_f32(FloatVector), ZeroPointVector);
+        IntegerVector = MlasQuantizeLinearPackBytes<uint8_t>(IntegerVector);
+        vst1q_lane_s32((int32_t*)Output, IntegerVector, 0);
+#else
+        auto IntegerVector = _mm_add_epi32(_mm_loadu_si128((const __m128i*)Input), BiasVector);
+        auto FloatVector = _mm_cvtepi32_ps(IntegerVector);
+        FloatVector = MlasMultiplyFloat32x4(FloatVector, ScaleVector);
+        FloatVector = _mm_max_ps(FloatVector, MinimumValueVector);
+        FloatVector = _mm_min_ps(FloatVector, MaximumValueVector);
+        IntegerVector = _mm_add_epi32(_mm_cvtps_epi32(FloatVector), ZeroPointVector);
+        IntegerVector = MlasQuantizeLinearPackBytes<uint8_t>(IntegerVector);
+        *((int32_t*)Output) = _mm_cvtsi128_si32(IntegerVector);
+#endif
+
+        Input += 4;
+        Output += 4;
+        N -= 4;
+    }
+
+    for (size_t n = 0; n < N; n++) {
+
+        float FloatValue = float(Input[n] + Bias) * Scale;
+        FloatValue = std::max(FloatValue, float(0 - ZeroPoint));
+        FloatValue = std::min(FloatValue, float(255 - ZeroPoint));
+        Output[n] = (uint8_t)((int32_t)std::nearbyintf(FloatValue) + ZeroPoint);
+    }
+}
+
 #else
 
 //
@@ -209,6 +266,26 @@ MlasQuantizeLinearKernel(
     }
 }
 
+MLAS_FORCEINLINE
+void
+MlasRequantizeOutputKernel(
+    const int32_t* Input,
+    uint8_t* Output,
+    size_t N,
+    int32_t Bias,
+    float Scale,
+    int32_t ZeroPoint
+    )
+{
+    for (size_t n = 0; n < N; n++) {
+
+        float FloatValue = std::nearbyintf(float(Input[n] + Bias) * Scale) + float(ZeroPoint);
+        FloatValue = std::max(FloatValue, 0.0f);
+        FloatValue = std::min(FloatValue, 255.0f);
+        Output[n] = (uint8_t)(int32_t)FloatValue;
+    }
+}
+
 #endif
 
 void
@@ -284,3 +361,60 @@ Return Value:
 {
     return MlasQuantizeLinearKernel<int8_t, -127, 127>(Input, Output, N, Scale, ZeroPoint);
 }
+
+void
+MLASCALL
+MlasRequantizeOutput(
+    const int32_t* Input,
+    size_t InputLeadingDimension,
+    uint8_t* Output,
+    size_t OutputLeadingDimension,
+    const int32_t* Bias,
+    size_t M,
+    size_t N,
+    float Scale,
+    uint8_t ZeroPoint
+    )
+/*++
+
+Routine Description:
+
+    This routine requantizes the int32 output of a quantized GEMM to uint8.
+
+Arguments:
+
+    Input - Supplies the int32 input matrix.
+
+    InputLeadingDimension - Supplies the first dimension of the input matrix.
+
+    Output - Supplies the uint8 output matrix.
+
+    OutputLeadingDimension - Supplies the first dimension of the output matrix.
+
+    Bias - Supplies an optional vector of M values added to each row of the
+        input matrix before it is scaled.
+
+    M - Supplies the number of rows to process.
+
+    N - Supplies the number of columns to process.
+
+    Scale - Supplies the requantization scale, the product of the input
+        scales divided by the output scale.
+
+    ZeroPoint - Supplies the output zero point value.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t m = 0; m < M; m++) {
+
+        MlasRequantizeOutputKernel(Input, Output, N, (Bias != nullptr) ? Bias[m] : 0,
+            Scale, ZeroPoint);
+
+        Input += InputLeadingDimension;
+        Output += OutputLeadingDimension;
+    }
+}
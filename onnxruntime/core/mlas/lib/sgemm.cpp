@@ -40,9 +40,11 @@ struct MLAS_SGEMM_WORK_BLOCK {
     size_t ldc;
     float alpha;
     float beta;
+    bool BIsPacked;
     struct SEGMENT {
         size_t M;
         size_t N;
+        size_t StartN;
         const float* A;
         const float* B;
         float* C;
@@ -762,6 +764,146 @@ Return Value:
     }
 }
 
+void
+MlasSgemmMultiplyPanelB(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t CountN,
+    size_t CountK,
+    float alpha,
+    bool ZeroMode,
+    const float* A,
+    size_t lda,
+    const float* PanelB,
+    float* C,
+    size_t ldc,
+    float* PanelA
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a slice of matrix A with a packed panel of matrix
+    B and accumulates the result into a slice of matrix C.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    CountN - Supplies the number of columns of the packed panel and matrix C.
+
+    CountK - Supplies the number of columns of matrix A and the number of rows
+        of the packed panel.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+    A - Supplies the address of the slice of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PanelB - Supplies the address of the packed panel of matrix B.
+
+    C - Supplies the address of the slice of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    PanelA - Supplies the address of a local buffer of MLAS_SGEMM_TRANSA_ROWS
+        by CountK elements used to transpose matrix A.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    float* c = C;
+
+    size_t RowsRemaining = M;
+    size_t RowsHandled;
+
+    if (TransA == CblasNoTrans) {
+
+        const float* a = A;
+
+        //
+        // Step through the rows of matrix A.
+        //
+
+        do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+            RowsHandled = MlasPlatform.GemmFloatKernel(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha, ZeroMode);
+#else
+            if (ZeroMode) {
+                RowsHandled = MlasSgemmKernelZero(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+            } else {
+                RowsHandled = MlasSgemmKernelAdd(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
+            }
+#endif
+
+            c += ldc * RowsHandled;
+            a += lda * RowsHandled;
+
+            RowsRemaining -= RowsHandled;
+
+        } while (RowsRemaining > 0);
+
+    } else {
+
+        const float* a = A;
+
+        do {
+
+            //
+            // Transpose elements from matrix A into a local buffer.
+            //
+
+            size_t RowsTransposed = RowsRemaining;
+
+            if (RowsTransposed > MLAS_SGEMM_TRANSA_ROWS) {
+                RowsTransposed = MLAS_SGEMM_TRANSA_ROWS;
+            }
+
+            RowsRemaining -= RowsTransposed;
+
+            MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
+
+            a += RowsTransposed;
+
+            //
+            // Step through the rows of the local buffer.
+            //
+
+            const float* pa = PanelA;
+
+            do {
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+                RowsHandled = MlasPlatform.GemmFloatKernel(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+#else
+                if (ZeroMode) {
+                    RowsHandled = MlasSgemmKernelZero(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+                } else {
+                    RowsHandled = MlasSgemmKernelAdd(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
+                }
+#endif
+
+                c += ldc * RowsHandled;
+                pa += CountK * RowsHandled;
+
+                RowsTransposed -= RowsHandled;
+
+            } while (RowsTransposed > 0);
+
+        } while (RowsRemaining > 0);
+    }
+}
+
 void
 MlasSgemmOperation(
     CBLAS_TRANSPOSE TransA,
@@ -927,87 +1069,123 @@ Return Value:
             // Step through each slice of matrix A along the M dimension.
             //
 
-            float* c = C + n;
+            const float* a = (TransA == CblasNoTrans) ? A + k : A + k * lda;
 
-            size_t RowsRemaining = M;
-            size_t RowsHandled;
+            MlasSgemmMultiplyPanelB(TransA, M, CountN, CountK, alpha, ZeroMode,
+                a, lda, PanelB, C + n, ldc, PanelA);
+        }
+    }
+}
 
-            if (TransA == CblasNoTrans) {
+void
+MlasSgemmPackedOperation(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t RangeStartN,
+    size_t RangeCountN,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const float* PackedB,
+    size_t AlignedN,
+    float beta,
+    float* C,
+    size_t ldc
+    )
+/*++
 
-                const float* a = A + k;
+Routine Description:
 
-                //
-                // Step through the rows of matrix A.
-                //
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with matrix B already packed by MlasGemmPackB.
 
-                do {
+Arguments:
 
-#if defined(MLAS_TARGET_AMD64_IX86)
-                    RowsHandled = MlasPlatform.GemmFloatKernel(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha, ZeroMode);
-#else
-                    if (ZeroMode) {
-                        RowsHandled = MlasSgemmKernelZero(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
-                    } else {
-                        RowsHandled = MlasSgemmKernelAdd(a, PanelB, c, CountK, RowsRemaining, CountN, lda, ldc, alpha);
-                    }
-#endif
+    TransA - Supplies the transpose operation for matrix A.
 
-                    c += ldc * RowsHandled;
-                    a += lda * RowsHandled;
+    M - Supplies the number of rows of matrix A and matrix C.
 
-                    RowsRemaining -= RowsHandled;
+    RangeStartN - Supplies the starting column of the packed matrix B to
+        process. This must be a multiple of MLAS_SGEMM_STRIDEN_THREAD_ALIGN.
 
-                } while (RowsRemaining > 0);
+    RangeCountN - Supplies the number of columns of the packed matrix B and
+        matrix C to process.
 
-            } else {
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
 
-                const float* a = A + k * lda;
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
 
-                do {
+    A - Supplies the address of matrix A.
 
-                    //
-                    // Transpose elements from matrix A into a local buffer.
-                    //
+    lda - Supplies the first dimension of matrix A.
 
-                    size_t RowsTransposed = RowsRemaining;
+    PackedB - Supplies the address of the packed matrix B.
 
-                    if (RowsTransposed > MLAS_SGEMM_TRANSA_ROWS) {
-                        RowsTransposed = MLAS_SGEMM_TRANSA_ROWS;
-                    }
+    AlignedN - Supplies the number of columns of the packed matrix B rounded
+        up to MLAS_SGEMM_STRIDEN_THREAD_ALIGN.
 
-                    RowsRemaining -= RowsTransposed;
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
 
-                    MlasSgemmTransposeA(PanelA, a, lda, RowsTransposed, CountK);
+    C - Supplies the address of matrix C, offset to the column RangeStartN.
 
-                    a += RowsTransposed;
+    ldc - Supplies the first dimension of matrix C.
 
-                    //
-                    // Step through the rows of the local buffer.
-                    //
+Return Value:
 
-                    const float* pa = PanelA;
+    None.
 
-                    do {
+--*/
+{
+    float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_PACKED_STRIDEK];
 
-#if defined(MLAS_TARGET_AMD64_IX86)
-                        RowsHandled = MlasPlatform.GemmFloatKernel(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
-#else
-                        if (ZeroMode) {
-                            RowsHandled = MlasSgemmKernelZero(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
-                        } else {
-                            RowsHandled = MlasSgemmKernelAdd(pa, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha);
-                        }
-#endif
+    //
+    // Step through each slice of matrix B along the N dimension.
+    //
 
-                        c += ldc * RowsHandled;
-                        pa += CountK * RowsHandled;
+    size_t CountN;
+    size_t CountK;
 
-                        RowsTransposed -= RowsHandled;
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+
+        CountN = MLAS_SGEMM_PACKED_STRIDEN;
+
+        if (CountN > (RangeCountN - n)) {
+            CountN = RangeCountN - n;
+        }
+
+        //
+        // Multiply the output matrix by beta as needed.
+        //
+
+        if (beta != 0.0f && beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C + n, M, CountN, ldc, beta);
+        }
+
+        //
+        // Step through each slice of matrix B along the K dimension. The
+        // packed buffer holds the panels of a K slice next to each other, so
+        // the panel of this N slice starts CountK elements per column into
+        // the K slice.
+        //
+
+        for (size_t k = 0; k < K; k += CountK) {
+
+            bool ZeroMode = (k == 0 && beta == 0.0f);
 
-                    } while (RowsTransposed > 0);
+            CountK = MLAS_SGEMM_PACKED_STRIDEK;
 
-                } while (RowsRemaining > 0);
+            if (CountK > (K - k)) {
+                CountK = K - k;
             }
+
+            const float* PanelB = PackedB + AlignedN * k + CountK * (RangeStartN + n);
+
+            const float* a = (TransA == CblasNoTrans) ? A + k : A + k * lda;
+
+            MlasSgemmMultiplyPanelB(TransA, M, CountN, CountK, alpha, ZeroMode,
+                a, lda, PanelB, C + n, ldc, PanelA);
         }
     }
 }
@@ -1040,10 +1218,20 @@ Return Value:
 
     MLAS_SGEMM_WORK_BLOCK::SEGMENT* Segment = &WorkBlock->Segments[Index];
 
-    MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
-        Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
-        Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
-        WorkBlock->ldc);
+    if (WorkBlock->BIsPacked) {
+
+        MlasSgemmPackedOperation(WorkBlock->TransA, Segment->M, Segment->StartN,
+            Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
+            Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
+            WorkBlock->ldc);
+
+    } else {
+
+        MlasSgemmOperation(WorkBlock->TransA, WorkBlock->TransB, Segment->M,
+            Segment->N, WorkBlock->K, WorkBlock->alpha, Segment->A, WorkBlock->lda,
+            Segment->B, WorkBlock->ldb, WorkBlock->beta, Segment->C,
+            WorkBlock->ldc);
+    }
 }
 
 inline
@@ -1062,6 +1250,7 @@ MlasSgemmTryMultithread(
     float beta,
     float* C,
     size_t ldc,
+    bool BIsPacked,
     MLAS_THREADPOOL* ThreadPool
     )
 /*++
@@ -1092,7 +1281,8 @@ Arguments:
 
     B - Supplies the address of matrix B.
 
-    ldb - Supplies the first dimension of matrix B.
+    ldb - Supplies the first dimension of matrix B. If matrix B is packed,
+        supplies the number of columns of the packed buffer.
 
     beta - Supplies the scalar beta multiplier (see SGEMM definition).
 
@@ -1100,6 +1290,8 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    BIsPacked - Supplies true if matrix B was packed by MlasGemmPackB.
+
     ThreadPool - Supplies the thread pool object to use, else nullptr if the
         base library threading support should be used.
 
@@ -1148,6 +1340,7 @@ Return Value:
     WorkBlock.ldc = ldc;
     WorkBlock.alpha = alpha;
     WorkBlock.beta = beta;
+    WorkBlock.BIsPacked = BIsPacked;
 
     //
     // Segment the operation across multiple threads.
@@ -1178,8 +1371,9 @@ Return Value:
 
             WorkBlock.Segments[Index].M = M;
             WorkBlock.Segments[Index].N = CountN;
+            WorkBlock.Segments[Index].StartN = n;
             WorkBlock.Segments[Index].A = A;
-            WorkBlock.Segments[Index].B = B + n * pldb;
+            WorkBlock.Segments[Index].B = BIsPacked ? B : B + n * pldb;
             WorkBlock.Segments[Index].C = C + n;
 
             Index++;
@@ -1205,6 +1399,7 @@ Return Value:
 
             WorkBlock.Segments[Index].M = CountM;
             WorkBlock.Segments[Index].N = N;
+            WorkBlock.Segments[Index].StartN = 0;
             WorkBlock.Segments[Index].A = A + m * plda;
             WorkBlock.Segments[Index].B = B;
             WorkBlock.Segments[Index].C = C + m * ldc;
@@ -1286,7 +1481,191 @@ Return Value:
     // single thread based on the GEMM parameters and system configuration.
     //
 
-    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, ThreadPool)) {
+    if (!MlasSgemmTryMultithread(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc, false, ThreadPool)) {
         MlasSgemmOperation(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, C, ldc);
     }
 }
+
+size_t
+MLASCALL
+MlasGemmPackBSize(
+    size_t N,
+    size_t K
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of bytes required to pack matrix B with
+    MlasGemmPackB.
+
+Arguments:
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+Return Value:
+
+    Returns the size in bytes of the packed buffer.
+
+--*/
+{
+    //
+    // The packed buffer holds every column rounded up to the kernel width, the
+    // size is then rounded up to the preferred buffer alignment.
+    //
+
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    const size_t BytesRequired = AlignedN * K * sizeof(float);
+    const size_t BufferAlignment = MlasGetPreferredBufferAlignment();
+
+    return (BytesRequired + BufferAlignment - 1) & ~(BufferAlignment - 1);
+}
+
+void
+MLASCALL
+MlasGemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    void* PackedB
+    )
+/*++
+
+Routine Description:
+
+    This routine packs matrix B into the layout used by the SGEMM kernels so
+    that MlasGemm can be called repeatedly with the same matrix B without
+    packing it on every call.
+
+    The packed buffer holds slices of MLAS_SGEMM_PACKED_STRIDEK rows. Each
+    slice holds the columns in groups of 16, each group storing the rows of
+    the slice contiguously.
+
+Arguments:
+
+    TransB - Supplies the transpose operation for matrix B.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    B - Supplies the address of matrix B.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    PackedB - Supplies the address of the packed buffer. The buffer must be
+        MlasGemmPackBSize bytes in size and aligned to the preferred buffer
+        alignment.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    float* D = (float*)PackedB;
+
+    //
+    // Step through each slice of matrix B along the K dimension.
+    //
+
+    size_t CountK;
+
+    for (size_t k = 0; k < K; k += CountK) {
+
+        CountK = MLAS_SGEMM_PACKED_STRIDEK;
+
+        if (CountK > (K - k)) {
+            CountK = K - k;
+        }
+
+        if (TransB == CblasNoTrans) {
+            MlasSgemmCopyPackB(D, B + k * ldb, ldb, N, CountK);
+        } else {
+            MlasSgemmTransposePackB(D, B + k, ldb, N, CountK);
+        }
+
+        D += AlignedN * CountK;
+    }
+}
+
+void
+MLASCALL
+MlasGemm(
+    CBLAS_TRANSPOSE TransA,
+    size_t M,
+    size_t N,
+    size_t K,
+    float alpha,
+    const float* A,
+    size_t lda,
+    const void* PackedB,
+    float beta,
+    float* C,
+    size_t ldc,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision matrix/matrix multiply
+    operation (SGEMM) with matrix B already packed by MlasGemmPackB.
+
+Arguments:
+
+    TransA - Supplies the transpose operation for matrix A.
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    K - Supplies the number of columns of matrix A and the number of rows of
+        matrix B.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    A - Supplies the address of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    PackedB - Supplies the address of matrix B packed by MlasGemmPackB.
+
+    beta - Supplies the scalar beta multiplier (see SGEMM definition).
+
+    C - Supplies the address of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t AlignedN =
+        (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) & ~(MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1);
+
+    const float* B = (const float*)PackedB;
+
+    //
+    // Try to run the operation across multiple threads or fall back to a
+    // single thread based on the GEMM parameters and system configuration.
+    //
+
+    if (!MlasSgemmTryMultithread(TransA, CblasNoTrans, M, N, K, alpha, A, lda, B, AlignedN, beta, C, ldc, true, ThreadPool)) {
+        MlasSgemmPackedOperation(TransA, M, 0, N, K, alpha, A, lda, B, AlignedN, beta, C, ldc);
+    }
+}
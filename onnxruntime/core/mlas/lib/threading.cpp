@@ -41,7 +41,19 @@ MlasExecuteThreaded(
     //
 
     if (ThreadPool != nullptr) {
-        ThreadPool->ParallelFor(Iterations, [&](int32_t tid) { ThreadedRoutine(Context, tid); });
+
+        //
+        // The work has already been partitioned by the caller, so mark each
+        // iteration as expensive enough to be a block of its own.
+        //
+
+        const double IterationCost = 1.0e6;
+
+        ThreadPool->ParallelFor(Iterations, IterationCost, [&](std::ptrdiff_t First, std::ptrdiff_t Last) {
+            for (std::ptrdiff_t tid = First; tid < Last; tid++) {
+                ThreadedRoutine(Context, int32_t(tid));
+            }
+        });
         return;
     }
 #endif
@@ -0,0 +1,388 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    transpose.cpp
+
+Abstract:
+
+    This module implements the transpose operation.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+void
+MlasTranspose4x4Block(
+    const uint32_t* Input,
+    size_t InputStride,
+    uint32_t* Output,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a 4x4 block of 32-bit elements.
+
+Arguments:
+
+    Input - Supplies the address of the first row of the source block.
+
+    InputStride - Supplies the number of elements between rows of the source
+        block.
+
+    Output - Supplies the address of the first row of the destination block.
+
+    OutputStride - Supplies the number of elements between rows of the
+        destination block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+    __m128i a0 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 0]);
+    __m128i a1 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 1]);
+    __m128i a2 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 2]);
+    __m128i a3 = _mm_loadu_si128((const __m128i*)&Input[InputStride * 3]);
+
+    __m128i b0 = _mm_unpacklo_epi32(a0, a1);
+    __m128i b1 = _mm_unpackhi_epi32(a0, a1);
+    __m128i b2 = _mm_unpacklo_epi32(a2, a3);
+    __m128i b3 = _mm_unpackhi_epi32(a2, a3);
+
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 0], _mm_unpacklo_epi64(b0, b2));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 1], _mm_unpackhi_epi64(b0, b2));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 2], _mm_unpacklo_epi64(b1, b3));
+    _mm_storeu_si128((__m128i*)&Output[OutputStride * 3], _mm_unpackhi_epi64(b1, b3));
+#elif defined(MLAS_NEON_INTRINSICS)
+    uint32x4_t a0 = vld1q_u32(&Input[InputStride * 0]);
+    uint32x4_t a1 = vld1q_u32(&Input[InputStride * 1]);
+    uint32x4_t a2 = vld1q_u32(&Input[InputStride * 2]);
+    uint32x4_t a3 = vld1q_u32(&Input[InputStride * 3]);
+
+    uint32x4x2_t b0 = vtrnq_u32(a0, a1);
+    uint32x4x2_t b1 = vtrnq_u32(a2, a3);
+
+    vst1q_u32(&Output[OutputStride * 0], vcombine_u32(vget_low_u32(b0.val[0]), vget_low_u32(b1.val[0])));
+    vst1q_u32(&Output[OutputStride * 1], vcombine_u32(vget_low_u32(b0.val[1]), vget_low_u32(b1.val[1])));
+    vst1q_u32(&Output[OutputStride * 2], vcombine_u32(vget_high_u32(b0.val[0]), vget_high_u32(b1.val[0])));
+    vst1q_u32(&Output[OutputStride * 3], vcombine_u32(vget_high_u32(b0.val[1]), vget_high_u32(b1.val[1])));
+#else
+    for (size_t i = 0; i < 4; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            Output[OutputStride * j + i] = Input[InputStride * i + j];
+        }
+    }
+#endif
+}
+
+MLAS_FORCEINLINE
+void
+MlasTranspose8x8Block(
+    const uint8_t* Input,
+    size_t InputStride,
+    uint8_t* Output,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a 8x8 block of 8-bit elements.
+
+Arguments:
+
+    Input - Supplies the address of the first row of the source block.
+
+    InputStride - Supplies the number of elements between rows of the source
+        block.
+
+    Output - Supplies the address of the first row of the destination block.
+
+    OutputStride - Supplies the number of elements between rows of the
+        destination block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+    __m128i a0 = _mm_loadl_epi64((const __m128i*)&Input[InputStride * 0]);
+    __m128i a1 = _mm_loadl_epi64((const __m128i*)&Input[InputStride * 1]);
+    __m128i b0 = _mm_unpacklo_epi8(a0, a1);
+
+    __m128i a2 = _mm_loadl_epi64((const __m128i*)&Input[InputStride * 2]);
+    __m128i a3 = _mm_loadl_epi64((const __m128i*)&Input[InputStride * 3]);
+    __m128i b1 = _mm_unpacklo_epi8(a2, a3);
+
+    __m128i a4 = _mm_loadl_epi64((const __m128i*)&Input[InputStride * 4]);
+    __m128i a5 = _mm_loadl_epi64((const __m128i*)&Input[InputStride * 5]);
+    __m128i b2 = _mm_unpacklo_epi8(a4, a5);
+
+    __m128i a6 = _mm_loadl_epi64((const __m128i*)&Input[InputStride * 6]);
+    __m128i a7 = _mm_loadl_epi64((const __m128i*)&Input[InputStride * 7]);
+    __m128i b3 = _mm_unpacklo_epi8(a6, a7);
+
+    __m128i c0 = _mm_unpacklo_epi16(b0, b1);
+    __m128i c1 = _mm_unpackhi_epi16(b0, b1);
+    __m128i c2 = _mm_unpacklo_epi16(b2, b3);
+    __m128i c3 = _mm_unpackhi_epi16(b2, b3);
+
+    __m128i d0 = _mm_unpacklo_epi32(c0, c2);
+    _mm_storel_epi64((__m128i*)&Output[OutputStride * 0], d0);
+    _mm_storel_epi64((__m128i*)&Output[OutputStride * 1], _mm_unpackhi_epi64(d0, d0));
+
+    __m128i d1 = _mm_unpackhi_epi32(c0, c2);
+    _mm_storel_epi64((__m128i*)&Output[OutputStride * 2], d1);
+    _mm_storel_epi64((__m128i*)&Output[OutputStride * 3], _mm_unpackhi_epi64(d1, d1));
+
+    __m128i d2 = _mm_unpacklo_epi32(c1, c3);
+    _mm_storel_epi64((__m128i*)&Output[OutputStride * 4], d2);
+    _mm_storel_epi64((__m128i*)&Output[OutputStride * 5], _mm_unpackhi_epi64(d2, d2));
+
+    __m128i d3 = _mm_unpackhi_epi32(c1, c3);
+    _mm_storel_epi64((__m128i*)&Output[OutputStride * 6], d3);
+    _mm_storel_epi64((__m128i*)&Output[OutputStride * 7], _mm_unpackhi_epi64(d3, d3));
+#elif defined(MLAS_NEON_INTRINSICS)
+    uint8x8x2_t b0 = vtrn_u8(vld1_u8(&Input[InputStride * 0]), vld1_u8(&Input[InputStride * 1]));
+    uint8x8x2_t b1 = vtrn_u8(vld1_u8(&Input[InputStride * 2]), vld1_u8(&Input[InputStride * 3]));
+    uint8x8x2_t b2 = vtrn_u8(vld1_u8(&Input[InputStride * 4]), vld1_u8(&Input[InputStride * 5]));
+    uint8x8x2_t b3 = vtrn_u8(vld1_u8(&Input[InputStride * 6]), vld1_u8(&Input[InputStride * 7]));
+
+    uint16x4x2_t c0 = vtrn_u16(vreinterpret_u16_u8(b0.val[0]), vreinterpret_u16_u8(b1.val[0]));
+    uint16x4x2_t c1 = vtrn_u16(vreinterpret_u16_u8(b0.val[1]), vreinterpret_u16_u8(b1.val[1]));
+    uint16x4x2_t c2 = vtrn_u16(vreinterpret_u16_u8(b2.val[0]), vreinterpret_u16_u8(b3.val[0]));
+    uint16x4x2_t c3 = vtrn_u16(vreinterpret_u16_u8(b2.val[1]), vreinterpret_u16_u8(b3.val[1]));
+
+    uint32x2x2_t d0 = vtrn_u32(vreinterpret_u32_u16(c0.val[0]), vreinterpret_u32_u16(c2.val[0]));
+    uint32x2x2_t d1 = vtrn_u32(vreinterpret_u32_u16(c1.val[0]), vreinterpret_u32_u16(c3.val[0]));
+    uint32x2x2_t d2 = vtrn_u32(vreinterpret_u32_u16(c0.val[1]), vreinterpret_u32_u16(c2.val[1]));
+    uint32x2x2_t d3 = vtrn_u32(vreinterpret_u32_u16(c1.val[1]), vreinterpret_u32_u16(c3.val[1]));
+
+    vst1_u8(&Output[OutputStride * 0], vreinterpret_u8_u32(d0.val[0]));
+    vst1_u8(&Output[OutputStride * 1], vreinterpret_u8_u32(d1.val[0]));
+    vst1_u8(&Output[OutputStride * 2], vreinterpret_u8_u32(d2.val[0]));
+    vst1_u8(&Output[OutputStride * 3], vreinterpret_u8_u32(d3.val[0]));
+    vst1_u8(&Output[OutputStride * 4], vreinterpret_u8_u32(d0.val[1]));
+    vst1_u8(&Output[OutputStride * 5], vreinterpret_u8_u32(d1.val[1]));
+    vst1_u8(&Output[OutputStride * 6], vreinterpret_u8_u32(d2.val[1]));
+    vst1_u8(&Output[OutputStride * 7], vreinterpret_u8_u32(d3.val[1]));
+#else
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t j = 0; j < 8; j++) {
+            Output[OutputStride * j + i] = Input[InputStride * i + j];
+        }
+    }
+#endif
+}
+
+template<typename ElementType, size_t BlockSize>
+MLAS_FORCEINLINE
+void
+MlasTransposeColumnBlock(
+    const ElementType* Input,
+    ElementType* Output,
+    size_t OutputStride
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes a single row of BlockSize elements to a single
+    column of the destination matrix.
+
+Arguments:
+
+    Input - Supplies the address of the row of the source matrix.
+
+    Output - Supplies the address of the column of the destination matrix.
+
+    OutputStride - Supplies the number of elements between rows of the
+        destination matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t j = 0; j < BlockSize; j++) {
+        Output[OutputStride * j] = Input[j];
+    }
+}
+
+template<typename ElementType, size_t BlockSize, void BlockRoutine(const ElementType*, size_t, ElementType*, size_t)>
+void
+MlasTransposeBlocked(
+    size_t M,
+    size_t N,
+    const ElementType* A,
+    size_t lda,
+    ElementType* B,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the matrix by walking BlockSize columns of the
+    source matrix at a time, so that the rows of the destination matrix are
+    written sequentially by the block routine.
+
+Arguments:
+
+    M - Supplies the number of rows of the source matrix.
+
+    N - Supplies the number of columns of the source matrix.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the first dimension of the source matrix.
+
+    B - Supplies the address of the destination matrix.
+
+    ldb - Supplies the first dimension of the destination matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t n = N;
+
+    while (n >= BlockSize) {
+
+        const ElementType* a = A;
+        ElementType* b = B;
+        size_t m = M;
+
+        while (m >= BlockSize) {
+
+            BlockRoutine(a, lda, b, ldb);
+
+            a += lda * BlockSize;
+            b += BlockSize;
+            m -= BlockSize;
+        }
+
+        while (m > 0) {
+
+            MlasTransposeColumnBlock<ElementType, BlockSize>(a, b, ldb);
+
+            a += lda;
+            b += 1;
+            m -= 1;
+        }
+
+        A += BlockSize;
+        B += ldb * BlockSize;
+        n -= BlockSize;
+    }
+
+    while (n > 0) {
+
+        const ElementType* a = A;
+        ElementType* b = B;
+
+        for (size_t m = 0; m < M; m++) {
+            b[m] = *a;
+            a += lda;
+        }
+
+        A += 1;
+        B += ldb;
+        n -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint32_t* A,
+    size_t lda,
+    uint32_t* B,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the M x N source matrix of 32-bit elements to the
+    N x M destination matrix.
+
+Arguments:
+
+    M - Supplies the number of rows of the source matrix.
+
+    N - Supplies the number of columns of the source matrix.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the first dimension of the source matrix.
+
+    B - Supplies the address of the destination matrix.
+
+    ldb - Supplies the first dimension of the destination matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTransposeBlocked<uint32_t, 4, MlasTranspose4x4Block>(M, N, A, lda, B, ldb);
+}
+
+void
+MLASCALL
+MlasTranspose(
+    size_t M,
+    size_t N,
+    const uint8_t* A,
+    size_t lda,
+    uint8_t* B,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine transposes the M x N source matrix of 8-bit elements to the
+    N x M destination matrix.
+
+Arguments:
+
+    M - Supplies the number of rows of the source matrix.
+
+    N - Supplies the number of columns of the source matrix.
+
+    A - Supplies the address of the source matrix.
+
+    lda - Supplies the first dimension of the source matrix.
+
+    B - Supplies the address of the destination matrix.
+
+    ldb - Supplies the first dimension of the destination matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MlasTransposeBlocked<uint8_t, 8, MlasTranspose8x8Block>(M, N, A, lda, B, ldb);
+}
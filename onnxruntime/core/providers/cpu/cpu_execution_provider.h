@@ -12,9 +12,11 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // keep a per-thread cache of small blocks in front of the arena
+  bool arena_thread_cache{false};
 
-  explicit CPUExecutionProviderInfo(bool use_arena)
-      : create_arena(use_arena) {}
+  explicit CPUExecutionProviderInfo(bool use_arena, bool use_arena_thread_cache = false)
+      : create_arena(use_arena), arena_thread_cache(use_arena_thread_cache) {}
 
   CPUExecutionProviderInfo() = default;
 };
@@ -30,6 +32,7 @@ class CPUExecutionProvider : public IExecutionProvider {
     DeviceAllocatorRegistrationInfo device_info{OrtMemTypeDefault,
                                                 [](int) { return onnxruntime::make_unique<TAllocator>(); },
                                                 std::numeric_limits<size_t>::max()};
+    device_info.use_thread_cache = info.arena_thread_cache;
 
 #ifdef USE_JEMALLOC
 #if defined(USE_MIMALLOC)
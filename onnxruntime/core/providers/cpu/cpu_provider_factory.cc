@@ -10,22 +10,29 @@
 namespace onnxruntime {
 
 struct CpuProviderFactory : IExecutionProviderFactory {
-  CpuProviderFactory(bool create_arena) : create_arena_(create_arena) {}
+  CpuProviderFactory(bool create_arena, bool arena_thread_cache)
+      : create_arena_(create_arena), arena_thread_cache_(arena_thread_cache) {}
   ~CpuProviderFactory() override = default;
   std::unique_ptr<IExecutionProvider> CreateProvider() override;
 
  private:
   bool create_arena_;
+  bool arena_thread_cache_;
 };
 
 std::unique_ptr<IExecutionProvider> CpuProviderFactory::CreateProvider() {
   CPUExecutionProviderInfo info;
   info.create_arena = create_arena_;
+  info.arena_thread_cache = arena_thread_cache_;
   return onnxruntime::make_unique<CPUExecutionProvider>(info);
 }
 
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CPU(int use_arena) {
-  return std::make_shared<onnxruntime::CpuProviderFactory>(use_arena != 0);
+  return std::make_shared<onnxruntime::CpuProviderFactory>(use_arena != 0, false);
+}
+
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CPU(int use_arena, int use_arena_thread_cache) {
+  return std::make_shared<onnxruntime::CpuProviderFactory>(use_arena != 0, use_arena_thread_cache != 0);
 }
 
 }  // namespace onnxruntime
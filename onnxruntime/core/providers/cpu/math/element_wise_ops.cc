@@ -254,12 +254,16 @@ Status Pow<T>::Compute(OpKernelContext* context) const {
   const Tensor& Y = *context->Input<Tensor>(1);
   std::function<void(EigenVectorMap<T>, ConstEigenVectorMap<T>, T)> input1scalar =
       [](EigenVectorMap<T> output, ConstEigenVectorMap<T> input0, T input1) { output = Eigen::pow(input0.array(), input1); };
+  // about the cost of std::pow, a few multiplications for the squares and cubes
+  double compute_cycles = 40.0;
   if (Y.Shape().Size() == 1) {
     T value = *Y.Data<T>();
     if (value == 2.0) {
       input1scalar = [](EigenVectorMap<T> output, ConstEigenVectorMap<T> input0, T) { output = Eigen::square(input0.array()); };
+      compute_cycles = 2.0;
     } else if (value == 3.0) {
       input1scalar = [](EigenVectorMap<T> output, ConstEigenVectorMap<T> input0, T) { output = Eigen::cube(input0.array()); };
+      compute_cycles = 2.0;
     }
   }
 
@@ -267,7 +271,8 @@ Status Pow<T>::Compute(OpKernelContext* context) const {
       *context,
       [](EigenVectorMap<T> output, T input0, ConstEigenVectorMap<T> input1) { output = Eigen::pow(input0, input1.array()); },
       input1scalar,
-      [](EigenVectorMap<T> output, ConstEigenVectorMap<T> input0, ConstEigenVectorMap<T> input1) { output = Eigen::pow(input0.array(), input1.array()); });
+      [](EigenVectorMap<T> output, ConstEigenVectorMap<T> input0, ConstEigenVectorMap<T> input1) { output = Eigen::pow(input0.array(), input1.array()); },
+      compute_cycles);
 }
 
 template <typename T>
@@ -993,8 +998,8 @@ void BroadCastFMod(const Tensor& X, const Tensor& Y, OpKernelContext* context) {
   TBroadcastOutput<T> mod_broadcast_output{
       mod_broadcaster.GetSpanSize(), *output};
 
-  BroadcastLoopSpan(
-      mod_broadcaster, mod_broadcast_output,
+  ParallelBroadcastLoopSpan(
+      context->GetOperatorThreadPool(), 10.0, mod_broadcaster, mod_broadcast_output,
       [](gsl::span<T> output, const T& X, gsl::span<const T> Y) {
         std::transform(Y.cbegin(), Y.cend(), output.begin(),
                        [X](T y) {
@@ -1036,8 +1041,8 @@ void BroadCastMod(const Tensor& X, const Tensor& Y, OpKernelContext* context) {
   // static_cast below are necessary when small types such as
   // int16_t and int8_t are converted to integers to perform remainder
   // operation. This cast is safe with respect to data loss.
-  BroadcastLoopSpan(
-      mod_broadcaster, mod_broadcast_output,
+  ParallelBroadcastLoopSpan(
+      context->GetOperatorThreadPool(), 10.0, mod_broadcaster, mod_broadcast_output,
       [](gsl::span<T> output, const T& X, gsl::span<const T> Y) {
         std::transform(Y.cbegin(), Y.cend(), output.begin(),
                        [X](T y) {
@@ -1066,8 +1071,8 @@ void BroadCastMFloat16FMod(const Tensor& X, const Tensor& Y, OpKernelContext* co
   TBroadcastOutput<MLFloat16> mod_broadcast_output{
       mod_broadcaster.GetSpanSize(), *output};
 
-  BroadcastLoopSpan(
-      mod_broadcaster, mod_broadcast_output,
+  ParallelBroadcastLoopSpan(
+      context->GetOperatorThreadPool(), 10.0, mod_broadcaster, mod_broadcast_output,
       [](gsl::span<MLFloat16> output, const MLFloat16& X, gsl::span<const MLFloat16> Y) {
         std::transform(Y.cbegin(), Y.cend(), output.begin(),
                        [X_fl = math::halfToFloat(X.val)](const MLFloat16& y) {
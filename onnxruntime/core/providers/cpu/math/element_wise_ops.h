@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -330,6 +331,20 @@ struct BroadcastIterator {
     return index;
   }
 
+  // Moves to the element at offset in the output, which must be the start of a span. A copy of the iterator can
+  // then process the spans from there while other copies process the rest of the output.
+  void Seek(size_t offset) {
+    ptrdiff_t index = 0;
+    size_t period = 1;  // number of elements between two increments of the counter
+    for (size_t counterIndex = 0; counterIndex < counters_.size(); counterIndex++) {
+      size_t steps = offset / period;
+      index += deltas_[counterIndex] * static_cast<ptrdiff_t>(steps);
+      counters_[counterIndex] = static_cast<int64_t>(steps % static_cast<size_t>(counts_[counterIndex]));
+      period *= static_cast<size_t>(counts_[counterIndex]);
+    }
+    index_ = static_cast<size_t>(index);
+  }
+
   void Reserve(int64_t max_dims) {
     deltas_.reserve(static_cast<size_t>(max_dims));
     counts_.reserve(static_cast<size_t>(max_dims));
@@ -509,10 +524,17 @@ struct TBroadcaster {
   ConstEigenVectorMap<T0> NextEigen0() { return ConstEigenVectorMap<T0>(Next0(), span_size_); }
   ConstEigenVectorMap<T1> NextEigen1() { return ConstEigenVectorMap<T1>(Next1(), span_size_); }
 
- private:
+  // Start of the next span of each input, a single element for an input which is a scalar over the span.
   const T0* Next0() { return input0_ + broadcaster_.iterator1_.AdvanceBy(span_size_); }
   const T1* Next1() { return input1_ + broadcaster_.iterator2_.AdvanceBy(span_size_); }
 
+  // Moves to the span of index span_index, for a copy of the broadcaster processing a range of the output.
+  void SeekSpan(size_t span_index) {
+    broadcaster_.iterator1_.Seek(span_index * span_size_);
+    broadcaster_.iterator2_.Seek(span_index * span_size_);
+  }
+
+ private:
   const Tensor& input_tensor0_;
   const Tensor& input_tensor1_;
   Broadcaster broadcaster_{input_tensor0_.Shape().GetDims(), input_tensor1_.Shape().GetDims()};
@@ -542,6 +564,10 @@ struct TBroadcastOutput {
     return gsl::span<T>(NextOutput(), span_size_);
   }
 
+  // Random access to the elements left, for a loop split between threads.
+  T* Data() const { return output_; }
+  size_t Size() const { return static_cast<size_t>(output_end_ - output_); }
+
  private:
   T* NextOutput() {
     T* output = output_;
@@ -610,17 +636,114 @@ void BroadcastLoopSpan(TBroadcaster& bc, Output& output, Input0Scalar input0scal
   }
 }
 
+// Calls fn(output, input0, input1, count) on the elements [first, last) of the output of bc, cut at the span
+// boundaries. The inputs point to the matching elements, or to the value of an input which is a scalar over the
+// span. bc is moved to the span of first.
+template <typename T0, typename T1, typename TOutput, typename Fn>
+void BroadcastRange(TBroadcaster<T0, T1>& bc, TOutput* output, size_t first, size_t last, Fn fn) {
+  const size_t span_size = bc.GetSpanSize();
+  const bool input0_scalar = bc.IsInput0Scalar();
+  const bool input1_scalar = bc.IsInput1Scalar();
+  size_t offset = first % span_size;
+  bc.SeekSpan(first / span_size);
+  for (size_t index = first; index < last; offset = 0) {
+    const size_t count = std::min(span_size - offset, last - index);
+    const T0* input0 = bc.Next0();
+    const T1* input1 = bc.Next1();
+    fn(output + index, input0_scalar ? input0 : input0 + offset, input1_scalar ? input1 : input1 + offset, count);
+    index += count;
+  }
+}
+
+// Cost of computing one output element, for splitting a broadcast loop between threads.
+template <typename T0, typename T1, typename TOutput>
+concurrency::TensorOpCost BroadcastCost(double compute_cycles) {
+  return concurrency::TensorOpCost{static_cast<double>(sizeof(T0) + sizeof(T1)),
+                                   static_cast<double>(sizeof(TOutput)),
+                                   compute_cycles};
+}
+
+// BroadcastLoop with the output split in ranges of elements run on the thread pool, compute_cycles being the cost
+// of one output element. Loops too small to be worth splitting run on the calling thread, see
+// ThreadPool::TryParallelFor. The ranges don't follow the span boundaries, so the functions receive parts of spans:
+// they must compute the output element by element. Whole outputs in a single span, the same shape and the
+// scalar-vs-tensor cases, are just split in contiguous blocks the Eigen expressions vectorize.
+template <typename T0, typename T1, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
+void ParallelBroadcastLoop(concurrency::ThreadPool* tp, double compute_cycles,
+                           TBroadcaster<T0, T1>& bc, TBroadcastOutput<TOutput>& output,
+                           Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
+  TOutput* output_data = output.Data();
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(output.Size()), BroadcastCost<T0, T1, TOutput>(compute_cycles),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        TBroadcaster<T0, T1> range_bc(bc);
+        if (bc.IsInput0Scalar()) {
+          BroadcastRange(range_bc, output_data, static_cast<size_t>(first), static_cast<size_t>(last),
+                         [&](TOutput* out, const T0* input0, const T1* input1, size_t count) {
+                           input0scalar(EigenVectorMap<TOutput>(out, count), *input0,
+                                        ConstEigenVectorMap<T1>(input1, count));
+                         });
+        } else if (bc.IsInput1Scalar()) {
+          BroadcastRange(range_bc, output_data, static_cast<size_t>(first), static_cast<size_t>(last),
+                         [&](TOutput* out, const T0* input0, const T1* input1, size_t count) {
+                           input1scalar(EigenVectorMap<TOutput>(out, count), ConstEigenVectorMap<T0>(input0, count),
+                                        *input1);
+                         });
+        } else {
+          BroadcastRange(range_bc, output_data, static_cast<size_t>(first), static_cast<size_t>(last),
+                         [&](TOutput* out, const T0* input0, const T1* input1, size_t count) {
+                           general(EigenVectorMap<TOutput>(out, count), ConstEigenVectorMap<T0>(input0, count),
+                                   ConstEigenVectorMap<T1>(input1, count));
+                         });
+        }
+      });
+}
+
+// BroadcastLoopSpan split between threads like ParallelBroadcastLoop.
+template <typename T0, typename T1, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
+void ParallelBroadcastLoopSpan(concurrency::ThreadPool* tp, double compute_cycles,
+                               TBroadcaster<T0, T1>& bc, TBroadcastOutput<TOutput>& output,
+                               Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
+  TOutput* output_data = output.Data();
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(output.Size()), BroadcastCost<T0, T1, TOutput>(compute_cycles),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        TBroadcaster<T0, T1> range_bc(bc);
+        if (bc.IsInput0Scalar()) {
+          BroadcastRange(range_bc, output_data, static_cast<size_t>(first), static_cast<size_t>(last),
+                         [&](TOutput* out, const T0* input0, const T1* input1, size_t count) {
+                           input0scalar(gsl::span<TOutput>(out, count), *input0, gsl::span<const T1>(input1, count));
+                         });
+        } else if (bc.IsInput1Scalar()) {
+          BroadcastRange(range_bc, output_data, static_cast<size_t>(first), static_cast<size_t>(last),
+                         [&](TOutput* out, const T0* input0, const T1* input1, size_t count) {
+                           input1scalar(gsl::span<TOutput>(out, count), gsl::span<const T0>(input0, count), *input1);
+                         });
+        } else {
+          BroadcastRange(range_bc, output_data, static_cast<size_t>(first), static_cast<size_t>(last),
+                         [&](TOutput* out, const T0* input0, const T1* input1, size_t count) {
+                           general(gsl::span<TOutput>(out, count), gsl::span<const T0>(input0, count),
+                                   gsl::span<const T1>(input1, count));
+                         });
+        }
+      });
+}
+
+// compute_cycles is the cost of computing one output element, see ParallelBroadcastLoop.
 template <typename TInput, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
-Status BroadcastTwo(OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
+Status BroadcastTwo(OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general,
+                    double compute_cycles = 1.0) {
   TBroadcaster<TInput, TInput> bc(*context.Input<Tensor>(0), *context.Input<Tensor>(1));
   TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *context.Output(0, bc.GetOutputShape()));
-  BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+  ParallelBroadcastLoop(context.GetOperatorThreadPool(), compute_cycles, bc, output,
+                        input0scalar, input1scalar, general);
 
   return Status::OK();
 }
 
 template <typename TInput, typename TOutput, typename Input0Scalar, typename Input1Scalar, typename General>
-Status BroadcastVariadic(const Node& node, OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general) {
+Status BroadcastVariadic(const Node& node, OpKernelContext& context, Input0Scalar input0scalar, Input1Scalar input1scalar, General general,
+                         double compute_cycles = 1.0) {
   auto input_count = node.InputArgCount().front();
   ORT_ENFORCE(input_count >= 1, "Must have 1 or more inputs");
 
@@ -653,7 +776,8 @@ Status BroadcastVariadic(const Node& node, OpKernelContext& context, Input0Scala
 
     TBroadcastOutput<TOutput> output(bc.GetSpanSize(), *p_output);
 
-    BroadcastLoop(bc, output, input0scalar, input1scalar, general);
+    ParallelBroadcastLoop(context.GetOperatorThreadPool(), compute_cycles, bc, output,
+                          input0scalar, input1scalar, general);
 
     tempInput = std::move(tempOutput);
   }
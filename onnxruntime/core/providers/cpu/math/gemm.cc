@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/gemm.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -26,4 +27,34 @@ ONNX_CPU_OPERATOR_KERNEL(
     11,
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     Gemm<float>);
+
+bool GemmPackBFp32(const OpKernelInfo& info, int input_index, bool trans_b, BufferUniquePtr& packed_b) {
+  const Tensor* tensor_b;
+  if (!info.TryGetConstantInput(input_index, &tensor_b) ||
+      !tensor_b->IsDataType<float>() ||
+      tensor_b->Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const auto& b_shape = tensor_b->Shape();
+  const size_t K = static_cast<size_t>(trans_b ? b_shape[1] : b_shape[0]);
+  const size_t N = static_cast<size_t>(trans_b ? b_shape[0] : b_shape[1]);
+  if (K == 0 || N == 0) {
+    return false;
+  }
+
+  // the CPU allocators return buffers aligned for MLAS
+  auto alloc = info.GetAllocator(0, OrtMemTypeDefault);
+  packed_b = BufferUniquePtr(alloc->Alloc(MlasGemmPackBSize(N, K)), BufferDeleter(alloc));
+  MlasGemmPackB(trans_b ? CblasTrans : CblasNoTrans, N, K, tensor_b->Data<float>(), trans_b ? K : N, packed_b.get());
+  return true;
+}
+
+void GemmPackedBFp32(CBLAS_TRANSPOSE trans_a, int64_t M, int64_t N, int64_t K, float alpha, const float* A,
+                     const void* packed_b, float beta, float* C, concurrency::ThreadPool* thread_pool) {
+  const size_t lda = static_cast<size_t>(trans_a == CblasNoTrans ? K : M);
+  MlasGemm(trans_a, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), alpha, A, lda, packed_b,
+           beta, C, static_cast<size_t>(N), thread_pool);
+}
+
 }  // namespace onnxruntime
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <type_traits>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math.h"
@@ -11,6 +13,14 @@
 
 namespace onnxruntime {
 
+// Packs the input B of a float Gemm or MatMul with MlasGemmPackB when it is a constant 2D initializer, so it is
+// packed once at kernel creation instead of on every Compute. Returns false and leaves packed_b empty otherwise.
+bool GemmPackBFp32(const OpKernelInfo& info, int input_index, bool trans_b, BufferUniquePtr& packed_b);
+
+// C = alpha * op(A) * B + beta * C with B packed by GemmPackBFp32, C has N columns.
+void GemmPackedBFp32(CBLAS_TRANSPOSE trans_a, int64_t M, int64_t N, int64_t K, float alpha, const float* A,
+                     const void* packed_b, float beta, float* C, concurrency::ThreadPool* thread_pool);
+
 template <typename T>
 class Gemm : public OpKernel {
  public:
@@ -24,6 +34,10 @@ class Gemm : public OpKernel {
 
     ORT_ENFORCE(info.GetAttr<float>("alpha", &alpha_).IsOK());
     ORT_ENFORCE(info.GetAttr<float>("beta", &beta_).IsOK());
+
+    if (std::is_same<T, float>::value) {
+      GemmPackBFp32(info, 1, trans_B_ != CblasNoTrans, packed_b_);
+    }
   }
 
   Status Compute(OpKernelContext* context) const override {
@@ -68,20 +82,25 @@ class Gemm : public OpKernel {
     }
 
     // W * x
-    math::Gemm<T>(
-        trans_A_,
-        trans_B_,
-        M,
-        N,
-        helper.K(),
-        alpha_,
-        X->template Data<T>(),
-        W->template Data<T>(),
-        // ideally we need to set the output buffer contents to 0 if bias is missing,
-        // but passing 0 for beta is cheaper and it will ignore any junk in the output buffer
-        B != nullptr ? beta_ : 0,
-        y_data,
-        thread_pool);
+    if (packed_b_) {
+      GemmPackedBFp32(trans_A_, M, N, helper.K(), alpha_, X->template Data<T>(), packed_b_.get(),
+                      B != nullptr ? beta_ : 0, y_data, thread_pool);
+    } else {
+      math::Gemm<T>(
+          trans_A_,
+          trans_B_,
+          M,
+          N,
+          helper.K(),
+          alpha_,
+          X->template Data<T>(),
+          W->template Data<T>(),
+          // ideally we need to set the output buffer contents to 0 if bias is missing,
+          // but passing 0 for beta is cheaper and it will ignore any junk in the output buffer
+          B != nullptr ? beta_ : 0,
+          y_data,
+          thread_pool);
+    }
 
     FuseActivation<T>(activation_, y_data, M * N, leaky_relu_alpha_);
 
@@ -93,6 +112,8 @@ class Gemm : public OpKernel {
   CBLAS_TRANSPOSE trans_B_;
   float alpha_;
   float beta_;
+  // B packed at kernel creation when it is a constant initializer
+  BufferUniquePtr packed_b_;
 
  protected:
   // For fused gemm + activation
@@ -91,4 +91,37 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+template <>
+Status MatMul<float>::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const auto* left_X = ctx->Input<Tensor>(0);
+  const auto* right_X = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(left_X->Shape(), right_X->Shape()));
+
+  Tensor* Y = ctx->Output(0, helper.OutputShape());
+
+  // a packed B is 2D, every output matrix is multiplied by the same B
+  size_t max_len = helper.OutputOffsets().size();
+  for (size_t i = 0; i < max_len; i++) {
+    if (packed_b_) {
+      GemmPackedBFp32(CblasNoTrans, helper.M(), helper.N(), helper.K(), 1.f,
+                      left_X->Data<float>() + helper.LeftOffsets()[i], packed_b_.get(), 0.f,
+                      Y->MutableData<float>() + helper.OutputOffsets()[i], thread_pool);
+    } else {
+      math::MatMul<float>(
+          static_cast<int>(helper.M()),
+          static_cast<int>(helper.N()),
+          static_cast<int>(helper.K()),
+          left_X->Data<float>() + helper.LeftOffsets()[i],
+          right_X->Data<float>() + helper.RightOffsets()[i],
+          Y->MutableData<float>() + helper.OutputOffsets()[i], thread_pool);
+    }
+  }
+
+  return Status::OK();
+}
+
 }  // namespace onnxruntime
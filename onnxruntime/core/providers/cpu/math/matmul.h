@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/math/gemm.h"
 
 namespace onnxruntime {
 
@@ -18,4 +19,19 @@ class MatMul final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 };
 
+template <>
+class MatMul<float> final : public OpKernel {
+ public:
+  MatMul(const OpKernelInfo& info)
+      : OpKernel(info) {
+    GemmPackBFp32(info, 1, false, packed_b_);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // B packed at kernel creation when it is a constant 2D initializer
+  BufferUniquePtr packed_b_;
+};
+
 }  // namespace onnxruntime
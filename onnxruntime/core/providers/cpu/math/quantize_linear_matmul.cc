@@ -56,22 +56,23 @@ Status QLinearMatMul<uint8_t, uint8_t, uint8_t>::Compute(OpKernelContext* ctx) c
   auto y_scale_data = *(y_scale->template Data<float>());
 
   const float real_multiplier = (a_scale_data * b_scale_data) / y_scale_data;
-  int32_t integer_multiplier;
-  int right_shift;
-  QuantizeMultiplier(real_multiplier, &integer_multiplier, &right_shift);
 
   for (size_t i = 0; i < helper.OutputOffsets().size(); i++) {
-    GemmlowpMultiplyu8u8_u8(a->template Data<uint8_t>() + helper.LeftOffsets()[i],
-                            b->template Data<uint8_t>() + helper.RightOffsets()[i],
-                            y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
-                            *a_offset->template Data<uint8_t>(),
-                            *b_offset->template Data<uint8_t>(),
-                            *y_offset->template Data<uint8_t>(),
-                            static_cast<int>(helper.M()),
-                            static_cast<int>(helper.N()),
-                            static_cast<int>(helper.K()),
-                            integer_multiplier,
-                            right_shift);
+    QGemmu8u8_u8(static_cast<int>(helper.M()),
+                 static_cast<int>(helper.N()),
+                 static_cast<int>(helper.K()),
+                 a->template Data<uint8_t>() + helper.LeftOffsets()[i],
+                 static_cast<int>(helper.K()),
+                 *a_offset->template Data<uint8_t>(),
+                 b->template Data<uint8_t>() + helper.RightOffsets()[i],
+                 static_cast<int>(helper.N()),
+                 *b_offset->template Data<uint8_t>(),
+                 y->template MutableData<uint8_t>() + helper.OutputOffsets()[i],
+                 static_cast<int>(helper.N()),
+                 real_multiplier,
+                 *y_offset->template Data<uint8_t>(),
+                 nullptr,
+                 ctx->GetOperatorThreadPool());
   }
 
   return Status::OK();
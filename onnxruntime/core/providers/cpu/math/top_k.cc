@@ -20,8 +20,8 @@
 #include "core/common/exceptions.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
-#include <queue>
 #include <algorithm>
 #include <cmath>
 
@@ -50,13 +50,20 @@ struct LesserValueCmp {
 
 // Static helpers that implement the core logic for each of the 'TopK' operator flavor
 
+// Contiguous rows of at least kThresholdSelectMinN elements, of which k is a small fraction, are selected by
+// filtering them against the k-th best value found so far instead of holding all of them as (value, idx) pairs.
+// Whole blocks of kThresholdSelectBlock elements are skipped with a vectorized min/max when none of them passes.
+constexpr int64_t kThresholdSelectMinN = 1024;
+constexpr int64_t kThresholdSelectMaxFraction = 8;
+constexpr int64_t kThresholdSelectBlock = 64;
+
 // Selects the top k elements (largest or smallest based on template parameter)
-template <class Comparator>
-static vector<pair<float, int64_t>> select_top_k(const ConstEigenMatrixMapRowMajor<float>& raw_data, int64_t row_num, int64_t num_blocks,
-                                                 int64_t block_slice, int64_t inter_block_offset, const unsigned k,
-                                                 bool sort_top_k) {
+template <typename T, class Comparator>
+static void select_top_k(const ConstEigenMatrixMapRowMajor<T>& raw_data, int64_t row_num, int64_t num_blocks,
+                         int64_t block_slice, int64_t inter_block_offset, const unsigned k, bool sort_top_k,
+                         vector<pair<T, int64_t>>& data_holder) {
   // create a data holder and insert elements
-  vector<pair<float, int64_t>> data_holder;
+  data_holder.clear();
   data_holder.reserve(num_blocks);
   for (int64_t l = 0; l < num_blocks; ++l) {
     data_holder.push_back({raw_data(row_num, l * block_slice + inter_block_offset), l});
@@ -71,104 +78,156 @@ static vector<pair<float, int64_t>> select_top_k(const ConstEigenMatrixMapRowMaj
   }
 
   // the data_holder now contains the top k elements in the first k indices
-  return data_holder;
+}
+
+// Selects the sorted top k elements by passing the 'n' elements over a heap of size 'k' - O(n * ln(k))
+template <bool largest, typename T, class Comparator>
+static void heap_select_top_k(const ConstEigenMatrixMapRowMajor<T>& raw_data, int64_t row_num, int64_t num_blocks,
+                              int64_t block_slice, int64_t inter_block_offset, const unsigned k,
+                              vector<pair<T, int64_t>>& heap) {
+  // Build a min-heap/max-heap, the heap element is pair of (value, idx)
+  // The top of the heap is the smallest/largest value depending on whether it is a min-heap/max-heap
+  // This is a min-heap if largest == true, this is a max-heap if largest == false
+  heap.clear();
+  heap.reserve(k);
+
+  // Maintain the size of heap to be less or equal to k, so the
+  // heap will hold the k largest/smallest values
+  for (int64_t l = 0; l < num_blocks; ++l) {
+    const auto value = raw_data(row_num, l * block_slice + inter_block_offset);
+    if (heap.size() < k) {
+      heap.push_back({value, l});
+      push_heap(heap.begin(), heap.end(), Comparator());
+    } else if ((largest && value > heap.front().first) || (!largest && value < heap.front().first)) {
+      // largest == true: replace the min element of the min-heap if the new element is greater
+      // largest == false: replace the max element of the max-heap if the new element is lesser
+      // the optimizer will clean-up the redundant condition based on the template parameter 'largest'
+      pop_heap(heap.begin(), heap.end(), Comparator());
+      heap.back() = {value, l};
+      push_heap(heap.begin(), heap.end(), Comparator());
+    }
+  }
+
+  // Order the k elements from the top down
+  sort_heap(heap.begin(), heap.end(), Comparator());
+}
+
+// Selects the top k elements of the contiguous row of n elements into the first k candidates.
+// The candidates are pruned back to the top k whenever they fill up, which raises the threshold a new element has
+// to beat. An element equal to the threshold comes after all the candidates, so it never beats them.
+template <bool largest, typename T, class Comparator>
+static void threshold_select_top_k(const T* row, int64_t n, const unsigned k, bool sort_top_k,
+                                   vector<pair<T, int64_t>>& candidates) {
+  const size_t capacity = k + std::max<size_t>(k, kThresholdSelectBlock);
+  candidates.clear();
+  candidates.reserve(capacity);
+
+  T threshold{};
+  bool has_threshold = false;
+  auto keep_top_k = [&]() {
+    nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), Comparator());
+    candidates.resize(k);
+    threshold = candidates[k - 1].first;
+    has_threshold = true;
+  };
+
+  for (int64_t l = 0; l < n; l += kThresholdSelectBlock) {
+    const int64_t block_n = std::min(kThresholdSelectBlock, n - l);
+    if (has_threshold) {
+      ConstEigenVectorArrayMap<T> block(row + l, block_n);
+      if (largest ? !(block.maxCoeff() > threshold) : !(block.minCoeff() < threshold)) {
+        continue;
+      }
+    }
+    for (int64_t m = l; m < l + block_n; ++m) {
+      const T value = row[m];
+      if (!has_threshold || (largest && value > threshold) || (!largest && value < threshold)) {
+        candidates.push_back({value, m});
+        if (candidates.size() == capacity) {
+          keep_top_k();
+        }
+      }
+    }
+  }
+
+  if (candidates.size() > k) {
+    keep_top_k();
+  }
+
+  if (sort_top_k) {
+    std::sort(candidates.begin(), candidates.end(), Comparator());
+  }
 }
 
 // Given an input tensor 'input' and metadata values - 'k' and 'axis_parsed',
 // this method will extract the sorted top k largest/smallest elements and place them in the output tensor 'values'
-// along with the metadata output 'indices'
-template <bool largest, bool sorted, class Comparator>
+// along with the metadata output 'indices'. The rows are split across the thread pool tp.
+template <bool largest, bool sorted, typename T, class Comparator>
 static void extract_top_k_elements(const Tensor* input, const TensorShape& input_shape, Tensor* values,
                                    Tensor* indices, const TensorShape& output_shape, const unsigned k,
-                                   const unsigned axis_parsed) {
+                                   const unsigned axis_parsed, concurrency::ThreadPool* tp) {
   // Cache some values that will be used in the implementation below
   const int64_t rows = input_shape.SizeToDimension(static_cast<size_t>(axis_parsed));
   const int64_t cols = input->Shape().Size() / rows;
-  auto input_map =
-      ConstEigenMatrixMapRowMajor<float>(static_cast<const float*>(input->template Data<float>()), rows, cols);
+  const T* input_data = input->template Data<T>();
+  auto input_map = ConstEigenMatrixMapRowMajor<T>(input_data, rows, cols);
 
   // Use Eigen maps to allow indexing into the 2d tensors like Values_map(i,j)
   const int64_t reduced_cols = output_shape.SizeFromDimension(static_cast<size_t>(axis_parsed));
-  auto values_map = EigenMatrixMapRowMajor<float>(values->template MutableData<float>(), rows, reduced_cols);
+  auto values_map = EigenMatrixMapRowMajor<T>(values->template MutableData<T>(), rows, reduced_cols);
   auto indices_map = EigenMatrixMapRowMajor<int64_t>(indices->template MutableData<int64_t>(), rows, reduced_cols);
 
   // This is basically the number of elements within each of the "k" rows
   const int64_t block_slice = reduced_cols / k;
   const int64_t num_blocks = input_shape[axis_parsed];
 
-  for (int64_t i = 0; i < rows; ++i) {
-    for (int64_t j = 0; j < block_slice; ++j) {
-      // Since sorted == true, we will use a Heap to hold the top K values in sorted fashion
-      if (sorted) {  // The optimizer will clean-up the redundant condition based on the template parameter 'sorted'
-        auto n_casted = static_cast<double>(num_blocks);
-        auto k_casted = static_cast<double>(k);
-        if ((n_casted + k_casted * log(k_casted)) < (n_casted * log(k_casted))) {
-          // Select first  - O(n), then sort O(k * ln(k))
-          // Overall complexity =  O (n + k * ln(k))
-          const auto& data_holder = select_top_k<Comparator>(input_map, i, num_blocks, block_slice, j, k, true);
+  const bool threshold_select = block_slice == 1 && num_blocks >= kThresholdSelectMinN &&
+                                k * kThresholdSelectMaxFraction <= num_blocks;
+
+  // Since sorted == true, we will use a Heap to hold the top K values in sorted fashion when
+  // passing 'n' elements over it - O(n * ln(k)) - is cheaper than selecting first - O(n) - then sorting - O(k * ln(k))
+  const auto n_casted = static_cast<double>(num_blocks);
+  const auto k_casted = static_cast<double>(k);
+  const bool select_then_sort = (n_casted + k_casted * log(k_casted)) < (n_casted * log(k_casted));
+
+  // Each (row, offset within the block) selection reads its n elements and writes k values and indices.
+  const concurrency::TensorOpCost cost{n_casted * sizeof(T), k_casted * (sizeof(T) + sizeof(int64_t)),
+                                       n_casted + k_casted * log(k_casted + 1)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, rows * block_slice, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // The (value, idx) pairs of a selection, reused across the selections of this thread.
+        vector<pair<T, int64_t>> data_holder;
+
+        for (std::ptrdiff_t work = first; work < last; ++work) {
+          const int64_t i = work / block_slice;
+          const int64_t j = work % block_slice;
+
+          if (threshold_select) {
+            threshold_select_top_k<largest, T, Comparator>(input_data + i * cols, num_blocks, k, sorted, data_holder);
+          } else if (sorted && !select_then_sort) {
+            // The optimizer will clean-up the redundant condition based on the template parameter 'sorted'
+            heap_select_top_k<largest, T, Comparator>(input_map, i, num_blocks, block_slice, j, k, data_holder);
+          } else {
+            // If the top K values are not required to be sorted, we use a more optimal selection algorithm
+            // Average - O(n). Worst - O(n * ln(n)) or O(n^2) depending on the implementation, where 'n' is the number
+            // of input. Sorted, it's followed by the sort of the k selected elements - O (k * ln(k))
+            select_top_k<T, Comparator>(input_map, i, num_blocks, block_slice, j, k, sorted, data_holder);
+          }
+
+          // Insert the top 'k' (largest or smallest) elements into the final output buffers
           for (int64_t l = 0; l < k; ++l) {
             const auto& elem = data_holder[l];
             auto col_index = l * block_slice + j;
             values_map(i, col_index) = elem.first;
             indices_map(i, col_index) = elem.second;
           }
-        } else {
-          // Perform sorted selection by passing 'n' elements over a heap of size 'k'
-          // overall complexity =  O (n * ln(k))
-
-          // Build a min-heap/max-heap, the heap element is pair of (value, idx)
-          // The top of the heap is the smallest/largest value depending on whether it is a min-heap/max-heap
-          // This is a min-heap if largest == true, this is a max-heap if largest == false
-          priority_queue<pair<float, int64_t>, vector<pair<float, int64_t>>, Comparator> heap;
-
-          // Maintain the size of heap to be less or equal to k, so the
-          // heap will hold the k largest/smallest values
-          for (int64_t l = 0; l < num_blocks; ++l) {
-            const auto value = input_map(i, l * block_slice + j);
-            // largest == true: insert into the min-heap if the size is < k or if the new
-            // element is greater than the min element in the min-heap
-
-            // largest == false: insert into the min-heap if the size is < k or if the new
-            // element is lesser than the max element in the max-heap
-            if ((heap.size() < k) || (largest && value > heap.top().first) ||
-                (!largest && value < heap.top().first)) {  // the optimizer will clean-up the redundant condition based
-                                                           // on the template parameter 'largest'
-              heap.push({value, l});
-            }
-            if (heap.size() > k) {
-              heap.pop();
-            }
-          }
-          // Extract these k elements and place them in the results placeholder
-          for (int64_t l = 0; l < k; ++l) {
-            const auto& elem = heap.top();
-            auto col_index = (k - l - 1) * block_slice + j;
-            values_map(i, col_index) = elem.first;
-            indices_map(i, col_index) = elem.second;
-            heap.pop();
-          }
-        }
-      } else {  // sorted == false
-        // The optimizer will clean-up the redundant condition based on the template parameter 'sorted'
-
-        // If the top K values are not required to be sorted, we use a more optimal selection algorithm
-        // Average - O(n). Worst - O(n * ln(n)) or O(n^2) depending on the implementation, where 'n' is the number of input
-
-        const auto& data_holder = select_top_k<Comparator>(input_map, i, num_blocks, block_slice, j, k, false);
-
-        // Insert the top 'k' (largest or smallest) elements into the final output buffers
-        for (int64_t l = 0; l < k; ++l) {
-          const auto& elem = data_holder[l];
-          auto col_index = l * block_slice + j;
-          values_map(i, col_index) = elem.first;
-          indices_map(i, col_index) = elem.second;
         }
-      }
-    }
-  }
+      });
 }
 
 // Wrapper over core TopK implementation
+template <typename T>
 static Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* input, const int axis, const unsigned k,
                        bool largest = true, bool sorted = true) {
   const TensorShape& input_shape = input->Shape();
@@ -198,22 +257,25 @@ static Status TopKImpl(OpKernelContext* p_op_kernel_context, const Tensor* input
     return Status::OK();
   }
 
+  concurrency::ThreadPool* tp = p_op_kernel_context->GetOperatorThreadPool();
+  const auto axis_unsigned = gsl::narrow_cast<unsigned>(axis_parsed);
+
   if (sorted && largest) {
     // extract sorted largest TopK elements
-    extract_top_k_elements<true, true, GreaterValueCmp<float>>(input, input_shape, values, indices, output_shape, k,
-                                                               gsl::narrow_cast<unsigned>(axis_parsed));
+    extract_top_k_elements<true, true, T, GreaterValueCmp<T>>(input, input_shape, values, indices, output_shape, k,
+                                                              axis_unsigned, tp);
   } else if (sorted && !largest) {
     // extract sorted smallest TopK elements
-    extract_top_k_elements<false, true, LesserValueCmp<float>>(input, input_shape, values, indices, output_shape, k,
-                                                               gsl::narrow_cast<unsigned>(axis_parsed));
+    extract_top_k_elements<false, true, T, LesserValueCmp<T>>(input, input_shape, values, indices, output_shape, k,
+                                                              axis_unsigned, tp);
   } else if (largest) {
     // extract unsorted (order undefined) largest TopK elements
-    extract_top_k_elements<true, false, GreaterValueCmp<float>>(input, input_shape, values, indices, output_shape, k,
-                                                                gsl::narrow_cast<unsigned>(axis_parsed));
+    extract_top_k_elements<true, false, T, GreaterValueCmp<T>>(input, input_shape, values, indices, output_shape, k,
+                                                               axis_unsigned, tp);
   } else {
     // extract unsorted (order undefined) smallest TopK elements
-    extract_top_k_elements<false, false, LesserValueCmp<float>>(input, input_shape, values, indices, output_shape, k,
-                                                                gsl::narrow_cast<unsigned>(axis_parsed));
+    extract_top_k_elements<false, false, T, LesserValueCmp<T>>(input, input_shape, values, indices, output_shape, k,
+                                                               axis_unsigned, tp);
   }
 
   return Status::OK();
@@ -240,7 +302,7 @@ Status TopK<9, float>::Compute(OpKernelContext* p_op_kernel_context) const {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "input count mismatch, expected 1 input - the tensor to be processed");
   }
 
-  return TopKImpl(p_op_kernel_context, X, axis_, k_);
+  return TopKImpl<float>(p_op_kernel_context, X, axis_, k_);
 }
 
 // Opset ver - 10
@@ -272,7 +334,7 @@ Status TopK<10, float>::Compute(OpKernelContext* p_op_kernel_context) const {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "value of k must not be negative");
   }
 
-  return TopKImpl(p_op_kernel_context, X, axis_, gsl::narrow_cast<unsigned>(parsed_input_k));
+  return TopKImpl<float>(p_op_kernel_context, X, axis_, gsl::narrow_cast<unsigned>(parsed_input_k));
 }
 
 // Opset ver - 11
@@ -302,6 +364,7 @@ TopK<11, int64_t>::TopK(const OpKernelInfo& op_kernel_info) : OpKernel(op_kernel
   TopkOpset11ConstructorCommon(op_kernel_info, axis_, largest_, sorted_);
 }
 
+template <typename T>
 static Status ComputeImplOpset11(OpKernelContext* p_op_kernel_context, int axis, bool is_largest, bool is_sorted) {
   const auto* X = p_op_kernel_context->Input<Tensor>(0);
   const auto* Y = p_op_kernel_context->Input<Tensor>(1);
@@ -321,18 +384,18 @@ static Status ComputeImplOpset11(OpKernelContext* p_op_kernel_context, int axis,
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "value of k must not be negative");
   }
 
-  return TopKImpl(p_op_kernel_context, X, axis, gsl::narrow_cast<unsigned>(parsed_input_k), is_largest, is_sorted);
+  return TopKImpl<T>(p_op_kernel_context, X, axis, gsl::narrow_cast<unsigned>(parsed_input_k), is_largest, is_sorted);
 }
 
 // Opset ver - 11
 template <>
 Status TopK<11, float>::Compute(OpKernelContext* p_op_kernel_context) const {
-  return ComputeImplOpset11(p_op_kernel_context, axis_, largest_, sorted_);
+  return ComputeImplOpset11<float>(p_op_kernel_context, axis_, largest_, sorted_);
 }
 
 template <>
 Status TopK<11, int64_t>::Compute(OpKernelContext* p_op_kernel_context) const {
-  return ComputeImplOpset11(p_op_kernel_context, axis_, largest_, sorted_);
+  return ComputeImplOpset11<int64_t>(p_op_kernel_context, axis_, largest_, sorted_);
 }
 
 // Register necessary kernels
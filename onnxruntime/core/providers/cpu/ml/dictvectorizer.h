@@ -2,10 +2,13 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
+#include <map>
 #include <string>
 #include <vector>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/ml/flat_hash_map.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -16,24 +19,42 @@ class DictVectorizerOp final : public OpKernel {
     //In some stupid models, the vocabulary could have duplicated elements.
     //We must support that, otherwise some tests will be break.
     ORT_ENFORCE(info.GetAttrs(std::is_same<AttrType, std::string>::value ? "string_vocabulary" : "int64_vocabulary", vocabulary_).IsOK());
+
+    // positions_ gives the first position of a key, next_position_ the following positions of a duplicated key
+    positions_.Reserve(vocabulary_.size());
+    next_position_.assign(vocabulary_.size(), -1);
+    for (size_t i = vocabulary_.size(); i-- > 0;) {
+      const int64_t* next = positions_.Find(vocabulary_[i]);
+      if (next != nullptr) {
+        next_position_[i] = *next;
+      }
+      positions_.Insert(vocabulary_[i], static_cast<int64_t>(i));
+    }
   }
   common::Status Compute(OpKernelContext* ctx) const override {
     auto map = ctx->Input<std::map<AttrType, TargetType> >(0);
     auto Y = ctx->Output(0, TensorShape({1, static_cast<int64_t>(vocabulary_.size())}));
     auto* y_data = Y->template MutableData<TargetType>();
-    for (size_t i = 0, end = vocabulary_.size(); i < end; ++i) {
-      auto index = map->find(vocabulary_[i]);
-      if (index != map->end()) {
-        *y_data++ = index->second;
-      } else {
-        //Any keys not present in the input dictionary, will be zero in the output array
-        *y_data++ = TargetType();
+    //Any keys not present in the input dictionary, will be zero in the output array
+    std::fill_n(y_data, vocabulary_.size(), TargetType());
+    // the input usually holds far fewer keys than the vocabulary, so look its keys up rather than the vocabulary
+    for (const auto& entry : *map) {
+      const int64_t* position = positions_.Find(entry.first);
+      if (position == nullptr) {
+        continue;
+      }
+      for (int64_t i = *position; i >= 0; i = next_position_[i]) {
+        y_data[i] = entry.second;
       }
     }
     return Status::OK();
   }
 
   std::vector<AttrType> vocabulary_;
+
+ private:
+  FlatHashMap<AttrType, int64_t> positions_;
+  std::vector<int64_t> next_position_;
 };
 
 }  // namespace ml
@@ -0,0 +1,165 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/utils.h"
+
+namespace onnxruntime {
+namespace ml {
+
+// Hash table for the keys given by the attributes of a kernel, filled when the kernel is created and only read by
+// Compute. It uses open addressing with linear probing over a power of two array of slots. A slot holds the index of
+// its entry and a tag taken from the hash of the key, so most mismatching slots are skipped without comparing keys.
+// Keys compare with operator== like in std::unordered_map: -0.f finds 0.f and a NaN key is never found.
+template <typename TKey, typename TValue>
+class FlatHashMap {
+ public:
+  // Makes room for count keys so inserting them doesn't rehash the table.
+  void Reserve(size_t count) {
+    size_t slot_count = kMinSlots;
+    while (slot_count < count * 2) {
+      slot_count *= 2;
+    }
+    if (slot_count > slots_.size()) {
+      Rehash(slot_count);
+    }
+    keys_.reserve(count);
+    values_.reserve(count);
+    hashes_.reserve(count);
+  }
+
+  // Inserting a key already in the map replaces its value.
+  void Insert(const TKey& key, const TValue& value) {
+    if ((keys_.size() + 1) * 2 > slots_.size()) {
+      Rehash(slots_.empty() ? kMinSlots : slots_.size() * 2);
+    }
+    const uint64_t hash = Hash(key);
+    const uint32_t tag = Tag(hash);
+    for (size_t slot = SlotOf(hash);; slot = (slot + 1) & mask_) {
+      Slot& s = slots_[slot];
+      if (s.index == kEmptySlot) {
+        ORT_ENFORCE(keys_.size() < kEmptySlot, "Too many keys in the lookup table.");
+        s.tag = tag;
+        s.index = static_cast<uint32_t>(keys_.size());
+        keys_.push_back(key);
+        values_.push_back(value);
+        hashes_.push_back(hash);
+        return;
+      }
+      if (s.tag == tag && keys_[s.index] == key) {
+        values_[s.index] = value;
+        return;
+      }
+    }
+  }
+
+  // Returns nullptr if key is not in the map.
+  const TValue* Find(const TKey& key) const {
+    return keys_.empty() ? nullptr : FindHashed(key, Hash(key));
+  }
+
+  // Writes the value of each of the count keys to values, or default_value for the keys not in the map. The keys are
+  // hashed and their slots prefetched kLookupBatch at a time, so the cache misses of a large table overlap.
+  void FindAll(const TKey* keys, size_t count, const TValue& default_value, TValue* values) const {
+    if (keys_.empty()) {
+      std::fill_n(values, count, default_value);
+      return;
+    }
+    uint64_t hashes[kLookupBatch];
+    for (size_t first = 0; first < count; first += kLookupBatch) {
+      const size_t batch = count - first < kLookupBatch ? count - first : kLookupBatch;
+      for (size_t i = 0; i < batch; ++i) {
+        hashes[i] = Hash(keys[first + i]);
+        PrefetchCacheLine(&slots_[SlotOf(hashes[i])]);
+      }
+      for (size_t i = 0; i < batch; ++i) {
+        const TValue* value = FindHashed(keys[first + i], hashes[i]);
+        values[first + i] = value == nullptr ? default_value : *value;
+      }
+    }
+  }
+
+  // FindAll split across the threads of tp.
+  void FindAll(const TKey* keys, int64_t count, const TValue& default_value, TValue* values,
+               concurrency::ThreadPool* tp) const {
+    // a lookup hashes the key and reads one or two cache lines of the table, about the cost of a short string hash
+    const concurrency::TensorOpCost cost{static_cast<double>(sizeof(TKey)), static_cast<double>(sizeof(TValue)),
+                                         kLookupCycles};
+    concurrency::ThreadPool::TryParallelFor(tp, count, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      FindAll(keys + first, static_cast<size_t>(last - first), default_value, values + first);
+    });
+  }
+
+  size_t Size() const { return keys_.size(); }
+
+ private:
+  struct Slot {
+    uint32_t tag;
+    uint32_t index;
+  };
+
+  static constexpr uint32_t kEmptySlot = std::numeric_limits<uint32_t>::max();
+  static constexpr size_t kMinSlots = 16;
+  static constexpr size_t kLookupBatch = 16;
+  static constexpr double kLookupCycles = 64.0;
+
+  static uint64_t Hash(const TKey& key) {
+    // std::hash of an integer is usually the integer itself, the multiplication mixes it into the high bits which
+    // pick the slot
+    return static_cast<uint64_t>(std::hash<TKey>()(key)) * 0x9E3779B97F4A7C15ull;
+  }
+
+  static uint32_t Tag(uint64_t hash) { return static_cast<uint32_t>(hash); }
+
+  size_t SlotOf(uint64_t hash) const { return static_cast<size_t>(hash >> shift_); }
+
+  const TValue* FindHashed(const TKey& key, uint64_t hash) const {
+    const uint32_t tag = Tag(hash);
+    for (size_t slot = SlotOf(hash);; slot = (slot + 1) & mask_) {
+      const Slot& s = slots_[slot];
+      if (s.index == kEmptySlot) {
+        return nullptr;
+      }
+      if (s.tag == tag && keys_[s.index] == key) {
+        return &values_[s.index];
+      }
+    }
+  }
+
+  void Rehash(size_t slot_count) {
+    slots_.assign(slot_count, Slot{0, kEmptySlot});
+    mask_ = slot_count - 1;
+    shift_ = 64;
+    for (size_t n = slot_count; n > 1; n >>= 1) {
+      --shift_;
+    }
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      size_t slot = SlotOf(hashes_[i]);
+      while (slots_[slot].index != kEmptySlot) {
+        slot = (slot + 1) & mask_;
+      }
+      slots_[slot] = Slot{Tag(hashes_[i]), static_cast<uint32_t>(i)};
+    }
+  }
+
+  std::vector<Slot> slots_;
+  size_t mask_ = 0;
+  int shift_ = 64;
+
+  // the entries in insertion order, indexed by the slots
+  std::vector<TKey> keys_;
+  std::vector<TValue> values_;
+  std::vector<uint64_t> hashes_;
+};
+
+}  // namespace ml
+}  // namespace onnxruntime
@@ -2,8 +2,6 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/label_encoder.h"
-#include <algorithm>
-#include <gsl/gsl>
 using namespace ::onnxruntime::common;
 
 namespace onnxruntime {
@@ -28,39 +26,19 @@ Status LabelEncoder::Compute(OpKernelContext* context) const {
   const TensorShape& shape = X.Shape();
   Tensor& Y = *context->Output(0, TensorShape(shape));
 
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
   if (X.IsDataTypeString()) {
     if (!Y.IsDataType<int64_t>())
       return Status(ONNXRUNTIME, FAIL, "Input of tensor(string) must have output of tensor(int64)");
 
-    auto input = gsl::make_span(X.template Data<std::string>(), shape.Size());
-    auto output = gsl::make_span(Y.template MutableData<int64_t>(), shape.Size());
-    auto out = output.begin();
-
-    // map isn't going to change so get end() once instead of calling inside the for_each loop
-    const auto map_end = string_to_int_map_.end();
-
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const std::string& value) {
-                    auto map_to = string_to_int_map_.find(value);
-                    *out = map_to == map_end ? default_int_ : map_to->second;
-                    ++out;
-                  });
+    string_to_int_map_.FindAll(X.template Data<std::string>(), shape.Size(), default_int_,
+                               Y.template MutableData<int64_t>(), tp);
   } else {
     if (!Y.IsDataTypeString())
       return Status(ONNXRUNTIME, FAIL, "Input of tensor(int64) must have output of tensor(string)");
 
-    auto input = gsl::make_span(X.template Data<int64_t>(), shape.Size());
-    auto output = gsl::make_span(Y.template MutableData<std::string>(), shape.Size());
-    auto out = output.begin();
-
-    const auto map_end = int_to_string_map_.end();
-
-    std::for_each(input.cbegin(), input.cend(),
-                  [&out, &map_end, this](const int64_t& value) {
-                    auto map_to = int_to_string_map_.find(value);
-                    *out = map_to == map_end ? default_string_ : map_to->second;
-                    ++out;
-                  });
+    int_to_string_map_.FindAll(X.template Data<int64_t>(), shape.Size(), default_string_,
+                               Y.template MutableData<std::string>(), tp);
   }
 
   return Status::OK();
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/linearclassifier.h"
+#include "core/util/math.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -63,6 +64,11 @@ Status LinearClassifier<T>::Compute(OpKernelContext* ctx) const {
 
   int64_t stride = shape.NumDimensions() == 1 ? shape[0] : shape[1];
   int64_t N = shape.NumDimensions() == 1 ? 1 : shape[0];
+  if (coefficients_.size() < static_cast<size_t>(class_count_ * stride)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input has ", stride, " features but the model has ",
+                           coefficients_.size(), " coefficients for ", class_count_, " classes");
+  }
+
   Tensor* Y = ctx->Output(0, TensorShape({N}));
 
   int64_t output_classes = class_count_;
@@ -73,79 +79,101 @@ Status LinearClassifier<T>::Compute(OpKernelContext* ctx) const {
   }
   Tensor* Z = ctx->Output(1, TensorShape({N, output_classes}));
 
-  int64_t zindex = 0;
+  // with two or more classes the scores are computed in place in Z, one column per class.
+  // A single binary score goes through write_scores, which may add the second class.
+  const bool scores_in_z = class_count_ >= 2;
+  const int64_t scores_per_row = add_second_class && post_transform_ != POST_EVAL_TRANSFORM::PROBIT ? 2 : 1;
   const auto* x_data = X->template Data<T>();
+  float* z_data = Z->template MutableData<float>();
 
-  auto class_count = static_cast<size_t>(class_count_);
-  std::vector<float> scores;
-  scores.reserve(class_count);
-  for (int64_t i = 0; i < N; i++)  //for each point
-  {
-    scores.clear();
-    size_t current_weight_0 = i * stride;
-    int maxclass = -1;
-    float maxweight = 0.f;
-    for (int j = 0; j < class_count_; j++)  // for each class
-    {
-      size_t current_coeff_0 = j * stride;
-      float weight = 0.f;
-      for (int64_t k = 0; k < stride; k++)  //for each weight
-      {
-        weight += static_cast<float>(x_data[current_weight_0 + k] * coefficients_[current_coeff_0 + k]);
-      }
-      if (intercepts_.size() == class_count) {
-        weight += intercepts_[j];
+  auto compute_rows = [&](int64_t first, int64_t last, concurrency::ThreadPool* gemm_tp) {
+    std::vector<float> x_buffer;
+    std::vector<float> buffer;
+    std::vector<float> scores;
+    for (int64_t block = first; block < last; block += kGemmRowsPerBlock) {
+      const int64_t rows = std::min(kGemmRowsPerBlock, last - block);
+      int64_t lda;
+      const float* x = rows_as_float(x_data + block * stride, rows, stride, stride, x_buffer, lda);
+      if (!scores_in_z) {
+        buffer.resize(rows * class_count_);
       }
-      scores.push_back(weight);
-      if (weight > maxweight || maxclass == -1) {
-        maxweight = weight;
-        maxclass = j;
+      float* block_scores = scores_in_z ? z_data + block * class_count_ : buffer.data();
+
+      // start from the intercepts and accumulate every class's weights onto them
+      for (int64_t r = 0; r < rows; ++r) {
+        std::copy(intercepts_.begin(), intercepts_.end(), block_scores + r * class_count_);
       }
-    }
-    //write top class
-    if (intercepts_.size() == 1)  //binary
-    {
-      if (using_strings_) {
-        if (classlabels_strings_.size() == 2 && maxweight > 0) {
-          Y->template MutableData<std::string>()[i] = classlabels_strings_[1];  //positive label
-        } else if (classlabels_strings_.size() == 2) {
-          Y->template MutableData<std::string>()[i] = classlabels_strings_[0];  //negative label
-        } else if (maxweight > 0) {
-          Y->template MutableData<std::string>()[i] = "1";  //positive label
-        } else {
-          Y->template MutableData<std::string>()[i] = "0";  //negative label
+      math::GemmEx<float>(CblasNoTrans, CblasTrans, static_cast<int>(rows), static_cast<int>(class_count_),
+                          static_cast<int>(stride), 1.f, x, static_cast<int>(lda), coefficients_.data(),
+                          static_cast<int>(stride), 1.f, block_scores, static_cast<int>(class_count_), gemm_tp);
+
+      for (int64_t r = 0; r < rows; ++r) {
+        const int64_t i = block + r;
+        const float* row = block_scores + r * class_count_;
+        int maxclass = -1;
+        float maxweight = 0.f;
+        for (int j = 0; j < class_count_; j++) {  // for each class
+          if (row[j] > maxweight || maxclass == -1) {
+            maxweight = row[j];
+            maxclass = j;
+          }
         }
-      } else  //no strings
-      {
-        if (classlabels_ints_.size() == 2 && maxweight > 0) {
-          Y->template MutableData<int64_t>()[i] = classlabels_ints_[1];  //positive label
-        } else if (classlabels_ints_.size() == 2) {
-          Y->template MutableData<int64_t>()[i] = classlabels_ints_[0];  //negative label
-        } else if (maxweight > 0) {
-          Y->template MutableData<int64_t>()[i] = 1;  //positive label
-        } else {
-          Y->template MutableData<int64_t>()[i] = 0;  //negative label
+        WriteLabel(Y, i, maxclass, maxweight);
+
+        if (!scores_in_z) {
+          scores.assign(row, row + class_count_);
+          ::onnxruntime::ml::write_scores(scores, post_transform_, i * scores_per_row, Z,
+                                          add_second_class ? (maxweight > 0 ? 0 : 1) : -1);
         }
       }
-    } else  //multiclass
+
+      if (scores_in_z) {
+        batched_post_transform(block_scores, rows, class_count_, post_transform_);
+      }
+    }
+  };
+
+  const concurrency::TensorOpCost row_cost{static_cast<double>(stride * sizeof(T)),
+                                           static_cast<double>(output_classes * sizeof(float)),
+                                           static_cast<double>(class_count_ * stride * 2)};
+  parallel_for_row_blocks(ctx->GetOperatorThreadPool(), N, row_cost, compute_rows);
+  return Status::OK();
+}
+
+template <typename T>
+void LinearClassifier<T>::WriteLabel(Tensor* Y, int64_t i, int maxclass, float maxweight) const {
+  if (intercepts_.size() == 1)  //binary
+  {
+    if (using_strings_) {
+      if (classlabels_strings_.size() == 2 && maxweight > 0) {
+        Y->template MutableData<std::string>()[i] = classlabels_strings_[1];  //positive label
+      } else if (classlabels_strings_.size() == 2) {
+        Y->template MutableData<std::string>()[i] = classlabels_strings_[0];  //negative label
+      } else if (maxweight > 0) {
+        Y->template MutableData<std::string>()[i] = "1";  //positive label
+      } else {
+        Y->template MutableData<std::string>()[i] = "0";  //negative label
+      }
+    } else  //no strings
     {
-      if (using_strings_) {
-        Y->template MutableData<std::string>()[i] = classlabels_strings_[maxclass];
+      if (classlabels_ints_.size() == 2 && maxweight > 0) {
+        Y->template MutableData<int64_t>()[i] = classlabels_ints_[1];  //positive label
+      } else if (classlabels_ints_.size() == 2) {
+        Y->template MutableData<int64_t>()[i] = classlabels_ints_[0];  //negative label
+      } else if (maxweight > 0) {
+        Y->template MutableData<int64_t>()[i] = 1;  //positive label
       } else {
-        Y->template MutableData<int64_t>()[i] = classlabels_ints_[maxclass];
+        Y->template MutableData<int64_t>()[i] = 0;  //negative label
       }
     }
-    //write float values
-    if (add_second_class && maxweight > 0) {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, 0);
-    } else if (add_second_class) {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, 1);
+  } else  //multiclass
+  {
+    if (using_strings_) {
+      Y->template MutableData<std::string>()[i] = classlabels_strings_[maxclass];
     } else {
-      ::onnxruntime::ml::write_scores(scores, post_transform_, zindex, Z, -1);
+      Y->template MutableData<int64_t>()[i] = classlabels_ints_[maxclass];
     }
-    zindex += scores.size();
-  }  //for each point
-  return Status::OK();
+  }
 }
 
 }  // namespace ml
@@ -18,6 +18,8 @@ class LinearClassifier final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  void WriteLabel(Tensor* Y, int64_t i, int maxclass, float maxweight) const;
+
   int64_t multi_class_;
   int64_t class_count_;
   POST_EVAL_TRANSFORM post_transform_;
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/linearregressor.h"
+#include "core/util/math.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -30,31 +31,36 @@ Status LinearRegressor<float>::Compute(OpKernelContext* ctx) const {
 
   int64_t stride = X->Shape().NumDimensions() == 1 ? X->Shape()[0] : X->Shape()[1];
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
+  if (coefficients_.size() < static_cast<size_t>(targets_ * stride)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input has ", stride, " features but the model has ",
+                           coefficients_.size(), " coefficients for ", targets_, " targets");
+  }
   Tensor* Y = ctx->Output(0, TensorShape({N, targets_}));
   const auto* Xdata = X->template Data<float>();
-  int64_t yindex = 0;
+  float* Ydata = Y->template MutableData<float>();
 
   bool useIntercepts = intercepts_.size() == static_cast<size_t>(targets_);
-  for (int64_t i = 0; i < N; i++)  //for each point
-  {
-    std::vector<float> scores;
-    int64_t current_weight_0 = i * stride;
-    for (int j = 0; j < targets_; j++)  //for each target
-    {
-      int64_t current_coeff_0 = j * stride;
-      float weight = 0.f;
-      for (int64_t k = 0; k < stride; k++)  //for each weight
-      {
-        weight = weight + Xdata[current_weight_0 + k] * coefficients_[current_coeff_0 + k];
-      }
+  auto compute_rows = [&](int64_t first, int64_t last, concurrency::ThreadPool* gemm_tp) {
+    for (int64_t block = first; block < last; block += kGemmRowsPerBlock) {
+      const int64_t rows = std::min(kGemmRowsPerBlock, last - block);
+      float* scores = Ydata + block * targets_;
       if (useIntercepts) {
-        weight = weight + intercepts_[j];
+        for (int64_t r = 0; r < rows; ++r) {
+          std::copy(intercepts_.begin(), intercepts_.end(), scores + r * targets_);
+        }
       }
-      scores.push_back(weight);
+      math::GemmEx<float>(CblasNoTrans, CblasTrans, static_cast<int>(rows), static_cast<int>(targets_),
+                          static_cast<int>(stride), 1.f, Xdata + block * stride, static_cast<int>(stride),
+                          coefficients_.data(), static_cast<int>(stride), useIntercepts ? 1.f : 0.f, scores,
+                          static_cast<int>(targets_), gemm_tp);
+      batched_post_transform(scores, rows, targets_, post_transform_);
     }
-    ::onnxruntime::ml::write_scores(scores, post_transform_, yindex, Y, -1);
-    yindex += scores.size();
-  }
+  };
+
+  const concurrency::TensorOpCost row_cost{static_cast<double>(stride * sizeof(float)),
+                                           static_cast<double>(targets_ * sizeof(float)),
+                                           static_cast<double>(targets_ * stride * 2)};
+  parallel_for_row_blocks(ctx->GetOperatorThreadPool(), N, row_cost, compute_rows);
   return Status::OK();
 }
 
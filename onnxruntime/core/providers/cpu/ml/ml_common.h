@@ -4,6 +4,8 @@
 #pragma once
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -267,16 +269,17 @@ static inline void ComputeSoftmax(std::vector<float>& values) {
 }
 
 //this function skips zero values (since exp(0) is non zero)
-static inline void ComputeSoftmaxZero(std::vector<float>& values) {
+static inline void ComputeSoftmaxZero(float* values, size_t count) {
   // compute exp with negative number to be numerically stable
   float v_max = -std::numeric_limits<float>::max();
-  for (float value : values) {
-    if (value > v_max)
-      v_max = value;
+  for (size_t i = 0; i < count; ++i) {
+    if (values[i] > v_max)
+      v_max = values[i];
   }
   float exp_neg_v_max = std::exp(-v_max);
   float this_sum = 0.f;
-  for (float& value : values) {
+  for (size_t i = 0; i < count; ++i) {
+    float& value = values[i];
     if (value > 0.0000001f || value < -0.0000001f) {
       value = std::exp(value - v_max);
       this_sum += value;
@@ -284,8 +287,12 @@ static inline void ComputeSoftmaxZero(std::vector<float>& values) {
       value *= exp_neg_v_max;
     }
   }
-  for (float& value : values)
-    value /= this_sum;
+  for (size_t i = 0; i < count; ++i)
+    values[i] /= this_sum;
+}
+
+static inline void ComputeSoftmaxZero(std::vector<float>& values) {
+  ComputeSoftmaxZero(values.data(), values.size());
 }
 
 template <typename T>
@@ -349,5 +356,71 @@ void write_scores(std::vector<T>& scores, POST_EVAL_TRANSFORM post_transform, in
   memcpy(out_p, scores.data(), len);
 }
 
+// Applies post_transform in place to rows of count scores, as write_scores does for a row without
+// an added second class: a single score is only transformed by PROBIT.
+static inline void batched_post_transform(float* scores, int64_t rows, int64_t count,
+                                          POST_EVAL_TRANSFORM post_transform) {
+  if (count == 1 && post_transform != POST_EVAL_TRANSFORM::PROBIT) {
+    return;
+  }
+  const size_t total = static_cast<size_t>(rows * count);
+  switch (post_transform) {
+    case POST_EVAL_TRANSFORM::PROBIT:
+      for (size_t i = 0; i < total; ++i)
+        scores[i] = ComputeProbit(scores[i]);
+      break;
+    case POST_EVAL_TRANSFORM::LOGISTIC:
+      MlasComputeLogistic(scores, scores, total);
+      break;
+    case POST_EVAL_TRANSFORM::SOFTMAX:
+      MlasComputeSoftmax(scores, scores, static_cast<size_t>(rows), static_cast<size_t>(count), false, nullptr);
+      break;
+    case POST_EVAL_TRANSFORM::SOFTMAX_ZERO:
+      for (int64_t r = 0; r < rows; ++r)
+        ComputeSoftmaxZero(scores + r * count, static_cast<size_t>(count));
+      break;
+    default:
+    case POST_EVAL_TRANSFORM::NONE:
+      break;
+  }
+}
+
+// Returns rows of x (row stride `stride`) as floats with leading dimension ld. The first len values
+// of each row are converted into buffer unless x already holds floats.
+template <typename T>
+static inline const float* rows_as_float(const T* x, int64_t rows, int64_t stride, int64_t len,
+                                         std::vector<float>& buffer, int64_t& ld) {
+  buffer.resize(rows * len);
+  for (int64_t i = 0; i < rows; ++i) {
+    std::transform(x + i * stride, x + i * stride + len, buffer.data() + i * len,
+                   [](T v) { return static_cast<float>(v); });
+  }
+  ld = len;
+  return buffer.data();
+}
+
+static inline const float* rows_as_float(const float* x, int64_t, int64_t stride, int64_t,
+                                         std::vector<float>&, int64_t& ld) {
+  ld = stride;
+  return x;
+}
+
+// rows of a batch that the linear and SVM kernels score with one GEMM
+constexpr int64_t kGemmRowsPerBlock = 32;
+
+// Calls fn(first, last, gemm_tp) over the N rows of a batch. A batch that fits in one block lets its
+// GEMM use tp, larger batches split their rows across tp instead.
+template <typename F>
+void parallel_for_row_blocks(concurrency::ThreadPool* tp, int64_t N, const concurrency::TensorOpCost& row_cost,
+                             F&& fn) {
+  if (N <= kGemmRowsPerBlock) {
+    fn(0, N, tp);
+  } else {
+    concurrency::ThreadPool::TryParallelFor(tp, N, row_cost, [&fn](std::ptrdiff_t first, std::ptrdiff_t last) {
+      fn(first, last, nullptr);
+    });
+  }
+}
+
 }  // namespace ml
 }  // namespace onnxruntime
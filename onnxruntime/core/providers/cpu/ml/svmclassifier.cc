@@ -66,6 +66,9 @@ SVMClassifier<T>::SVMClassifier(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.size() > 0 || classlabels_ints_.size() > 0);
   ORT_ENFORCE(proba_.size() == probb_.size());
   ORT_ENFORCE(coefficients_.size() > 0);
+  if (mode_ == SVM_TYPE::SVM_SVC && get_kernel_type() == KERNEL::RBF) {
+    support_vector_norms_ = squared_norms(support_vectors_, vector_count_, feature_count_);
+  }
   weights_are_all_positive_ = true;
   for (int64_t i = 0; i < static_cast<int64_t>(coefficients_.size()); i++) {
     if (coefficients_[i] < 0) {
@@ -107,6 +110,10 @@ Status SVMClassifier<T>::Compute(OpKernelContext* ctx) const {
 
   int64_t stride = X->Shape().NumDimensions() == 1 ? X->Shape()[0] : X->Shape()[1];
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
+  if (stride < feature_count_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input has ", stride, " features but the model expects ",
+                           feature_count_);
+  }
 
   Tensor* Y = ctx->Output(0, TensorShape({N}));
 
@@ -121,126 +128,151 @@ Status SVMClassifier<T>::Compute(OpKernelContext* ctx) const {
   std::vector<int64_t> dims{N, nb_columns};
   Tensor* Z = ctx->Output(1, TensorShape(dims));
 
+  // every row writes the same number of scores. write_scores adds a second column to a single
+  // binary score unless the transform is PROBIT.
+  int64_t scores_per_row = mode_ == SVM_TYPE::SVM_SVC && proba_.empty()
+                               ? class_count_ * (class_count_ - 1) / 2
+                               : class_count_;
+  const size_t label_count = using_strings_ ? classlabels_strings_.size() : classlabels_ints_.size();
+  if (scores_per_row == 1 && rho_.size() == 1 && label_count == 2 &&
+      post_transform_ != POST_EVAL_TRANSFORM::PROBIT) {
+    scores_per_row = 2;
+  }
+
+  // the liblinear mode scores a row with one dot product per class
+  const bool linear = mode_ == SVM_TYPE::SVM_LINEAR;
+  const int64_t kernel_count = linear ? class_count_ : vector_count_;
+  const std::vector<float>& vectors = linear ? coefficients_ : support_vectors_;
   const T* x_data = X->template Data<T>();
-  int64_t zindex = 0;
 
-  for (int64_t n = 0; n < N; n++)  //for each example
-  {
-    int64_t current_weight_0 = n * stride;
-    int64_t maxclass = -1;
-    std::vector<float> decisions;
-    std::vector<float> scores;
+  auto compute_rows = [&](int64_t first, int64_t last, concurrency::ThreadPool* gemm_tp) {
+    std::vector<float> x_buffer;
     std::vector<float> kernels;
+    std::vector<float> scores;
     std::vector<int64_t> votes;
-
-    if (vector_count_ == 0 && mode_ == SVM_TYPE::SVM_LINEAR) {
-      for (int64_t j = 0; j < class_count_; j++) {  //for each class
-        auto val = kernel_dot(x_data, current_weight_0, coefficients_, feature_count_ * j,
-                              feature_count_, get_kernel_type());
-        val += rho_[0];
-        scores.push_back(val);
-      }
-    } else {
-      if (vector_count_ == 0)
-        return Status(common::ONNXRUNTIME, common::FAIL, "No support vectors.");
-      int evals = 0;
-
-      for (int64_t j = 0; j < vector_count_; j++) {
-        auto val = kernel_dot(x_data, current_weight_0, support_vectors_, feature_count_ * j,
-                              feature_count_, get_kernel_type());
-        kernels.push_back(val);
-      }
-      votes.resize(class_count_, 0);
-      for (int64_t i = 0; i < class_count_; i++) {        // for each class
-        for (int64_t j = i + 1; j < class_count_; j++) {  // for each class
-          double sum = 0;
-          int64_t start_index_i = starting_vector_[i];  // *feature_count_;
-          int64_t start_index_j = starting_vector_[j];  // *feature_count_;
-
-          int64_t class_i_support_count = vectors_per_class_[i];
-          int64_t class_j_support_count = vectors_per_class_[j];
-
-          int64_t pos1 = (vector_count_) * (j - 1);
-          int64_t pos2 = (vector_count_) * (i);
-          const float* val1 = &(coefficients_[pos1 + start_index_i]);
-          const float* val2 = &(kernels[start_index_i]);
-          for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          val1 = &(coefficients_[pos2 + start_index_j]);
-          val2 = &(kernels[start_index_j]);
-          for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          sum += rho_[evals];
-          scores.push_back((float)sum);
-          ++(votes[sum > 0 ? i : j]);
-          ++evals;  //index into rho
-        }
+    for (int64_t block = first; block < last; block += kGemmRowsPerBlock) {
+      const int64_t rows = std::min(kGemmRowsPerBlock, last - block);
+      int64_t lda;
+      const float* x = rows_as_float(x_data + block * stride, rows, stride, feature_count_, x_buffer, lda);
+      kernels.resize(rows * kernel_count);
+      batched_kernel_dot(x, rows, lda, vectors, kernel_count, feature_count_, support_vector_norms_,
+                         get_kernel_type(), kernels.data(), gemm_tp);
+      for (int64_t r = 0; r < rows; ++r) {
+        ComputeRow(block + r, kernels.data() + r * kernel_count, scores_per_row, scores, votes, Y, Z);
       }
     }
+  };
 
-    if (proba_.size() > 0 && mode_ == SVM_TYPE::SVM_SVC) {
-      //compute probabilities from the scores
-      int64_t num = class_count_ * class_count_;
-      std::vector<float> probsp2(num, 0.f);
-      std::vector<float> estimates(class_count_, 0.f);
-      int64_t index = 0;
-      for (int64_t i = 0; i < class_count_; ++i) {
-        int64_t p1 = i * class_count_ + i + 1;
-        int64_t p2 = (i + 1) * class_count_ + i;
-        for (int64_t j = i + 1; j < class_count_; ++j, ++index) {
-          float val1 = sigmoid_probability(scores[index], proba_[index], probb_[index]);
-          float val2 = std::max(val1, 1.0e-7f);
-          val2 = std::min(val2, 1 - 1.0e-7f);
-          probsp2[p1] = val2;
-          probsp2[p2] = 1 - val2;
-          ++p1;
-          p2 += class_count_;
-        }
-      }
-      multiclass_probability(class_count_, probsp2, estimates);
-      // copy probabilities back into scores
-      scores.resize(estimates.size());
-      std::copy(estimates.begin(), estimates.end(), scores.begin());
-    }
+  const concurrency::TensorOpCost row_cost{static_cast<double>(feature_count_ * sizeof(T)),
+                                           static_cast<double>(scores_per_row * sizeof(float)),
+                                           static_cast<double>(kernel_count * (feature_count_ + class_count_) * 2)};
+  parallel_for_row_blocks(ctx->GetOperatorThreadPool(), N, row_cost, compute_rows);
 
-    float max_weight = 0;
-    if (votes.size() > 0) {
-      auto it_maxvotes = std::max_element(votes.begin(), votes.end());
-      maxclass = std::distance(votes.begin(), it_maxvotes);
-    } else {
-      auto it_max_weight = std::max_element(scores.begin(), scores.end());
-      maxclass = std::distance(scores.begin(), it_max_weight);
-      max_weight = *it_max_weight;
+  return Status::OK();
+}
+
+template <typename T>
+void SVMClassifier<T>::ComputeRow(int64_t n, const float* kernels, int64_t scores_per_row,
+                                  std::vector<float>& scores, std::vector<int64_t>& votes,
+                                  Tensor* Y, Tensor* Z) const {
+  int64_t maxclass = -1;
+  scores.clear();
+  votes.clear();
+
+  if (mode_ == SVM_TYPE::SVM_LINEAR) {
+    for (int64_t j = 0; j < class_count_; j++) {  //for each class
+      scores.push_back(kernels[j] + rho_[0]);
     }
+  } else {
+    int evals = 0;
+
+    votes.resize(class_count_, 0);
+    for (int64_t i = 0; i < class_count_; i++) {        // for each class
+      for (int64_t j = i + 1; j < class_count_; j++) {  // for each class
+        double sum = 0;
+        int64_t start_index_i = starting_vector_[i];  // *feature_count_;
+        int64_t start_index_j = starting_vector_[j];  // *feature_count_;
+
+        int64_t class_i_support_count = vectors_per_class_[i];
+        int64_t class_j_support_count = vectors_per_class_[j];
+
+        int64_t pos1 = (vector_count_) * (j - 1);
+        int64_t pos2 = (vector_count_) * (i);
+        const float* val1 = &(coefficients_[pos1 + start_index_i]);
+        const float* val2 = kernels + start_index_i;
+        for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
+          sum += *val1 * *val2;
+
+        val1 = &(coefficients_[pos2 + start_index_j]);
+        val2 = kernels + start_index_j;
+        for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
+          sum += *val1 * *val2;
 
-    // write top class
-    // onnx specs expects one column per class.
-    int write_additional_scores = -1;
-    if (rho_.size() == 1) {
-      if (using_strings_) {
-        write_additional_scores = _set_score_svm<std::string>(
-            Y, max_weight, maxclass, n, post_transform_, proba_,
-            weights_are_all_positive_, classlabels_strings_, "1", "0");
-      } else {
-        write_additional_scores = _set_score_svm<int64_t>(
-            Y, max_weight, maxclass, n, post_transform_, proba_,
-            weights_are_all_positive_, classlabels_ints_, 1, 0);
+        sum += rho_[evals];
+        scores.push_back((float)sum);
+        ++(votes[sum > 0 ? i : j]);
+        ++evals;  //index into rho
       }
-    } else {  //multiclass
-      if (using_strings_) {
-        Y->template MutableData<std::string>()[n] = classlabels_strings_[maxclass];
-      } else {
-        Y->template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];
+    }
+  }
+
+  if (proba_.size() > 0 && mode_ == SVM_TYPE::SVM_SVC) {
+    //compute probabilities from the scores
+    int64_t num = class_count_ * class_count_;
+    std::vector<float> probsp2(num, 0.f);
+    std::vector<float> estimates(class_count_, 0.f);
+    int64_t index = 0;
+    for (int64_t i = 0; i < class_count_; ++i) {
+      int64_t p1 = i * class_count_ + i + 1;
+      int64_t p2 = (i + 1) * class_count_ + i;
+      for (int64_t j = i + 1; j < class_count_; ++j, ++index) {
+        float val1 = sigmoid_probability(scores[index], proba_[index], probb_[index]);
+        float val2 = std::max(val1, 1.0e-7f);
+        val2 = std::min(val2, 1 - 1.0e-7f);
+        probsp2[p1] = val2;
+        probsp2[p2] = 1 - val2;
+        ++p1;
+        p2 += class_count_;
       }
     }
+    multiclass_probability(class_count_, probsp2, estimates);
+    // copy probabilities back into scores
+    scores.resize(estimates.size());
+    std::copy(estimates.begin(), estimates.end(), scores.begin());
+  }
 
-    write_scores(scores, post_transform_, zindex, Z, write_additional_scores);
-    zindex += scores.size();
+  float max_weight = 0;
+  if (votes.size() > 0) {
+    auto it_maxvotes = std::max_element(votes.begin(), votes.end());
+    maxclass = std::distance(votes.begin(), it_maxvotes);
+  } else {
+    auto it_max_weight = std::max_element(scores.begin(), scores.end());
+    maxclass = std::distance(scores.begin(), it_max_weight);
+    max_weight = *it_max_weight;
   }
 
-  return Status::OK();
+  // write top class
+  // onnx specs expects one column per class.
+  int write_additional_scores = -1;
+  if (rho_.size() == 1) {
+    if (using_strings_) {
+      write_additional_scores = _set_score_svm<std::string>(
+          Y, max_weight, maxclass, n, post_transform_, proba_,
+          weights_are_all_positive_, classlabels_strings_, "1", "0");
+    } else {
+      write_additional_scores = _set_score_svm<int64_t>(
+          Y, max_weight, maxclass, n, post_transform_, proba_,
+          weights_are_all_positive_, classlabels_ints_, 1, 0);
+    }
+  } else {  //multiclass
+    if (using_strings_) {
+      Y->template MutableData<std::string>()[n] = classlabels_strings_[maxclass];
+    } else {
+      Y->template MutableData<int64_t>()[n] = classlabels_ints_[maxclass];
+    }
+  }
+
+  write_scores(scores, post_transform_, n * scores_per_row, Z, write_additional_scores);
 }
 
 }  // namespace ml
@@ -5,6 +5,8 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "ml_common.h"
 
@@ -29,34 +31,73 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
-  float kernel_dot(const T* A, int64_t a, const std::vector<float>& B, int64_t b, int64_t len, KERNEL k) const {
-    double sum = 0;
-    const T* pA = A + a;
-    const float* pB = B.data() + b;
+  // squared L2 norm of each of the count vectors of len values, used to expand the RBF distance. Accumulated in
+  // double like the direct distance so large features don't lose precision.
+  static std::vector<double> squared_norms(const std::vector<float>& vectors, int64_t count, int64_t len) {
+    std::vector<double> norms(count);
+    for (int64_t i = 0; i < count; ++i) {
+      norms[i] = squared_norm(vectors.data() + i * len, len);
+    }
+    return norms;
+  }
+
+  // Writes the kernel between row r of A and vector j of B to out[r * count + j].
+  // All the dot products are one GEMM, then the kernel function is applied to the whole block.
+  // b_norms holds the squared norms of the vectors of B and is only read by the RBF kernel.
+  void batched_kernel_dot(const float* A, int64_t rows, int64_t lda, const std::vector<float>& B, int64_t count,
+                          int64_t len, const std::vector<double>& b_norms, KERNEL k, float* out,
+                          concurrency::ThreadPool* tp) const {
+    math::GemmEx<float>(CblasNoTrans, CblasTrans, static_cast<int>(rows), static_cast<int>(count),
+                        static_cast<int>(len), k == KERNEL::RBF ? -2.f : 1.f, A, static_cast<int>(lda),
+                        B.data(), static_cast<int>(len), 0.f, out, static_cast<int>(count), tp);
+
+    EigenVectorArrayMap<float> values(out, rows * count);
     if (k == KERNEL::POLY) {
-      for (int64_t i = len; i > 0; --i, ++pA, ++pB)
-        sum += *pA * *pB;
-      sum = gamma_ * sum + coef0_;
-      sum = std::pow(sum, degree_);
+      values = (gamma_ * values + coef0_).pow(degree_);
     } else if (k == KERNEL::SIGMOID) {
-      for (int64_t i = len; i > 0; --i, ++pA, ++pB)
-        sum += *pA * *pB;
-      sum = gamma_ * sum + coef0_;
-      sum = std::tanh(sum);
+      values = (gamma_ * values + coef0_).tanh();
     } else if (k == KERNEL::RBF) {
-      for (int64_t i = len; i > 0; --i, ++pA, ++pB) {
-        double val = *pA - *pB;
-        sum += val * val;
+      // |a - b|^2 = |a|^2 + |b|^2 - 2 a.b. When the distance is small next to the norms (features far from 0 and
+      // close to each other) the subtraction cancels most of the digits of the float dot product, the distance is
+      // then summed directly in double as done without the GEMM.
+      for (int64_t r = 0; r < rows; ++r) {
+        const float* a = A + r * lda;
+        const double a_sq = squared_norm(a, len);
+        float* row = out + r * count;
+        for (int64_t j = 0; j < count; ++j) {
+          const double norms = a_sq + b_norms[j];
+          double distance = norms + row[j];
+          if (distance < norms * kRbfCancellationRatio) {
+            distance = squared_distance(a, B.data() + j * len, len);
+          }
+          row[j] = static_cast<float>(-gamma_ * distance);
+        }
       }
-      sum = std::exp(-gamma_ * sum);
-    } else if (k == KERNEL::LINEAR) {
-      for (int64_t i = len; i > 0; --i, ++pA, ++pB)
-        sum += *pA * *pB;
+      values = values.exp();
     }
-    return (float)sum;
   }
 
  private:
+  // expanded RBF distances below this fraction of |a|^2 + |b|^2 have lost more than 4 bits to cancellation
+  static constexpr double kRbfCancellationRatio = 1.0 / 16;
+
+  static double squared_norm(const float* a, int64_t len) {
+    double sum = 0;
+    for (int64_t i = 0; i < len; ++i) {
+      sum += static_cast<double>(a[i]) * a[i];
+    }
+    return sum;
+  }
+
+  static double squared_distance(const float* a, const float* b, int64_t len) {
+    double sum = 0;
+    for (int64_t i = 0; i < len; ++i) {
+      double val = a[i] - b[i];
+      sum += val * val;
+    }
+    return sum;
+  }
+
   KERNEL kernel_type_;
   float gamma_;
   float coef0_;
@@ -65,7 +106,8 @@ class SVMCommon {
 
 template <typename T>
 class SVMClassifier final : public OpKernel, private SVMCommon<T> {
-  using SVMCommon<T>::kernel_dot;
+  using SVMCommon<T>::batched_kernel_dot;
+  using SVMCommon<T>::squared_norms;
   using SVMCommon<T>::set_kernel_type;
   using SVMCommon<T>::get_kernel_type;
 
@@ -74,6 +116,9 @@ class SVMClassifier final : public OpKernel, private SVMCommon<T> {
   Status Compute(OpKernelContext* context) const override;
 
  private:
+  void ComputeRow(int64_t n, const float* kernels, int64_t scores_per_row, std::vector<float>& scores,
+                  std::vector<int64_t>& votes, Tensor* Y, Tensor* Z) const;
+
   bool weights_are_all_positive_;
   int64_t feature_count_;
   int64_t class_count_;
@@ -86,6 +131,7 @@ class SVMClassifier final : public OpKernel, private SVMCommon<T> {
   std::vector<float> probb_;
   std::vector<float> coefficients_;
   std::vector<float> support_vectors_;
+  std::vector<double> support_vector_norms_;  // squared norms of support_vectors_ for the RBF kernel
   std::vector<int64_t> classlabels_ints_;
   std::vector<std::string> classlabels_strings_;
   POST_EVAL_TRANSFORM post_transform_;
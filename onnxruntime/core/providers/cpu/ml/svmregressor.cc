@@ -34,6 +34,9 @@ SVMRegressor<T>::SVMRegressor(const OpKernelInfo& info)
     mode_ = SVM_TYPE::SVM_LINEAR;
     set_kernel_type(KERNEL::LINEAR);
   }
+  if (mode_ == SVM_TYPE::SVM_SVC && get_kernel_type() == KERNEL::RBF) {
+    support_vector_norms_ = squared_norms(support_vectors_, vector_count_, feature_count_);
+  }
 }
 
 template <typename T>
@@ -43,34 +46,49 @@ Status SVMRegressor<T>::Compute(OpKernelContext* ctx) const {
   int64_t stride = X->Shape().NumDimensions() == 1 ? X->Shape()[0] : X->Shape()[1];
   int64_t N = X->Shape().NumDimensions() == 1 ? 1 : X->Shape()[0];
 
+  if (stride < feature_count_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input has ", stride, " features but the model expects ",
+                           feature_count_);
+  }
+
   Tensor* Y = ctx->Output(0, TensorShape({N, 1}));  // this op outputs for one target only
   const auto* x_data = X->template Data<T>();
+  float* y_data = Y->template MutableData<float>();
 
-  for (int64_t n = 0; n < N; n++) {  //for each example
-    int64_t current_weight_0 = n * stride;
-    std::vector<float> scores;
+  // the liblinear mode is a single dot product with the coefficients
+  const bool svc = mode_ == SVM_TYPE::SVM_SVC;
+  const int64_t kernel_count = svc ? vector_count_ : 1;
+  const std::vector<float>& vectors = svc ? support_vectors_ : coefficients_;
 
-    float sum = 0.f;
-    if (mode_ == SVM_TYPE::SVM_SVC) {
-      for (int64_t j = 0; j < vector_count_; j++) {
-        float val1 = kernel_dot(x_data, current_weight_0, support_vectors_, feature_count_ * j, feature_count_, get_kernel_type());
-        float val2 = coefficients_[j];
-        float val3 = val1 * val2;
-        sum += val3;
+  auto compute_rows = [&](int64_t first, int64_t last, concurrency::ThreadPool* gemm_tp) {
+    std::vector<float> x_buffer;
+    std::vector<float> kernels;
+    for (int64_t block = first; block < last; block += kGemmRowsPerBlock) {
+      const int64_t rows = std::min(kGemmRowsPerBlock, last - block);
+      int64_t lda;
+      const float* x = rows_as_float(x_data + block * stride, rows, stride, feature_count_, x_buffer, lda);
+      kernels.resize(rows * kernel_count);
+      batched_kernel_dot(x, rows, lda, vectors, kernel_count, feature_count_, support_vector_norms_,
+                         get_kernel_type(), kernels.data(), gemm_tp);
+      for (int64_t r = 0; r < rows; ++r) {
+        float sum = svc ? (ConstEigenVectorArrayMap<float>(kernels.data() + r * kernel_count, kernel_count) *
+                           ConstEigenVectorArrayMap<float>(coefficients_.data(), kernel_count))
+                              .sum()
+                        : kernels[r];
+        sum += rho_[0];
+        if (one_class_) {
+          y_data[block + r] = sum > 0 ? 1.f : -1.f;
+        } else {
+          y_data[block + r] = sum;
+        }
       }
-      sum += rho_[0];
-    } else if (mode_ == SVM_TYPE::SVM_LINEAR) {  //liblinear
-      sum = kernel_dot(x_data, current_weight_0, coefficients_, 0, feature_count_, get_kernel_type());
-      sum += rho_[0];
     }
-    if (one_class_ && sum > 0) {
-      Y->template MutableData<float>()[n] = 1.f;
-    } else if (one_class_) {
-      Y->template MutableData<float>()[n] = -1.f;
-    } else {
-      Y->template MutableData<float>()[n] = sum;
-    }
-  }
+  };
+
+  const concurrency::TensorOpCost row_cost{static_cast<double>(feature_count_ * sizeof(T)),
+                                           static_cast<double>(sizeof(float)),
+                                           static_cast<double>(kernel_count * (feature_count_ + 1) * 2)};
+  parallel_for_row_blocks(ctx->GetOperatorThreadPool(), N, row_cost, compute_rows);
 
   return Status::OK();
 }
@@ -138,157 +138,27 @@ ADD_IN_TYPE_TREE_ENSEMBLE_CLASSIFIER_OP(int32_t);
 template <typename T>
 TreeEnsembleClassifier<T>::TreeEnsembleClassifier(const OpKernelInfo& info)
     : OpKernel(info),
-      nodes_treeids_(info.GetAttrsOrDefault<int64_t>("nodes_treeids")),
-      nodes_nodeids_(info.GetAttrsOrDefault<int64_t>("nodes_nodeids")),
-      nodes_featureids_(info.GetAttrsOrDefault<int64_t>("nodes_featureids")),
-      nodes_values_(info.GetAttrsOrDefault<float>("nodes_values")),
-      nodes_hitrates_(info.GetAttrsOrDefault<float>("nodes_hitrates")),
-      nodes_modes_names_(info.GetAttrsOrDefault<std::string>("nodes_modes")),
-      nodes_truenodeids_(info.GetAttrsOrDefault<int64_t>("nodes_truenodeids")),
-      nodes_falsenodeids_(info.GetAttrsOrDefault<int64_t>("nodes_falsenodeids")),
-      missing_tracks_true_(info.GetAttrsOrDefault<int64_t>("nodes_missing_value_tracks_true")),
-      class_nodeids_(info.GetAttrsOrDefault<int64_t>("class_nodeids")),
-      class_treeids_(info.GetAttrsOrDefault<int64_t>("class_treeids")),
-      class_ids_(info.GetAttrsOrDefault<int64_t>("class_ids")),
-      class_weights_(info.GetAttrsOrDefault<float>("class_weights")),
+      tree_ensemble_(info, "class_"),
       base_values_(info.GetAttrsOrDefault<float>("base_values")),
       classlabels_strings_(info.GetAttrsOrDefault<std::string>("classlabels_strings")),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
       post_transform_(MakeTransform(info.GetAttrOrDefault<std::string>("post_transform", "NONE"))) {
-  ORT_ENFORCE(!nodes_treeids_.empty());
-  ORT_ENFORCE(class_nodeids_.size() == class_ids_.size());
-  ORT_ENFORCE(class_nodeids_.size() == class_weights_.size());
-  ORT_ENFORCE(nodes_nodeids_.size() == nodes_featureids_.size());
-  ORT_ENFORCE(nodes_nodeids_.size() == nodes_modes_names_.size());
-  ORT_ENFORCE(nodes_nodeids_.size() == nodes_values_.size());
-  ORT_ENFORCE(nodes_nodeids_.size() == nodes_truenodeids_.size());
-  ORT_ENFORCE(nodes_nodeids_.size() == nodes_falsenodeids_.size());
-  ORT_ENFORCE((nodes_nodeids_.size() == nodes_hitrates_.size()) || (nodes_hitrates_.empty()));
-
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
+  class_count_ = !classlabels_strings_.empty() ? classlabels_strings_.size() : classlabels_int64s_.size();
+  using_strings_ = !classlabels_strings_.empty();
 
-  // in the absence of bool type supported by GetAttrs this ensure that we don't have any negative
-  // values so that we can check for the truth condition without worrying about negative values.
-  ORT_ENFORCE(std::all_of(
-      std::begin(missing_tracks_true_),
-      std::end(missing_tracks_true_), [](int64_t elem) { return elem >= 0; }));
-
-  Initialize();
-}
-
-template <typename T>
-void TreeEnsembleClassifier<T>::Initialize() {
-  int64_t current_tree_id = 1234567891L;
-  std::vector<int64_t> tree_offsets;
+  std::vector<int64_t> class_ids(info.GetAttrsOrDefault<int64_t>("class_ids"));
+  std::vector<float> class_weights(info.GetAttrsOrDefault<float>("class_weights"));
   weights_are_all_positive_ = true;
-
-  for (int64_t i = 0, size_node_treeids = static_cast<int64_t>(nodes_treeids_.size());
-       i < size_node_treeids;
-       ++i) {
-    if (nodes_treeids_[i] != current_tree_id) {
-      tree_offsets.push_back(nodes_nodeids_[i]);
-      current_tree_id = nodes_treeids_[i];
-    }
-    int64_t offset = tree_offsets[tree_offsets.size() - 1];
-    nodes_nodeids_[i] = nodes_nodeids_[i] - offset;
-    if (nodes_falsenodeids_[i] >= 0) {
-      nodes_falsenodeids_[i] = nodes_falsenodeids_[i] - offset;
-    }
-    if (nodes_truenodeids_[i] >= 0) {
-      nodes_truenodeids_[i] = nodes_truenodeids_[i] - offset;
-    }
-  }
-  for (int64_t i = 0, size_class_nodeids = static_cast<int64_t>(class_nodeids_.size());
-       i < size_class_nodeids;
-       ++i) {
-    int64_t offset = tree_offsets[class_treeids_[i]];
-    class_nodeids_[i] = class_nodeids_[i] - offset;
-    if (class_weights_[i] < 0) {
+  for (size_t i = 0, end = class_ids.size(); i < end; ++i) {
+    ORT_ENFORCE(class_ids[i] < class_count_, "class_ids value ", class_ids[i],
+                " is out of range, the number of class labels is ", class_count_, ".");
+    weights_classes_.insert(class_ids[i]);
+    if (class_weights[i] < 0) {
       weights_are_all_positive_ = false;
     }
   }
-
-  nodes_modes_.reserve(nodes_modes_names_.size());
-  for (size_t i = 0, end = nodes_modes_names_.size(); i < end; ++i) {
-    nodes_modes_.push_back(MakeTreeNodeMode(nodes_modes_names_[i]));
-  }
-
-  // leafnode data, these are the votes that leaves do
-  using LeafNodeData = std::tuple<int64_t, int64_t, int64_t, float>;
-  for (size_t i = 0, end = class_nodeids_.size(); i < end; ++i) {
-    leafnodedata_.push_back(std::make_tuple(class_treeids_[i], class_nodeids_[i], class_ids_[i], class_weights_[i]));
-    weights_classes_.insert(class_ids_[i]);
-  }
-  std::sort(std::begin(leafnodedata_), std::end(leafnodedata_), [](LeafNodeData const& t1, LeafNodeData const& t2) {
-    if (std::get<0>(t1) != std::get<0>(t2))
-      return std::get<0>(t1) < std::get<0>(t2);
-
-    return std::get<1>(t1) < std::get<1>(t2);
-  });
-  // make an index so we can find the leafnode data quickly when evaluating
-  int64_t field0 = -1;
-  int64_t field1 = -1;
-  for (size_t i = 0, end = leafnodedata_.size(); i < end; ++i) {
-    int64_t id0 = std::get<0>(leafnodedata_[i]);
-    int64_t id1 = std::get<1>(leafnodedata_[i]);
-    if (id0 != field0 || id1 != field1) {
-      int64_t id = id0 * kOffset_ + id1;
-      auto position = static_cast<int64_t>(i);
-      auto p3 = std::make_pair(id, position);
-      leafdata_map_.insert(p3);
-      field0 = id;
-      field1 = position;
-    }
-  }
-
-  // treenode ids, some are roots_, and roots_ have no parents
-  std::unordered_map<int64_t, int64_t> parents;  // holds count of all who point to you
-  std::unordered_map<int64_t, int64_t> indices;
-  // add all the nodes to a map, and the ones that have parents are not roots_
-  std::unordered_map<int64_t, int64_t>::iterator it;
-  for (size_t i = 0, end = nodes_treeids_.size(); i < end; ++i) {
-    // make an index to look up later
-    int64_t id = nodes_treeids_[i] * kOffset_ + nodes_nodeids_[i];
-    auto position = static_cast<int64_t>(i);
-    auto p3 = std::make_pair(id, position);
-    indices.insert(p3);
-    it = parents.find(id);
-    if (it == parents.end()) {
-      // start counter at 0
-      auto b = (int64_t)0L;
-      auto p1 = std::make_pair(id, b);
-      parents.insert(p1);
-    }
-  }
-  // all true nodes arent roots_
-  for (size_t i = 0, end = nodes_truenodeids_.size(); i < end; ++i) {
-    if (nodes_modes_[i] == NODE_MODE::LEAF) continue;
-    // they must be in the same tree
-    int64_t id = nodes_treeids_[i] * kOffset_ + nodes_truenodeids_[i];
-    it = parents.find(id);
-    ORT_ENFORCE(it != parents.end());
-    it->second++;
-  }
-  // all false nodes arent roots_
-  for (size_t i = 0, end = nodes_falsenodeids_.size(); i < end; ++i) {
-    if (nodes_modes_[i] == NODE_MODE::LEAF) continue;
-    // they must be in the same tree
-    int64_t id = nodes_treeids_[i] * kOffset_ + nodes_falsenodeids_[i];
-    it = parents.find(id);
-    ORT_ENFORCE(it != parents.end());
-    it->second++;
-  }
-  // find all the nodes that dont have other nodes pointing at them
-  for (auto& parent : parents) {
-    if (parent.second == 0) {
-      int64_t id = parent.first;
-      it = indices.find(id);
-      roots_.push_back(it->second);
-    }
-  }
-  class_count_ = !classlabels_strings_.empty() ? classlabels_strings_.size() : classlabels_int64s_.size();
-  using_strings_ = !classlabels_strings_.empty();
   ORT_ENFORCE(base_values_.empty() ||
               base_values_.size() == static_cast<size_t>(class_count_) ||
               base_values_.size() == weights_classes_.size());
@@ -305,210 +175,158 @@ common::Status TreeEnsembleClassifier<T>::Compute(OpKernelContext* context) cons
 
   int64_t stride = x_dims.size() == 1 ? x_dims[0] : x_dims[1];  // TODO(task 495): how does this work in the case of 3D tensors?
   int64_t N = x_dims.size() == 1 ? 1 : x_dims[0];
+  if (tree_ensemble_.MaxFeatureId() >= stride) {
+    return Status(ONNXRUNTIME, INVALID_ARGUMENT,
+                  MakeString("The trees use feature ", tree_ensemble_.MaxFeatureId(), " but X has only ", stride,
+                             " features."));
+  }
   Tensor* Y = context->Output(0, TensorShape({N}));
   auto* Z = context->Output(1, TensorShape({N, class_count_}));
 
-  int64_t zindex = 0;
   const T* x_data = X.template Data<T>();
 
-  // for each class
-  std::vector<float> scores;
-  scores.reserve(class_count_);
-  for (int64_t i = 0; i < N; ++i) {
-    scores.clear();
-    int64_t current_weight_0 = i * stride;
-    std::map<int64_t, float> classes;
-    // fill in base values, this might be empty but that is ok
-    for (int64_t k = 0, end = static_cast<int64_t>(base_values_.size()); k < end; ++k) {
-      auto p1 = std::make_pair<int64_t&, const float&>(k, base_values_[k]);
-      classes.insert(p1);
-    }
-    // walk each tree from its root
-    for (size_t j = 0, end = roots_.size(); j < end; ++j) {
-      ORT_RETURN_IF_ERROR(ProcessTreeNode(classes, roots_[j], x_data, current_weight_0));
-    }
-    float maxweight = 0.f;
-    int64_t maxclass = -1;
-    // write top class
-    int write_additional_scores = -1;
-    if (class_count_ > 2) {
-      for (auto& classe : classes) {
-        if (maxclass == -1 || classe.second > maxweight) {
-          maxclass = classe.first;
-          maxweight = classe.second;
-        }
-      }
-      if (using_strings_) {
-        Y->template MutableData<std::string>()[i] = classlabels_strings_[maxclass];
-      } else {
-        Y->template MutableData<int64_t>()[i] = classlabels_int64s_[maxclass];
-      }
-    } else  // binary case
-    {
-      maxweight = !classes.empty() ? classes[0] : 0.f;  // only 1 class
-      if (using_strings_) {
-        auto* y_data = Y->template MutableData<std::string>();
-        if (classlabels_strings_.size() == 2 &&
-            weights_are_all_positive_ &&
-            maxweight > 0.5 &&
-            weights_classes_.size() == 1) {
-          y_data[i] = classlabels_strings_[1];  // positive label
-          write_additional_scores = 0;
-        } else if (classlabels_strings_.size() == 2 &&
-                   weights_are_all_positive_ &&
-                   maxweight <= 0.5 &&
-                   weights_classes_.size() == 1) {
-          y_data[i] = classlabels_strings_[0];  // negative label
-          write_additional_scores = 1;
-        } else if (classlabels_strings_.size() == 2 &&
-                   maxweight > 0 &&
-                   !weights_are_all_positive_ && weights_classes_.size() == 1) {
-          y_data[i] = classlabels_strings_[1];  // pos label
-          write_additional_scores = 2;
-        } else if (classlabels_strings_.size() == 2 &&
-                   maxweight <= 0 &&
-                   !weights_are_all_positive_ &&
-                   weights_classes_.size() == 1) {
-          y_data[i] = classlabels_strings_[0];  // neg label
-          write_additional_scores = 3;
-        } else if (maxweight > 0) {
-          y_data[i] = "1";  // positive label
-        } else {
-          y_data[i] = "0";  // negative label
-        }
-      } else {
-        auto* y_data = Y->template MutableData<int64_t>();
-        if (classlabels_int64s_.size() == 2 &&
-            weights_are_all_positive_ &&
-            maxweight > 0.5 &&
-            weights_classes_.size() == 1) {
-          y_data[i] = classlabels_int64s_[1];  // positive label
-          write_additional_scores = 0;
-        } else if (classlabels_int64s_.size() == 2 &&
-                   weights_are_all_positive_ &&
-                   maxweight <= 0.5 &&
-                   weights_classes_.size() == 1) {
-          y_data[i] = classlabels_int64s_[0];  // negative label
-          write_additional_scores = 1;
-        } else if (classlabels_int64s_.size() == 2 &&
-                   maxweight > 0 &&
-                   !weights_are_all_positive_ &&
-                   weights_classes_.size() == 1) {
-          y_data[i] = classlabels_int64s_[1];  // pos label
-          write_additional_scores = 2;
-        } else if (classlabels_int64s_.size() == 2 &&
-                   maxweight <= 0 &&
-                   !weights_are_all_positive_ &&
-                   weights_classes_.size() == 1) {
-          y_data[i] = classlabels_int64s_[0];  // neg label
-          write_additional_scores = 3;
-        } else if (maxweight > 0) {
-          y_data[i] = 1;  // positive label
-        } else {
-          y_data[i] = 0;  // negative label
-        }
+  // one dense row of class scores per point, filled in with the base values, this might be empty but that is ok
+  std::vector<ScoreValue> scores(static_cast<size_t>(N * class_count_), ScoreValue{0.f, 0});
+  if (!base_values_.empty()) {
+    for (int64_t i = 0; i < N; ++i) {
+      ScoreValue* classes = scores.data() + i * class_count_;
+      for (size_t k = 0, end = base_values_.size(); k < end; ++k) {
+        classes[k] = ScoreValue{base_values_[k], 1};
       }
     }
-    // write float values, might not have all the classes in the output yet
-    // for example a 10 class case where we only found 2 classes in the leaves
-    if (weights_classes_.size() == static_cast<size_t>(class_count_)) {
-      for (int64_t k = 0; k < class_count_; ++k) {
-        auto it_classes = classes.find(k);
-        if (it_classes != classes.end()) {
-          scores.push_back(it_classes->second);
-        } else {
-          scores.push_back(0.f);
+  }
+
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  tree_ensemble_.ComputeScores(tp, x_data, N, stride, AGGREGATE_FUNCTION::SUM, class_count_, scores.data());
+
+  // the post transform of a row costs a few cycles per class
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(N), static_cast<double>(class_count_) * 20,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> row_scores;
+        row_scores.reserve(std::max<int64_t>(class_count_, 2));
+        for (int64_t i = first; i < last; ++i) {
+          WriteRow(scores.data() + i * class_count_, i, Y, Z, row_scores);
         }
-      }
-    } else {
-      for (auto& classe : classes) {
-        scores.push_back(classe.second);
-      }
-    }
-    write_scores(scores, post_transform_, zindex, Z, write_additional_scores);
-    zindex += scores.size();
-  }  // for every batch
+      });
   return Status::OK();
 }
 
 template <typename T>
-common::Status TreeEnsembleClassifier<T>::ProcessTreeNode(std::map<int64_t, float>& classes,
-                                                          int64_t treeindex,
-                                                          const T* x_data,
-                                                          int64_t feature_base) const {
-  // walk down tree to the leaf
-  auto mode = static_cast<NODE_MODE>(nodes_modes_[treeindex]);
-  int64_t loopcount = 0;
-  int64_t root = treeindex;
-  while (mode != NODE_MODE::LEAF) {
-    T val = x_data[feature_base + nodes_featureids_[treeindex]];
-    bool tracktrue = true;
-    if (missing_tracks_true_.size() != nodes_truenodeids_.size()) {
-      tracktrue = false;
+void TreeEnsembleClassifier<T>::WriteRow(ScoreValue* classes, int64_t i, Tensor* Y, Tensor* Z,
+                                         std::vector<float>& scores) const {
+  scores.clear();
+  float maxweight = 0.f;
+  int64_t maxclass = -1;
+  // write top class
+  int write_additional_scores = -1;
+  if (class_count_ > 2) {
+    for (int64_t k = 0; k < class_count_; ++k) {
+      if (classes[k].has_score && (maxclass == -1 || classes[k].score > maxweight)) {
+        maxclass = k;
+        maxweight = classes[k].score;
+      }
+    }
+    // no leaf voted and there is no base value, report the first class
+    if (maxclass == -1) {
+      maxclass = 0;
+    }
+    if (using_strings_) {
+      Y->template MutableData<std::string>()[i] = classlabels_strings_[maxclass];
     } else {
-      tracktrue = missing_tracks_true_[treeindex] && std::isnan(static_cast<float>(val));
+      Y->template MutableData<int64_t>()[i] = classlabels_int64s_[maxclass];
     }
-    float threshold = nodes_values_[treeindex];
-    switch (mode) {
-      case NODE_MODE::BRANCH_LEQ:
-        treeindex = val <= threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-        break;
-      case NODE_MODE::BRANCH_LT:
-        treeindex = val < threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-        break;
-      case NODE_MODE::BRANCH_GTE:
-        treeindex = val >= threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-        break;
-      case NODE_MODE::BRANCH_GT:
-        treeindex = val > threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-        break;
-      case NODE_MODE::BRANCH_EQ:
-        treeindex = val == threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-        break;
-      case NODE_MODE::BRANCH_NEQ:
-        treeindex = val != threshold || tracktrue ? nodes_truenodeids_[treeindex] : nodes_falsenodeids_[treeindex];
-        break;
-      default: {
-        std::ostringstream err_msg;
-        err_msg << "Invalid mode of value: " << static_cast<std::underlying_type<NODE_MODE>::type>(mode);
-        return Status(ONNXRUNTIME, INVALID_ARGUMENT, err_msg.str());
+  } else  // binary case
+  {
+    // the score of the first class is reported as soon as any class has one
+    if (!classes[0].has_score &&
+        std::any_of(classes, classes + class_count_, [](const ScoreValue& s) { return s.has_score != 0; })) {
+      classes[0].has_score = 1;
+    }
+    maxweight = classes[0].score;  // only 1 class
+    if (using_strings_) {
+      auto* y_data = Y->template MutableData<std::string>();
+      if (classlabels_strings_.size() == 2 &&
+          weights_are_all_positive_ &&
+          maxweight > 0.5 &&
+          weights_classes_.size() == 1) {
+        y_data[i] = classlabels_strings_[1];  // positive label
+        write_additional_scores = 0;
+      } else if (classlabels_strings_.size() == 2 &&
+                 weights_are_all_positive_ &&
+                 maxweight <= 0.5 &&
+                 weights_classes_.size() == 1) {
+        y_data[i] = classlabels_strings_[0];  // negative label
+        write_additional_scores = 1;
+      } else if (classlabels_strings_.size() == 2 &&
+                 maxweight > 0 &&
+                 !weights_are_all_positive_ && weights_classes_.size() == 1) {
+        y_data[i] = classlabels_strings_[1];  // pos label
+        write_additional_scores = 2;
+      } else if (classlabels_strings_.size() == 2 &&
+                 maxweight <= 0 &&
+                 !weights_are_all_positive_ &&
+                 weights_classes_.size() == 1) {
+        y_data[i] = classlabels_strings_[0];  // neg label
+        write_additional_scores = 3;
+      } else if (maxweight > 0) {
+        y_data[i] = "1";  // positive label
+      } else {
+        y_data[i] = "0";  // negative label
+      }
+    } else {
+      auto* y_data = Y->template MutableData<int64_t>();
+      if (classlabels_int64s_.size() == 2 &&
+          weights_are_all_positive_ &&
+          maxweight > 0.5 &&
+          weights_classes_.size() == 1) {
+        y_data[i] = classlabels_int64s_[1];  // positive label
+        write_additional_scores = 0;
+      } else if (classlabels_int64s_.size() == 2 &&
+                 weights_are_all_positive_ &&
+                 maxweight <= 0.5 &&
+                 weights_classes_.size() == 1) {
+        y_data[i] = classlabels_int64s_[0];  // negative label
+        write_additional_scores = 1;
+      } else if (classlabels_int64s_.size() == 2 &&
+                 maxweight > 0 &&
+                 !weights_are_all_positive_ &&
+                 weights_classes_.size() == 1) {
+        y_data[i] = classlabels_int64s_[1];  // pos label
+        write_additional_scores = 2;
+      } else if (classlabels_int64s_.size() == 2 &&
+                 maxweight <= 0 &&
+                 !weights_are_all_positive_ &&
+                 weights_classes_.size() == 1) {
+        y_data[i] = classlabels_int64s_[0];  // neg label
+        write_additional_scores = 3;
+      } else if (maxweight > 0) {
+        y_data[i] = 1;  // positive label
+      } else {
+        y_data[i] = 0;  // negative label
       }
     }
-    ORT_ENFORCE(treeindex >= 0);
-    treeindex = treeindex + root;
-    mode = static_cast<NODE_MODE>(nodes_modes_[treeindex]);
-    loopcount++;
-    if (loopcount > kMaxTreeDepth_) break;
   }
-  // should be at leaf
-  int64_t id = nodes_treeids_[treeindex] * kOffset_ + nodes_nodeids_[treeindex];
-  auto it_lp = leafdata_map_.find(id);
-  if (it_lp == leafdata_map_.end()) {  // if not found, simply return
-    return Status::OK();
-  }
-  int64_t index = it_lp->second;
-  int64_t treeid = std::get<0>(leafnodedata_[index]);
-  int64_t nodeid = std::get<1>(leafnodedata_[index]);
-  while (treeid == nodes_treeids_[treeindex] && nodeid == nodes_nodeids_[treeindex]) {
-    int64_t classid = std::get<2>(leafnodedata_[index]);
-    float weight = std::get<3>(leafnodedata_[index]);
-    std::map<int64_t, float>::iterator it_classes;
-    it_classes = classes.find(classid);
-    if (it_classes != classes.end()) {
-      it_classes->second += weight;
-    } else {
-      auto p1 = std::make_pair(classid, weight);
-      classes.insert(p1);
+  // write float values, might not have all the classes in the output yet
+  // for example a 10 class case where we only found 2 classes in the leaves
+  if (weights_classes_.size() == static_cast<size_t>(class_count_)) {
+    for (int64_t k = 0; k < class_count_; ++k) {
+      scores.push_back(classes[k].score);
     }
-    ++index;
-    // some tree node will be last
-    if (index >= static_cast<int64_t>(leafnodedata_.size())) {
-      break;
+  } else {
+    for (int64_t k = 0; k < class_count_; ++k) {
+      if (classes[k].has_score) {
+        scores.push_back(classes[k].score);
+      }
     }
-    treeid = std::get<0>(leafnodedata_[index]);
-    nodeid = std::get<1>(leafnodedata_[index]);
   }
-  return Status::OK();
+  int64_t zindex = i * class_count_;
+  write_scores(scores, post_transform_, zindex, Z, write_additional_scores);
+  // every row owns class_count_ scores in Z, pad the ones no leaf voted for
+  float* z_data = Z->template MutableData<float>();
+  for (int64_t k = static_cast<int64_t>(scores.size()); k < class_count_; ++k) {
+    z_data[zindex + k] = 0.f;
+  }
 }
 }  // namespace ml
 }  // namespace onnxruntime
@@ -0,0 +1,194 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/ml/tree_ensemble_common.h"
+
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
+
+namespace onnxruntime {
+namespace ml {
+
+namespace {
+struct TreeNodeKey {
+  int64_t tree_id;
+  int64_t node_id;
+  bool operator==(const TreeNodeKey& other) const {
+    return tree_id == other.tree_id && node_id == other.node_id;
+  }
+};
+
+struct TreeNodeKeyHash {
+  size_t operator()(const TreeNodeKey& key) const {
+    return std::hash<int64_t>()(key.tree_id) ^ (std::hash<int64_t>()(key.node_id) << 1);
+  }
+};
+}  // namespace
+
+TreeEnsembleCommon::TreeEnsembleCommon(const OpKernelInfo& info, const std::string& weights_prefix) {
+  std::vector<int64_t> nodes_treeids(info.GetAttrsOrDefault<int64_t>("nodes_treeids"));
+  std::vector<int64_t> nodes_nodeids(info.GetAttrsOrDefault<int64_t>("nodes_nodeids"));
+  std::vector<int64_t> nodes_featureids(info.GetAttrsOrDefault<int64_t>("nodes_featureids"));
+  std::vector<float> nodes_values(info.GetAttrsOrDefault<float>("nodes_values"));
+  std::vector<float> nodes_hitrates(info.GetAttrsOrDefault<float>("nodes_hitrates"));
+  std::vector<std::string> nodes_modes_names(info.GetAttrsOrDefault<std::string>("nodes_modes"));
+  std::vector<int64_t> nodes_truenodeids(info.GetAttrsOrDefault<int64_t>("nodes_truenodeids"));
+  std::vector<int64_t> nodes_falsenodeids(info.GetAttrsOrDefault<int64_t>("nodes_falsenodeids"));
+  std::vector<int64_t> missing_tracks_true(info.GetAttrsOrDefault<int64_t>("nodes_missing_value_tracks_true"));
+  std::vector<int64_t> weights_treeids(info.GetAttrsOrDefault<int64_t>(weights_prefix + "treeids"));
+  std::vector<int64_t> weights_nodeids(info.GetAttrsOrDefault<int64_t>(weights_prefix + "nodeids"));
+  std::vector<int64_t> weights_ids(info.GetAttrsOrDefault<int64_t>(weights_prefix + "ids"));
+  std::vector<float> weights_values(info.GetAttrsOrDefault<float>(weights_prefix + "weights"));
+
+  size_t n_nodes = nodes_nodeids.size();
+  ORT_ENFORCE(!nodes_treeids.empty());
+  ORT_ENFORCE(n_nodes == nodes_treeids.size());
+  ORT_ENFORCE(n_nodes == nodes_featureids.size());
+  ORT_ENFORCE(n_nodes == nodes_modes_names.size());
+  ORT_ENFORCE(n_nodes == nodes_values.size());
+  ORT_ENFORCE(n_nodes == nodes_truenodeids.size());
+  ORT_ENFORCE(n_nodes == nodes_falsenodeids.size());
+  ORT_ENFORCE((n_nodes == nodes_hitrates.size()) || (nodes_hitrates.empty()));
+  ORT_ENFORCE(weights_nodeids.size() == weights_treeids.size());
+  ORT_ENFORCE(weights_nodeids.size() == weights_ids.size());
+  ORT_ENFORCE(weights_nodeids.size() == weights_values.size());
+  ORT_ENFORCE(n_nodes < std::numeric_limits<uint32_t>::max() &&
+                  weights_nodeids.size() < std::numeric_limits<uint32_t>::max(),
+              "Too many nodes in the tree ensemble.");
+
+  // in the absence of bool type supported by GetAttrs this ensure that we don't have any negative
+  // values so that we can check for the truth condition without worrying about negative values.
+  ORT_ENFORCE(std::all_of(
+      std::begin(missing_tracks_true),
+      std::end(missing_tracks_true), [](int64_t elem) { return elem >= 0; }));
+  // missing values are only tracked when the attribute is given for every node
+  bool use_missing_tracks = missing_tracks_true.size() == n_nodes;
+
+  std::vector<NODE_MODE> modes;
+  modes.reserve(n_nodes);
+  for (const auto& name : nodes_modes_names) {
+    modes.push_back(MakeTreeNodeMode(name));
+  }
+
+  // node ids may restart at zero for each tree, a node is identified by (tree id, node id)
+  std::unordered_map<TreeNodeKey, size_t, TreeNodeKeyHash> indices;
+  indices.reserve(n_nodes);
+  for (size_t i = 0; i < n_nodes; ++i) {
+    ORT_ENFORCE(indices.insert({{nodes_treeids[i], nodes_nodeids[i]}, i}).second,
+                "Node ", nodes_nodeids[i], " appears more than once in tree ", nodes_treeids[i], ".");
+  }
+
+  // resolve the children, the roots are the nodes no other node points to
+  std::vector<size_t> truenodes(n_nodes, 0);
+  std::vector<size_t> falsenodes(n_nodes, 0);
+  std::vector<bool> has_parent(n_nodes, false);
+  for (size_t i = 0; i < n_nodes; ++i) {
+    if (modes[i] == NODE_MODE::LEAF) continue;
+    // they must be in the same tree
+    auto it = indices.find({nodes_treeids[i], nodes_truenodeids[i]});
+    ORT_ENFORCE(it != indices.end(), "True node ", nodes_truenodeids[i], " of node ", nodes_nodeids[i],
+                " is missing in tree ", nodes_treeids[i], ".");
+    truenodes[i] = it->second;
+    has_parent[it->second] = true;
+    it = indices.find({nodes_treeids[i], nodes_falsenodeids[i]});
+    ORT_ENFORCE(it != indices.end(), "False node ", nodes_falsenodeids[i], " of node ", nodes_nodeids[i],
+                " is missing in tree ", nodes_treeids[i], ".");
+    falsenodes[i] = it->second;
+    has_parent[it->second] = true;
+  }
+
+  // Lay out every tree in depth-first order, the true branch directly follows its parent. A node shared by
+  // several parents is only emitted once.
+  const uint32_t not_compiled = std::numeric_limits<uint32_t>::max();
+  std::vector<uint32_t> compiled(n_nodes, not_compiled);
+  std::vector<size_t> order;
+  order.reserve(n_nodes);
+  std::vector<size_t> stack;
+  for (size_t i = 0; i < n_nodes; ++i) {
+    if (has_parent[i]) continue;
+    roots_.push_back(static_cast<uint32_t>(order.size()));
+    stack.push_back(i);
+    while (!stack.empty()) {
+      size_t index = stack.back();
+      stack.pop_back();
+      if (compiled[index] != not_compiled) continue;
+      compiled[index] = static_cast<uint32_t>(order.size());
+      order.push_back(index);
+      if (modes[index] != NODE_MODE::LEAF) {
+        stack.push_back(falsenodes[index]);
+        stack.push_back(truenodes[index]);
+      }
+    }
+  }
+
+  // leaf votes, grouped by compiled node so a leaf reads a contiguous range
+  std::vector<std::pair<uint32_t, size_t>> votes;
+  votes.reserve(weights_nodeids.size());
+  for (size_t i = 0; i < weights_nodeids.size(); ++i) {
+    ORT_ENFORCE(weights_ids[i] >= 0, "Invalid ", weights_prefix, "ids value ", weights_ids[i], ".");
+    auto it = indices.find({weights_treeids[i], weights_nodeids[i]});
+    // votes on unknown or unreachable nodes can never be cast
+    if (it == indices.end() || compiled[it->second] == not_compiled) continue;
+    votes.push_back({compiled[it->second], i});
+  }
+  std::stable_sort(votes.begin(), votes.end(),
+                   [](const std::pair<uint32_t, size_t>& a, const std::pair<uint32_t, size_t>& b) {
+                     return a.first < b.first;
+                   });
+  weights_.reserve(votes.size());
+  for (const auto& vote : votes) {
+    weights_.push_back({weights_ids[vote.second], weights_values[vote.second]});
+  }
+
+  nodes_.resize(order.size());
+  max_feature_id_ = -1;
+  all_branch_leq_ = true;
+  size_t vote_index = 0;
+  for (size_t n = 0; n < order.size(); ++n) {
+    size_t i = order[n];
+    TreeNodeElement& node = nodes_[n];
+    node.value = nodes_values[i];
+    node.mode = modes[i];
+    node.missing_tracks_true = use_missing_tracks && missing_tracks_true[i] != 0;
+    if (node.mode == NODE_MODE::LEAF) {
+      // the feature id of a leaf is never read
+      node.feature_id = 0;
+      node.truenode = 0;
+      node.falsenode = 0;
+    } else {
+      ORT_ENFORCE(nodes_featureids[i] >= 0 && nodes_featureids[i] <= std::numeric_limits<int32_t>::max(),
+                  "Invalid feature id ", nodes_featureids[i], " for node ", nodes_nodeids[i],
+                  " in tree ", nodes_treeids[i], ".");
+      node.feature_id = static_cast<int32_t>(nodes_featureids[i]);
+      node.truenode = compiled[truenodes[i]];
+      node.falsenode = compiled[falsenodes[i]];
+      max_feature_id_ = std::max(max_feature_id_, nodes_featureids[i]);
+      if (node.mode != NODE_MODE::BRANCH_LEQ || node.missing_tracks_true) {
+        all_branch_leq_ = false;
+      }
+    }
+    node.weights_begin = static_cast<uint32_t>(vote_index);
+    while (vote_index < votes.size() && votes[vote_index].first == n) {
+      ++vote_index;
+    }
+    node.weights_count = static_cast<uint32_t>(vote_index - node.weights_begin);
+  }
+
+  // group consecutive trees into blocks of about kNodesPerTreeBlock nodes
+  tree_blocks_.push_back(0);
+  size_t block_nodes = 0;
+  for (size_t j = 0; j < roots_.size(); ++j) {
+    size_t tree_end = j + 1 < roots_.size() ? roots_[j + 1] : nodes_.size();
+    size_t tree_nodes = tree_end - roots_[j];
+    if (block_nodes > 0 && block_nodes + tree_nodes > kNodesPerTreeBlock) {
+      tree_blocks_.push_back(j);
+      block_nodes = 0;
+    }
+    block_nodes += tree_nodes;
+  }
+  tree_blocks_.push_back(roots_.size());
+}
+
+}  // namespace ml
+}  // namespace onnxruntime
@@ -0,0 +1,265 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/platform/threadpool.h"
+#include "ml_common.h"
+
+namespace onnxruntime {
+namespace ml {
+
+// One node of a compiled tree. Children are absolute indices into TreeEnsembleCommon::nodes_ and the
+// leaf weights of a node are the range [weights_begin, weights_begin + weights_count) of
+// TreeEnsembleCommon::weights_. The struct is kept at 32 bytes so two nodes share a cache line.
+struct TreeNodeElement {
+  int32_t feature_id;
+  float value;
+  uint32_t truenode;
+  uint32_t falsenode;
+  uint32_t weights_begin;
+  uint32_t weights_count;
+  NODE_MODE mode;
+  bool missing_tracks_true;
+};
+static_assert(sizeof(TreeNodeElement) == 32, "TreeNodeElement is expected to fill half a cache line");
+
+// A vote cast by a leaf for one class (TreeEnsembleClassifier) or one target (TreeEnsembleRegressor).
+struct TreeNodeWeight {
+  int64_t id;
+  float value;
+};
+
+// Dense per-row accumulator. has_score tells apart a class/target no leaf voted for from one whose votes add up to 0.
+struct ScoreValue {
+  float score;
+  unsigned char has_score;
+};
+
+struct TreeAggregatorSum {
+  static inline void Add(ScoreValue& s, float value) {
+    s.score += value;
+    s.has_score = 1;
+  }
+  static inline void Merge(ScoreValue& s, const ScoreValue& other) {
+    s.score += other.score;
+    s.has_score |= other.has_score;
+  }
+};
+
+struct TreeAggregatorMin {
+  static inline void Add(ScoreValue& s, float value) {
+    s.score = (!s.has_score || value < s.score) ? value : s.score;
+    s.has_score = 1;
+  }
+  static inline void Merge(ScoreValue& s, const ScoreValue& other) {
+    if (other.has_score) Add(s, other.score);
+  }
+};
+
+struct TreeAggregatorMax {
+  static inline void Add(ScoreValue& s, float value) {
+    s.score = (!s.has_score || value > s.score) ? value : s.score;
+    s.has_score = 1;
+  }
+  static inline void Merge(ScoreValue& s, const ScoreValue& other) {
+    if (other.has_score) Add(s, other.score);
+  }
+};
+
+// Shared by TreeEnsembleClassifier and TreeEnsembleRegressor.
+// The node attributes are compiled once at kernel creation into a flat array of TreeNodeElement. Each tree is
+// stored contiguously in depth-first order with the true branch right after its parent, and the trees are
+// grouped into blocks small enough to stay in cache while a chunk of rows is evaluated against them.
+class TreeEnsembleCommon {
+ public:
+  // weights_prefix is "class_" for the classifier and "target_" for the regressor.
+  TreeEnsembleCommon(const OpKernelInfo& info, const std::string& weights_prefix);
+
+  size_t NumTrees() const { return roots_.size(); }
+  const std::vector<TreeNodeWeight>& Weights() const { return weights_; }
+  // Largest feature index read by a branch node, -1 if all the trees are single leaves.
+  int64_t MaxFeatureId() const { return max_feature_id_; }
+
+  // Walks every tree for each of the N rows of x_data and aggregates the leaf votes into
+  // scores[row * n_scores + id]. scores must be initialized by the caller (base values or zeros).
+  // Work is split across rows, or across blocks of trees when there are fewer rows than threads.
+  template <typename T>
+  void ComputeScores(concurrency::ThreadPool* tp, const T* x_data, int64_t N, int64_t stride,
+                     AGGREGATE_FUNCTION aggregate_function, int64_t n_scores, ScoreValue* scores) const;
+
+ private:
+  template <typename T, typename TAgg>
+  void ComputeScoresAgg(concurrency::ThreadPool* tp, const T* x_data, int64_t N, int64_t stride,
+                        int64_t n_scores, ScoreValue* scores) const;
+
+  template <typename T, typename TAgg>
+  void ComputeTreeRange(const T* x_data, int64_t first_row, int64_t last_row, int64_t stride,
+                        size_t first_tree, size_t last_tree, int64_t n_scores, ScoreValue* scores) const;
+
+  template <typename T>
+  const TreeNodeElement* ProcessTreeNodeLeave(const TreeNodeElement* root, const T* x_data) const;
+
+  std::vector<TreeNodeElement> nodes_;
+  std::vector<TreeNodeWeight> weights_;
+  std::vector<uint32_t> roots_;
+  // tree_blocks_[b] is the first tree of block b, the last entry is NumTrees().
+  std::vector<size_t> tree_blocks_;
+  int64_t max_feature_id_;
+  // set when every branch node is BRANCH_LEQ and no node tracks missing values, the common case for
+  // models exported from xgboost, lightgbm and scikit-learn.
+  bool all_branch_leq_;
+
+  static constexpr int64_t kMaxTreeDepth = 1000;
+  // number of nodes per tree block, 4096 nodes use 128KB
+  static constexpr size_t kNodesPerTreeBlock = 4096;
+  // number of rows evaluated against one tree block before moving to the next
+  static constexpr int64_t kRowsPerBlock = 64;
+  // estimated cost of walking down one tree for one row, used to size the parallel blocks
+  static constexpr double kCyclesPerTree = 40;
+};
+
+template <typename T>
+inline const TreeNodeElement* TreeEnsembleCommon::ProcessTreeNodeLeave(const TreeNodeElement* root,
+                                                                        const T* x_data) const {
+  const TreeNodeElement* nodes = nodes_.data();
+  const TreeNodeElement* node = root;
+  int64_t loopcount = 0;
+  if (all_branch_leq_) {
+    while (node->mode != NODE_MODE::LEAF) {
+      node = nodes + (x_data[node->feature_id] <= node->value ? node->truenode : node->falsenode);
+      if (++loopcount > kMaxTreeDepth) break;
+    }
+    return node;
+  }
+
+  while (node->mode != NODE_MODE::LEAF) {
+    T val = x_data[node->feature_id];
+    bool tracktrue = node->missing_tracks_true && std::isnan(static_cast<float>(val));
+    float threshold = node->value;
+    bool cond;
+    switch (node->mode) {
+      case NODE_MODE::BRANCH_LEQ:
+        cond = val <= threshold;
+        break;
+      case NODE_MODE::BRANCH_LT:
+        cond = val < threshold;
+        break;
+      case NODE_MODE::BRANCH_GTE:
+        cond = val >= threshold;
+        break;
+      case NODE_MODE::BRANCH_GT:
+        cond = val > threshold;
+        break;
+      case NODE_MODE::BRANCH_EQ:
+        cond = val == threshold;
+        break;
+      default:
+        cond = val != threshold;
+        break;
+    }
+    node = nodes + (cond || tracktrue ? node->truenode : node->falsenode);
+    if (++loopcount > kMaxTreeDepth) break;
+  }
+  return node;
+}
+
+template <typename T, typename TAgg>
+void TreeEnsembleCommon::ComputeTreeRange(const T* x_data, int64_t first_row, int64_t last_row, int64_t stride,
+                                          size_t first_tree, size_t last_tree, int64_t n_scores,
+                                          ScoreValue* scores) const {
+  const TreeNodeElement* nodes = nodes_.data();
+  const TreeNodeWeight* weights = weights_.data();
+  for (int64_t row = first_row; row < last_row; ++row) {
+    const T* x_row = x_data + row * stride;
+    ScoreValue* row_scores = scores + row * n_scores;
+    for (size_t j = first_tree; j < last_tree; ++j) {
+      const TreeNodeElement* leaf = ProcessTreeNodeLeave(nodes + roots_[j], x_row);
+      const TreeNodeWeight* w = weights + leaf->weights_begin;
+      for (uint32_t k = 0; k < leaf->weights_count; ++k, ++w) {
+        TAgg::Add(row_scores[w->id], w->value);
+      }
+    }
+  }
+}
+
+template <typename T, typename TAgg>
+void TreeEnsembleCommon::ComputeScoresAgg(concurrency::ThreadPool* tp, const T* x_data, int64_t N, int64_t stride,
+                                          int64_t n_scores, ScoreValue* scores) const {
+  const int32_t num_batches = tp == nullptr ? 1 : tp->NumThreads() + 1;
+  const size_t num_blocks = tree_blocks_.size() - 1;
+  const size_t n_trees = NumTrees();
+  // a row walks one path of about kCyclesPerTree cycles down every tree
+  const double cost_per_row = static_cast<double>(n_trees) * kCyclesPerTree;
+
+  if (N >= num_batches) {
+    // Split the rows. Each block of rows is evaluated kRowsPerBlock rows at a time against one block of trees
+    // at a time so both the rows and the nodes of the block stay in cache.
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(N), cost_per_row, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (int64_t row = first; row < last; row += kRowsPerBlock) {
+            int64_t row_end = std::min<int64_t>(row + kRowsPerBlock, last);
+            for (size_t b = 0; b < num_blocks; ++b) {
+              ComputeTreeRange<T, TAgg>(x_data, row, row_end, stride, tree_blocks_[b], tree_blocks_[b + 1],
+                                        n_scores, scores);
+            }
+          }
+        });
+    return;
+  }
+
+  // Fewer rows than threads: split the trees, each batch accumulates into its own buffer which are
+  // merged once all the batches are done.
+  const int32_t num_tree_batches = static_cast<int32_t>(std::min<size_t>(num_batches, n_trees));
+  if (num_tree_batches <= 1) {
+    ComputeTreeRange<T, TAgg>(x_data, 0, N, stride, 0, n_trees, n_scores, scores);
+    return;
+  }
+
+  const size_t buffer_size = static_cast<size_t>(N * n_scores);
+  std::vector<ScoreValue> partial_scores(static_cast<size_t>(num_tree_batches - 1) * buffer_size, ScoreValue{0, 0});
+  const double cost_per_batch = cost_per_row * N / num_tree_batches;
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_tree_batches, cost_per_batch, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t batch = first; batch < last; ++batch) {
+          size_t first_tree = batch * n_trees / num_tree_batches;
+          size_t last_tree = (batch + 1) * n_trees / num_tree_batches;
+          // the first batch accumulates straight into the output buffer
+          ScoreValue* batch_scores = batch == 0 ? scores : partial_scores.data() + (batch - 1) * buffer_size;
+          ComputeTreeRange<T, TAgg>(x_data, 0, N, stride, first_tree, last_tree, n_scores, batch_scores);
+        }
+      });
+  for (int32_t batch = 1; batch < num_tree_batches; ++batch) {
+    const ScoreValue* batch_scores = partial_scores.data() + (batch - 1) * buffer_size;
+    for (size_t i = 0; i < buffer_size; ++i) {
+      TAgg::Merge(scores[i], batch_scores[i]);
+    }
+  }
+}
+
+template <typename T>
+void TreeEnsembleCommon::ComputeScores(concurrency::ThreadPool* tp, const T* x_data, int64_t N, int64_t stride,
+                                       AGGREGATE_FUNCTION aggregate_function, int64_t n_scores,
+                                       ScoreValue* scores) const {
+  switch (aggregate_function) {
+    case AGGREGATE_FUNCTION::MIN:
+      ComputeScoresAgg<T, TreeAggregatorMin>(tp, x_data, N, stride, n_scores, scores);
+      break;
+    case AGGREGATE_FUNCTION::MAX:
+      ComputeScoresAgg<T, TreeAggregatorMax>(tp, x_data, N, stride, n_scores, scores);
+      break;
+    default:
+      // AVERAGE is a SUM divided by the number of trees once all the votes are in
+      ComputeScoresAgg<T, TreeAggregatorSum>(tp, x_data, N, stride, n_scores, scores);
+      break;
+  }
+}
+
+}  // namespace ml
+}  // namespace onnxruntime
@@ -2,6 +2,8 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/zipmap.h"
+#include <algorithm>
+#include <numeric>
 #include "core/util/math_cpuonly.h"
 /**
 https://github.com/onnx/onnx/blob/master/onnx/defs/traditionalml/defs.cc
@@ -35,6 +37,51 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                             DataTypeImpl::GetType<std::vector<std::map<std::int64_t, float>>>()}),
     ZipMapOp);
 
+namespace {
+
+template <typename TKey>
+std::vector<size_t> SortedLabelOrder(const std::vector<TKey>& labels) {
+  std::vector<size_t> order(labels.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  std::stable_sort(order.begin(), order.end(), [&labels](size_t a, size_t b) { return labels[a] < labels[b]; });
+
+  // keep the last of the equal labels, its value is the one the map ends up with
+  std::vector<size_t> unique_order;
+  unique_order.reserve(order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    if (i + 1 < order.size() && !(labels[order[i]] < labels[order[i + 1]])) continue;
+    unique_order.push_back(order[i]);
+  }
+  return unique_order;
+}
+
+template <typename TKey>
+Status ZipRows(OpKernelContext* context, const float* x_data, int64_t batch_size, int64_t features_per_batch,
+               const std::vector<TKey>& labels, const std::vector<size_t>& label_order) {
+  if (features_per_batch != static_cast<int64_t>(labels.size())) {
+    return Status(ONNXRUNTIME,
+                  INVALID_ARGUMENT,
+                  "Input features_per_batch[" + std::to_string(features_per_batch) +
+                      "] != number of classlabels[" + std::to_string(labels.size()) + "]");
+  }
+  auto* y_data = context->Output<std::vector<std::map<TKey, float>>>(0);
+  if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
+
+  y_data->resize(batch_size);
+  for (int64_t n = 0; n < batch_size; n++) {
+    std::map<TKey, float>& map1 = (*y_data)[n];
+    map1.clear();
+    const float* row = x_data + n * features_per_batch;
+    // the labels come in increasing order so every insertion is a constant time append
+    for (size_t j : label_order) {
+      map1.emplace_hint(map1.end(), labels[j], row[j]);
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
 ZipMapOp::ZipMapOp(const OpKernelInfo& info)
     : OpKernel(info),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
@@ -42,6 +89,7 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+  label_order_ = using_strings_ ? SortedLabelOrder(classlabels_strings_) : SortedLabelOrder(classlabels_int64s_);
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -69,48 +117,9 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
   const auto* x_data = X.template Data<float>();
 
   if (using_strings_) {
-    if (features_per_batch != static_cast<int64_t>(classlabels_strings_.size())) {
-      return Status(ONNXRUNTIME,
-                    INVALID_ARGUMENT,
-                    "Input features_per_batch[" + std::to_string(features_per_batch) +
-                        "] != number of classlabels[" + std::to_string(classlabels_strings_.size()) + "]");
-    }
-    auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
-    if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-
-    //auto* y_data = Y->template MutableData<std::vector<std::map<std::string, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int64_t n = 0; n < batch_size; n++) {
-      std::map<std::string, float> map1;
-      for (int64_t j = 0; j < features_per_batch; j++) {
-        map1[classlabels_strings_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map1);
-    }
-  } else {
-    if (features_per_batch != static_cast<int64_t>(classlabels_int64s_.size())) {
-      return Status(ONNXRUNTIME,
-                    INVALID_ARGUMENT,
-                    "Input features_per_batch[" + std::to_string(features_per_batch) +
-                        "] != number of classlabels[" + std::to_string(classlabels_int64s_.size()) + "]");
-    }
-    auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
-    if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    //auto* y_data = Y->template MutableData<std::vector<std::map<int64_t, float>>>();
-    y_data->resize(batch_size);
-    int64_t current_weight_0 = 0;
-    for (int n = 0; n < batch_size; n++) {
-      std::map<int64_t, float> map2;
-      for (int j = 0; j < features_per_batch; j++) {
-        map2[classlabels_int64s_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map2);
-    }
+    return ZipRows(context, x_data, batch_size, features_per_batch, classlabels_strings_, label_order_);
   }
-  return common::Status::OK();
+  return ZipRows(context, x_data, batch_size, features_per_batch, classlabels_int64s_, label_order_);
 }
 }  // namespace ml
 }  // namespace onnxruntime
@@ -16,6 +16,9 @@ class ZipMapOp final : public OpKernel {
   bool using_strings_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
+  // indices of the labels in increasing order, so the maps are built by appending to them. A label given more than
+  // once keeps the index of its last occurrence only.
+  std::vector<size_t> label_order_;
 };
 
 }  // namespace ml
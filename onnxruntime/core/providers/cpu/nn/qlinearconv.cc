@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/nn/qlinearconv.h"
+
+#include <algorithm>
+
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
@@ -50,9 +53,6 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
   auto result_scale_data = *(result_scale->template Data<float>());
 
   const float real_multiplier = (input_scale_data * filter_scale_data) / result_scale_data;
-  int32_t integer_multiplier;
-  int right_shift;
-  QuantizeMultiplier(real_multiplier, &integer_multiplier, &right_shift);
 
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* bias = nullptr;
@@ -104,8 +104,16 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
   const int64_t col_buffer_size = kernel_dim * output_image_size;
   const int bias_offset = static_cast<int>(M / conv_attrs_.group);
 
-  auto col_data = alloc->Alloc(sizeof(uint8_t) * col_buffer_size);
-  BufferUniquePtr col_buffer(col_data, BufferDeleter(alloc));
+  // A pointwise convolution multiplies the filter by the input image directly, there is nothing to unfold.
+  const bool is_pointwise = kernel_size == 1 &&
+                            std::all_of(strides.begin(), strides.end(), [](int64_t s) { return s == 1; }) &&
+                            std::all_of(pads.begin(), pads.end(), [](int64_t p) { return p == 0; });
+
+  BufferUniquePtr col_buffer;
+  if (!is_pointwise) {
+    auto col_data = alloc->Alloc(sizeof(uint8_t) * col_buffer_size);
+    col_buffer = BufferUniquePtr(col_data, BufferDeleter(alloc));
+  }
   auto* col_buffer_data = static_cast<uint8_t*>(col_buffer.get());
 
   TensorShape image_shape = X->Shape().Slice(1);
@@ -114,10 +122,14 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
                           output_shape.GetDims().end());
 
   const size_t kernel_rank = kernel_shape.size();
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
 
   for (int image_id = 0; image_id < N; ++image_id) {
     for (int group_id = 0; group_id < conv_attrs_.group; ++group_id) {
-      if (kernel_rank == 2) {
+      const uint8_t* gemm_input = col_buffer_data;
+      if (is_pointwise) {
+        gemm_input = Xdata + group_id * X_offset;
+      } else if (kernel_rank == 2) {
         math::Im2col<uint8_t, StorageOrder::NCHW>()(
             Xdata + group_id * X_offset,
             C / conv_attrs_.group,
@@ -152,18 +164,21 @@ Status QLinearConv::Compute(OpKernelContext* context) const {
             *input_offset->template Data<uint8_t>());
       }
 
-      GemmlowpMultiplyu8u8_u8(W->template Data<uint8_t>() + group_id * W_offset,
-                              col_buffer_data,
-                              Ydata + group_id * Y_offset,
-                              *filter_offset->template Data<uint8_t>(),
-                              *input_offset->template Data<uint8_t>(),
-                              *result_offset->template Data<uint8_t>(),
-                              static_cast<int>(M / conv_attrs_.group),
-                              static_cast<int>(output_image_size),
-                              static_cast<int>(kernel_dim),
-                              integer_multiplier,
-                              right_shift,
-                              bias == nullptr ? nullptr : bias->template Data<int32_t>() + group_id * bias_offset);
+      QGemmu8u8_u8(static_cast<int>(M / conv_attrs_.group),
+                   static_cast<int>(output_image_size),
+                   static_cast<int>(kernel_dim),
+                   W->template Data<uint8_t>() + group_id * W_offset,
+                   static_cast<int>(kernel_dim),
+                   *filter_offset->template Data<uint8_t>(),
+                   gemm_input,
+                   static_cast<int>(output_image_size),
+                   *input_offset->template Data<uint8_t>(),
+                   Ydata + group_id * Y_offset,
+                   static_cast<int>(output_image_size),
+                   real_multiplier,
+                   *result_offset->template Data<uint8_t>(),
+                   bias == nullptr ? nullptr : bias->template Data<int32_t>() + group_id * bias_offset,
+                   thread_pool);
     }
 
     Xdata += X_offset * conv_attrs_.group;
@@ -6,10 +6,11 @@
 #include "core/common/common.h"
 #include "core/framework/tensor.h"
 
-#include <functional>
-#include <unordered_set>
-#include <ostream>
-#include <iterator>
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/ml/flat_hash_map.h"
+
+#include <algorithm>
+#include <limits>
 
 namespace onnxruntime {
 
@@ -40,170 +41,12 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>()),
     TfIdfVectorizer);
 
-namespace ngram_details {
-
-class NgramEntryBase {
-  size_t id_;  // Id in the pool
- protected:
-  NgramEntryBase(size_t id) : id_(id) {}
-  ~NgramEntryBase() = default;
-
- public:
-  size_t Id() const { return id_; }
-};
-
-template <class T>
-class NgramEntry;
-
-template <>
-class NgramEntry<int64_t> : public NgramEntryBase {
-  std::vector<int64_t> items_;
-  size_t hash_ = 0;
-
-  void RunningHash(int64_t v) {
-    std::hash<int64_t> hf;
-    hash_ ^= hf(v) + 0x9e3779b9 + (hash_ << 6) + (hash_ >> 2);
-  }
-
- public:
-  template <typename ForwardIter>
-  explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntryBase(id) {
-    while (first != last) {
-      RunningHash(*first);
-      items_.push_back(*first);
-      ++first;
-    }
-    assert(!items_.empty());
-  }
-  // For sampling
-  explicit NgramEntry() : NgramEntryBase(0) {}
-  void AddItem(int64_t v) {
-    items_.push_back(v);
-    RunningHash(v);
-  }
-  void DebugPrint() const {
-    std::copy(items_.cbegin(), items_.cend(), std::ostream_iterator<int64_t>(std::cout, ","));
-    std::cout << std::endl;
-  }
-  void Clear() {
-    items_.clear();
-    hash_ = 0;
-  }
-  bool operator==(const NgramEntry& o) const {
-    return items_ == o.items_;
-  }
-  size_t Hash() const {
-    return hash_;
-  }
-};
-
-template <>
-class NgramEntry<int32_t> : public NgramEntry<int64_t> {
- public:
-  template <typename ForwardIter>
-  explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntry<int64_t>(id, first, last) {}
-  explicit NgramEntry() = default;
-};
-
-template <>
-class NgramEntry<std::string> : public NgramEntryBase {
- private:
-  std::vector<std::reference_wrapper<const std::string>> items_;
-  size_t hash_ = 0;
-
-  void RunningHash(const std::string& s) {
-    std::hash<std::string> hf;
-    hash_ ^= hf(s) + 0x9e3779b9 + (hash_ << 6) + (hash_ >> 2);
-  }
-
- public:
-  template <typename ForwardIter>
-  explicit NgramEntry(size_t id, ForwardIter first, ForwardIter last) : NgramEntryBase(id) {
-    while (first != last) {
-      RunningHash(*first);
-      items_.push_back(std::cref(*first));
-      ++first;
-    }
-    assert(!items_.empty());
-  }
-  explicit NgramEntry() : NgramEntryBase(0) {}
-  void AddItem(const std::string& s) {
-    items_.push_back(std::cref(s));
-    RunningHash(s);
-  }
-  void DebugPrint() const {
-    std::copy(items_.cbegin(), items_.cend(), std::ostream_iterator<std::string>(std::cout, ","));
-    std::cout << std::endl;
-  }
-  void Clear() {
-    items_.clear();
-    hash_ = 0;
-  }
-
-  bool operator==(const NgramEntry& o) const {
-    if (items_.size() == o.items_.size()) {
-      std::equal_to<std::string> pred;
-      for (size_t i = 0; i < items_.size(); ++i) {
-        if (!pred(items_[i], o.items_[i])) {
-          return false;
-        }
-      }
-      return true;
-    }
-    return false;
-  }
-  size_t Hash() const {
-    return hash_;
-  }
-};
-
-template <typename ForwardIter, typename Cont>
-inline void Emplace(ForwardIter first, size_t ngrams, size_t ngram_size, size_t& ngram_id, Cont& c) {
-  for (; ngrams > 0; --ngrams) {
-    c.emplace(ngram_id, first, first + ngram_size);
-    first += ngram_size;
-    ++ngram_id;
-  }
-}
-
-}  // namespace ngram_details
-}  // namespace onnxruntime
-
-using namespace onnxruntime::ngram_details;
-
-namespace std {
-template <typename T>
-struct hash<NgramEntry<T>> {
-  typedef NgramEntry<T> argument_type;
-  typedef size_t result_type;
-  result_type operator()(const argument_type& a) const {
-    return a.Hash();
-  }
-};
-}  // namespace std
-
-namespace onnxruntime {
-
-using IntegerPoolSet = std::unordered_set<NgramEntry<int64_t>>;
-// Does not own strings, contains references to them. This helps
-// to search by string references that point to the current input.
-using StringPoolSet = std::unordered_set<NgramEntry<std::string>>;
-
-template <typename T>
-struct Return;
-
-template <>
-struct Return<int64_t> {
-  using type = IntegerPoolSet::const_iterator;
-};
-
-template <>
-struct Return<int32_t> : Return<int64_t> {};
+// Items of the pool are numbered in the order they are first seen, an input item that is not in the pool gets
+// kNoToken. The n-grams are matched on these numbers so each input item is hashed only once.
+constexpr uint32_t kNoToken = std::numeric_limits<uint32_t>::max();
 
-template <>
-struct Return<std::string> {
-  using type = StringPoolSet::const_iterator;
-};
+// Cycles of one step of the n-gram trie, a lookup in the flat hash table of its edges.
+constexpr double kTrieStepCycles = 20.0;
 
 // The weighting criteria.
 // "TF"(term frequency),
@@ -239,12 +82,16 @@ struct TfIdfVectorizer::Impl {
   std::vector<int64_t> ngram_indexes_;
   std::vector<float> weights_;
 
-  std::vector<std::string> pool_strings_;
-  // This set contains references to pool_string_ entries
-  // of pool_strings attribute
-  StringPoolSet str_set_;
-  // This set contains pool_int64s entries
-  IntegerPoolSet int64_set_;
+  // The numbers of the items of pool_strings or pool_int64s, int32 inputs are looked up as int64.
+  ml::FlatHashMap<std::string, uint32_t> str_tokens_;
+  ml::FlatHashMap<int64_t, uint32_t> int64_tokens_;
+  uint32_t token_count_ = 0;
+  // The n-grams of the pool in [min_gram_length, max_gram_length] as a trie whose node 0 is the root. The edges
+  // are in one flat hash table keyed by (parent node << 32 | item number), their values are the child nodes.
+  ml::FlatHashMap<uint64_t, uint32_t> edges_;
+  // The n-gram id (index in ngram_indexes_) of the n-gram ending at each node, -1 for a node that is only the
+  // prefix of longer n-grams.
+  std::vector<int64_t> node_ngram_ids_{-1};
   size_t output_size_ = 0;
 
   Impl() = default;
@@ -252,49 +99,105 @@ struct TfIdfVectorizer::Impl {
   Impl(const Impl&) = delete;
   Impl& operator=(const Impl&) = delete;
 
-  template <typename T>
-  typename Return<T>::type PoolEnd() const;
+  uint32_t TokenOf(int64_t item) const {
+    const uint32_t* token = int64_tokens_.Find(item);
+    return token == nullptr ? kNoToken : *token;
+  }
 
-  template <typename T>
-  typename Return<T>::type PoolFind(const ngram_details::NgramEntry<T>&) const;
+  uint32_t TokenOf(const std::string& item) const {
+    const uint32_t* token = str_tokens_.Find(item);
+    return token == nullptr ? kNoToken : *token;
+  }
 
-  void IncrementCount(size_t ngram_id, size_t row_num,
-                      std::vector<uint32_t>& frequencies) const {
-    assert(ngram_id < ngram_indexes_.size());
-    auto output_idx = row_num * output_size_ + ngram_indexes_[ngram_id];
-    assert(static_cast<size_t>(output_idx) < frequencies.size());
-    ++frequencies[output_idx];
+  static uint64_t EdgeKey(uint32_t node, uint32_t token) {
+    return (static_cast<uint64_t>(node) << 32) | token;
   }
-};
 
-template <>
-inline Return<int64_t>::type TfIdfVectorizer::Impl::PoolEnd<int64_t>() const {
-  return int64_set_.cend();
-}
+  // Returns 0 (the root, which is no one's child) if node has no child for token.
+  uint32_t Child(uint32_t node, uint32_t token) const {
+    if (token == kNoToken) {
+      return 0;
+    }
+    const uint32_t* child = edges_.Find(EdgeKey(node, token));
+    return child == nullptr ? 0 : *child;
+  }
 
-template <>
-inline Return<int32_t>::type TfIdfVectorizer::Impl::PoolEnd<int32_t>() const {
-  return PoolEnd<int64_t>();
-}
+  // Inserts ngrams n-grams of ngram_size items starting at first, numbered from ngram_id.
+  template <typename ForwardIter, typename TokenMap>
+  void AddNgrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t& ngram_id, TokenMap& tokens,
+                 const char* pool_name) {
+    for (; ngrams > 0; --ngrams, ++ngram_id) {
+      uint32_t node = 0;
+      for (size_t i = 0; i < ngram_size; ++i, ++first) {
+        const uint32_t* known_token = tokens.Find(*first);
+        const uint32_t token = known_token == nullptr ? token_count_ : *known_token;
+        if (known_token == nullptr) {
+          tokens.Insert(*first, token_count_++);
+        }
+        const uint32_t child = Child(node, token);
+        if (child != 0) {
+          node = child;
+        } else {
+          ORT_ENFORCE(node_ngram_ids_.size() < kNoToken, "Too many n-grams in ", pool_name);
+          const auto new_node = static_cast<uint32_t>(node_ngram_ids_.size());
+          edges_.Insert(EdgeKey(node, token), new_node);
+          node_ngram_ids_.push_back(-1);
+          node = new_node;
+        }
+      }
+      ORT_ENFORCE(node_ngram_ids_[node] < 0, pool_name, " duplicate ", std::to_string(ngram_size), "-grams detected");
+      node_ngram_ids_[node] = static_cast<int64_t>(ngram_id);
+    }
+  }
 
-template <>
-inline Return<std::string>::type TfIdfVectorizer::Impl::PoolEnd<std::string>() const {
-  return str_set_.cend();
-}
+  void IncrementCount(int64_t ngram_id, uint32_t* row_frequencies) const {
+    assert(static_cast<size_t>(ngram_id) < ngram_indexes_.size());
+    auto output_idx = ngram_indexes_[ngram_id];
+    assert(static_cast<size_t>(output_idx) < output_size_);
+    ++row_frequencies[output_idx];
+  }
 
-template <>
-inline Return<int64_t>::type TfIdfVectorizer::Impl::PoolFind<int64_t>(const NgramEntry<int64_t>& i) const {
-  return int64_set_.find(i);
-}
+  // Counts the n-grams of the pool found in the C items of a row, given by their numbers.
+  void CountNgrams(const uint32_t* tokens, size_t C, uint32_t* row_frequencies) const;
+};
 
-template <>
-inline Return<int32_t>::type TfIdfVectorizer::Impl::PoolFind<int32_t>(const NgramEntry<int32_t>& i) const {
-  return int64_set_.find(i);
-}
+void TfIdfVectorizer::Impl::CountNgrams(const uint32_t* tokens, size_t C, uint32_t* row_frequencies) const {
+  const size_t max_gram_length = max_gram_length_;
+  const size_t max_skip_distance = max_skip_count_ + 1;  // Convert to distance
+  size_t start_ngram_size = min_gram_length_;
+
+  // Treat 1-grams in a special way, they are counted once whatever the skip distance
+  if (start_ngram_size == 1) {
+    for (size_t i = 0; i < C; ++i) {
+      const uint32_t node = Child(0, tokens[i]);
+      if (node != 0 && node_ngram_ids_[node] >= 0) {
+        IncrementCount(node_ngram_ids_[node], row_frequencies);
+      }
+    }
+    if (++start_ngram_size > max_gram_length) {
+      return;
+    }
+  }
 
-template <>
-inline Return<std::string>::type TfIdfVectorizer::Impl::PoolFind<std::string>(const NgramEntry<std::string>& i) const {
-  return str_set_.find(i);
+  for (size_t skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
+    // At least items of start_ngram_size should fit before the end of the row
+    for (size_t start = 0; start + skip_distance * (start_ngram_size - 1) < C; ++start) {
+      // Walk down the trie, so the items of an n-gram are not looked up again for the longer n-grams
+      uint32_t node = 0;
+      for (size_t ngram_size = 1, i = start;
+           ngram_size <= max_gram_length && i < C;
+           ++ngram_size, i += skip_distance) {
+        node = Child(node, tokens[i]);
+        if (node == 0) {
+          break;
+        }
+        // Do not count anything before start_ngram_size
+        if (ngram_size >= start_ngram_size && node_ngram_ids_[node] >= 0) {
+          IncrementCount(node_ngram_ids_[node], row_frequencies);
+        }
+      }
+    }
+  }
 }
 
 TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), impl_(new Impl) {
@@ -353,19 +256,20 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
                 " must be of equal size");
   }
 
+  std::vector<std::string> pool_strings;
   std::vector<int64_t> pool_int64s;
-  status = info.GetAttrs("pool_strings", impl_->pool_strings_);
+  status = info.GetAttrs("pool_strings", pool_strings);
   if (status.IsOK()) {
-    ORT_ENFORCE(!impl_->pool_strings_.empty(), "pool_strings must not be empty if specified");
+    ORT_ENFORCE(!pool_strings.empty(), "pool_strings must not be empty if specified");
   } else {
     status = info.GetAttrs("pool_int64s", pool_int64s);
     ORT_ENFORCE(status.IsOK() && !pool_int64s.empty(), "non-empty pool_int64s is required if pool_strings not provided");
   }
 
   // Iterator via the pool. Insert 1 item for 1-grams, 2 items for 2-grams, etc.
-  const auto total_items = (impl_->pool_strings_.empty()) ? pool_int64s.size() : impl_->pool_strings_.size();
+  const auto total_items = (pool_strings.empty()) ? pool_int64s.size() : pool_strings.size();
   size_t ngram_id = 0;
-  // Load into dictionary only required gram sizes
+  // Load into the trie only required gram sizes
   const size_t min_gram_length = impl_->min_gram_length_;
   const size_t max_gram_length = impl_->max_gram_length_;
   size_t ngram_size = 1;
@@ -379,16 +283,14 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       ORT_ENFORCE((items % ngram_size == 0),
                   "Number of items must compose whole ", std::to_string(ngram_size), "-grams");
       auto ngrams = items / ngram_size;
-      // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
+      // Skip loading into the trie ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
-        if (impl_->pool_strings_.empty()) {
-          auto before_insert = impl_->int64_set_.size();
-          Emplace(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_set_);
-          ORT_ENFORCE((before_insert + ngrams) == impl_->int64_set_.size(), "pool_int64s duplicate ", std::to_string(ngram_size), "-grams detected");
+        if (pool_strings.empty()) {
+          impl_->AddNgrams(pool_int64s.cbegin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_tokens_,
+                           "pool_int64s");
         } else {
-          auto before_insert = impl_->str_set_.size();
-          Emplace(impl_->pool_strings_.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_set_);
-          ORT_ENFORCE((before_insert + ngrams) == impl_->str_set_.size(), "pool_strings duplicate ", std::to_string(ngram_size), "-grams detected");
+          impl_->AddNgrams(pool_strings.cbegin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_tokens_,
+                           "pool_strings");
         }
       } else {
         ngram_id += ngrams;
@@ -455,7 +357,6 @@ void TfIdfVectorizer::OutputResult(OpKernelContext* ctx, size_t B, const std::ve
 template <typename T>
 Status TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx) const {
   const auto& impl = *impl_;
-  auto const set_end = impl.PoolEnd<T>();
 
   auto X = ctx->Input<Tensor>(0);
   auto& input_shape = X->Shape();
@@ -502,81 +403,28 @@ Status TfIdfVectorizer::ComputeImpl(OpKernelContext* ctx) const {
 
   assert((b_dim * C) == total_items);
 
-  const auto max_gram_length = impl.max_gram_length_;
-  const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
-  auto start_ngram_size = impl.min_gram_length_;
   auto const input_data = X->template Data<T>();
-  auto const end_data = input_data + total_items;
-  NgramEntry<T> sample;
-
-  // Treat 1-grams in a special way
-  if (start_ngram_size == 1) {
-    size_t row_num = 0;
-    auto ngram_start = input_data;
-    while (ngram_start < end_data) {
-      auto const ngram_row_end = ngram_start + C;
-      while (ngram_start < ngram_row_end) {
-        sample.Clear();
-        sample.AddItem(*ngram_start);
-        auto hit = impl.PoolFind<T>(sample);
-        if (hit != set_end) {
-          // record frequency
-          auto ngram_id = hit->Id();
-          impl.IncrementCount(ngram_id, row_num, frequencies);
-        }
-        ++ngram_start;
-      }
-      ++row_num;
-      ngram_start = ngram_row_end;
-    }
-    if (++start_ngram_size > max_gram_length) {
-      OutputResult(ctx, B, frequencies);
-      return Status::OK();
-    }
-  }
-
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = input_data;
-    size_t row_num = 0;
-    while (ngram_start < end_data) {
-      assert((B == 0) || (row_num < B));
-      auto const ngram_row_end = ngram_start + C;
-      assert(ngram_row_end <= end_data);
-      while (ngram_start < ngram_row_end) {
-        // Check if any n-gram size in [start_ngram_size..max_gram_length] range
-        // fit before the end of the row so we do not waste time adding [1..start_ngram_size)
-        // At least items of start_ngram_size should fit
-        // last row should match end_data
-        auto at_least_this = ngram_start + skip_distance * (start_ngram_size - 1);
-        if (at_least_this >= ngram_row_end) {
-          break;
-        }
-        sample.Clear();
-        auto ngram_item = ngram_start;
-        for (auto ngram_size = 1;
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item += skip_distance) {
-          sample.AddItem(*ngram_item);
-
-          // Do not test anything before start_ngram_size
-          if (ngram_size >= start_ngram_size) {
-            auto hit = impl.PoolFind<T>(sample);
-            if (hit != set_end) {
-              // record frequency
-              auto ngram_id = hit->Id();
-              impl.IncrementCount(ngram_id, row_num, frequencies);
-            }
+  uint32_t* const frequency_data = frequencies.data();
+  const size_t output_size = impl.output_size_;
+
+  // The rows are independent, each counts into its own row of frequencies
+  const double row_cycles = static_cast<double>(C) * impl.max_gram_length_ * (impl.max_skip_count_ + 1) *
+                            kTrieStepCycles;
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(b_dim),
+      concurrency::TensorOpCost{static_cast<double>(C * sizeof(T)),
+                                static_cast<double>(output_size * sizeof(uint32_t)), row_cycles},
+      [&impl, input_data, frequency_data, output_size, C](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<uint32_t> tokens(C);
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const T* row_data = input_data + row * C;
+          for (size_t i = 0; i < C; ++i) {
+            tokens[i] = impl.TokenOf(row_data[i]);
           }
+          impl.CountNgrams(tokens.data(), C, frequency_data + row * output_size);
         }
-        // Sliding window shift
-        ++ngram_start;
-      }
-      // Next row
-      ngram_start = ngram_row_end;
-      ++row_num;
-    }
-  }
+      });
+
   OutputResult(ctx, B, frequencies);
   return Status::OK();
 }
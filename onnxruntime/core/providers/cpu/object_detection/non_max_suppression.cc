@@ -13,7 +13,8 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 #include "non_max_suppression_helper.h"
-#include <queue>
+#include "core/platform/threadpool.h"
+#include <algorithm>
 
 namespace onnxruntime {
 
@@ -110,6 +111,140 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
+namespace {
+
+struct ScoreIndexPair {
+  float score_{};
+  int64_t index_{};
+
+  ScoreIndexPair() = default;
+  explicit ScoreIndexPair(float score, int64_t idx) : score_(score), index_(idx) {}
+
+  // The heap of candidates pops the top score first, and the lower index first among equal scores.
+  bool operator<(const ScoreIndexPair& rhs) const {
+    return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
+  }
+};
+
+struct BoxCorners {
+  float x_min, y_min, x_max, y_max;
+
+  BoxCorners(const float* box, int64_t center_point_box) {
+    // center_point_box_ only support 0 or 1
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2],
+      MaxMin(box[1], box[3], x_min, x_max);
+      MaxMin(box[0], box[2], y_min, y_max);
+    } else {
+      // 1 == center_point_box_ => boxes data format [x_center, y_center, width, height]
+      float box_width_half = box[2] / 2;
+      float box_height_half = box[3] / 2;
+      x_min = box[0] - box_width_half;
+      x_max = box[0] + box_width_half;
+      y_min = box[1] - box_height_half;
+      y_max = box[1] + box_height_half;
+    }
+  }
+
+  float Area() const { return (x_max - x_min) * (y_max - y_min); }
+};
+
+// The boxes selected for a class, one array per coordinate so a candidate is checked against a block of them in a
+// loop the compiler vectorizes. Boxes with no area never suppress another one and aren't kept.
+struct SelectedBoxes {
+  std::vector<float> x_min, y_min, x_max, y_max, area;
+
+  void Clear() {
+    x_min.clear();
+    y_min.clear();
+    x_max.clear();
+    y_max.clear();
+    area.clear();
+  }
+
+  void Add(const BoxCorners& box, float box_area) {
+    x_min.push_back(box.x_min);
+    y_min.push_back(box.y_min);
+    x_max.push_back(box.x_max);
+    y_max.push_back(box.y_max);
+    area.push_back(box_area);
+  }
+};
+
+constexpr size_t kSuppressBlockSize = 16;
+
+// Same as SuppressByIOU of the candidate box with any of the selected boxes.
+bool SuppressBySelected(const SelectedBoxes& selected, const BoxCorners& box, float box_area, float iou_threshold) {
+  if (!(box_area > .0f)) {
+    return false;
+  }
+
+  const size_t count = selected.area.size();
+  for (size_t block = 0; block < count; block += kSuppressBlockSize) {
+    const size_t block_end = std::min(count, block + kSuppressBlockSize);
+    int suppressed = 0;
+    for (size_t i = block; i < block_end; ++i) {
+      const float intersection_x_min = std::max(selected.x_min[i], box.x_min);
+      const float intersection_y_min = std::max(selected.y_min[i], box.y_min);
+      const float intersection_x_max = std::min(selected.x_max[i], box.x_max);
+      const float intersection_y_max = std::min(selected.y_max[i], box.y_max);
+
+      const float intersection_area = std::max(intersection_x_max - intersection_x_min, .0f) *
+                                      std::max(intersection_y_max - intersection_y_min, .0f);
+      const float union_area = selected.area[i] + box_area - intersection_area;
+
+      suppressed |= (intersection_area > .0f) & (union_area > .0f) & (intersection_area / union_area > iou_threshold);
+    }
+    if (suppressed) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Selects up to max_output_boxes boxes of a (batch, class) by decreasing score into selected_indices. The boxes
+// not above score_threshold are dropped before the candidates are put in a heap, so only the popped candidates are
+// ever ordered. candidates and selected_boxes are scratch space reused across the calls.
+void SelectBoxesOfClass(const float* boxes_data, const float* class_scores, int64_t num_boxes,
+                        const float* score_threshold, int64_t center_point_box, float iou_threshold,
+                        int64_t max_output_boxes, std::vector<ScoreIndexPair>& candidates,
+                        SelectedBoxes& selected_boxes, std::vector<int64_t>& selected_indices) {
+  candidates.clear();
+  if (score_threshold != nullptr) {
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      if (class_scores[box_index] > *score_threshold) {
+        candidates.emplace_back(class_scores[box_index], box_index);
+      }
+    }
+  } else {
+    for (int64_t box_index = 0; box_index < num_boxes; ++box_index) {
+      candidates.emplace_back(class_scores[box_index], box_index);
+    }
+  }
+  std::make_heap(candidates.begin(), candidates.end());
+
+  selected_boxes.Clear();
+  // Get the next box with top score, filter by iou_threshold
+  while (!candidates.empty() && static_cast<int64_t>(selected_indices.size()) < max_output_boxes) {
+    std::pop_heap(candidates.begin(), candidates.end());
+    const int64_t box_index = candidates.back().index_;
+    candidates.pop_back();
+
+    // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
+    const BoxCorners box(boxes_data + 4 * box_index, center_point_box);
+    const float box_area = box.Area();
+    if (!SuppressBySelected(selected_boxes, box, box_area, iou_threshold)) {
+      selected_indices.push_back(box_index);
+      if (box_area > .0f) {
+        selected_boxes.Add(box, box_area);
+      }
+    }
+  }
+}
+
+}  // namespace
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   auto ret = PrepareCompute(ctx, pc);
@@ -129,76 +264,43 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto* const boxes_data = pc.boxes_data_;
   const auto* const scores_data = pc.scores_data_;
-
-  struct ScoreIndexPair {
-    float score_{};
-    int64_t index_{};
-
-    ScoreIndexPair() = default;
-    explicit ScoreIndexPair(float score, int64_t idx) : score_(score), index_(idx) {}
-
-    bool operator<(const ScoreIndexPair& rhs) const {
-      return score_ < rhs.score_;
-    }
-  };
-
   const auto center_point_box = GetCenterPointBox();
 
-  std::vector<SelectedIndex> selected_indices;
-  for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      int64_t box_offset = batch_index * pc.num_boxes_ * 4;
-      // Filter by score_threshold_
-      std::priority_queue<ScoreIndexPair, std::deque<ScoreIndexPair>> sorted_scores_with_index;
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            sorted_scores_with_index.push(ScoreIndexPair(*class_scores, box_index));
-          }
+  // The (batch, class) pairs are independent and split across the thread pool. Each reads the scores of its class
+  // and goes over its candidates heap and IoU checks for a few tens of cycles per box.
+  const int64_t num_batch_classes = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<int64_t>> selected_indices_of_class(static_cast<size_t>(num_batch_classes));
+  const concurrency::TensorOpCost cost{static_cast<double>(pc.num_boxes_ * sizeof(float)), 0,
+                                       static_cast<double>(pc.num_boxes_ * 32)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), num_batch_classes, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<ScoreIndexPair> candidates;
+        SelectedBoxes selected_boxes;
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t batch_index = i / pc.num_classes_;
+          SelectBoxesOfClass(boxes_data + batch_index * pc.num_boxes_ * 4, scores_data + i * pc.num_boxes_,
+                             pc.num_boxes_, pc.score_threshold_ != nullptr ? &score_threshold : nullptr,
+                             center_point_box, iou_threshold, max_output_boxes_per_class, candidates,
+                             selected_boxes, selected_indices_of_class[i]);
         }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          sorted_scores_with_index.push(ScoreIndexPair(*class_scores, box_index));
-        }
-      }
+      });
 
-      ScoreIndexPair next_top_score;
-      std::vector<int64_t> selected_indices_inside_class;
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_scores_with_index.empty()) {
-        next_top_score = sorted_scores_with_index.top();
-        sorted_scores_with_index.pop();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (int64_t selected_index : selected_indices_inside_class) {
-          if (SuppressByIOU(boxes_data + box_offset, selected_index, next_top_score.index_,
-                            center_point_box, iou_threshold)) {
-            selected = false;
-            break;
-          }
-        }
-
-        if (selected) {
-          if (max_output_boxes_per_class > 0 &&
-              static_cast<int64_t>(selected_indices_inside_class.size()) >= max_output_boxes_per_class) {
-            break;
-          }
-          selected_indices_inside_class.push_back(next_top_score.index_);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-      }  //while
-    }    //for class_index
-  }      //for batch_index
+  size_t num_selected = 0;
+  for (const auto& selected : selected_indices_of_class) {
+    num_selected += selected.size();
+  }
 
   const auto last_dim = 3;
-  const auto num_selected = selected_indices.size();
   Tensor* output = ctx->Output(0, {static_cast<int64_t>(num_selected), last_dim});
   ORT_ENFORCE(output != nullptr);
   static_assert(last_dim * sizeof(int64_t) == sizeof(SelectedIndex), "Possible modification of SelectedIndex");
-  memcpy(output->MutableData<int64_t>(), selected_indices.data(), num_selected * sizeof(SelectedIndex));
+  auto* selected_indices = reinterpret_cast<SelectedIndex*>(output->MutableData<int64_t>());
+  for (int64_t i = 0; i < num_batch_classes; ++i) {
+    for (int64_t box_index : selected_indices_of_class[i]) {
+      *selected_indices++ = SelectedIndex(i / pc.num_classes_, i % pc.num_classes_, box_index);
+    }
+  }
 
   return Status::OK();
 }
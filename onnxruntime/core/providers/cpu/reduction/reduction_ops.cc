@@ -2,7 +2,14 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/reduction/reduction_ops.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
 #include "core/providers/common.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 using namespace std;
 namespace onnxruntime {
@@ -118,86 +125,58 @@ REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMax, 11);
 REGISTER_UNARY_ELEMENTWISE_VERSIONED_KERNEL(ArgMin, 1, 10);
 REGISTER_UNARY_ELEMENTWISE_KERNEL(ArgMin, 11);
 
-// When all reduce axises located at the tail of the dims, quite general cases, transpose and extra
-// copy could be skipped to improve performance, if required by check_no_transpose = true;
-// return value: true means transposedInputData is not created/copied, input tensor data could
-//               be direct use as row major matrix [block_size, blocks], where blocks is the
-//               size of each reduce.
-template <typename T>
+namespace {
+
+// Input shape of a reduction with every run of consecutive kept or reduced dims merged into one dim, and the dims
+// of size 1 dropped, so the merged dims alternate between kept and reduced. The reductions walk the input in place
+// with strided loops over this shape, whatever the axes, instead of transposing the reduced axes to the front.
+struct ReduceShape {
+  std::vector<int64_t> dims;
+  std::vector<int64_t> strides;
+  std::vector<bool> reduced;
+  // number of output values, and number of input values reduced into each of them
+  int64_t output_size;
+  int64_t reduced_size;
+};
+
+// Offsets of all the elements of the sub-tensor made of the merged dims [first, last) of shape for which
+// shape.reduced is is_reduced, in row-major order.
+std::vector<int64_t> EnumerateOffsets(const ReduceShape& shape, size_t first, size_t last, bool is_reduced) {
+  std::vector<int64_t> offsets(1, 0);
+  for (size_t d = first; d < last; ++d) {
+    if (shape.reduced[d] != is_reduced) continue;
+    std::vector<int64_t> next;
+    next.reserve(offsets.size() * shape.dims[d]);
+    for (int64_t base : offsets) {
+      for (int64_t i = 0; i < shape.dims[d]; ++i) {
+        next.push_back(base + i * shape.strides[d]);
+      }
+    }
+    offsets.swap(next);
+  }
+  return offsets;
+}
+
+// Computes the output shape, allocates the output and merges the input dims into shape.
+// Returns false when the input is empty and there is nothing to compute.
 bool PrepareForReduce(OpKernelContext* ctx,
-                      std::vector<T>& transposedInputData,
                       Tensor** reducedTensor,
-                      int64_t& block_size,
-                      int64_t& blocks,
+                      ReduceShape& shape,
                       const std::vector<int64_t>& axes_,
-                      bool keepdims_,
-                      bool check_no_transpose = false) {
+                      bool keepdims_) {
   const auto* input_tensor_ptr = ctx->Input<Tensor>(0);
   ORT_ENFORCE(input_tensor_ptr != nullptr);
   const Tensor& input = *input_tensor_ptr;
 
-  size_t ndim = input.Shape().GetDims().size();
-  std::vector<int64_t> axes;
-  axes.reserve(axes_.size());
+  const auto& in_dims = input.Shape().GetDims();
+  size_t ndim = in_dims.size();
+  vector<bool> keep_axis(ndim, !axes_.empty());
   for (int64_t axis : axes_) {
-    axes.push_back(HandleNegativeAxis(axis, static_cast<int64_t>(ndim)));
-  }
-
-  if (axes.empty()) {
-    // This is the default case for non-arg kind reductions. Reduce on all dimensions.
-    for (size_t i = 0; i < ndim; i++) {
-      axes.push_back(i);
-    }
+    // the default for non-arg kind reductions is to reduce on all dimensions
+    keep_axis[HandleNegativeAxis(axis, static_cast<int64_t>(ndim))] = false;
   }
 
-  std::sort(axes.begin(), axes.end());
-
-  // If all reduced axes are located at the tail of the input shape, then copy could be skipped is required
-  bool need_copy = true;
-  if (axes.size() <= ndim &&
-      axes.front() == static_cast<int64_t>(ndim - axes.size()) &&
-      axes.back() == static_cast<int64_t>(ndim) - 1) {
-    need_copy = false;
-  }
-
-  vector<bool> keep_axis(ndim, true);
-  for (auto i : axes) {
-    keep_axis[i] = false;
-  }
-
-  //transpose the input so that all to-be-reduced axes are at the head
-  vector<int64_t> transposed_axes(axes.begin(), axes.end());
-  for (size_t i = 0; i < ndim; ++i) {
-    if (keep_axis[i]) {
-      transposed_axes.push_back(i);
-    }
-  }
-
-  vector<int64_t> new_dims_(transposed_axes.size());
-  for (size_t i = 0; i < transposed_axes.size(); ++i) {
-    new_dims_[i] = input.Shape().GetDims().at(transposed_axes[i]);
-  }
-
-  int num_axes = static_cast<int>(transposed_axes.size());
-  auto in_dims = input.Shape().GetDims();
-
-  // Measure amount of contiguous data we can copy at once
-  int64_t blocksize = 1;
-  int n_shared_idxs = 0;
-  for (int i = num_axes - 1; i >= 0; --i) {
-    if (transposed_axes[i] == i) {
-      blocksize *= new_dims_[i];
-      ++n_shared_idxs;
-    } else {
-      break;
-    }
-  }
-
-  const T* from_data = input.template Data<T>();
-  size_t count = input.Shape().Size();
-
   //set to-be-reduced axes to one. squeeze is keepdims_ is false
-  int64_t first_dim = 1;
   std::vector<int64_t> reduced_dims;
   reduced_dims.reserve(in_dims.size());
 
@@ -206,7 +185,6 @@ bool PrepareForReduce(OpKernelContext* ctx,
     if (keep_axis[i]) {
       reduced_dims.push_back(in_dim);
     } else {
-      first_dim *= in_dim;
       if (keepdims_) {
         reduced_dims.push_back(in_dim == 0 ? 0 : 1);
       } else {
@@ -224,335 +202,354 @@ bool PrepareForReduce(OpKernelContext* ctx,
   }
 
   *reducedTensor = ctx->Output(0, std::move(reduced_dims));
-  auto num_elements = input.Shape().Size();
 
   // edge case. one or more input dims with value of 0.
-  if (num_elements == 0) {
-    block_size = blocks = 0;
-    return true;
+  if (input.Shape().Size() == 0) {
+    return false;
   }
 
-  block_size = num_elements / first_dim;
-  blocks = first_dim;
-
-  if (!need_copy && check_no_transpose) {
-    return true;
+  shape.dims.clear();
+  shape.strides.clear();
+  shape.reduced.clear();
+  shape.output_size = 1;
+  shape.reduced_size = 1;
+  int64_t stride = 1;
+  for (size_t i = ndim; i-- > 0;) {
+    const int64_t dim = in_dims[i];
+    if (keep_axis[i]) {
+      shape.output_size *= dim;
+    } else {
+      shape.reduced_size *= dim;
+    }
+    if (dim != 1) {
+      if (!shape.dims.empty() && shape.reduced.back() == !keep_axis[i]) {
+        shape.dims.back() *= dim;
+      } else {
+        shape.dims.push_back(dim);
+        shape.strides.push_back(stride);
+        shape.reduced.push_back(!keep_axis[i]);
+      }
+    }
+    stride *= dim;
   }
-
-  transposedInputData.resize(input.Shape().Size(), 0);
-  T* to_data = &transposedInputData[0];
-  if (num_axes < 2 || n_shared_idxs == num_axes) {
-    memcpy(to_data, from_data, count * sizeof(T));
-    return false;
+  if (shape.dims.empty()) {
+    // a single value
+    shape.dims.push_back(1);
+    shape.strides.push_back(1);
+    shape.reduced.push_back(false);
   }
+  std::reverse(shape.dims.begin(), shape.dims.end());
+  std::reverse(shape.strides.begin(), shape.strides.end());
+  std::reverse(shape.reduced.begin(), shape.reduced.end());
+  return true;
+}
 
-  int itr_axes = num_axes - n_shared_idxs;
+// The aggregators fold the input values into one accumulator per output value. Update folds a contiguous run of
+// values into one accumulator, UpdateVector folds a contiguous run of values into as many accumulators,
+// elementwise. Both are vectorized through Eigen. Aggregators with two_loops set read the values twice, PreUpdate
+// and PreUpdateVector are called on the first pass.
 
-  // Calculate strides
-  std::vector<int64_t> stride_x(itr_axes, 0);
-  for (size_t i = 0; static_cast<int>(i) < itr_axes; i++) {
-    stride_x[i] = 1;
-    for (size_t j = transposed_axes[i] + 1; static_cast<int>(j) < itr_axes; j++) {
-      stride_x[i] *= in_dims[j];
-    }
+template <typename T>
+struct ReduceAggregatorSum {
+  using AccType = T;
+  static constexpr bool two_loops = false;
+  static AccType Init() { return 0; }
+  static void PreUpdate(AccType&, const T*, int64_t) {}
+  static void PreUpdateVector(AccType*, const T*, int64_t) {}
+  static void Update(AccType& acc, const T* data, int64_t size) {
+    acc += ConstEigenVectorMap<T>(data, size).sum();
   }
+  static void UpdateVector(AccType* acc, const T* data, int64_t size) {
+    EigenVectorMap<T>(acc, size) += ConstEigenVectorMap<T>(data, size);
+  }
+  static T Finalize(const AccType& acc, int64_t) { return acc; }
+};
 
-  std::vector<int64_t> itr_idxs(itr_axes, 0);
+template <typename T>
+struct ReduceAggregatorMean : ReduceAggregatorSum<T> {
+  static T Finalize(const T& acc, int64_t count) { return acc / static_cast<T>(count); }
+};
 
-  // Branch here to avoid branching within the loop
-  if (blocksize > 1) {
-    for (size_t index = 0; index < (count / blocksize); index++) {
-      int64_t from_index = 0;
-      for (int i = 0; i < itr_axes; ++i) {
-        from_index += stride_x[i] * itr_idxs[i];
-      }
+template <typename T>
+struct ReduceAggregatorLogSum : ReduceAggregatorSum<T> {
+  static T Finalize(const T& acc, int64_t) { return static_cast<T>(std::log(acc)); }
+};
 
-      memcpy(
-          to_data + blocksize * index,
-          from_data + blocksize * from_index,
-          blocksize * sizeof(T));
+template <typename T>
+struct ReduceAggregatorSumSquare : ReduceAggregatorSum<T> {
+  static void Update(T& acc, const T* data, int64_t size) {
+    acc += ConstEigenVectorMap<T>(data, size).squaredNorm();
+  }
+  static void UpdateVector(T* acc, const T* data, int64_t size) {
+    EigenVectorArrayMap<T>(acc, size) += ConstEigenVectorArrayMap<T>(data, size).square();
+  }
+};
 
-      ++itr_idxs[itr_axes - 1];
-      for (int i = itr_axes - 1; i >= 1; --i) {
-        auto expected_dim = new_dims_[i];
-        if (itr_idxs[i] < expected_dim) {
-          break;
-        }
-        itr_idxs[i] %= expected_dim;
-        ++itr_idxs[i - 1];
-      }
-    }
-  } else {
-    for (size_t index = 0; index < count; index++) {
-      int64_t from_index = 0;
-      for (int i = 0; i < itr_axes; ++i) {
-        from_index += stride_x[i] * itr_idxs[i];
-      }
+template <typename T>
+struct ReduceAggregatorL2 : ReduceAggregatorSumSquare<T> {
+  static T Finalize(const T& acc, int64_t) { return static_cast<T>(std::sqrt(acc)); }
+};
 
-      *(to_data + index) = *(from_data + from_index);
+template <typename T>
+struct ReduceAggregatorL1 : ReduceAggregatorSum<T> {
+  static void Update(T& acc, const T* data, int64_t size) {
+    acc += ConstEigenVectorMap<T>(data, size).cwiseAbs().sum();
+  }
+  static void UpdateVector(T* acc, const T* data, int64_t size) {
+    EigenVectorArrayMap<T>(acc, size) += ConstEigenVectorArrayMap<T>(data, size).abs();
+  }
+};
 
-      ++itr_idxs[itr_axes - 1];
-      for (int i = itr_axes - 1; i >= 1; --i) {
-        auto expected_dim = new_dims_[i];
-        if (itr_idxs[i] < expected_dim) {
-          break;
-        }
-        itr_idxs[i] %= expected_dim;
-        ++itr_idxs[i - 1];
-      }
-    }
+template <typename T>
+struct ReduceAggregatorProd : ReduceAggregatorSum<T> {
+  static T Init() { return 1; }
+  static void Update(T& acc, const T* data, int64_t size) {
+    acc *= ConstEigenVectorMap<T>(data, size).prod();
   }
-  return false;
-}
+  static void UpdateVector(T* acc, const T* data, int64_t size) {
+    EigenVectorArrayMap<T>(acc, size) *= ConstEigenVectorArrayMap<T>(data, size);
+  }
+};
 
 template <typename T>
-Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+struct ReduceAggregatorMax : ReduceAggregatorSum<T> {
+  static T Init() { return std::numeric_limits<T>::lowest(); }
+  static void Update(T& acc, const T* data, int64_t size) {
+    acc = std::max(acc, ConstEigenVectorMap<T>(data, size).maxCoeff());
+  }
+  static void UpdateVector(T* acc, const T* data, int64_t size) {
+    EigenVectorMap<T> acc_vec(acc, size);
+    acc_vec = acc_vec.cwiseMax(ConstEigenVectorMap<T>(data, size));
+  }
+};
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+struct ReduceAggregatorMin : ReduceAggregatorSum<T> {
+  static T Init() { return std::numeric_limits<T>::max(); }
+  static void Update(T& acc, const T* data, int64_t size) {
+    acc = std::min(acc, ConstEigenVectorMap<T>(data, size).minCoeff());
+  }
+  static void UpdateVector(T* acc, const T* data, int64_t size) {
+    EigenVectorMap<T> acc_vec(acc, size);
+    acc_vec = acc_vec.cwiseMin(ConstEigenVectorMap<T>(data, size));
+  }
+};
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).cwiseAbs().rowwise().sum();
+// log(sum(exp(x - max(x)))) + max(x), the maximum is found on the first pass
+template <typename T>
+struct ReduceAggregatorLogSumExp {
+  struct AccType {
+    T max;
+    T sum;
+  };
+  static constexpr bool two_loops = true;
+  static AccType Init() { return {std::numeric_limits<T>::lowest(), 0}; }
+  static void PreUpdate(AccType& acc, const T* data, int64_t size) {
+    acc.max = std::max(acc.max, ConstEigenVectorMap<T>(data, size).maxCoeff());
+  }
+  static void PreUpdateVector(AccType* acc, const T* data, int64_t size) {
+    for (int64_t i = 0; i < size; ++i) {
+      acc[i].max = std::max(acc[i].max, data[i]);
+    }
+  }
+  static void Update(AccType& acc, const T* data, int64_t size) {
+    for (int64_t i = 0; i < size; ++i) {
+      acc.sum += static_cast<T>(std::exp(data[i] - acc.max));
+    }
+  }
+  static void UpdateVector(AccType* acc, const T* data, int64_t size) {
+    for (int64_t i = 0; i < size; ++i) {
+      acc[i].sum += static_cast<T>(std::exp(data[i] - acc[i].max));
+    }
+  }
+  static T Finalize(const AccType& acc, int64_t) { return static_cast<T>(std::log(acc.sum) + acc.max); }
+};
+
+// Reduces the input of shape into output, split across the output values on the thread pool.
+template <typename T, typename TAgg>
+void ReduceNoTranspose(const T* input, T* output, const ReduceShape& shape, concurrency::ThreadPool* tp) {
+  using AccType = typename TAgg::AccType;
+  const size_t num_dims = shape.dims.size();
+  const int64_t inner_size = shape.dims.back();
+  const int64_t reduced_size = shape.reduced_size;
+  const concurrency::TensorOpCost cost{static_cast<double>(reduced_size * sizeof(T)), static_cast<double>(sizeof(T)),
+                                       static_cast<double>(reduced_size * (TAgg::two_loops ? 2 : 1))};
+
+  if (shape.reduced.back()) {
+    // The innermost dim is reduced: every output value is the reduction of contiguous runs of inner_size values,
+    // one run per offset of the outer reduced dims.
+    const std::vector<int64_t> output_offsets = EnumerateOffsets(shape, 0, num_dims, false);
+    const std::vector<int64_t> reduced_offsets = EnumerateOffsets(shape, 0, num_dims - 1, true);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, shape.output_size, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const T* data = input + output_offsets[i];
+            AccType acc = TAgg::Init();
+            if (TAgg::two_loops) {
+              for (int64_t offset : reduced_offsets) {
+                TAgg::PreUpdate(acc, data + offset, inner_size);
+              }
+            }
+            for (int64_t offset : reduced_offsets) {
+              TAgg::Update(acc, data + offset, inner_size);
+            }
+            output[i] = TAgg::Finalize(acc, reduced_size);
+          }
+        });
+    return;
+  }
 
-  return Status::OK();
+  // The innermost dim is kept: the output is made of rows of inner_size contiguous values, a row is the
+  // elementwise reduction of one input row per offset of the reduced dims. [B, S, H] reduced over S is B rows
+  // of H values, each the sum of S rows of the input.
+  const std::vector<int64_t> row_offsets = EnumerateOffsets(shape, 0, num_dims - 1, false);
+  const std::vector<int64_t> reduced_offsets = EnumerateOffsets(shape, 0, num_dims - 1, true);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, shape.output_size, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<AccType> acc;
+        while (first < last) {
+          // the part of the output row that falls in [first, last)
+          const int64_t row = first / inner_size;
+          const int64_t column = first % inner_size;
+          const int64_t size = std::min<int64_t>(inner_size - column, last - first);
+          const T* data = input + row_offsets[row] + column;
+          acc.assign(size, TAgg::Init());
+          if (TAgg::two_loops) {
+            for (int64_t offset : reduced_offsets) {
+              TAgg::PreUpdateVector(acc.data(), data + offset, size);
+            }
+          }
+          for (int64_t offset : reduced_offsets) {
+            TAgg::UpdateVector(acc.data(), data + offset, size);
+          }
+          T* out = output + first;
+          for (int64_t i = 0; i < size; ++i) {
+            out[i] = TAgg::Finalize(acc[i], reduced_size);
+          }
+          first += size;
+        }
+      });
 }
 
-template <typename T>
-Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size;
-  int64_t blocks;
+template <typename T, typename TAgg>
+Status ReduceCompute(OpKernelContext* ctx, const std::vector<int64_t>& axes, bool keepdims) {
+  ReduceShape shape;
   Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+  if (PrepareForReduce(ctx, &reduced, shape, axes, keepdims)) {
+    ReduceNoTranspose<T, TAgg>(ctx->Input<Tensor>(0)->template Data<T>(), reduced->template MutableData<T>(), shape,
+                               ctx->GetOperatorThreadPool());
+  }
+  return Status::OK();
+}
 
-  T* output_data = reduced->template MutableData<T>();
+// ArgMax and ArgMin reduce a single axis: the input is seen as [outer, axis, inner] and the index of the first
+// extreme value along the axis is kept, as Eigen's maxCoeff and minCoeff do.
+template <typename T, typename TCompare>
+Status ArgReduceCompute(OpKernelContext* ctx, const std::vector<int64_t>& axes, bool keepdims) {
+  ReduceShape shape;
+  Tensor* reduced;
+  if (!PrepareForReduce(ctx, &reduced, shape, axes, keepdims)) {
+    return Status::OK();
+  }
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().norm();
+  const Tensor& input = *ctx->Input<Tensor>(0);
+  const auto& in_dims = input.Shape().GetDims();
+  const int64_t axis = HandleNegativeAxis(axes[0], static_cast<int64_t>(in_dims.size()));
+  const int64_t axis_size = in_dims[axis];
+  const int64_t inner_size = input.Shape().SizeFromDimension(axis + 1);
+  const T* input_data = input.template Data<T>();
+  int64_t* output_data = reduced->template MutableData<int64_t>();
+  TCompare compare;
+
+  const concurrency::TensorOpCost cost{static_cast<double>(axis_size * sizeof(T)), static_cast<double>(sizeof(int64_t)),
+                                       static_cast<double>(axis_size)};
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), shape.output_size, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<T> best;
+        while (first < last) {
+          const int64_t outer = first / inner_size;
+          const int64_t column = first % inner_size;
+          const int64_t size = std::min<int64_t>(inner_size - column, last - first);
+          const T* data = input_data + outer * axis_size * inner_size + column;
+          int64_t* out = output_data + first;
+          best.assign(data, data + size);
+          std::fill(out, out + size, 0);
+          for (int64_t a = 1; a < axis_size; ++a) {
+            const T* row = data + a * inner_size;
+            for (int64_t i = 0; i < size; ++i) {
+              if (compare(row[i], best[i])) {
+                best[i] = row[i];
+                out[i] = a;
+              }
+            }
+          }
+          first += size;
+        }
+      });
 
   return Status::OK();
 }
 
-template <typename T>
-Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
+}  // namespace
 
-  T* output_data = reduced->template MutableData<T>();
+template <typename T>
+Status ReduceL1<T>::Compute(OpKernelContext* ctx) const {
+  return ReduceCompute<T, ReduceAggregatorL1<T>>(ctx, axes_, keepdims_);
+}
 
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  for (int j = 0; j < block_size; ++j) {
-    *(output_data) = static_cast<T>(std::log(*(output_data)));
-    ++output_data;
-  }
+template <typename T>
+Status ReduceL2<T>::Compute(OpKernelContext* ctx) const {
+  return ReduceCompute<T, ReduceAggregatorL2<T>>(ctx, axes_, keepdims_);
+}
 
-  return Status::OK();
+template <typename T>
+Status ReduceLogSum<T>::Compute(OpKernelContext* ctx) const {
+  return ReduceCompute<T, ReduceAggregatorLogSum<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceLogSumExp<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  for (int j = 0; j < block_size; ++j) {
-    T max_value = std::numeric_limits<T>::lowest();
-    for (int i = 0; i < blocks; ++i) {
-      max_value = std::max(max_value, transposedInputData[i * block_size + j]);
-    }
-    T scaled_exp_sum = 0;
-    for (int i = 0; i < blocks; ++i) {
-      scaled_exp_sum += static_cast<T>(std::exp(transposedInputData[i * block_size + j] - max_value));
-    }
-    *(output_data++) = static_cast<T>(std::log(scaled_exp_sum) + max_value);
-  }
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorLogSumExp<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceMax<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).maxCoeff();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().maxCoeff();
-  }
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorMax<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceMean<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).mean();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().mean();
-  }
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorMean<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceMin<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).minCoeff();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().minCoeff();
-  }
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorMin<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceProd<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().prod();
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorProd<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceSum<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  bool no_transpose = PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_, true);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  if (no_transpose) {
-    const T* input_data = ctx->Input<Tensor>(0)->template Data<T>();
-
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-    for (int64_t i = 0; i < block_size; ++i) {
-      output_data[i] = ConstEigenVectorMap<T>(input_data + (i * blocks), blocks).sum();
-    }
-  } else {
-    EigenVectorMap<T> out_vec(output_data, block_size);
-    out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().sum();
-  }
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorSum<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ReduceSumSquare<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  T* output_data = reduced->template MutableData<T>();
-
-  EigenVectorMap<T> out_vec(output_data, block_size);
-  out_vec = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks).rowwise().squaredNorm();
-
-  return Status::OK();
+  return ReduceCompute<T, ReduceAggregatorSumSquare<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ArgMax<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  auto* output_data = reduced->template MutableData<int64_t>();
-
-  Eigen::MatrixXf::Index maxIndex;
-  auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
-  for (int i = 0; i < block_size; ++i) {
-    matrixData.row(i).maxCoeff(&maxIndex);
-    *(output_data++) = maxIndex;
-  }
-
-  return Status::OK();
+  return ArgReduceCompute<T, std::greater<T>>(ctx, axes_, keepdims_);
 }
 
 template <typename T>
 Status ArgMin<T>::Compute(OpKernelContext* ctx) const {
-  std::vector<T> transposedInputData;
-  int64_t block_size;
-  int64_t blocks;
-  Tensor* reduced;
-  PrepareForReduce<T>(ctx, transposedInputData, &reduced, block_size, blocks, axes_, keepdims_);
-
-  auto* output_data = reduced->template MutableData<int64_t>();
-
-  Eigen::MatrixXf::Index minIndex;
-  auto matrixData = ConstEigenMatrixMap<T>(&transposedInputData[0], block_size, blocks);
-  for (int i = 0; i < block_size; ++i) {
-    matrixData.row(i).minCoeff(&minIndex);
-    *(output_data++) = minIndex;
-  }
-
-  return Status::OK();
+  return ArgReduceCompute<T, std::less<T>>(ctx, axes_, keepdims_);
 }
 
 }  // namespace onnxruntime
@@ -210,9 +210,12 @@ T* SafeRawPointer(typename gsl::span<T> span, size_t offset, size_t size) {
   return span.data() + offset;
 }
 
+// Runs lambda(i) for i in [0, max) with a stride of step. The calls are spread over ttp, the calling thread runs
+// the first one. Runs them in order on the calling thread if ttp is nullptr. The calling thread waits for the calls
+// it queued, so it must not be a thread of ttp: calling this from a task of ttp can deadlock the pool.
 template <typename TLambda>
 void ExecuteLambdaInParallel(const std::string& name, TLambda lambda, int max, int step,
-                             onnxruntime::concurrency::ThreadPool& ttp,
+                             onnxruntime::concurrency::ThreadPool* ttp,
                              const ::onnxruntime::logging::Logger& logger) {
   // #define NOTHREADS to execute the lambdas directly and in order if you need to do that to debug
 
@@ -229,6 +232,13 @@ void ExecuteLambdaInParallel(const std::string& name, TLambda lambda, int max, i
   ORT_UNUSED_PARAMETER(name);
   ORT_UNUSED_PARAMETER(logger);
 
+  if (ttp == nullptr || max <= step) {
+    for (int i = 0; i < max; i += step) {
+      lambda(i);
+    }
+    return;
+  }
+
   // ORT_ENFORCE may and does throw at times from within the tasks that run
   // on a thread-pool. Without propagating exceptions the process exits silently
   // which will make diagnosing bugs more difficult.
@@ -248,12 +258,12 @@ void ExecuteLambdaInParallel(const std::string& name, TLambda lambda, int max, i
   //
   const int total_tasks = max / (step > 0 ? step : 1) + (max % step > 0 ? 1 : 0);
   std::vector<std::future<void> > futures;
-  futures.reserve(total_tasks);
+  futures.reserve(total_tasks - 1);
 
-  for (int i = 0, t = 0; i < max; i += step, ++t) {
+  for (int i = step; i < max; i += step) {
     auto p_ptr = std::make_shared<std::promise<void> >();
     futures.push_back(p_ptr->get_future());
-    ttp.Schedule([p_ptr, lambda, i]() {
+    ttp->Schedule([p_ptr, lambda, i]() {
       try {
         lambda(i);
         p_ptr->set_value();
@@ -267,6 +277,12 @@ void ExecuteLambdaInParallel(const std::string& name, TLambda lambda, int max, i
   // even though one or more have already thrown. We will store
   // the first exception and then will re-throw at the end.
   std::exception_ptr pending_exception;
+  try {
+    lambda(0);
+  } catch (...) {
+    pending_exception = std::current_exception();
+  }
+
   for (auto& fut : futures) {
     try {
       // get() will re-throw any exceptions
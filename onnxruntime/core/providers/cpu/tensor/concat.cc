@@ -4,6 +4,8 @@
 #include "core/providers/cpu/tensor/concat.h"
 #include "core/providers/common.h"
 #include "core/framework/TensorSeq.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
 
@@ -152,52 +154,55 @@ Status ConcatBase::PrepareForCompute(OpKernelContext* ctx,
 }
 
 // This method computes the output tensor for Concat/ConcatFromSequence ops
-Status ConcatBase::ComputeImpl(Prepare& p) const {
+Status ConcatBase::ComputeImpl(Prepare& p, concurrency::ThreadPool* tp) const {
   int input_count = static_cast<int>(p.inputs.size());
-  int64_t initial_output_offset = 0;  // initial offset for each input
   auto element_bytes = p.output_tensor->DataType()->Size();
-  for (int input_index = 0; input_index < input_count; input_index++) {
-    const auto& prep = p.inputs[input_index];
-
-    // no data in this tensor - so skip it
-    if (prep.num_elements == 0)
-      continue;
-
-    auto input_axis_pitch = prep.axis_pitch;
-    const uint8_t* input = static_cast<const uint8_t*>(prep.tensor->DataRaw());
-
-    auto input_size = prep.num_elements;
-
-    // Copy the data across. For every 'input_axis_pitch' values copied, we move over by the 'output_axis_pitch'
-    // TODO: Optimization possibility: There are cases where we simply need to "merge" raw buffers and this 
-    // could be done without the pointer house-keeping as below. Some scenarios whether this is possible are:
-    // 1) Concatenating on input axis = 0
-    // 2) Stacking on output axis = 0
-    // 3) Stacking scalars
-    uint8_t* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
-    int64_t cur_out_offset = 0;
-    int64_t cur_in_offset = 0;
-    for (size_t idx_copy = 0, end = input_size / input_axis_pitch; idx_copy < end; ++idx_copy) {
-      if (p.is_string_type) {
-        size_t out = initial_output_offset + cur_out_offset;
-        for (int idx_item = 0; idx_item < input_axis_pitch; ++idx_item) {
-          reinterpret_cast<std::string*>(output)[out + idx_item] =
-              reinterpret_cast<const std::string*>(input)[cur_in_offset + idx_item];
-        }
-      } else {
-        memcpy(
-            output + (initial_output_offset + cur_out_offset) * element_bytes,
-            input + cur_in_offset * element_bytes,
-            input_axis_pitch * element_bytes);
-      }
-
-      cur_out_offset += p.output_axis_pitch;
-      cur_in_offset += input_axis_pitch;
-    }
 
-    initial_output_offset += input_axis_pitch;
+  // Each output row (every 'output_axis_pitch' values) is made of one 'input_axis_pitch' block per input, so the
+  // copies are split across the thread pool by (output row, input) and written in output order.
+  // TODO: Optimization possibility: There are cases where we simply need to "merge" raw buffers and this
+  // could be done without the pointer house-keeping as below. Some scenarios whether this is possible are:
+  // 1) Concatenating on input axis = 0
+  // 2) Stacking on output axis = 0
+  // 3) Stacking scalars
+  std::vector<int64_t> initial_output_offsets(input_count);  // initial offset for each input
+  int64_t initial_output_offset = 0;
+  for (int input_index = 0; input_index < input_count; input_index++) {
+    initial_output_offsets[input_index] = initial_output_offset;
+    initial_output_offset += p.inputs[input_index].axis_pitch;
   }
 
+  const int64_t row_count = p.output_num_elements / p.output_axis_pitch;
+  uint8_t* output = static_cast<uint8_t*>(p.output_tensor->MutableDataRaw());
+  const size_t row_bytes = static_cast<size_t>(p.output_axis_pitch) *
+                           (p.is_string_type ? sizeof(std::string) : element_bytes);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, row_count * input_count, CopyCost(row_bytes / input_count),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const int64_t row = block / input_count;
+          const auto& prep = p.inputs[block % input_count];
+
+          // no data in this tensor - so skip it
+          if (prep.num_elements == 0)
+            continue;
+
+          auto input_axis_pitch = prep.axis_pitch;
+          const uint8_t* input = static_cast<const uint8_t*>(prep.tensor->DataRaw());
+          const int64_t out_offset = row * p.output_axis_pitch + initial_output_offsets[block % input_count];
+          const int64_t in_offset = row * input_axis_pitch;
+
+          if (p.is_string_type) {
+            const auto* src = reinterpret_cast<const std::string*>(input) + in_offset;
+            std::copy(src, src + input_axis_pitch, reinterpret_cast<std::string*>(output) + out_offset);
+          } else {
+            memcpy(output + out_offset * element_bytes, input + in_offset * element_bytes,
+                   input_axis_pitch * element_bytes);
+          }
+        }
+      });
+
   return Status::OK();
 }
 
@@ -224,7 +229,7 @@ Status Concat::Compute(OpKernelContext* ctx) const {
     return Status::OK();
 
   // Compute values to be placed in the output tensor
-  return ComputeImpl(p);
+  return ComputeImpl(p, ctx->GetOperatorThreadPool());
 }
 
 }  // namespace onnxruntime
@@ -4,6 +4,8 @@
 //https://github.com/onnx/onnx/blob/master/docs/Operators.md#Gather
 #include "core/providers/cpu/tensor/gather.h"
 #include "core/common/common.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 namespace onnxruntime {
 
@@ -53,15 +55,22 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
   return Status::OK();
 }
 
+// Rows are prefetched this many indices ahead when gathering from a table larger than kGatherPrefetchTableBytes,
+// as the indices usually read it in random order (e.g. embedding lookups) which defeats the hardware prefetcher.
+constexpr int64_t kGatherPrefetchDistance = 8;
+constexpr int64_t kGatherPrefetchTableBytes = 1024 * 1024;
+constexpr int64_t kGatherPrefetchRowBytes = 256;
+constexpr int64_t kCacheLineBytes = 64;
+
 template <typename Tin>
 Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uint8_t* dst_base, bool is_string_type,
                       const size_t element_bytes, const int64_t block_size, const int64_t M,
                       const int64_t N, const int64_t data_batch_bytes, const int64_t gathered_batch_bytes,
-                      const TensorShape& input_data_shape, const int64_t axis) {
+                      const TensorShape& input_data_shape, const int64_t axis, concurrency::ThreadPool* tp) {
   const Tin* indices_data = indices_tensor->template Data<Tin>();
 
   // Check the indices first in case there's a out of bound index.
-  // We can't merge this code in the omp loop below as omp does not allow return in the loop
+  // The copy below is split across the thread pool and can't return early.
   auto axis_dim_limit = input_data_shape[axis];
 
   for (int64_t i = 0; i < N; ++i) {
@@ -73,27 +82,35 @@ Status GatherCopyData(const Tensor* indices_tensor, const uint8_t* src_base, uin
     }
   }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t index = 0; index < M * N; ++index) {
-    int64_t batch = index / N;
-    int64_t i = index % N;
-
-    const int64_t src_offset_batch = batch * data_batch_bytes;
-    const int64_t dst_offset_batch = batch * gathered_batch_bytes;
-    Tin idx = indices_data[i];
+  auto src_offset_at = [&](int64_t index) {
+    Tin idx = indices_data[index % N];
     idx = idx < 0 ? idx + static_cast<Tin>(axis_dim_limit) : idx;
-    const int64_t src_offset = src_offset_batch + idx * block_size;
-    const int64_t dst_offset = dst_offset_batch + i * block_size;
-
-    if (is_string_type) {
-      reinterpret_cast<std::string*>(dst_base)[dst_offset / element_bytes] =
-          reinterpret_cast<const std::string*>(src_base)[src_offset / element_bytes];
-    } else {
-      memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
-    }
-  }
+    return index / N * data_batch_bytes + idx * block_size;
+  };
+
+  const bool prefetch = !is_string_type && data_batch_bytes >= kGatherPrefetchTableBytes;
+  const int64_t prefetch_bytes = std::min(block_size, kGatherPrefetchRowBytes);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, M * N, CopyCost(static_cast<size_t>(block_size)), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t index = first; index < last; ++index) {
+          const int64_t src_offset = src_offset_at(index);
+          const int64_t dst_offset = index / N * gathered_batch_bytes + index % N * block_size;
+
+          if (is_string_type) {
+            const auto* src = reinterpret_cast<const std::string*>(src_base + src_offset);
+            std::copy(src, src + block_size / element_bytes, reinterpret_cast<std::string*>(dst_base + dst_offset));
+          } else {
+            if (prefetch && index + kGatherPrefetchDistance < last) {
+              const uint8_t* ahead = src_base + src_offset_at(index + kGatherPrefetchDistance);
+              for (int64_t offset = 0; offset < prefetch_bytes; offset += kCacheLineBytes) {
+                PrefetchCacheLine(ahead + offset);
+              }
+            }
+            memcpy(dst_base + dst_offset, src_base + src_offset, block_size);
+          }
+        }
+      });
 
   return Status::OK();
 }
@@ -119,11 +136,13 @@ Status Gather::Compute(OpKernelContext* context) const {
 
   if (p.indices_tensor->IsDataType<int32_t>()) {
     return GatherCopyData<int32_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis,
+                                   context->GetOperatorThreadPool());
   }
   if (p.indices_tensor->IsDataType<int64_t>()) {
     return GatherCopyData<int64_t>(p.indices_tensor, src_base, dst_base, is_string_type, element_bytes,
-                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis);
+                                   block_size, M, N, data_batch_bytes, gathered_batch_bytes, input_data_shape, p.axis,
+                                   context->GetOperatorThreadPool());
   }
 
   return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Type for Tind not supported yet in Gather.");
@@ -3,6 +3,10 @@
 
 #include "gather_nd.h"
 
+#include <atomic>
+
+#include "core/providers/cpu/tensor/utils.h"
+
 namespace onnxruntime {
 
 // Register a kernel for kMsDomain (contrib op) GatherND
@@ -56,14 +60,11 @@ Status GatherNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) con
   std::vector<int64_t> element_counts(last_indices_dimension,
                                       0LL);  // Number of elements for each input dimension
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
   for (int64_t i = 0; i < last_indices_dimension; ++i) {
     element_counts[i] = input_shape.SizeFromDimension(i + 1);
   }
 
-  int64_t err_index = 0;
+  std::atomic<int64_t> err_index{0};
   p.element_bytes = input_tensor->DataType()->Size();
   p.element_to_copy = input_shape.SizeFromDimension(last_indices_dimension);
   p.bytes_to_copy = p.element_bytes * p.element_to_copy;
@@ -79,26 +80,29 @@ Status GatherNDBase::PrepareForCompute(OpKernelContext* context, Prepare& p) con
     p.output_base = static_cast<uint8_t*>(output_tensor->MutableDataRaw());
   }
 
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < offset_count; ++i) {
-    for (int64_t j = 0; j < last_indices_dimension; ++j) {
-      auto index = *(indices_data + i * last_indices_dimension + j);
-      auto upper_limit = input_shape[j];
-      auto lower_limit = -upper_limit;
-      if (index < lower_limit || index >= upper_limit) {
-        err_index = index;
-      }
-      if (index < 0) {
-        index += static_cast<Tind>(upper_limit);
-      }
-      p.element_offsets[i] += index * element_counts[j];
-    }
-  }
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), offset_count,
+      CopyCost(static_cast<size_t>(last_indices_dimension) * (sizeof(Tind) + sizeof(uint64_t))),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t i = first; i < last; ++i) {
+          for (int64_t j = 0; j < last_indices_dimension; ++j) {
+            auto index = *(indices_data + i * last_indices_dimension + j);
+            auto upper_limit = input_shape[j];
+            auto lower_limit = -upper_limit;
+            if (index < lower_limit || index >= upper_limit) {
+              err_index.store(index, std::memory_order_relaxed);
+            }
+            if (index < 0) {
+              index += static_cast<Tind>(upper_limit);
+            }
+            p.element_offsets[i] += index * element_counts[j];
+          }
+        }
+      });
 
   return err_index == 0 ? Status::OK()
-                        : ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid index found, index = ", err_index);
+                        : ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "invalid index found, index = ",
+                                          err_index.load());
 }
 
 template Status GatherNDBase::PrepareForCompute<int32_t>(OpKernelContext*, Prepare&) const;
@@ -110,30 +114,34 @@ Status GatherND::Compute(OpKernelContext* context) const {
                           ? PrepareForCompute<int32_t>(context, p)
                           : PrepareForCompute<int64_t>(context, p));
 
-  return nullptr == p.input_str_base ? GatherNumber(p) : GatherString(p);
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+  return nullptr == p.input_str_base ? GatherNumber(p, tp) : GatherString(p, tp);
 }
 
-Status GatherND::GatherNumber(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    memcpy(p.output_base + i * p.bytes_to_copy, p.input_base + p.element_offsets[i] * p.element_bytes,
-           p.bytes_to_copy);
-  }
+Status GatherND::GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const {
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(p.element_offsets.size()), CopyCost(static_cast<size_t>(p.bytes_to_copy)),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t i = first; i < last; ++i) {
+          memcpy(p.output_base + i * p.bytes_to_copy, p.input_base + p.element_offsets[i] * p.element_bytes,
+                 p.bytes_to_copy);
+        }
+      });
 
   return Status::OK();
 }
 
-Status GatherND::GatherString(const Prepare& p) const {
-#ifdef USE_OPENMP
-#pragma omp parallel for
-#endif
-  for (int64_t i = 0; i < static_cast<int64_t>(p.element_offsets.size()); ++i) {
-    for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
-      p.output_str_base[i * p.element_to_copy + j] = p.input_str_base[p.element_offsets[i] + j];
-    }
-  }
+Status GatherND::GatherString(const Prepare& p, concurrency::ThreadPool* tp) const {
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(p.element_offsets.size()),
+      CopyCost(static_cast<size_t>(p.element_to_copy) * sizeof(std::string)),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t i = first; i < last; ++i) {
+          for (int64_t j = 0; j < static_cast<int64_t>(p.element_to_copy); ++j) {
+            p.output_str_base[i * p.element_to_copy + j] = p.input_str_base[p.element_offsets[i] + j];
+          }
+        }
+      });
 
   return Status::OK();
 }
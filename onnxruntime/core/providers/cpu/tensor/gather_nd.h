@@ -41,8 +41,8 @@ class GatherND final : public OpKernel, protected GatherNDBase {
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  Status GatherNumber(const Prepare& p) const;
-  Status GatherString(const Prepare& p) const;
+  Status GatherNumber(const Prepare& p, concurrency::ThreadPool* tp) const;
+  Status GatherString(const Prepare& p, concurrency::ThreadPool* tp) const;
 };
 
 }  // namespace onnxruntime
@@ -5,6 +5,8 @@
 #include "core/providers/common.h"
 #include "core/util/math.h"
 #include "core/util/math_cpuonly.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/utils.h"
 
 #include "gsl/gsl"
 
@@ -120,6 +122,9 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
   auto& input_dims = input_shape.GetDims();
   std::vector<int64_t> output_dimensions{input_dims};
 
+  std::vector<T*> output_data(num_outputs);
+  std::vector<int64_t> input_offsets(num_outputs);
+  std::vector<int64_t> output_pitches(num_outputs);
   int64_t input_offset = 0;
   const T* input_data = input.template Data<T>();
 
@@ -129,22 +134,28 @@ Status Split::ComputeImpl(OpKernelContext& context, const Tensor& input) const {
     output_dimensions[axis] = split_size;
 
     Tensor* output = context.Output(i, TensorShape{output_dimensions});
-    T* output_data = output->template MutableData<T>();
-
-    ::onnxruntime::math::CopyMatrix<T>(
-        before_dims,                                       // M
-        split_size * after_dims_excluding_split,           // N
-        static_cast<const T*>(input_data + input_offset),  // A
-        after_dims_including_split_axis,                   // lda
-        static_cast<T*>(output_data),                      // B
-        split_size * after_dims_excluding_split,           // ldb
-        [](const T* src, T* dst, size_t count) {
-          copy_data<T>(src, dst, count);
-        });
+    output_data[i] = output->template MutableData<T>();
+    input_offsets[i] = input_offset;
+    output_pitches[i] = split_size * after_dims_excluding_split;
 
     input_offset += split_size * after_dims_excluding_split;  // offset by the N data we used in this iteration
   }
 
+  // Each of the before_dims input rows holds one block per output, so the copies are split across the thread pool
+  // by (input row, output) and read in input order.
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(before_dims) * num_outputs,
+      CopyCost(static_cast<size_t>(after_dims_including_split_axis) * sizeof(T) / num_outputs),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const int64_t row = block / num_outputs;
+          const int i = static_cast<int>(block % num_outputs);
+          copy_data<T>(input_data + row * after_dims_including_split_axis + input_offsets[i],
+                       output_data[i] + row * output_pitches[i],
+                       static_cast<size_t>(output_pitches[i]));
+        }
+      });
+
   return Status::OK();
 }
 
@@ -2,7 +2,15 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/transpose.h"
+
+#include <algorithm>
+#include <numeric>
+
 #include "core/framework/utils.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tensor/utils.h"
+
 namespace onnxruntime {
 
 /* A permutation [a,b,c,...] indicates that 
@@ -32,6 +40,16 @@ static inline void IncrementIndex(std::vector<int64_t>& index, const std::vector
   }
 }
 
+// InitializeIndex: set an index into a tensor (in lexicographic ordering) to the position of the
+// element number linear_index.
+static inline void InitializeIndex(std::vector<int64_t>& index, const std::vector<int64_t>& upper_bound,
+                                   int64_t num_axes, size_t linear_index) {
+  for (int64_t k = num_axes - 1; k >= 0; --k) {
+    index[k] = static_cast<int64_t>(linear_index % upper_bound[k]);
+    linear_index /= upper_bound[k];
+  }
+}
+
 // DoTransposeSingleBlock: specialization of DoTranspose for the num_blocks=1 case.
 // copies source tensor to target, transposing elements.
 static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const void* source, void* target,
@@ -48,13 +66,17 @@ static inline void DoTransposeSingleBlock(size_t num_elts_in_block, const std::s
 
 // DoTranspose: copies source tensor to target, transposing elements.
 // The stride vector indicates the transposition.
+// Only the blocks [first_block, last_block) of the target are copied.
 static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
-                            size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
+                            size_t first_block, size_t last_block, size_t num_elts_in_block,
+                            const std::vector<size_t>& stride,
                             const uint8_t* source, uint8_t* target, size_t element_size) {
   size_t blocksize = num_elts_in_block * element_size;
+  target += first_block * blocksize;
   // index used to iterate over target iteration-space
   std::vector<int64_t> target_index(num_axes, 0);
-  for (size_t i = 0; i < num_blocks; ++i) {
+  InitializeIndex(target_index, target_dims, num_axes, first_block);
+  for (size_t i = first_block; i < last_block; ++i) {
     // convert target_index into an offset in source data
     size_t source_offset = ComputeOffset(target_index, stride, num_axes);
 
@@ -68,11 +90,14 @@ static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target
 }
 
 static void DoTransposeImpl(int64_t num_axes, const std::vector<int64_t>& target_dims,
-                            size_t num_blocks, size_t num_elts_in_block, const std::vector<size_t>& stride,
+                            size_t first_block, size_t last_block, size_t num_elts_in_block,
+                            const std::vector<size_t>& stride,
                             const std::string* source, std::string* target) {
+  target += first_block * num_elts_in_block;
   // index used to iterate over target iteration-space
   std::vector<int64_t> target_index(num_axes, 0);
-  for (size_t i = 0; i < num_blocks; ++i) {
+  InitializeIndex(target_index, target_dims, num_axes, first_block);
+  for (size_t i = first_block; i < last_block; ++i) {
     // convert target_index into an offset in source data
     size_t source_offset = ComputeOffset(target_index, stride, num_axes);
 
@@ -92,16 +117,20 @@ inline void CopyPrim(uint8_t* target, const uint8_t* source) {
 
 // DoTransposeEltWise: specialization of DoTranspose for the num_elts_in_block=1 case.
 // copies source tensor to target, transposing elements.
-// The stride vector indicates the transposition.
-static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims, size_t num_blocks,
+// The stride vector indicates the transposition. Only the elements [first_block, last_block) of the target
+// are copied.
+static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims,
+                               size_t first_block, size_t last_block,
                                const std::vector<size_t>& stride, const uint8_t* source, uint8_t* target,
                                size_t element_size) {
+  target += first_block * element_size;
   // index used to iterate over target iteration-space
   std::vector<int64_t> target_index(num_axes, 0);
+  InitializeIndex(target_index, target_dims, num_axes, first_block);
 
   switch (element_size) {
     case sizeof(uint64_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
+      for (size_t i = first_block; i < last_block; ++i) {
         // convert target_index into an offset in source data
         size_t source_offset = ComputeOffset(target_index, stride, num_axes);
 
@@ -114,7 +143,7 @@ static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& tar
       }
       break;
     case sizeof(uint32_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
+      for (size_t i = first_block; i < last_block; ++i) {
         // convert target_index into an offset in source data
         size_t source_offset = ComputeOffset(target_index, stride, num_axes);
 
@@ -127,7 +156,7 @@ static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& tar
       }
       break;
     case sizeof(uint16_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
+      for (size_t i = first_block; i < last_block; ++i) {
         // convert target_index into an offset in source data
         size_t source_offset = ComputeOffset(target_index, stride, num_axes);
 
@@ -140,7 +169,7 @@ static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& tar
       }
       break;
     case sizeof(uint8_t):
-      for (size_t i = 0; i < num_blocks; ++i) {
+      for (size_t i = first_block; i < last_block; ++i) {
         // convert target_index into an offset in source data
         size_t source_offset = ComputeOffset(target_index, stride, num_axes);
 
@@ -157,11 +186,14 @@ static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& tar
   }
 }
 
-static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims, size_t num_blocks,
+static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& target_dims,
+                               size_t first_block, size_t last_block,
                                const std::vector<size_t>& stride, const std::string* source, std::string* target) {
+  target += first_block;
   // index used to iterate over target iteration-space
   std::vector<int64_t> target_index(num_axes, 0);
-  for (size_t i = 0; i < num_blocks; ++i) {
+  InitializeIndex(target_index, target_dims, num_axes, first_block);
+  for (size_t i = first_block; i < last_block; ++i) {
     // convert target_index into an offset in source data
     size_t source_offset = ComputeOffset(target_index, stride, num_axes);
 
@@ -174,21 +206,66 @@ static void DoTransposeEltWise(int64_t num_axes, const std::vector<int64_t>& tar
   }
 }
 
-static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
-  const auto& input_shape = input.Shape();
-  const auto& input_dims = input_shape.GetDims();
-  auto rank = input_shape.NumDimensions();
+// CoalesceTranspose: simplify the transposition of a tensor of input_dims by permutations. The axes of size 1
+// are dropped and the input axes that stay next to each other in the output are merged, e.g. NCHW -> NHWC with
+// permutations {0, 2, 3, 1} becomes the transposition of {N, C, H*W} with permutations {0, 2, 1}.
+static void CoalesceTranspose(const std::vector<size_t>& permutations, const std::vector<int64_t>& input_dims,
+                              std::vector<size_t>& coalesced_permutations, std::vector<int64_t>& coalesced_dims) {
+  const size_t rank = input_dims.size();
+
+  // the axes of size 1 are numbered out
+  std::vector<size_t> kept_axis(rank);
+  size_t num_kept = 0;
+  for (size_t i = 0; i < rank; ++i) {
+    if (input_dims[i] != 1) kept_axis[i] = num_kept++;
+  }
+
+  // runs of consecutive input axes in the output, as their first input axis and the product of their dimensions
+  std::vector<std::pair<size_t, int64_t>> runs;
+  size_t previous_axis = 0;
+  for (size_t i = 0; i < rank; ++i) {
+    size_t input_axis = permutations[i];
+    if (input_dims[input_axis] == 1) continue;
+    size_t axis = kept_axis[input_axis];
+    if (!runs.empty() && axis == previous_axis + 1) {
+      runs.back().second *= input_dims[input_axis];
+    } else {
+      runs.emplace_back(axis, input_dims[input_axis]);
+    }
+    previous_axis = axis;
+  }
+
+  // the runs are the axes of the coalesced input in the order of their first input axis
+  std::vector<size_t> order(runs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&runs](size_t lhs, size_t rhs) { return runs[lhs].first < runs[rhs].first; });
+
+  coalesced_dims.resize(runs.size());
+  coalesced_permutations.resize(runs.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    coalesced_dims[i] = runs[order[i]].second;
+    coalesced_permutations[order[i]] = i;
+  }
+}
+
+// DoUntypedTranspose: the default implementation for the permutations of input_dims, the blocks of the target are
+// split across the thread pool.
+static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const std::vector<int64_t>& input_dims,
+                                 const Tensor& input, Tensor& output, concurrency::ThreadPool* tp) {
+  auto rank = input_dims.size();
 
   const auto element_size = input.DataType()->Size();
   const bool is_string_type = input.IsDataTypeString();
 
   std::vector<size_t> stride(rank);
+  std::vector<int64_t> target_dims(rank);
   for (size_t i = 0; i < rank; i++) {
     size_t inpdim = permutations[i];
-    if (inpdim + 1 < rank)
-      stride[i] = input_shape.SizeFromDimension(inpdim + 1);
-    else
-      stride[i] = 1;
+    stride[i] = 1;
+    for (size_t j = inpdim + 1; j < rank; j++) {
+      stride[i] *= static_cast<size_t>(input_dims[j]);
+    }
+    target_dims[i] = input_dims[inpdim];
   }
 
   // Partition the permutation into a prefix and the largest suffix such that
@@ -209,35 +286,136 @@ static Status DoUntypedTranspose(const std::vector<size_t>& permutations, const
     }
   }
 
+  const auto cost = CopyCost(suffix_blocksize * (is_string_type ? sizeof(std::string) : element_size));
+
   if (is_string_type) {
     const auto* input_data = input.template Data<std::string>();
     auto* output_data = output.template MutableData<std::string>();
     if (1 == prefix_blocksize) {
       DoTransposeSingleBlock(suffix_blocksize, input_data, output_data);
-    } else if (1 == suffix_blocksize) {
-      DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                         input_data, output_data);
     } else {
-      DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data);
+      concurrency::ThreadPool::TryParallelFor(
+          tp, static_cast<std::ptrdiff_t>(prefix_blocksize), cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            if (1 == suffix_blocksize) {
+              DoTransposeEltWise(num_axes_in_prefix, target_dims, static_cast<size_t>(first),
+                                 static_cast<size_t>(last), stride, input_data, output_data);
+            } else {
+              DoTransposeImpl(num_axes_in_prefix, target_dims, static_cast<size_t>(first), static_cast<size_t>(last),
+                              suffix_blocksize, stride, input_data, output_data);
+            }
+          });
     }
   } else {
     const auto* input_data = reinterpret_cast<const uint8_t*>(input.DataRaw());
     auto* output_data = reinterpret_cast<uint8_t*>(output.MutableDataRaw());
     if (1 == prefix_blocksize) {
       DoTransposeSingleBlock(suffix_blocksize, input_data, output_data, element_size);
-    } else if (1 == suffix_blocksize) {
-      DoTransposeEltWise(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, stride,
-                         input_data, output_data, element_size);
     } else {
-      DoTransposeImpl(num_axes_in_prefix, output.Shape().GetDims(), prefix_blocksize, suffix_blocksize, stride,
-                      input_data, output_data, element_size);
+      concurrency::ThreadPool::TryParallelFor(
+          tp, static_cast<std::ptrdiff_t>(prefix_blocksize), cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            if (1 == suffix_blocksize) {
+              DoTransposeEltWise(num_axes_in_prefix, target_dims, static_cast<size_t>(first),
+                                 static_cast<size_t>(last), stride, input_data, output_data, element_size);
+            } else {
+              DoTransposeImpl(num_axes_in_prefix, target_dims, static_cast<size_t>(first), static_cast<size_t>(last),
+                              suffix_blocksize, stride, input_data, output_data, element_size);
+            }
+          });
     }
   }
 
   return Status::OK();
 }
 
+/*
+Batched 2D transpose: after CoalesceTranspose, the permutations {1, 0} and {0, 2, 1} transpose one or more M x N
+matrices, e.g. NCHW <-> NHWC or [B, S, N, H] -> [B, N, S, H] when H is small enough to be moved as one element.
+
+The matrices are split in tiles of kTransposeTileSize x kTransposeTileSize elements that are transposed in the
+cache and run on the thread pool. The tiles of 8 bit and 32 bit elements use the SIMD kernels of MlasTranspose.
+*/
+constexpr size_t kTransposeTileSize = 64;
+
+template <typename T>
+static inline void TransposeTile(size_t M, size_t N, const T* A, size_t lda, T* B, size_t ldb) {
+  for (size_t n = 0; n < N; ++n) {
+    for (size_t m = 0; m < M; ++m) {
+      B[n * ldb + m] = A[m * lda + n];
+    }
+  }
+}
+
+static inline void TransposeTile(size_t M, size_t N, const uint8_t* A, size_t lda, uint8_t* B, size_t ldb) {
+  MlasTranspose(M, N, A, lda, B, ldb);
+}
+
+static inline void TransposeTile(size_t M, size_t N, const uint32_t* A, size_t lda, uint32_t* B, size_t ldb) {
+  MlasTranspose(M, N, A, lda, B, ldb);
+}
+
+template <typename T>
+static void Transpose2D(size_t batch, size_t M, size_t N, const T* input_data, T* output_data,
+                        concurrency::ThreadPool* tp) {
+  const size_t tiles_m = (M + kTransposeTileSize - 1) / kTransposeTileSize;
+  const size_t tiles_n = (N + kTransposeTileSize - 1) / kTransposeTileSize;
+  const size_t tiles_per_matrix = tiles_m * tiles_n;
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch * tiles_per_matrix),
+      CopyCost(kTransposeTileSize * kTransposeTileSize * sizeof(T)),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (auto tile = static_cast<size_t>(first), end = static_cast<size_t>(last); tile < end; ++tile) {
+          const size_t b = tile / tiles_per_matrix;
+          const size_t m = (tile % tiles_per_matrix) / tiles_n * kTransposeTileSize;
+          const size_t n = (tile % tiles_per_matrix) % tiles_n * kTransposeTileSize;
+          TransposeTile(std::min(kTransposeTileSize, M - m), std::min(kTransposeTileSize, N - n),
+                        input_data + b * M * N + m * N + n, N,
+                        output_data + b * M * N + n * M + m, M);
+        }
+      });
+}
+
+// Transposes the input with the SIMD/tiled kernels if the coalesced permutations are a batched 2D transpose of
+// elements of 1, 2, 4 or 8 bytes, an innermost axis that doesn't move widening the elements.
+static bool TryTranspose2D(std::vector<size_t> permutations, std::vector<int64_t> dims,
+                           const Tensor& input, Tensor& output, concurrency::ThreadPool* tp) {
+  size_t element_size = input.DataType()->Size();
+  if (permutations.size() > 1 && permutations.back() == permutations.size() - 1) {
+    element_size *= static_cast<size_t>(dims.back());
+    permutations.pop_back();
+    dims.pop_back();
+  }
+
+  size_t batch = 1;
+  if (permutations.size() == 3 && permutations[0] == 0 && permutations[1] == 2 && permutations[2] == 1) {
+    batch = static_cast<size_t>(dims[0]);
+  } else if (!(permutations.size() == 2 && permutations[0] == 1 && permutations[1] == 0)) {
+    return false;
+  }
+
+  const auto M = static_cast<size_t>(dims[dims.size() - 2]);
+  const auto N = static_cast<size_t>(dims[dims.size() - 1]);
+  const void* input_data = input.DataRaw();
+  void* output_data = output.MutableDataRaw();
+
+  switch (element_size) {
+    case sizeof(uint8_t):
+      Transpose2D(batch, M, N, static_cast<const uint8_t*>(input_data), static_cast<uint8_t*>(output_data), tp);
+      return true;
+    case sizeof(uint16_t):
+      Transpose2D(batch, M, N, static_cast<const uint16_t*>(input_data), static_cast<uint16_t*>(output_data), tp);
+      return true;
+    case sizeof(uint32_t):
+      Transpose2D(batch, M, N, static_cast<const uint32_t*>(input_data), static_cast<uint32_t*>(output_data), tp);
+      return true;
+    case sizeof(uint64_t):
+      Transpose2D(batch, M, N, static_cast<const uint64_t*>(input_data), static_cast<uint64_t*>(output_data), tp);
+      return true;
+    default:
+      return false;
+  }
+}
+
 /*
 Optimizations for moving a single axis either inwards or outwards.
 
@@ -528,7 +706,8 @@ static bool IsMovingSingleAxis(const std::vector<size_t>& permutations, size_t&
   return single_axis_moved;
 }
 
-Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output) {
+Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                                  concurrency::ThreadPool* tp) {
   Status status = Status::OK();
 
   auto input_type = input.DataType();
@@ -537,7 +716,15 @@ Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const
   if (input_type != output_type) {
     status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Mismatched data types between input and output Tensors. ",
                              input_type, " != ", output_type);
-  } else {
+  } else if (input.Shape().Size() > 0) {
+    std::vector<size_t> coalesced_permutations;
+    std::vector<int64_t> coalesced_dims;
+    CoalesceTranspose(permutations, input.Shape().GetDims(), coalesced_permutations, coalesced_dims);
+
+    if (!input.IsDataTypeString() && TryTranspose2D(coalesced_permutations, coalesced_dims, input, output, tp)) {
+      return status;
+    }
+
     size_t from = 0, to = 0;
     bool moving_single_axis = IsMovingSingleAxis(permutations, from, to);
 
@@ -545,7 +732,7 @@ Status TransposeBase::DoTranspose(const std::vector<size_t>& permutations, const
       SingleAxisTranspose(permutations, input, output, from, to);
     } else {
       // fall back to default implementation
-      status = DoUntypedTranspose(permutations, input, output);
+      status = DoUntypedTranspose(coalesced_permutations, coalesced_dims, input, output, tp);
     }
   }
 
@@ -573,17 +760,7 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  size_t from = 0, to = 0;
-  bool moving_single_axis = IsMovingSingleAxis(*p_perm, from, to);
-
-  if (moving_single_axis && !X.IsDataTypeString()) {
-    SingleAxisTranspose(*p_perm, X, Y, from, to);
-  } else {
-    // fall back to default implementation
-    status = DoUntypedTranspose(*p_perm, X, Y);
-  }
-
-  return status;
+  return DoTranspose(*p_perm, X, Y, ctx->GetOperatorThreadPool());
 }
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -14,9 +14,10 @@ class TransposeBase {
  public:
   /**
   Transpose the input Tensor into the output Tensor using the provided permutations.
-  Both Tensors must have the same data type. 
+  Both Tensors must have the same data type. The copy is split across tp if provided.
   */
-  static Status DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output);
+  static Status DoTranspose(const std::vector<size_t>& permutations, const Tensor& input, Tensor& output,
+                            concurrency::ThreadPool* tp = nullptr);
 
  protected:
   TransposeBase(const OpKernelInfo& info) {
@@ -3,6 +3,8 @@
 
 #include "core/providers/cpu/tensor/upsample.h"
 #include <sstream>
+#include "core/providers/cpu/tensor/utils.h"
+#include "core/util/math_cpuonly.h"
 
 using namespace onnxruntime::common;
 using namespace std;
@@ -30,182 +32,145 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     Upsample<uint8_t>);
 
 
-template <typename T>
-void UpsampleNearest2x(int64_t batch_size,
-                       int64_t num_channels,
-                       int64_t input_height,
-                       int64_t input_width,
-                       const T* input,
-                       T* output) {
-  const int64_t output_height = input_height * 2;
-  const int64_t output_width = input_width * 2;
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        const int64_t in_y = y / 2;
-        for (int64_t x = 0; x < input_width; ++x) {
-          const T v = input[in_y * input_width + x];
-          const int64_t oidx = output_width * y + x * 2;
-          output[oidx + 0] = v;
-          output[oidx + 1] = v;
-        }
+// Index and weight tables of one (input dims, output dims, scales, roi) combination, so that the coordinate
+// transformation is only evaluated once per output coordinate of every axis instead of once per output element.
+struct UpsampleTables {
+  std::vector<int64_t> input_dims;
+  std::vector<int64_t> output_dims;
+  std::vector<float> scales;
+  std::vector<float> roi;
+
+  // 'nearest' mode: for every axis and output coordinate the offset of the nearest input coordinate
+  // (index * pitch of the axis in the input), or -1 when the extrapolation value is used.
+  std::vector<std::vector<int64_t>> nearest_offsets;
+  bool inner_extrapolated = false;
+
+  // 'linear' mode: the offsets of the two input rows (and columns) surrounding every output row (and column),
+  // their weights, and whether the extrapolation value is used for it.
+  std::vector<int64_t> input_width_mul_y1;
+  std::vector<int64_t> input_width_mul_y2;
+  std::vector<int64_t> in_x1;
+  std::vector<int64_t> in_x2;
+  std::vector<float> dy1;
+  std::vector<float> dy2;
+  std::vector<float> dx1;
+  std::vector<float> dx2;
+  std::vector<uint8_t> y_extrapolated;
+  std::vector<uint8_t> x_extrapolated;
+  bool any_x_extrapolated = false;
+
+  bool Matches(const std::vector<int64_t>& in_dims, const std::vector<int64_t>& out_dims,
+               const std::vector<float>& in_scales, const std::vector<float>& in_roi) const {
+    return input_dims == in_dims && output_dims == out_dims && scales == in_scales && roi == in_roi;
+  }
+};
+
+static void BuildNearestTables(UpsampleTables& tables,
+                               bool extrapolation_enabled,
+                               const GetOriginalCoordinateFunc& get_original_coordinate,
+                               const GetNearestPixelFunc& get_nearest_pixel) {
+  const auto& input_dims = tables.input_dims;
+  const auto& output_dims = tables.output_dims;
+  const size_t n_dim = input_dims.size();
+
+  tables.nearest_offsets.resize(n_dim);
+  int64_t input_pitch = 1;
+  for (size_t dim_idx = n_dim; dim_idx-- > 0;) {
+    auto& offsets = tables.nearest_offsets[dim_idx];
+    offsets.resize(output_dims[dim_idx]);
+    for (int64_t output_idx = 0; output_idx < output_dims[dim_idx]; ++output_idx) {
+      float original_idx = get_original_coordinate(static_cast<float>(output_idx), tables.scales[dim_idx],
+                                                   static_cast<float>(output_dims[dim_idx]),
+                                                   static_cast<float>(input_dims[dim_idx]),
+                                                   tables.roi[dim_idx], tables.roi[n_dim + dim_idx]);
+      if (extrapolation_enabled && (original_idx < 0 || original_idx > input_dims[dim_idx] - 1)) {
+        offsets[output_idx] = -1;
+        tables.inner_extrapolated |= dim_idx == n_dim - 1;
+        continue;
       }
-      input += input_height * input_width;
-      output += output_height * output_width;
+
+      int64_t input_idx = get_nearest_pixel(original_idx, tables.scales[dim_idx] < 1);
+      input_idx = std::max(static_cast<int64_t>(0), std::min(input_idx, input_dims[dim_idx] - 1));
+      offsets[output_idx] = input_idx * input_pitch;
     }
+    input_pitch *= input_dims[dim_idx];
   }
 }
 
+// Nearest neighbour upsampling of an N-D tensor. The output is processed one innermost row at a time, and the rows
+// are split across the thread pool. An output row that reads the same input row as the one before it is copied.
 template <typename T>
-Status UpsampleNearest(const T* input,
-                       T* output,
-                       const TensorShape& input_shape,
-                       const TensorShape& output_shape,
-                       const vector<float>& scales,
-                       const vector<float>& roi,
-                       bool is_resize,
-                       bool extrapolation_enabled,
-                       float extrapolation_value,
-                       bool use_nearest2x_optimization,
-                       GetOriginalCoordinateFunc get_original_coordinate,
-                       GetNearestPixelFunc get_nearest_pixel) {
-  if (!input || !output)
-    return Status(ONNXRUNTIME, FAIL,
-                  is_resize ? "Resize: input/output value is nullptr"
-                            : "Upsample: input/output value is nullptr");
-  if (input_shape.NumDimensions() != output_shape.NumDimensions())
-    return Status(ONNXRUNTIME, FAIL,
-                  is_resize ? "Resize: input/output value's dimension mismatch"
-                            : "Upsample: input/output value's dimension mismatch");
-  if (input_shape.NumDimensions() == 0) {
-    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                  is_resize ? "Resize: input shape needs to be at least a single dimension"
-                            : "Upsample: input shape needs to be at least a single dimension.");
-  }
-
-  int64_t n_dim = static_cast<int64_t>(input_shape.NumDimensions());
-
-  std::vector<int64_t> input_dim_counters(n_dim);
-  std::vector<int64_t> input_dim_factor(n_dim);
-  std::vector<bool> use_extrapolation_value(n_dim);
-  input_dim_factor[n_dim - 1] = 1;  // initialize dimension factor
-  for (int64_t dim_idx = n_dim - 2; dim_idx >= 0; dim_idx--) {
-    input_dim_factor[dim_idx] = input_dim_factor[dim_idx + 1] * input_shape[dim_idx + 1];
+void UpsampleNearest(const T* input,
+                     T* output,
+                     const UpsampleTables& tables,
+                     float extrapolation_value,
+                     concurrency::ThreadPool* tp) {
+  const auto& output_dims = tables.output_dims;
+  const size_t n_dim = output_dims.size();
+  const int64_t inner_size = output_dims[n_dim - 1];
+  if (inner_size == 0) {
+    return;
   }
 
-  int64_t output_idx = 0;
-  int64_t input_idx = 0;
-
-#define OneDimensionProcessor(dim_inx)                                                                                                                                                                                                               \
-  use_extrapolation_value[dim_inx] = false;                                                                                                                                                                                                          \
-  float original_##dim_inx##_idx = get_original_coordinate(static_cast<float>(output_dim##dim_inx##_inx), scales[dim_inx], static_cast<float>(output_shape[dim_inx]), static_cast<float>(input_shape[dim_inx]), roi[dim_inx], roi[n_dim + dim_inx]); \
-  if (extrapolation_enabled && (original_##dim_inx##_idx < 0 || original_##dim_inx##_idx > input_shape[dim_inx] - 1)) use_extrapolation_value[dim_inx] = true;                                                                                       \
-  int64_t input_dim##dim_inx##_inx = get_nearest_pixel(original_##dim_inx##_idx, scales[dim_inx] < 1);                                                                                                                                               \
-  if (input_dim##dim_inx##_inx > input_shape[dim_inx] - 1) input_dim##dim_inx##_inx = input_shape[dim_inx] - 1;                                                                                                                                      \
-  if (input_dim##dim_inx##_inx < 0) input_dim##dim_inx##_inx = 0;                                                                                                                                                                                    \
-  if (input_dim##dim_inx##_inx != input_dim_counters[dim_inx]) {                                                                                                                                                                                     \
-    input_idx += (input_dim##dim_inx##_inx - input_dim_counters[dim_inx]) * input_dim_factor[dim_inx];                                                                                                                                               \
-    input_dim_counters[dim_inx] = input_dim##dim_inx##_inx;                                                                                                                                                                                          \
+  int64_t num_rows = 1;
+  for (size_t dim_idx = 0; dim_idx + 1 < n_dim; ++dim_idx) {
+    num_rows *= output_dims[dim_idx];
   }
 
-  if (n_dim == 1) {
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      OneDimensionProcessor(0);
-      output[output_idx++] = use_extrapolation_value[0] ? static_cast<T>(extrapolation_value) : input[input_idx];
-    }
-    return Status::OK();
-  }
+  const int64_t* inner_offsets = tables.nearest_offsets[n_dim - 1].data();
+  const bool inner_extrapolated = tables.inner_extrapolated;
+  const T extrapolation = static_cast<T>(extrapolation_value);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_rows), CopyCost(static_cast<size_t>(inner_size) * sizeof(T)),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // output coordinates of the current row along the outer axes
+        std::vector<int64_t> counters(n_dim - 1);
+        int64_t remaining = first;
+        for (size_t dim_idx = n_dim - 1; dim_idx-- > 0;) {
+          counters[dim_idx] = remaining % output_dims[dim_idx];
+          remaining /= output_dims[dim_idx];
+        }
 
-  if (n_dim == 2) {
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      OneDimensionProcessor(0);
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        OneDimensionProcessor(1);
-        output[output_idx++] = (use_extrapolation_value[0] || use_extrapolation_value[1])
-                                   ? static_cast<T>(extrapolation_value)
-                                   : input[input_idx];
-      }
-    }
-    return Status::OK();
-  }
+        const T* prev_input_row = nullptr;
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          T* output_row = output + row * inner_size;
 
-  if (n_dim == 3) {
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      OneDimensionProcessor(0);
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        OneDimensionProcessor(1);
-        for (int64_t output_dim2_inx = 0; output_dim2_inx < output_shape[2]; output_dim2_inx++) {
-          OneDimensionProcessor(2);
-          bool use_extrapolation = std::any_of(use_extrapolation_value.begin(), use_extrapolation_value.end(),
-                                               [](bool use_extrapolation) {
-                                                 return use_extrapolation == true;
-                                               });
-
-          output[output_idx++] = use_extrapolation ? static_cast<T>(extrapolation_value) : input[input_idx];
-        }
-      }
-    }
-    return Status::OK();
-  }
+          bool extrapolate = false;
+          int64_t input_offset = 0;
+          for (size_t dim_idx = 0; dim_idx + 1 < n_dim; ++dim_idx) {
+            const int64_t offset = tables.nearest_offsets[dim_idx][counters[dim_idx]];
+            extrapolate |= offset < 0;
+            input_offset += offset;
+          }
 
-  if (n_dim == 4) {
-    if (use_nearest2x_optimization && scales[0] == 1 && scales[1] == 1 && scales[2] == 2 && scales[3] == 2) {
-      UpsampleNearest2x<T>(input_shape[0], input_shape[1], input_shape[2], input_shape[3], input, output);
-      return Status::OK();
-    }
-    for (int64_t output_dim0_inx = 0; output_dim0_inx < output_shape[0]; output_dim0_inx++) {
-      OneDimensionProcessor(0);
-      for (int64_t output_dim1_inx = 0; output_dim1_inx < output_shape[1]; output_dim1_inx++) {
-        OneDimensionProcessor(1);
-        for (int64_t output_dim2_inx = 0; output_dim2_inx < output_shape[2]; output_dim2_inx++) {
-          OneDimensionProcessor(2);
-          for (int64_t output_dim3_inx = 0; output_dim3_inx < output_shape[3]; output_dim3_inx++) {
-            OneDimensionProcessor(3);
-            bool use_extrapolation = std::any_of(use_extrapolation_value.begin(), use_extrapolation_value.end(),
-                                                 [](bool use_extrapolation) {
-                                                   return use_extrapolation == true;
-                                                 });
-
-            output[output_idx++] = use_extrapolation ? static_cast<T>(extrapolation_value) : input[input_idx];
+          if (extrapolate) {
+            std::fill_n(output_row, inner_size, extrapolation);
+            prev_input_row = nullptr;
+          } else {
+            const T* input_row = input + input_offset;
+            if (input_row == prev_input_row) {
+              memcpy(output_row, output_row - inner_size, static_cast<size_t>(inner_size) * sizeof(T));
+            } else if (inner_extrapolated) {
+              for (int64_t x = 0; x < inner_size; ++x) {
+                output_row[x] = inner_offsets[x] < 0 ? extrapolation : input_row[inner_offsets[x]];
+              }
+            } else {
+              for (int64_t x = 0; x < inner_size; ++x) {
+                output_row[x] = input_row[inner_offsets[x]];
+              }
+            }
+            prev_input_row = input_row;
           }
-        }
-      }
-    }
-    return Status::OK();
-  }
 
-#undef OneDimensionProcessor
-
-  std::vector<int64_t> output_dim_counter(n_dim);
-  output_dim_counter[n_dim - 1] = -1;  // initialize dimension counter
-
-  for (; output_idx < output_shape.Size(); output_idx++) {
-    for (int64_t dim_idx = n_dim - 1; dim_idx >= 0; dim_idx--) {
-      if (++output_dim_counter[dim_idx] < output_shape[dim_idx]) {
-        int64_t current_input_dim_counter = 0;
-        auto original_idx = get_original_coordinate(static_cast<float>(output_dim_counter[dim_idx]), scales[dim_idx],
-                                                    static_cast<float>(output_shape[dim_idx]), static_cast<float>(input_shape[dim_idx]),
-                                                    roi[dim_idx], roi[n_dim + dim_idx]);
-        current_input_dim_counter = get_nearest_pixel(original_idx, scales[dim_idx] < 1);
-        current_input_dim_counter = std::max((int64_t)0,
-                                             std::min(current_input_dim_counter, (input_shape[dim_idx] - 1)));
-
-        if (current_input_dim_counter != input_dim_counters[dim_idx]) {
-          input_idx += (current_input_dim_counter - input_dim_counters[dim_idx]) * input_dim_factor[dim_idx];
-          input_dim_counters[dim_idx] = current_input_dim_counter;
+          for (size_t dim_idx = n_dim - 1; dim_idx-- > 0;) {
+            if (++counters[dim_idx] < output_dims[dim_idx]) {
+              break;
+            }
+            counters[dim_idx] = 0;
+          }
         }
-        break;
-      } else {
-        output_dim_counter[dim_idx] = 0;
-        input_idx += (0 - input_dim_counters[dim_idx]) * input_dim_factor[dim_idx];
-        input_dim_counters[dim_idx] = 0;
-      }
-    }
-
-    output[output_idx] = input[input_idx];
-  }
-
-  return Status::OK();
+      });
 }
 
 //This is a generic upsample in linear mode for N-D tensor.
@@ -278,45 +243,22 @@ Status UpsampleLinear(const T* input,
   return Status::OK();
 }
 
-// The following method supports a 4-D input in 'Linear mode'
-// that amounts to 'Bilinear' Upsampling/Resizing in the sense that it assumes
-// the scale values for the outermost 2 dimensions are 1.
-// This is the common use-case where the 4-D input (batched multi-channel images)
-// is usually of shape [N, C, H, W] and the scales are [1.0, 1.0, height_scale, width_scale]
-template <typename T>
-void UpsampleBilinear(int64_t batch_size,
-                      int64_t num_channels,
-                      int64_t input_height,
-                      int64_t input_width,
-                      int64_t output_height,
-                      int64_t output_width,
-                      float height_scale,
-                      float width_scale,
-                      const std::vector<float>& roi,
-                      bool use_extrapolation,
-                      float extrapolation_value,
-                      const T* Xdata,
-                      T* Ydata,
-                      AllocatorPtr& alloc,
-                      GetOriginalCoordinateFunc get_original_coordinate) {
-  std::vector<float> y_original;
-  std::vector<float> x_original;
-
-  size_t idx_buffer_size = 2 * sizeof(int64_t) * (output_height + output_width);
-  size_t scale_buffer_size = 2 * sizeof(float_t) * (output_height + output_width);
-  auto inx_scale_data_buffer = alloc->Alloc(idx_buffer_size + scale_buffer_size);
-  BufferUniquePtr idx_scale_data_buffer_holder(inx_scale_data_buffer, BufferDeleter(alloc));
-  auto* idx_data = static_cast<int64_t*>(idx_scale_data_buffer_holder.get());
-  int64_t* input_width_mul_y1 = idx_data;
-  int64_t* input_width_mul_y2 = idx_data + output_height;
-  int64_t* in_x1 = idx_data + 2 * output_height;
-  int64_t* in_x2 = idx_data + 2 * output_height + output_width;
-
-  auto* scale_data = reinterpret_cast<float*>(in_x2 + output_width);
-  float* dy1 = scale_data;
-  float* dy2 = scale_data + output_height;
-  float* dx1 = scale_data + 2 * output_height;
-  float* dx2 = scale_data + 2 * output_height + output_width;
+static void BuildBilinearTables(UpsampleTables& tables,
+                                int64_t input_height,
+                                int64_t input_width,
+                                int64_t output_height,
+                                int64_t output_width,
+                                float height_scale,
+                                float width_scale,
+                                bool use_extrapolation,
+                                const GetOriginalCoordinateFunc& get_original_coordinate) {
+  const auto& roi = tables.roi;
+
+  tables.input_width_mul_y1.resize(output_height);
+  tables.input_width_mul_y2.resize(output_height);
+  tables.dy1.resize(output_height);
+  tables.dy2.resize(output_height);
+  tables.y_extrapolated.resize(output_height);
 
   auto roi_y_start = roi.size() / 2 - 2;
   auto roi_y_end = roi.size() - 2;
@@ -324,71 +266,177 @@ void UpsampleBilinear(int64_t batch_size,
     float in_y = get_original_coordinate(static_cast<float>(y), height_scale,
                                          static_cast<float>(output_height), static_cast<float>(input_height),
                                          roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
+    tables.y_extrapolated[y] = use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1));
     in_y = std::max(0.0f, std::min(in_y, static_cast<float>(input_height - 1)));
 
     const int64_t in_y1 = std::min(static_cast<int64_t>(in_y), input_height - 1);
     const int64_t in_y2 = std::min(in_y1 + 1, input_height - 1);
-    dy1[y] = std::fabs(in_y - in_y1);
-    dy2[y] = std::fabs(in_y - in_y2);
+    tables.dy1[y] = std::fabs(in_y - in_y1);
+    tables.dy2[y] = std::fabs(in_y - in_y2);
 
     if (in_y1 == in_y2) {
-      dy1[y] = 0.5f;
-      dy2[y] = 0.5f;
+      tables.dy1[y] = 0.5f;
+      tables.dy2[y] = 0.5f;
     }
 
-    input_width_mul_y1[y] = input_width * in_y1;
-    input_width_mul_y2[y] = input_width * in_y2;
+    tables.input_width_mul_y1[y] = input_width * in_y1;
+    tables.input_width_mul_y2[y] = input_width * in_y2;
   }
 
+  tables.in_x1.resize(output_width);
+  tables.in_x2.resize(output_width);
+  tables.dx1.resize(output_width);
+  tables.dx2.resize(output_width);
+  tables.x_extrapolated.resize(output_width);
+
   auto roi_x_start = roi.size() / 2 - 1;
   auto roi_x_end = roi.size() - 1;
   for (int64_t x = 0; x < output_width; ++x) {
     float in_x = get_original_coordinate(static_cast<float>(x), width_scale,
                                          static_cast<float>(output_width), static_cast<float>(input_width),
                                          roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
+    tables.x_extrapolated[x] = use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1));
+    tables.any_x_extrapolated |= tables.x_extrapolated[x] != 0;
     in_x = std::max(0.0f, std::min(in_x, static_cast<float>(input_width - 1)));
 
-    in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
-    in_x2[x] = std::min(in_x1[x] + 1, input_width - 1);
+    tables.in_x1[x] = std::min(static_cast<int64_t>(in_x), input_width - 1);
+    tables.in_x2[x] = std::min(tables.in_x1[x] + 1, input_width - 1);
 
-    dx1[x] = std::abs(in_x - in_x1[x]);
-    dx2[x] = std::abs(in_x - in_x2[x]);
-    if (in_x1[x] == in_x2[x]) {
-      dx1[x] = 0.5f;
-      dx2[x] = 0.5f;
+    tables.dx1[x] = std::abs(in_x - tables.in_x1[x]);
+    tables.dx2[x] = std::abs(in_x - tables.in_x2[x]);
+    if (tables.in_x1[x] == tables.in_x2[x]) {
+      tables.dx1[x] = 0.5f;
+      tables.dx2[x] = 0.5f;
     }
   }
+}
+
+// The following methods support a 4-D input in 'Linear mode'
+// that amounts to 'Bilinear' Upsampling/Resizing in the sense that it assumes
+// the scale values for the outermost 2 dimensions are 1.
+// This is the common use-case where the 4-D input (batched multi-channel images)
+// is usually of shape [N, C, H, W] and the scales are [1.0, 1.0, height_scale, width_scale]
+// The N * C * output_height output rows are split across the thread pool.
+template <typename T>
+void UpsampleBilinear(int64_t num_images,
+                      int64_t input_height,
+                      int64_t input_width,
+                      int64_t output_height,
+                      int64_t output_width,
+                      const UpsampleTables& tables,
+                      float extrapolation_value,
+                      const T* Xdata,
+                      T* Ydata,
+                      concurrency::ThreadPool* tp) {
+  const concurrency::TensorOpCost cost{static_cast<double>(output_width * 4 * sizeof(T)),
+                                       static_cast<double>(output_width * sizeof(T)),
+                                       static_cast<double>(output_width * 8)};
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_images * output_height), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t y = row % output_height;
+          T* Yrow = Ydata + row * output_width;
 
-  for (int64_t n = 0; n < batch_size; ++n) {
-    for (int64_t c = 0; c < num_channels; ++c) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        for (int64_t x = 0; x < output_width; ++x) {
           // when use_extrapolation is set and original index of x or y is out of the dim range
           // then use extrapolation_value as the output value.
-          if (use_extrapolation &&
-              ((y_original[y] < 0 || y_original[y] > static_cast<float>(input_height - 1)) ||
-               (x_original[x] < 0 || x_original[x] > static_cast<float>(input_width - 1)))) {
-            Ydata[output_width * y + x] = static_cast<T>(extrapolation_value);
+          if (tables.y_extrapolated[y]) {
+            std::fill_n(Yrow, output_width, static_cast<T>(extrapolation_value));
             continue;
           }
 
-          T X11 = Xdata[input_width_mul_y1[y] + in_x1[x]];
-          T X21 = Xdata[input_width_mul_y1[y] + in_x2[x]];
-          T X12 = Xdata[input_width_mul_y2[y] + in_x1[x]];
-          T X22 = Xdata[input_width_mul_y2[y] + in_x2[x]];
+          const T* Xdata_n = Xdata + (row / output_height) * input_height * input_width;
+          const T* X1 = Xdata_n + tables.input_width_mul_y1[y];
+          const T* X2 = Xdata_n + tables.input_width_mul_y2[y];
+          const float dy1 = tables.dy1[y];
+          const float dy2 = tables.dy2[y];
+          for (int64_t x = 0; x < output_width; ++x) {
+            if (tables.x_extrapolated[x]) {
+              Yrow[x] = static_cast<T>(extrapolation_value);
+              continue;
+            }
+
+            const int64_t in_x1 = tables.in_x1[x];
+            const int64_t in_x2 = tables.in_x2[x];
+            const float dx1 = tables.dx1[x];
+            const float dx2 = tables.dx2[x];
+            Yrow[x] = static_cast<T>(dx2 * dy2 * X1[in_x1] +
+                                     dx1 * dy2 * X1[in_x2] +
+                                     dx2 * dy1 * X2[in_x1] +
+                                     dx1 * dy1 * X2[in_x2]);
+          }
+        }
+      });
+}
+
+// float version of the above, interpolating separably: every input row is first interpolated along the width,
+// and the output row is then blended from the two interpolated rows surrounding it. When upsampling, consecutive
+// output rows share their input rows, so the two most recent interpolated rows are kept for reuse.
+static void UpsampleBilinear(int64_t num_images,
+                             int64_t input_height,
+                             int64_t input_width,
+                             int64_t output_height,
+                             int64_t output_width,
+                             const UpsampleTables& tables,
+                             float extrapolation_value,
+                             const float* Xdata,
+                             float* Ydata,
+                             concurrency::ThreadPool* tp) {
+  const concurrency::TensorOpCost cost{static_cast<double>(output_width * 2 * sizeof(float)),
+                                       static_cast<double>(output_width * sizeof(float)),
+                                       static_cast<double>(output_width * 4)};
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_images * output_height), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> interpolated_rows(2 * output_width);
+        int64_t row_offsets[2] = {-1, -1};
+
+        // returns the slot holding the input row starting at row_offset interpolated along the width,
+        // computing it into a slot other than keep_slot when it is not present.
+        auto get_interpolated_row = [&](int64_t row_offset, int keep_slot) {
+          int slot = row_offsets[0] == row_offset ? 0 : row_offsets[1] == row_offset ? 1 : -1;
+          if (slot < 0) {
+            slot = keep_slot == 0 ? 1 : 0;
+            const float* Xrow = Xdata + row_offset;
+            float* interpolated = interpolated_rows.data() + slot * output_width;
+            for (int64_t x = 0; x < output_width; ++x) {
+              interpolated[x] = tables.dx2[x] * Xrow[tables.in_x1[x]] + tables.dx1[x] * Xrow[tables.in_x2[x]];
+            }
+            row_offsets[slot] = row_offset;
+          }
+          return slot;
+        };
+
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const int64_t y = row % output_height;
+          float* Yrow = Ydata + row * output_width;
 
-          Ydata[output_width * y + x] = static_cast<T>(dx2[x] * dy2[y] * X11 +
-                                                       dx1[x] * dy2[y] * X21 +
-                                                       dx2[x] * dy1[y] * X12 +
-                                                       dx1[x] * dy1[y] * X22);
+          if (tables.y_extrapolated[y]) {
+            std::fill_n(Yrow, output_width, extrapolation_value);
+            continue;
+          }
+
+          const int64_t image_offset = (row / output_height) * input_height * input_width;
+          const int64_t row_offset1 = image_offset + tables.input_width_mul_y1[y];
+          const int64_t row_offset2 = image_offset + tables.input_width_mul_y2[y];
+          const int slot1 = get_interpolated_row(row_offset1, row_offsets[0] == row_offset2 ? 0 : 1);
+          const int slot2 = get_interpolated_row(row_offset2, slot1);
+
+          EigenVectorArrayMap<float>(Yrow, output_width) =
+              tables.dy2[y] * ConstEigenVectorArrayMap<float>(interpolated_rows.data() + slot1 * output_width,
+                                                              output_width) +
+              tables.dy1[y] * ConstEigenVectorArrayMap<float>(interpolated_rows.data() + slot2 * output_width,
+                                                              output_width);
+
+          if (tables.any_x_extrapolated) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              if (tables.x_extrapolated[x]) {
+                Yrow[x] = extrapolation_value;
+              }
+            }
+          }
         }
-      }
-      Xdata += input_height * input_width;
-      Ydata += output_width * output_height;
-    }
-  }
+      });
 }
 
 // Calculates cubic coeff based on Robert Keys approach
@@ -581,6 +629,39 @@ void ResizeBiCubic(
   }
 }
 
+template <typename T>
+std::shared_ptr<const UpsampleTables> Upsample<T>::GetTables(const std::vector<int64_t>& input_dims,
+                                                             const std::vector<int64_t>& output_dims,
+                                                             const std::vector<float>& scales,
+                                                             const std::vector<float>& roi) const {
+  {
+    std::lock_guard<OrtMutex> lock(tables_mutex_);
+    if (tables_ != nullptr && tables_->Matches(input_dims, output_dims, scales, roi)) {
+      return tables_;
+    }
+  }
+
+  auto tables = std::make_shared<UpsampleTables>();
+  tables->input_dims = input_dims;
+  tables->output_dims = output_dims;
+  tables->scales = scales;
+  tables->roi = roi;
+
+  if (mode_ == UpsampleMode::NN) {
+    BuildNearestTables(*tables, use_extrapolation_, get_original_coordinate_, get_nearest_pixel_);
+  } else {
+    bool is_2D = input_dims.size() == 2;
+    BuildBilinearTables(*tables, is_2D ? input_dims[0] : input_dims[2], is_2D ? input_dims[1] : input_dims[3],
+                        is_2D ? output_dims[0] : output_dims[2], is_2D ? output_dims[1] : output_dims[3],
+                        is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], use_extrapolation_,
+                        get_original_coordinate_);
+  }
+
+  std::lock_guard<OrtMutex> lock(tables_mutex_);
+  tables_ = tables;
+  return tables;
+}
+
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                 const std::vector<float>& roi,
@@ -613,10 +694,12 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
   }
 
   switch (mode_) {
-    case UpsampleMode::NN:
-      return UpsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), X->Shape(), Y->Shape(), scales, roi,
-                                is_resize_, use_extrapolation_, extrapolation_value_, use_nearest2x_optimization_,
-                                get_original_coordinate_, get_nearest_pixel_);
+    case UpsampleMode::NN: {
+      auto tables = GetTables(dims, output_dims, scales, roi);
+      UpsampleNearest<T>(X->template Data<T>(), Y->template MutableData<T>(), *tables, extrapolation_value_,
+                         context->GetOperatorThreadPool());
+      return Status::OK();
+    }
     case UpsampleMode::LINEAR: {
       //The correct behavior of 'linear' mode for an N-D input is not clear right now,
       //so only support 'bilinear' with 2-D or 4-D input tensor with outermost 2 scales as 1 in the 4-D case
@@ -636,12 +719,10 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
       const int64_t output_height = is_2D ? output_dims[0] : output_dims[2];
       const int64_t output_width = is_2D ? output_dims[1] : output_dims[3];
 
-      AllocatorPtr alloc;
-      ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
-      UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
-                       is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], roi,
-                       use_extrapolation_, extrapolation_value_, X->template Data<T>(),
-                       Y->template MutableData<T>(), alloc, get_original_coordinate_);
+      auto tables = GetTables(dims, output_dims, scales, roi);
+      UpsampleBilinear(batch_size * num_channels, input_height, input_width, output_height, output_width, *tables,
+                       extrapolation_value_, X->template Data<T>(), Y->template MutableData<T>(),
+                       context->GetOperatorThreadPool());
       return Status::OK();
     }
     case UpsampleMode::CUBIC: {
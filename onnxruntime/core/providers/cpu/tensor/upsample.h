@@ -4,7 +4,9 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
 #include <cmath>
+#include <memory>
 
 namespace onnxruntime {
 
@@ -86,10 +88,6 @@ class UpsampleBase {
       ORT_THROW("exclude_outside can be set to 1 only when mode is CUBIC. Current mode is set to " + mode);
     }
 
-    // after version 11 update, this optimization is no longer applicable for all the available modes...
-    // TODO : needs more testing to enable this for version 11
-    use_nearest2x_optimization_ = start > 10 ? false : true;
-
     if (start > 10) {
       roi_input_idx_ = 1;
       scales_input_idx_ = 2;
@@ -129,7 +127,6 @@ class UpsampleBase {
   float cubic_coeff_a_;
   bool exclude_outside_;
   float extrapolation_value_;
-  bool use_nearest2x_optimization_ = false;
 
   std::vector<float> scales_;
   std::vector<float> roi_;
@@ -319,6 +316,8 @@ class UpsampleBase {
   }
 };  // UpsampleBase 
 
+struct UpsampleTables;
+
 template <typename T>
 class Upsample : public UpsampleBase, public OpKernel {
  public:
@@ -329,6 +328,17 @@ class Upsample : public UpsampleBase, public OpKernel {
 
   Status BaseCompute(OpKernelContext* context, const std::vector<float>& roi, const std::vector<float>& scales,
                      const std::vector<int64_t>& output_dims) const;
+
+ private:
+  // Returns the per-axis index and weight tables for the input and output dims, scales and roi. The tables of the
+  // last call are kept, as the shapes of a model rarely change between runs.
+  std::shared_ptr<const UpsampleTables> GetTables(const std::vector<int64_t>& input_dims,
+                                                  const std::vector<int64_t>& output_dims,
+                                                  const std::vector<float>& scales,
+                                                  const std::vector<float>& roi) const;
+
+  mutable OrtMutex tables_mutex_;
+  mutable std::shared_ptr<const UpsampleTables> tables_;
 };
 
 }  // namespace onnxruntime
@@ -4,6 +4,10 @@
 #pragma once
 #include "gsl/gsl"
 #include "core/framework/utils.h"
+#include "core/platform/threadpool.h"
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
 namespace onnxruntime {
 
 struct TensorPitches : std::vector<int64_t> {
@@ -280,6 +284,22 @@ inline void CopyCpuTensor(const Tensor* src, Tensor* tgt) {
   }
 }
 
+// Cost of copying num_bytes for ThreadPool::TryParallelFor, so the copy kernels split their work by byte count.
+inline concurrency::TensorOpCost CopyCost(size_t num_bytes) {
+  return concurrency::TensorOpCost{static_cast<double>(num_bytes), static_cast<double>(num_bytes), 0};
+}
+
+// Hint the processor to load the cache line holding address, for reads in an order its prefetcher can't predict.
+inline void PrefetchCacheLine(const void* address) {
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+  _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__)
+  __builtin_prefetch(address);
+#else
+  ORT_UNUSED_PARAMETER(address);
+#endif
+}
+
 // This provides easy sequential iteration over a subset of a tensor given a span of starts, extents & optionally steps
 template <typename T>
 struct WritableSliceIterator {
@@ -28,16 +28,14 @@ common::Status IOBinding::BindInput(const std::string& name, const OrtValue& ml_
     } else {
       feed_names_.push_back(name);
       feeds_.push_back(value);
+      feeds_fetches_manager_.reset();
     }
+    validated_ = false;
   };
 
-  if (ml_value.IsTensor()) {
-    OrtValue new_mlvalue;
-    ORT_RETURN_IF_ERROR(utils::CopyOneInputAcrossDevices(session_state_, name, ml_value, new_mlvalue));
-    add_or_replace(rc.first, rc.second, new_mlvalue);
-  } else {
-    add_or_replace(rc.first, rc.second, ml_value);
-  }
+  // the caller's value is kept as is, an input on another device than the one of the nodes consuming it is copied
+  // by every Run so data written to its buffer after binding is not missed
+  add_or_replace(rc.first, rc.second, ml_value);
 
   return Status::OK();
 }
@@ -74,17 +72,37 @@ common::Status IOBinding::SynchronizeOutputs() {
 }
 
 common::Status IOBinding::BindOutput(const std::string& name, const OrtValue& ml_value) {
+  validated_ = false;
+
   auto rc = Contains(output_names_, name);
   if (rc.first) {
     outputs_[rc.second] = ml_value;
+    outputs_preallocated_[rc.second] = ml_value.IsAllocated();
     return Status::OK();
   }
 
   output_names_.push_back(name);
   outputs_.push_back(ml_value);
+  outputs_preallocated_.push_back(ml_value.IsAllocated());
+  feeds_fetches_manager_.reset();
   return Status::OK();
 }
 
+void IOBinding::ClearInputs() {
+  feed_names_.clear();
+  feeds_.clear();
+  feeds_fetches_manager_.reset();
+  validated_ = false;
+}
+
+void IOBinding::ClearOutputs() {
+  output_names_.clear();
+  outputs_.clear();
+  outputs_preallocated_.clear();
+  feeds_fetches_manager_.reset();
+  validated_ = false;
+}
+
 const std::vector<std::string>& IOBinding::GetOutputNames() const {
   return output_names_;
 }
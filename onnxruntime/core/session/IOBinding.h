@@ -10,6 +10,7 @@
 #include "core/common/status.h"
 #include "core/graph/basic_types.h"
 #include "core/framework/ml_value.h"
+#include "core/framework/feeds_fetches_manager.h"
 #include "core/session/inference_session.h"
 #include "core/common/logging/logging.h"
 
@@ -35,17 +36,18 @@ class SessionState;
  * session.Run(io_binding);
  *
  * vector<OrtValue>& outputs = io_binding->GetOutputs();
+ *
+ * The names are only validated and mapped to the graph values by the first Run after they change, so a binding
+ * reused across Run calls skips that work. A binding must not be used by concurrent Run calls.
  */
 class IOBinding {
  public:
   /**
    * Call repeatedly to bind as many inputs as required.
    * If called again for the same name will replace an existing value.
-   * If the input ort_value is not at the desired location (specified by the execution provider), this will
-   * copy it to the desired location. This copy may or may not be async. It depends on the exec provider.
-   * If the input ort_value is not at the desired location, it should be preallocated
-   * If the input ort_value isn't preallocated, it should have memtype of OrtMemTypeDefault
-   * For copying it leverages DataTransferManager::CopyTensor().
+   * The binding keeps a reference to ort_value, so data written to its buffer is used by the next Run.
+   * If the input ort_value is not at the desired location (specified by the execution provider), every Run
+   * copies it to the desired location with DataTransferManager::CopyTensor().
    */
   common::Status BindInput(const std::string& name, const OrtValue& ml_value);
 
@@ -60,9 +62,16 @@ class IOBinding {
   common::Status SynchronizeOutputs();
   /**
     * This simply provides the names and optionally allocated output containers.
+    * An output bound without an allocated container is allocated by every Run, an allocated one is written in place.
     */
   common::Status BindOutput(const std::string& name, const OrtValue& ml_value);
 
+  /**
+    * Remove all the bound inputs or outputs.
+    */
+  void ClearInputs();
+  void ClearOutputs();
+
   /**
     * This simply collects the outputs obtained after calling Run() inside the @param outputs.
     */
@@ -88,6 +97,12 @@ class IOBinding {
   std::vector<OrtValue> feeds_;
   std::vector<std::string> output_names_;
   std::vector<OrtValue> outputs_;
+  std::vector<bool> outputs_preallocated_;
+
+  // mapping of the bound names to the graph values, created by the first Run after the names change
+  std::unique_ptr<FeedsFetchesManager> feeds_fetches_manager_;
+  // whether the bound values were validated against the model since they were last bound
+  bool validated_ = false;
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(IOBinding);
 };
@@ -95,6 +95,16 @@ ORT_API_STATUS_IMPL(OrtApis::DisableCpuMemArena, _In_ OrtSessionOptions* options
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::EnableCpuMemArenaThreadCache, _Inout_ OrtSessionOptions* options) {
+  options->value.enable_cpu_mem_arena_thread_cache = true;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::EnableColumnarZipMap, _Inout_ OrtSessionOptions* options) {
+  options->value.columnar_zipmap = true;
+  return nullptr;
+}
+
 ///< logger id to use for session output
 ORT_API_STATUS_IMPL(OrtApis::SetSessionLogId, _In_ OrtSessionOptions* options, const char* logid) {
   options->value.session_logid = logid;
@@ -149,6 +159,11 @@ ORT_API_STATUS_IMPL(OrtApis::SetInterOpNumThreads, _In_ OrtSessionOptions* optio
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(OrtApis::DisablePerSessionThreads, _Inout_ OrtSessionOptions* options) {
+  options->value.use_per_session_threads = false;
+  return nullptr;
+}
+
 ORT_API_STATUS_IMPL(OrtApis::AddFreeDimensionOverride, _Inout_ OrtSessionOptions* options,
                     _In_ const char* symbolic_dim, _In_ int64_t dim_override) {
   options->value.free_dimension_overrides.push_back(onnxruntime::FreeDimensionOverride{symbolic_dim, dim_override});
@@ -18,6 +18,7 @@
 #endif
 
 #include "core/platform/env.h"
+#include "core/util/thread_utils.h"
 
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
 #include "core/platform/tracing.h"
@@ -31,16 +32,24 @@ std::once_flag schemaRegistrationOnceFlag;
 
 std::atomic<bool> Environment::is_initialized_{false};
 
-Status Environment::Create(std::unique_ptr<Environment>& environment) {
+Status Environment::Create(std::unique_ptr<Environment>& environment, const ThreadingOptions* tp_options) {
   environment = std::unique_ptr<Environment>(new Environment());
-  auto status = environment->Initialize();
+  auto status = environment->Initialize(tp_options);
   return status;
 }
 
-Status Environment::Initialize() {
+Status Environment::Initialize(const ThreadingOptions* tp_options) {
   auto status = Status::OK();
 
   try {
+    if (tp_options != nullptr) {
+      create_global_thread_pools_ = true;
+      intra_op_thread_pool_ = concurrency::CreateThreadPool("env_global_intra_op_thread_pool",
+                                                            tp_options->intra_op_num_threads);
+      inter_op_thread_pool_ = concurrency::CreateThreadPool("env_global_inter_op_thread_pool",
+                                                            tp_options->inter_op_num_threads);
+    }
+
     // Register Microsoft domain with min/max op_set version as 1/1.
     std::call_once(schemaRegistrationOnceFlag, []() {
       ONNX_NAMESPACE::OpSchemaRegistry::DomainToVersionRange::Instance().AddDomainToVersion(onnxruntime::kMSDomain, 1, 1);
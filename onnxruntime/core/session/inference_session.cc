@@ -7,6 +7,7 @@
 
 #include "core/session/inference_session.h"
 
+#include <algorithm>
 #include <memory>
 #include <sstream>
 #include <unordered_set>
@@ -163,7 +164,8 @@ static Status FinalizeSessionOptions(const SessionOptions& user_provided_session
 }
 
 void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
-                                         logging::LoggingManager* logging_manager) {
+                                         logging::LoggingManager* logging_manager,
+                                         const Environment* session_env) {
   ORT_ENFORCE(Environment::IsInitialized(),
               "Environment must be initialized before creating an InferenceSession.");
 
@@ -175,19 +177,35 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
       session_options_.max_num_graph_transformation_steps);
   logging_manager_ = logging_manager;
 
-  thread_pool_ = concurrency::CreateThreadPool("intra_op_thread_pool",
-                                               session_options_.intra_op_num_threads);
-
-  inter_op_thread_pool_ = session_options_.execution_mode == ExecutionMode::ORT_PARALLEL
-                              ? concurrency::CreateThreadPool("inter_op_thread_pool",
-                                                              session_options_.inter_op_num_threads)
-                              : nullptr;
+  concurrency::ThreadPool* intra_op_thread_pool = nullptr;
+  concurrency::ThreadPool* inter_op_thread_pool = nullptr;
+  if (session_options_.use_per_session_threads) {
+    thread_pool_ = concurrency::CreateThreadPool("intra_op_thread_pool",
+                                                 session_options_.intra_op_num_threads);
+
+    inter_op_thread_pool_ = session_options_.execution_mode == ExecutionMode::ORT_PARALLEL
+                                ? concurrency::CreateThreadPool("inter_op_thread_pool",
+                                                                session_options_.inter_op_num_threads)
+                                : nullptr;
+    intra_op_thread_pool = thread_pool_.get();
+    inter_op_thread_pool = inter_op_thread_pool_.get();
+  } else {
+    ORT_ENFORCE(session_env != nullptr && session_env->EnvCreatedWithGlobalThreadPools(),
+                "When the session is not configured to use per session threadpools, the env must be created with "
+                "global threadpools.");
+    intra_op_thread_pool = session_env->GetIntraOpThreadPool();
+    inter_op_thread_pool = session_options_.execution_mode == ExecutionMode::ORT_PARALLEL
+                               ? session_env->GetInterOpThreadPool()
+                               : nullptr;
+  }
 
   session_state_ = onnxruntime::make_unique<SessionState>(execution_providers_,
                                                           session_options_.enable_mem_pattern &&
                                                               session_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL,
-                                                          thread_pool_.get(),
-                                                          inter_op_thread_pool_.get());
+                                                          intra_op_thread_pool,
+                                                          inter_op_thread_pool,
+                                                          session_options_.mem_pattern_cache_capacity,
+                                                          session_options_.mem_pattern_dim_bucket_size);
 
   InitLogger(logging_manager);
 
@@ -203,15 +221,17 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
 }
 
 InferenceSession::InferenceSession(const SessionOptions& session_options,
-                                   logging::LoggingManager* logging_manager)
+                                   logging::LoggingManager* logging_manager,
+                                   const Environment* session_env)
     : insert_cast_transformer_("CastFloat16Transformer") {
   // Initialize assets of this session instance
-  ConstructorCommon(session_options, logging_manager);
+  ConstructorCommon(session_options, logging_manager, session_env);
 }
 
 InferenceSession::InferenceSession(const SessionOptions& session_options,
                                    const std::string& model_uri,
-                                   logging::LoggingManager* logging_manager)
+                                   logging::LoggingManager* logging_manager,
+                                   const Environment* session_env)
     : insert_cast_transformer_("CastFloat16Transformer") {
   model_location_ = ToWideString(model_uri);
   model_proto_ = onnxruntime::make_unique<ONNX_NAMESPACE::ModelProto>();
@@ -220,13 +240,14 @@ InferenceSession::InferenceSession(const SessionOptions& session_options,
               status.ErrorMessage());
 
   // Finalize session options and initialize assets of this session instance
-  ConstructorCommon(session_options, logging_manager);
+  ConstructorCommon(session_options, logging_manager, session_env);
 }
 
 #ifdef _WIN32
 InferenceSession::InferenceSession(const SessionOptions& session_options,
                                    const std::wstring& model_uri,
-                                   logging::LoggingManager* logging_manager)
+                                   logging::LoggingManager* logging_manager,
+                                   const Environment* session_env)
     : insert_cast_transformer_("CastFloat16Transformer") {
   model_location_ = ToWideString(model_uri);
   model_proto_ = onnxruntime::make_unique<ONNX_NAMESPACE::ModelProto>();
@@ -235,13 +256,14 @@ InferenceSession::InferenceSession(const SessionOptions& session_options,
               status.ErrorMessage());
 
   // Finalize session options and initialize assets of this session instance
-  ConstructorCommon(session_options, logging_manager);
+  ConstructorCommon(session_options, logging_manager, session_env);
 }
 #endif
 
 InferenceSession::InferenceSession(const SessionOptions& session_options,
                                    std::istream& model_istream,
-                                   logging::LoggingManager* logging_manager)
+                                   logging::LoggingManager* logging_manager,
+                                   const Environment* session_env)
     : insert_cast_transformer_("CastFloat16Transformer") {
   google::protobuf::io::IstreamInputStream zero_copy_input(&model_istream);
   model_proto_ = onnxruntime::make_unique<ONNX_NAMESPACE::ModelProto>();
@@ -249,20 +271,21 @@ InferenceSession::InferenceSession(const SessionOptions& session_options,
   ORT_ENFORCE(result, "Could not parse model successfully while constructing the inference session");
 
   // Finalize session options and initialize assets of this session instance
-  ConstructorCommon(session_options, logging_manager);
+  ConstructorCommon(session_options, logging_manager, session_env);
 }
 
 InferenceSession::InferenceSession(const SessionOptions& session_options,
                                    const void* model_data,
                                    int model_data_len,
-                                   logging::LoggingManager* logging_manager)
+                                   logging::LoggingManager* logging_manager,
+                                   const Environment* session_env)
     : insert_cast_transformer_("CastFloat16Transformer") {
   model_proto_ = onnxruntime::make_unique<ONNX_NAMESPACE::ModelProto>();
   const bool result = model_proto_->ParseFromArray(model_data, model_data_len);
   ORT_ENFORCE(result, "Could not parse model successfully while constructing the inference session");
 
   // Finalize session options and initialize assets of this session instance
-  ConstructorCommon(session_options, logging_manager);
+  ConstructorCommon(session_options, logging_manager, session_env);
 }
 
 InferenceSession::~InferenceSession() {
@@ -371,6 +394,10 @@ common::Status InferenceSession::Load(std::function<common::Status(std::shared_p
 
     model_ = p_tmp_model;
 
+    if (session_options_.columnar_zipmap) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ReplaceZipMapOutputs());
+    }
+
     status = DoPostLoadProcessing(*model_);
     ORT_RETURN_IF_ERROR_SESSIONID_(status);
 
@@ -674,7 +701,9 @@ common::Status InferenceSession::CreateSubgraphSessionState(Graph& graph, Sessio
       auto subgraph_session_state = onnxruntime::make_unique<SessionState>(execution_providers_,
                                                                            session_state.GetEnableMemoryPattern(),
                                                                            session_state.GetThreadPool(),
-                                                                           session_state.GetInterOpThreadPool());
+                                                                           session_state.GetInterOpThreadPool(),
+                                                                           session_state.GetMemoryPatternCache().Capacity(),
+                                                                           session_state.GetMemoryPatternCache().DimBucketSize());
       subgraph_session_state->SetProfiler(session_profiler_);
       subgraph_session_state->SetLogger(*session_logger_);
       // Pass data transfer manager to subgraph.
@@ -769,7 +798,8 @@ common::Status InferenceSession::Initialize() {
     // Register default CPUExecutionProvider if user didn't provide it through the Register() calls
     if (!execution_providers_.Get(onnxruntime::kCpuExecutionProvider)) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
-      CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena,
+                                   session_options_.enable_cpu_mem_arena_thread_cache};
       auto p_cpu_exec_provider = onnxruntime::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
     }
@@ -868,6 +898,10 @@ const SessionOptions& InferenceSession::GetSessionOptions() const {
   return session_options_;
 }
 
+MemoryPatternCacheStats InferenceSession::GetMemoryPatternCacheStats() const {
+  return session_state_->GetMemoryPatternCacheStats();
+}
+
 common::Status InferenceSession::CheckShapes(const std::string& input_name,
                                              const TensorShape& input_shape,
                                              const TensorShape& expected_shape) const {
@@ -1004,6 +1038,12 @@ common::Status InferenceSession::ValidateOutputs(const std::vector<std::string>&
 Status InferenceSession::Run(const RunOptions& run_options, const std::vector<std::string>& feed_names,
                              const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
                              std::vector<OrtValue>* p_fetches) {
+  return Run(run_options, feed_names, feeds, output_names, p_fetches, nullptr);
+}
+
+Status InferenceSession::Run(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                             const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                             std::vector<OrtValue>* p_fetches, FeedsFetchesManager* feeds_fetches_manager) {
   TimePoint tp;
   if (session_profiler_.IsEnabled()) {
     tp = session_profiler_.StartTime();
@@ -1022,11 +1062,15 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
       return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
     }
 
-    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
-    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
+    std::unique_ptr<FeedsFetchesManager> owned_feeds_fetches_manager;
+    if (feeds_fetches_manager == nullptr) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(feed_names, feeds));
+      ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(output_names, p_fetches));
 
-    FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
-    FeedsFetchesManager feeds_fetches_manager{std::move(info)};
+      FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
+      owned_feeds_fetches_manager = onnxruntime::make_unique<FeedsFetchesManager>(std::move(info));
+      feeds_fetches_manager = owned_feeds_fetches_manager.get();
+    }
 
     if (!run_options.run_tag.empty()) {
       LOGS(*session_logger_, INFO) << "Running with tag: " << run_options.run_tag;
@@ -1049,7 +1093,7 @@ Status InferenceSession::Run(const RunOptions& run_options, const std::vector<st
 
     // execute the graph
     ORT_CHECK_AND_SET_RETVAL(
-        utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
+        utils::ExecuteGraph(*session_state_, *feeds_fetches_manager, feeds, *p_fetches,
                             session_options_.execution_mode,
                             run_options.terminate, run_logger));
 
@@ -1181,8 +1225,32 @@ common::Status InferenceSession::NewIOBinding(std::unique_ptr<IOBinding>* io_bin
 common::Status InferenceSession::Run(const RunOptions& run_options, IOBinding& io_binding) {
   // TODO should Run() call io_binding.SynchronizeInputs() or should it let the callers do it?
   // io_binding.SynchronizeInputs();
-  return Run(run_options, io_binding.GetInputNames(), io_binding.GetInputs(),
-             io_binding.GetOutputNames(), &io_binding.GetOutputs());
+  if (!is_inited_) {
+    LOGS(*session_logger_, ERROR) << "Session was not initialized";
+    return Status(common::ONNXRUNTIME, common::FAIL, "Session not initialized.");
+  }
+
+  // the names and values are only validated again once they have been rebound
+  if (!io_binding.validated_) {
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateInputs(io_binding.feed_names_, io_binding.feeds_));
+    ORT_RETURN_IF_ERROR_SESSIONID_(ValidateOutputs(io_binding.output_names_, &io_binding.outputs_));
+    if (io_binding.feeds_fetches_manager_ == nullptr) {
+      ORT_RETURN_IF_ERROR_SESSIONID_(FeedsFetchesManager::Create(io_binding.feed_names_, io_binding.output_names_,
+                                                                 session_state_->GetOrtValueNameIdxMap(),
+                                                                 io_binding.feeds_fetches_manager_));
+    }
+    io_binding.validated_ = true;
+  }
+
+  // the outputs bound without a container get a new one allocated by this run
+  for (size_t i = 0, end = io_binding.outputs_.size(); i < end; ++i) {
+    if (!io_binding.outputs_preallocated_[i]) {
+      io_binding.outputs_[i] = OrtValue();
+    }
+  }
+
+  return Run(run_options, io_binding.feed_names_, io_binding.feeds_, io_binding.output_names_,
+             &io_binding.outputs_, io_binding.feeds_fetches_manager_.get());
 }
 
 common::Status InferenceSession::Run(IOBinding& io_binding) {
@@ -1224,6 +1292,77 @@ std::string InferenceSession::EndProfiling() {
   return std::string();
 }
 
+common::Status InferenceSession::ReplaceZipMapOutputs() {
+  bool has_zipmap = false;
+  for (const auto& node : model_->MainGraph().Nodes()) {
+    has_zipmap = has_zipmap || (node.OpType() == "ZipMap" && node.Domain() == kMLDomain);
+  }
+  if (!has_zipmap) {
+    return Status::OK();
+  }
+
+  ModelProto model_proto = model_->ToProto();
+  GraphProto& graph_proto = *model_proto.mutable_graph();
+
+  std::unordered_map<std::string, TypeProto*> output_types;
+  for (auto& output : *graph_proto.mutable_output()) {
+    output_types[output.name()] = output.mutable_type();
+  }
+  std::unordered_set<std::string> consumed;
+  for (const auto& node : graph_proto.node()) {
+    consumed.insert(node.input().begin(), node.input().end());
+  }
+
+  for (auto& node : *graph_proto.mutable_node()) {
+    if (node.op_type() != "ZipMap" || node.domain() != kMLDomain || node.output_size() != 1) {
+      continue;
+    }
+    // a ZipMap whose maps are also used inside the graph keeps producing them
+    const std::string& output_name = node.output(0);
+    auto output_type = output_types.find(output_name);
+    if (output_type == output_types.end() || consumed.count(output_name) != 0) {
+      continue;
+    }
+
+    ColumnarZipMapLabels labels;
+    for (const auto& attr : node.attribute()) {
+      if (attr.name() == "classlabels_strings") {
+        labels.strings.assign(attr.strings().begin(), attr.strings().end());
+      } else if (attr.name() == "classlabels_int64s") {
+        labels.int64s.assign(attr.ints().begin(), attr.ints().end());
+      }
+    }
+    if (labels.strings.empty() == labels.int64s.empty()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_GRAPH, "ZipMap node producing ", output_name,
+                             " must have classlabels_strings or classlabels_int64s but not both.");
+    }
+
+    node.set_op_type("Identity");
+    node.clear_domain();
+    node.clear_attribute();
+    output_type->second->Clear();
+    output_type->second->mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    columnar_zipmap_labels_.emplace(output_name, std::move(labels));
+  }
+
+  if (columnar_zipmap_labels_.empty()) {
+    return Status::OK();
+  }
+
+  // models made of ai.onnx.ml operators only may not import the domain of Identity
+  const auto& opset_imports = model_proto.opset_import();
+  if (std::none_of(opset_imports.begin(), opset_imports.end(), [](const OperatorSetIdProto& opset) {
+        return opset.domain() == kOnnxDomain || opset.domain() == kOnnxDomainAlias;
+      })) {
+    auto* opset = model_proto.add_opset_import();
+    opset->set_domain(kOnnxDomain);
+    opset->set_version(1);
+  }
+
+  return Model::Load(model_proto, model_, HasLocalSchema() ? &custom_schema_registries_ : nullptr,
+                     *session_logger_);
+}
+
 // assumes model has already been loaded before
 common::Status InferenceSession::DoPostLoadProcessing(onnxruntime::Model& model) {
   // TODO add other post load processing here
@@ -1231,6 +1370,11 @@ common::Status InferenceSession::DoPostLoadProcessing(onnxruntime::Model& model)
   return status;
 }
 
+const ColumnarZipMapLabels* InferenceSession::GetColumnarZipMapLabels(const std::string& output_name) const {
+  auto labels = columnar_zipmap_labels_.find(output_name);
+  return labels == columnar_zipmap_labels_.end() ? nullptr : &labels->second;
+}
+
 common::Status InferenceSession::SaveModelMetadata(const onnxruntime::Model& model) {
   VLOGS(*session_logger_, 1) << "Saving model metadata";
   const onnxruntime::Graph& graph = model.MainGraph();
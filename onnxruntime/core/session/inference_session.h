@@ -45,8 +45,10 @@ struct OrtCustomOpDomain {
 namespace onnxruntime {
 class IExecutionProvider;  // forward decl
 class IOBinding;
+class FeedsFetchesManager;
 class CustomRegistry;
 class Notification;
+class Environment;
 
 namespace logging {
 class LoggingManager;
@@ -64,6 +66,15 @@ struct ModelMetadata {
   std::unordered_map<std::string, std::string> custom_metadata_map;
 };
 
+/**
+  * Class labels of a ZipMap output returned as a score tensor, see SessionOptions::columnar_zipmap.
+  * Exactly one of the vectors is non-empty. Label i is the one of the column i of the scores.
+  */
+struct ColumnarZipMapLabels {
+  std::vector<std::string> strings;
+  std::vector<int64_t> int64s;
+};
+
 /**
  * @brief This is the main class used to Run a model.
  * Sample simple usage:
@@ -96,9 +107,13 @@ class InferenceSession {
     If nullptr, the default LoggingManager MUST have been created previously as it will be used
     for logging. This will use the default logger id in messages.
     See core/common/logging/logging.h for details, and how LoggingManager::DefaultLogger works.
+    @param session_env
+    Optional environment providing the thread pools used when session_options.use_per_session_threads is false.
+    It must outlive the session.
     */
   explicit InferenceSession(const SessionOptions& session_options,
-                            logging::LoggingManager* logging_manager = nullptr);
+                            logging::LoggingManager* logging_manager = nullptr,
+                            const Environment* session_env = nullptr);
 
   /**
     Create a new InferenceSession
@@ -110,15 +125,20 @@ class InferenceSession {
     If nullptr, the default LoggingManager MUST have been created previously as it will be used
     for logging. This will use the default logger id in messages.
     See core/common/logging/logging.h for details, and how LoggingManager::DefaultLogger works.
+    @param session_env
+    Optional environment providing the thread pools used when session_options.use_per_session_threads is false.
+    It must outlive the session.
     This ctor will throw on encountering model parsing issues.
     */
   InferenceSession(const SessionOptions& session_options,
                    const std::string& model_uri,
-                   logging::LoggingManager* logging_manager = nullptr);
+                   logging::LoggingManager* logging_manager = nullptr,
+                   const Environment* session_env = nullptr);
 #ifdef _WIN32
   InferenceSession(const SessionOptions& session_options,
                    const std::wstring& model_uri,
-                   logging::LoggingManager* logging_manager = nullptr);
+                   logging::LoggingManager* logging_manager = nullptr,
+                   const Environment* session_env = nullptr);
 #endif
 
   /**
@@ -131,11 +151,15 @@ class InferenceSession {
     If nullptr, the default LoggingManager MUST have been created previously as it will be used
     for logging. This will use the default logger id in messages.
     See core/common/logging/logging.h for details, and how LoggingManager::DefaultLogger works.
+    @param session_env
+    Optional environment providing the thread pools used when session_options.use_per_session_threads is false.
+    It must outlive the session.
     This ctor will throw on encountering model parsing issues.
     */
   InferenceSession(const SessionOptions& session_options,
                    std::istream& model_istream,
-                   logging::LoggingManager* logging_manager = nullptr);
+                   logging::LoggingManager* logging_manager = nullptr,
+                   const Environment* session_env = nullptr);
 
   /**
     Create a new InferenceSession
@@ -148,12 +172,16 @@ class InferenceSession {
     If nullptr, the default LoggingManager MUST have been created previously as it will be used
     for logging. This will use the default logger id in messages.
     See core/common/logging/logging.h for details, and how LoggingManager::DefaultLogger works.
+    @param session_env
+    Optional environment providing the thread pools used when session_options.use_per_session_threads is false.
+    It must outlive the session.
     This ctor will throw on encountering model parsing issues.
     */
   InferenceSession(const SessionOptions& session_options,
                    const void* model_data,
                    int model_data_len,
-                   logging::LoggingManager* logging_manager = nullptr);
+                   logging::LoggingManager* logging_manager = nullptr,
+                   const Environment* session_env = nullptr);
 
   virtual ~InferenceSession();
 
@@ -306,6 +334,14 @@ class InferenceSession {
     */
   std::pair<common::Status, const OutputDefList*> GetModelOutputs() const;
 
+  /**
+    * Get the class labels of a model output produced by a ZipMap node when the session was created with
+    * SessionOptions::columnar_zipmap. Such an output holds the scores as a float tensor instead of maps.
+    * @return nullptr if the output is not a ZipMap output returned as a score tensor.
+    * @note lifetime of the returned pointer is valid as long as the Session object is live.
+    */
+  const ColumnarZipMapLabels* GetColumnarZipMapLabels(const std::string& output_name) const;
+
   /**
     * Get the current number of in-progress concurrent Run calls.
     */
@@ -322,6 +358,11 @@ class InferenceSession {
    */
   const SessionOptions& GetSessionOptions() const;
 
+  /*
+   * Get the hit/miss counters of the memory pattern cache of the main graph.
+   */
+  MemoryPatternCacheStats GetMemoryPatternCacheStats() const;
+
   /**
     * Start profiling on this inference session. This simply turns on profiling events to be
     * recorded. A corresponding EndProfiling has to follow to write profiling data to a file.
@@ -381,7 +422,8 @@ class InferenceSession {
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(InferenceSession);
 
   void ConstructorCommon(const SessionOptions& session_options,
-                         logging::LoggingManager* logging_manager);
+                         logging::LoggingManager* logging_manager,
+                         const Environment* session_env);
 
   bool HasLocalSchema() const {
     return !custom_schema_registries_.empty();
@@ -389,6 +431,10 @@ class InferenceSession {
 
   common::Status SaveModelMetadata(const onnxruntime::Model& model);
 
+  // Replaces model_ by a copy where the ZipMap nodes producing a graph output are Identity nodes, and records their
+  // class labels in columnar_zipmap_labels_.
+  common::Status ReplaceZipMapOutputs();
+
   // Create a Logger for a single execution if possible. Otherwise use the default logger.
   // If a new logger is created, it will also be stored in new_run_logger,
   // which must remain valid for the duration of the execution.
@@ -424,6 +470,12 @@ class InferenceSession {
 
   common::Status ValidateOutputs(const std::vector<std::string>& output_names, const std::vector<OrtValue>* p_fetches) const;
 
+  // Runs with the feeds and fetches of feeds_fetches_manager, which are validated and mapped to the graph values by
+  // this call when feeds_fetches_manager is null.
+  common::Status Run(const RunOptions& run_options, const std::vector<std::string>& feed_names,
+                     const std::vector<OrtValue>& feeds, const std::vector<std::string>& output_names,
+                     std::vector<OrtValue>* p_fetches, FeedsFetchesManager* feeds_fetches_manager);
+
   common::Status WaitForNotification(Notification* p_executor_done, int64_t timeout_in_ms);
 
   template <typename T>
@@ -459,7 +511,7 @@ class InferenceSession {
   std::unique_ptr<SessionState> session_state_;
 
  private:
-  // Threadpool for this session
+  // Threadpools owned by this session, both are nullptr when the session uses the environment's thread pools
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> thread_pool_;
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
 
@@ -483,6 +535,9 @@ class InferenceSession {
   std::unordered_map<std::string, InputDefMetaData> input_def_map_;
   OutputDefList output_def_list_;
 
+  // class labels of the ZipMap outputs returned as score tensors, by output name
+  std::unordered_map<std::string, ColumnarZipMapLabels> columnar_zipmap_labels_;
+
   // Data transfer manager.
   DataTransferManager data_transfer_mgr_;
 
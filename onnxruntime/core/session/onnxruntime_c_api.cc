@@ -6,6 +6,7 @@
 #include "core/framework/error_code_helper.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/utils.h"
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <functional>
@@ -23,6 +24,7 @@
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/onnxruntime_typeinfo.h"
 #include "core/session/inference_session.h"
+#include "core/session/IOBinding.h"
 #include "core/session/ort_apis.h"
 #include "core/framework/data_types.h"
 #include "abi_session_options_impl.h"
@@ -67,6 +69,14 @@ class LoggingWrapper : public ISink {
   void* logger_param_;
 };
 
+struct OrtThreadingOptions {
+  onnxruntime::ThreadingOptions value;
+};
+
+struct OrtIoBinding {
+  std::unique_ptr<onnxruntime::IOBinding> value;
+};
+
 struct OrtEnv {
  public:
   struct LoggingManagerConstructionInfo {
@@ -84,11 +94,13 @@ struct OrtEnv {
     const char* logid{};
   };
 
-  static OrtEnv* GetInstance(const LoggingManagerConstructionInfo& lm_info, Status& status) {
+  // tp_options is not null when the environment is created with global thread pools.
+  static OrtEnv* GetInstance(const LoggingManagerConstructionInfo& lm_info, Status& status,
+                             const onnxruntime::ThreadingOptions* tp_options = nullptr) {
     std::lock_guard<OrtMutex> lock(m_);
     if (!p_instance_) {
       std::unique_ptr<Environment> env;
-      status = Environment::Create(env);
+      status = Environment::Create(env, tp_options);
       if (!status.IsOK()) {
         return nullptr;
       }
@@ -112,6 +124,11 @@ struct OrtEnv {
       }
 
       p_instance_ = new OrtEnv(std::move(env), std::move(lmgr));
+    } else if (tp_options != nullptr && !p_instance_->value_->EnvCreatedWithGlobalThreadPools()) {
+      // the environment is a process-wide singleton, its thread pools can't be added after the fact
+      status = Status(onnxruntime::common::ONNXRUNTIME, onnxruntime::common::INVALID_ARGUMENT,
+                      "An environment without global thread pools already exists in this process.");
+      return nullptr;
     }
     ++ref_count_;
     return p_instance_;
@@ -134,6 +151,10 @@ struct OrtEnv {
     return logging_manager_.get();
   }
 
+  const Environment* GetEnvironment() const {
+    return value_.get();
+  }
+
  private:
   static OrtEnv* p_instance_;
   static OrtMutex m_;
@@ -186,6 +207,35 @@ ORT_API_STATUS_IMPL(OrtApis::CreateEnv, OrtLoggingLevel default_warning_level,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateEnvWithGlobalThreadPools, OrtLoggingLevel default_warning_level,
+                    _In_ const char* logid, _In_ const OrtThreadingOptions* t_options, _Outptr_ OrtEnv** out) {
+  API_IMPL_BEGIN
+  OrtEnv::LoggingManagerConstructionInfo lm_info{nullptr, nullptr, default_warning_level, logid};
+  Status status;
+  *out = OrtEnv::GetInstance(lm_info, status, &t_options->value);
+  return ToOrtStatus(status);
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CreateThreadingOptions, _Outptr_ OrtThreadingOptions** out) {
+  API_IMPL_BEGIN
+  *out = new OrtThreadingOptions();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetGlobalIntraOpNumThreads, _Inout_ OrtThreadingOptions* tp_options,
+                    int intra_op_num_threads) {
+  tp_options->value.intra_op_num_threads = intra_op_num_threads;
+  return nullptr;
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SetGlobalInterOpNumThreads, _Inout_ OrtThreadingOptions* tp_options,
+                    int inter_op_num_threads) {
+  tp_options->value.inter_op_num_threads = inter_op_num_threads;
+  return nullptr;
+}
+
 // enable platform telemetry
 ORT_API_STATUS_IMPL(OrtApis::EnableTelemetryEvents, _In_ const OrtEnv* ort_env) {
   API_IMPL_BEGIN
@@ -518,7 +568,7 @@ ORT_API_STATUS_IMPL(OrtApis::CreateSession, _In_ const OrtEnv* env, _In_ const O
   try {
     sess = onnxruntime::make_unique<onnxruntime::InferenceSession>(
         options == nullptr ? onnxruntime::SessionOptions() : options->value,
-        model_path, env->GetLoggingManager());
+        model_path, env->GetLoggingManager(), env->GetEnvironment());
   } catch (const std::exception& e) {
     return OrtApis::CreateStatus(ORT_FAIL, e.what());
   }
@@ -533,7 +583,7 @@ ORT_API_STATUS_IMPL(OrtApis::CreateSessionFromArray, _In_ const OrtEnv* env, _In
   try {
     sess = onnxruntime::make_unique<onnxruntime::InferenceSession>(
         options == nullptr ? onnxruntime::SessionOptions() : options->value,
-        model_data, static_cast<int>(model_data_length), env->GetLoggingManager());
+        model_data, static_cast<int>(model_data_length), env->GetLoggingManager(), env->GetEnvironment());
   } catch (const std::exception& e) {
     return OrtApis::CreateStatus(ORT_FAIL, e.what());
   }
@@ -603,6 +653,95 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess,
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::CreateIoBinding, _Inout_ OrtSession* sess, _Outptr_ OrtIoBinding** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  auto binding = onnxruntime::make_unique<OrtIoBinding>();
+  auto status = session->NewIOBinding(&binding->value);
+  if (!status.IsOK())
+    return ToOrtStatus(status);
+  *out = binding.release();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::BindInput, _Inout_ OrtIoBinding* binding_ptr, _In_ const char* name,
+                    _In_ const OrtValue* val_ptr) {
+  API_IMPL_BEGIN
+  if (name == nullptr || name[0] == '\0') {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input name cannot be empty");
+  }
+  if (val_ptr == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "input value cannot be null");
+  }
+  return ToOrtStatus(binding_ptr->value->BindInput(name, *val_ptr));
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::BindOutput, _Inout_ OrtIoBinding* binding_ptr, _In_ const char* name,
+                    _In_opt_ const OrtValue* val_ptr) {
+  API_IMPL_BEGIN
+  if (name == nullptr || name[0] == '\0') {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
+  }
+  return ToOrtStatus(binding_ptr->value->BindOutput(name, val_ptr == nullptr ? OrtValue() : *val_ptr));
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::GetBoundOutputValues, _In_ const OrtIoBinding* binding_ptr,
+                    _Inout_ OrtAllocator* allocator, _Outptr_result_maybenull_ OrtValue*** output,
+                    _Out_ size_t* output_count) {
+  API_IMPL_BEGIN
+  const auto& outputs = binding_ptr->value->GetOutputs();
+  *output = nullptr;
+  *output_count = 0;
+  if (outputs.empty()) {
+    return nullptr;
+  }
+
+  // the values are created before the array is allocated so nothing leaks if one of them throws
+  std::vector<std::unique_ptr<OrtValue>> values;
+  values.reserve(outputs.size());
+  for (const auto& output_value : outputs) {
+    values.push_back(onnxruntime::make_unique<OrtValue>(output_value));
+  }
+
+  auto* values_array = reinterpret_cast<OrtValue**>(allocator->Alloc(allocator, values.size() * sizeof(OrtValue*)));
+  if (values_array == nullptr) {
+    return OrtApis::CreateStatus(ORT_FAIL, "failed to allocate the output array");
+  }
+  for (size_t i = 0; i != values.size(); ++i) {
+    values_array[i] = values[i].release();
+  }
+  *output = values_array;
+  *output_count = values.size();
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API(void, OrtApis::ClearBoundInputs, _Inout_ OrtIoBinding* binding_ptr) {
+  binding_ptr->value->ClearInputs();
+}
+
+ORT_API(void, OrtApis::ClearBoundOutputs, _Inout_ OrtIoBinding* binding_ptr) {
+  binding_ptr->value->ClearOutputs();
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunWithBinding, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _Inout_ OrtIoBinding* binding_ptr) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  Status status;
+  if (run_options == nullptr) {
+    OrtRunOptions op;
+    status = session->Run(op, *binding_ptr->value);
+  } else {
+    status = session->Run(*run_options, *binding_ptr->value);
+  }
+  return ToOrtStatus(status);
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::IsTensor, _In_ const OrtValue* value, int* out) {
   auto v = reinterpret_cast<const ::OrtValue*>(value);
   *out = v->IsTensor() ? 1 : 0;
@@ -786,6 +925,41 @@ ORT_API_STATUS_IMPL(OrtApis::SessionGetOverridableInitializerName, _In_ const Or
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetOutputZipMapLabels, _In_ const OrtSession* sess, size_t index,
+                    _Inout_ OrtAllocator* allocator, _Outptr_result_maybenull_ OrtValue** out) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::pair<Status, const OutputDefList*> p = session->GetModelOutputs();
+  if (!p.first.IsOK())
+    return ToOrtStatus(p.first);
+  if (index >= p.second->size())
+    return OrtApis::CreateStatus(ORT_FAIL, "index out of range");
+
+  *out = nullptr;
+  const ColumnarZipMapLabels* labels = session->GetColumnarZipMapLabels((*p.second)[index]->Name());
+  if (labels == nullptr)
+    return nullptr;
+
+  std::unique_ptr<Tensor> tensor;
+  if (!labels->strings.empty()) {
+    const int64_t count = static_cast<int64_t>(labels->strings.size());
+    ORT_API_RETURN_IF_ERROR(c_api_internal::CallCreateTensorImpl<std::string>(&count, 1, allocator, &tensor));
+    std::copy(labels->strings.begin(), labels->strings.end(), tensor->MutableData<std::string>());
+  } else {
+    const int64_t count = static_cast<int64_t>(labels->int64s.size());
+    ORT_API_RETURN_IF_ERROR(c_api_internal::CallCreateTensorImpl<int64_t>(&count, 1, allocator, &tensor));
+    std::copy(labels->int64s.begin(), labels->int64s.end(), tensor->MutableData<int64_t>());
+  }
+  auto value = onnxruntime::make_unique<OrtValue>();
+  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
+  value->Init(tensor.release(),
+              ml_tensor,
+              ml_tensor->GetDeleteFunc());
+  *out = value.release();
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::AllocatorAlloc, _Inout_ OrtAllocator* ptr, size_t size, _Outptr_ void** out) {
   API_IMPL_BEGIN
   *out = ptr->Alloc(ptr, size);
@@ -1332,7 +1506,7 @@ static constexpr OrtApiBase ort_api_base = {
     &OrtApis::GetVersionString,
 };
 
-static constexpr OrtApi ort_api_1 = {
+static constexpr OrtApi ort_api_1_to_2 = {
     &OrtApis::CreateStatus,
     &OrtApis::GetErrorCode,
     &OrtApis::GetErrorMessage,
@@ -1447,13 +1621,33 @@ static constexpr OrtApi ort_api_1 = {
     &OrtApis::ReleaseTensorTypeAndShapeInfo,
     &OrtApis::ReleaseSessionOptions,
     &OrtApis::ReleaseCustomOpDomain,
+    // End of Version 1 - DO NOT MODIFY ABOVE
+
+    &OrtApis::CreateEnvWithGlobalThreadPools,
+    &OrtApis::DisablePerSessionThreads,
+    &OrtApis::CreateThreadingOptions,
+    &OrtApis::SetGlobalIntraOpNumThreads,
+    &OrtApis::SetGlobalInterOpNumThreads,
+    &OrtApis::ReleaseThreadingOptions,
+    &OrtApis::EnableCpuMemArenaThreadCache,
+    &OrtApis::CreateIoBinding,
+    &OrtApis::ReleaseIoBinding,
+    &OrtApis::BindInput,
+    &OrtApis::BindOutput,
+    &OrtApis::GetBoundOutputValues,
+    &OrtApis::ClearBoundInputs,
+    &OrtApis::ClearBoundOutputs,
+    &OrtApis::RunWithBinding,
+    &OrtApis::EnableColumnarZipMap,
+    &OrtApis::SessionGetOutputZipMapLabels,
 };
 
 ORT_API(const OrtApi*, OrtApis::GetApi, uint32_t version) {
-  if (version > 1)
-    return nullptr;
+  // version 0 was accepted before versioning and still returns the table
+  if (version <= ORT_API_VERSION)
+    return &ort_api_1_to_2;
 
-  return &ort_api_1;
+  return nullptr;  // Unsupported version
 }
 
 ORT_API(const char*, OrtApis::GetVersionString) {
@@ -1471,3 +1665,5 @@ ORT_API(void, OrtApis::ReleaseEnv, _Frees_ptr_opt_ OrtEnv* value) {
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Value, OrtValue)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(RunOptions, OrtRunOptions)
 DEFINE_RELEASE_ORT_OBJECT_FUNCTION(Session, ::onnxruntime::InferenceSession)
+DEFINE_RELEASE_ORT_OBJECT_FUNCTION(ThreadingOptions, OrtThreadingOptions)
+DEFINE_RELEASE_ORT_OBJECT_FUNCTION(IoBinding, OrtIoBinding)
@@ -6,6 +6,9 @@
 #include "core/util/math_cpuonly.h"
 #include "core/mlas/inc/mlas.h"
 
+#include <algorithm>
+#include <vector>
+
 #if defined(_M_AMD64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
 #define MLAS_SUPPORTS_GEMM_U8X8
 #else
@@ -71,6 +74,75 @@ void QGemmu8u8_s32(
 #else
   MlasGemm(M, N, K, lhs_data, lda, lhs_offset, rhs_data, ldb, rhs_offset, result_data, ldc, thread_pool);
 
+#endif
+}
+
+void QGemmu8u8_u8(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    int lda,
+    const uint8_t lhs_offset,
+    const uint8_t* rhs_data,
+    int ldb,
+    const uint8_t rhs_offset,
+    uint8_t* result_data,
+    int ldc,
+    float real_multiplier,
+    const uint8_t result_offset,
+    const int32_t* bias,
+    concurrency::ThreadPool* thread_pool) {
+#ifdef USE_GEMMLOWP
+
+  ORT_ENFORCE(lda == K && ldb == N && ldc == N, "For gemmlowp only RowMajor*RowMajor=RowMajor format is supported");
+
+  int32_t integer_multiplier;
+  int right_shift;
+  QuantizeMultiplier(real_multiplier, &integer_multiplier, &right_shift);
+  GemmlowpMultiplyu8u8_u8(lhs_data, rhs_data, result_data, lhs_offset, rhs_offset, result_offset,
+                          M, N, K, integer_multiplier, right_shift, bias);
+
+#else
+  if (M == 0 || N == 0) {
+    return;
+  }
+
+  // The result is computed in blocks small enough for their int32 products to stay in cache until they are
+  // requantized, the int32 result of the whole GEMM is never written to memory. The blocks are split across
+  // the thread pool and narrowed for short results so every thread gets one.
+  constexpr int kBlockM = 64;
+  constexpr int kBlockN = 256;
+  const int num_threads = thread_pool == nullptr ? 1 : thread_pool->NumThreads() + 1;
+  const int block_m = std::min(M, kBlockM);
+  const int blocks_m = (M + block_m - 1) / block_m;
+  int block_n = std::min(N, kBlockN);
+  while (block_n > 16 && blocks_m * ((N + block_n - 1) / block_n) < num_threads) {
+    block_n /= 2;
+  }
+  const int blocks_n = (N + block_n - 1) / block_n;
+
+  const double block_loaded = static_cast<double>(block_m + block_n) * K;
+  const double block_stored = static_cast<double>(block_m) * block_n;
+  const double block_compute = static_cast<double>(block_m) * block_n * K;
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(blocks_m) * blocks_n,
+      concurrency::TensorOpCost{block_loaded, block_stored, block_compute},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<int32_t> block_result(static_cast<size_t>(block_m) * block_n);
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const int m = static_cast<int>(block / blocks_n) * block_m;
+          const int n = static_cast<int>(block % blocks_n) * block_n;
+          const int count_m = std::min(block_m, M - m);
+          const int count_n = std::min(block_n, N - n);
+          MlasGemm(count_m, count_n, K, lhs_data + static_cast<size_t>(m) * lda, lda, lhs_offset,
+                   rhs_data + n, ldb, rhs_offset, block_result.data(), count_n, nullptr);
+          MlasRequantizeOutput(block_result.data(), count_n, result_data + static_cast<size_t>(m) * ldc + n, ldc,
+                               bias == nullptr ? nullptr : bias + m, count_m, count_n, real_multiplier,
+                               result_offset);
+        }
+      });
+
 #endif
 }
 }  // namespace onnxruntime
@@ -35,4 +35,24 @@ void QGemmu8u8_s32(
     int ldc,
     concurrency::ThreadPool* thread_pool);
 
+// Multiplies lhs (M x K) by rhs (K x N) and requantizes the int32 products to the uint8 result with
+// real_multiplier (lhs_scale * rhs_scale / result_scale) and result_offset. bias is optional and holds one value
+// per row of the result.
+void QGemmu8u8_u8(
+    int M,
+    int N,
+    int K,
+    const uint8_t* lhs_data,
+    int lda,
+    const uint8_t lhs_offset,
+    const uint8_t* rhs_data,
+    int ldb,
+    const uint8_t rhs_offset,
+    uint8_t* result_data,
+    int ldc,
+    float real_multiplier,
+    const uint8_t result_offset,
+    const int32_t* bias,
+    concurrency::ThreadPool* thread_pool);
+
 }  // namespace onnxruntime
@@ -110,6 +110,7 @@ std::string nuphar_settings;
 
 namespace onnxruntime {
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CPU(int use_arena);
+std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CPU(int use_arena, int use_arena_thread_cache);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_CUDA(int device_id);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Tensorrt(int device_id);
 std::shared_ptr<IExecutionProviderFactory> CreateExecutionProviderFactory_Dnnl(int use_arena);
@@ -302,7 +303,9 @@ const std::vector<std::string>& GetAvailableProviders() {
 void RegisterExecutionProviders(InferenceSession* sess, const std::vector<std::string>& provider_types) {
   for (const std::string& type : provider_types) {
     if (type == kCpuExecutionProvider) {
-      RegisterExecutionProvider(sess, *onnxruntime::CreateExecutionProviderFactory_CPU(sess->GetSessionOptions().enable_cpu_mem_arena));
+      RegisterExecutionProvider(sess, *onnxruntime::CreateExecutionProviderFactory_CPU(
+                                          sess->GetSessionOptions().enable_cpu_mem_arena,
+                                          sess->GetSessionOptions().enable_cpu_mem_arena_thread_cache));
     } else if (type == kTensorrtExecutionProvider) {
 #ifdef USE_TENSORRT
       RegisterExecutionProvider(sess, *onnxruntime::CreateExecutionProviderFactory_Tensorrt(0));
@@ -564,12 +567,18 @@ void addObjectMethods(py::module& m) {
       .def_readwrite("enable_cpu_mem_arena", &SessionOptions::enable_cpu_mem_arena,
                      R"pbdoc(Enables the memory arena on CPU. Arena may pre-allocate memory for future usage.
 Set this option to false if you don't want it. Default is True.)pbdoc")
+      .def_readwrite("enable_cpu_mem_arena_thread_cache", &SessionOptions::enable_cpu_mem_arena_thread_cache,
+                     R"pbdoc(Keeps a per-thread cache of small blocks in front of the memory arena on CPU, which reduces the contention between concurrent runs. Default is False.)pbdoc")
       .def_readwrite("enable_profiling", &SessionOptions::enable_profiling,
                      R"pbdoc(Enable profiling for this session. Default is false.)pbdoc")
       .def_readwrite("optimized_model_filepath", &SessionOptions::optimized_model_filepath,
                      R"pbdoc(File path to serialize optimized model. By default, optimized model is not serialized if optimized_model_filepath is not provided.)pbdoc")
       .def_readwrite("enable_mem_pattern", &SessionOptions::enable_mem_pattern,
                      R"pbdoc(Enable the memory pattern optimization. Default is true.)pbdoc")
+      .def_readwrite("mem_pattern_cache_capacity", &SessionOptions::mem_pattern_cache_capacity,
+                     R"pbdoc(Maximum number of memory patterns kept, the least recently used is evicted first. 0 keeps them all. Default is 64.)pbdoc")
+      .def_readwrite("mem_pattern_dim_bucket_size", &SessionOptions::mem_pattern_dim_bucket_size,
+                     R"pbdoc(When greater than 1, input dimensions are rounded up to a multiple of this value to look up the memory patterns so nearby shapes share one. Default is 0.)pbdoc")
       .def_readwrite("logid", &SessionOptions::session_logid,
                      R"pbdoc(Logger id to use for session output.)pbdoc")
       .def_readwrite("log_severity_level", &SessionOptions::session_log_severity_level,
@@ -1,10 +1,14 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <cmath>
+
 #include "gtest/gtest.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 
 namespace onnxruntime {
 namespace test {
@@ -53,6 +57,127 @@ static void RunAttentionTest(
   }
 }
 
+// Attention computed step by step, for the sequences too long to write the expected values.
+static void ComputeReferenceAttention(
+    const std::vector<float>& input_data,
+    const std::vector<float>& weights_data,
+    const std::vector<float>& bias_data,
+    const std::vector<int32_t>& mask_index_data,
+    const std::vector<float>& past_data,
+    int batch_size,
+    int sequence_length,
+    int hidden_size,
+    int number_of_heads,
+    int past_sequence_length,
+    bool is_unidirectional,
+    std::vector<float>& output_data,
+    std::vector<float>& present_data) {
+  const int head_size = hidden_size / number_of_heads;
+  const int all_sequence_length = past_sequence_length + sequence_length;
+  auto projection = [&](int b, int s, int column) {
+    float value = bias_data[column];
+    for (int k = 0; k < hidden_size; k++) {
+      value += input_data[(b * sequence_length + s) * hidden_size + k] * weights_data[k * 3 * hidden_size + column];
+    }
+    return value;
+  };
+
+  // present(2, B, N, S*, H)
+  present_data.assign(2 * batch_size * number_of_heads * all_sequence_length * head_size, 0.0f);
+  for (int kv = 0; kv < 2; kv++) {
+    for (int b = 0; b < batch_size; b++) {
+      for (int n = 0; n < number_of_heads; n++) {
+        float* block = present_data.data() + ((kv * batch_size + b) * number_of_heads + n) * all_sequence_length * head_size;
+        for (int t = 0; t < all_sequence_length; t++) {
+          for (int h = 0; h < head_size; h++) {
+            block[t * head_size + h] =
+                t < past_sequence_length
+                    ? past_data[(((kv * batch_size + b) * number_of_heads + n) * past_sequence_length + t) * head_size + h]
+                    : projection(b, t - past_sequence_length, (kv + 1) * hidden_size + n * head_size + h);
+          }
+        }
+      }
+    }
+  }
+
+  output_data.assign(batch_size * sequence_length * hidden_size, 0.0f);
+  for (int b = 0; b < batch_size; b++) {
+    for (int n = 0; n < number_of_heads; n++) {
+      const float* keys = present_data.data() + (b * number_of_heads + n) * all_sequence_length * head_size;
+      const float* values = keys + batch_size * number_of_heads * all_sequence_length * head_size;
+      for (int s = 0; s < sequence_length; s++) {
+        std::vector<double> scores(all_sequence_length);
+        for (int t = 0; t < all_sequence_length; t++) {
+          double score = 0.0;
+          for (int h = 0; h < head_size; h++) {
+            score += projection(b, s, n * head_size + h) * keys[t * head_size + h];
+          }
+          scores[t] = score / std::sqrt(static_cast<double>(head_size));
+          if (t >= mask_index_data[b] || (is_unidirectional && t > past_sequence_length + s)) {
+            scores[t] -= 10000.0;
+          }
+        }
+        const double max = *std::max_element(scores.begin(), scores.end());
+        double sum = 0.0;
+        for (auto& score : scores) {
+          score = std::exp(score - max);
+          sum += score;
+        }
+        for (int h = 0; h < head_size; h++) {
+          double value = 0.0;
+          for (int t = 0; t < all_sequence_length; t++) {
+            value += scores[t] / sum * values[t * head_size + h];
+          }
+          output_data[(b * sequence_length + s) * hidden_size + n * head_size + h] = static_cast<float>(value);
+        }
+      }
+    }
+  }
+}
+
+// Runs the CPU kernel with the optional past input and present output, the CUDA one doesn't support them.
+static void RunAttentionTestWithPast(
+    const std::vector<float>& input_data,         // input:      [batch_size, sequence_length, hidden_size]
+    const std::vector<float>& weights_data,       // weights:    [hidden_size, 3 * hidden_size]
+    const std::vector<float>& bias_data,          // bias:       [3 * hidden_size]
+    const std::vector<int32_t>& mask_index_data,  // mask_index: [batch_size]
+    const std::vector<float>& past_data,          // past:       [2, batch_size, num_heads, past_sequence_length, head_size]
+    const std::vector<float>& output_data,        // output:     [batch_size, sequence_length, hidden_size]
+    const std::vector<float>& present_data,       // present:    [2, batch_size, num_heads, past_sequence_length + sequence_length, head_size]
+    int batch_size,
+    int sequence_length,
+    int hidden_size,
+    int number_of_heads,
+    int past_sequence_length,
+    bool is_unidirectional) {
+  OpTester tester("Attention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+  tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(is_unidirectional ? 1 : 0));
+
+  int head_size = hidden_size / number_of_heads;
+  std::vector<int64_t> input_dims = {batch_size, sequence_length, hidden_size};
+  std::vector<int64_t> weights_dims = {hidden_size, 3 * hidden_size};
+  std::vector<int64_t> bias_dims = {3 * hidden_size};
+  std::vector<int64_t> mask_index_dims = {batch_size};
+  std::vector<int64_t> past_dims = {2, batch_size, number_of_heads, past_sequence_length, head_size};
+  std::vector<int64_t> output_dims = input_dims;
+  std::vector<int64_t> present_dims = {2, batch_size, number_of_heads, past_sequence_length + sequence_length, head_size};
+
+  tester.AddInput<float>("input", input_dims, input_data);
+  tester.AddInput<float>("weight", weights_dims, weights_data);
+  tester.AddInput<float>("bias", bias_dims, bias_data);
+  tester.AddInput<int32_t>("mask_index", mask_index_dims, mask_index_data);
+  if (past_sequence_length > 0) {
+    tester.AddInput<float>("past", past_dims, past_data);
+  }
+  tester.AddOutput<float>("output", output_dims, output_data);
+  tester.AddOutput<float>("present", present_dims, present_data);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 TEST(AttentionTest, AttentionBatch1) {
   int batch_size = 1;
   int sequence_length = 2;
@@ -204,5 +329,158 @@ TEST(AttentionTest, AttentionMaskExceedSequence) {
                    batch_size, sequence_length, hidden_size, number_of_heads);
 }
 
+TEST(AttentionTest, AttentionUnidirectional) {
+  int batch_size = 1;
+  int sequence_length = 2;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data = {
+      0.8f, -0.5f, 0.0f, 1.f,
+      0.5f, 0.2f, 0.3f, -0.6f};
+
+  std::vector<float> weight_data = {
+      0.1f, -0.2f, 0.3f, 1.0f, 1.1f, 0.3f, 0.5f, 0.2f, 0.3f, -0.6f, 1.5f, 2.0f,
+      0.5f, 0.1f, 0.4f, 1.6f, 1.0f, 2.0f, 0.4f, 0.8f, 0.9f, 0.1f, -1.3f, 0.7f,
+      0.3f, 0.2f, 4.0f, 2.2f, 1.6f, 1.1f, 0.7f, 0.2f, 0.4f, 1.0f, 1.2f, 0.5f,
+      0.2f, 0.1f, 0.4f, 1.6f, 2.4f, 3.3f, 2.1f, 4.2f, 8.4f, 0.0f, 2.1f, 3.2f};
+
+  std::vector<float> bias_data = {
+      -0.5f, 0.6f, 1.2f, 2.1f, 0.5f, 0.7f, 0.2f, 1.2f, 0.5f, 0.4f, 0.3f, 1.2f};
+
+  std::vector<int32_t> mask_index_data = {2L};
+
+  // the first position only attends to itself
+  std::vector<float> output_data = {
+      8.69f, -0.13f, 4.25f, 5.65f,
+      3.969679f, 0.0731437f, 4.25f, 5.65f};
+
+  std::vector<float> present_data = {
+      3.28f, 3.24f, 0.29f, -0.4f,
+      2.5f, 5.16f, -0.52f, -1.0f,
+      8.69f, -0.13f, -4.09f, 0.42f,
+      4.25f, 5.65f, -0.11f, 0.57f};
+
+  RunAttentionTestWithPast(input_data, weight_data, bias_data, mask_index_data, {}, output_data, present_data,
+                           batch_size, sequence_length, hidden_size, number_of_heads, 0, true);
+}
+
+TEST(AttentionTest, AttentionPastState) {
+  int batch_size = 2;
+  int sequence_length = 1;
+  int hidden_size = 4;
+  int number_of_heads = 2;
+  int past_sequence_length = 2;
+
+  std::vector<float> input_data = {
+      0.8f, -0.5f, 0.0f, 1.f,
+      0.5f, 0.2f, 0.3f, -0.6f};
+
+  std::vector<float> weight_data = {
+      0.1f, -0.2f, 0.3f, 1.0f, 1.1f, 0.3f, 0.5f, 0.2f, 0.3f, -0.6f, 1.5f, 2.0f,
+      0.5f, 0.1f, 0.4f, 1.6f, 1.0f, 2.0f, 0.4f, 0.8f, 0.9f, 0.1f, -1.3f, 0.7f,
+      0.3f, 0.2f, 4.0f, 2.2f, 1.6f, 1.1f, 0.7f, 0.2f, 0.4f, 1.0f, 1.2f, 0.5f,
+      0.2f, 0.1f, 0.4f, 1.6f, 2.4f, 3.3f, 2.1f, 4.2f, 8.4f, 0.0f, 2.1f, 3.2f};
+
+  std::vector<float> bias_data = {
+      -0.5f, 0.6f, 1.2f, 2.1f, 0.5f, 0.7f, 0.2f, 1.2f, 0.5f, 0.4f, 0.3f, 1.2f};
+
+  // the past and the input positions are valid
+  std::vector<int32_t> mask_index_data = {3L, 3L};
+
+  std::vector<float> past_data = {
+      -0.5f, 0.2f, -0.2f, 0.5f,
+      0.1f, -0.3f, 0.4f, 0.0f,
+      -0.4f, 0.3f, -0.1f, -0.5f,
+      0.2f, -0.2f, 0.5f, 0.1f,
+      -0.3f, 0.4f, 0.0f, -0.4f,
+      0.3f, -0.1f, -0.5f, 0.2f,
+      -0.2f, 0.5f, 0.1f, -0.3f,
+      0.4f, 0.0f, -0.4f, 0.3f};
+
+  std::vector<float> output_data = {
+      2.408685f, -0.03822734f, 4.249999f, 5.649999f,
+      -1.183858f, 0.2418804f, -0.193141f, 0.2288601f};
+
+  // the keys and values of the input follow the past ones
+  std::vector<float> present_data = {
+      -0.5f, 0.2f, -0.2f, 0.5f, 3.28f, 3.24f,
+      0.1f, -0.3f, 0.4f, 0.0f, 2.5f, 5.16f,
+      -0.4f, 0.3f, -0.1f, -0.5f, 0.29f, -0.4f,
+      0.2f, -0.2f, 0.5f, 0.1f, -0.52f, -1.0f,
+      -0.3f, 0.4f, 0.0f, -0.4f, 8.69f, -0.13f,
+      0.3f, -0.1f, -0.5f, 0.2f, 4.25f, 5.65f,
+      -0.2f, 0.5f, 0.1f, -0.3f, -4.09f, 0.42f,
+      0.4f, 0.0f, -0.4f, 0.3f, -0.11f, 0.57f};
+
+  RunAttentionTestWithPast(input_data, weight_data, bias_data, mask_index_data, past_data, output_data, present_data,
+                           batch_size, sequence_length, hidden_size, number_of_heads, past_sequence_length, true);
+}
+
+// Several blocks of queries and keys, some of them masked for every query.
+TEST(AttentionTest, AttentionLongSequence) {
+  int batch_size = 2;
+  int sequence_length = 150;
+  int hidden_size = 8;
+  int number_of_heads = 2;
+
+  std::vector<float> input_data(batch_size * sequence_length * hidden_size);
+  for (size_t i = 0; i < input_data.size(); i++) {
+    input_data[i] = static_cast<float>(i % 13) * 0.1f - 0.6f;
+  }
+  std::vector<float> weight_data(hidden_size * 3 * hidden_size);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    weight_data[i] = static_cast<float>(i % 7) * 0.2f - 0.5f;
+  }
+  std::vector<float> bias_data(3 * hidden_size);
+  for (size_t i = 0; i < bias_data.size(); i++) {
+    bias_data[i] = static_cast<float>(i % 5) * 0.1f;
+  }
+  std::vector<int32_t> mask_index_data = {150, 20};
+
+  std::vector<float> output_data, present_data;
+  ComputeReferenceAttention(input_data, weight_data, bias_data, mask_index_data, {},
+                            batch_size, sequence_length, hidden_size, number_of_heads, 0, false,
+                            output_data, present_data);
+
+  RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
+                   batch_size, sequence_length, hidden_size, number_of_heads);
+}
+
+TEST(AttentionTest, AttentionLongSequenceUnidirectionalPastState) {
+  int batch_size = 2;
+  int sequence_length = 70;
+  int hidden_size = 8;
+  int number_of_heads = 2;
+  int past_sequence_length = 100;
+
+  std::vector<float> input_data(batch_size * sequence_length * hidden_size);
+  for (size_t i = 0; i < input_data.size(); i++) {
+    input_data[i] = static_cast<float>(i % 13) * 0.1f - 0.6f;
+  }
+  std::vector<float> weight_data(hidden_size * 3 * hidden_size);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    weight_data[i] = static_cast<float>(i % 7) * 0.2f - 0.5f;
+  }
+  std::vector<float> bias_data(3 * hidden_size);
+  for (size_t i = 0; i < bias_data.size(); i++) {
+    bias_data[i] = static_cast<float>(i % 5) * 0.1f;
+  }
+  std::vector<float> past_data(2 * batch_size * past_sequence_length * hidden_size);
+  for (size_t i = 0; i < past_data.size(); i++) {
+    past_data[i] = static_cast<float>(i % 11) * 0.1f - 0.5f;
+  }
+  // all the positions of the second batch are masked
+  std::vector<int32_t> mask_index_data = {150, 0};
+
+  std::vector<float> output_data, present_data;
+  ComputeReferenceAttention(input_data, weight_data, bias_data, mask_index_data, past_data,
+                            batch_size, sequence_length, hidden_size, number_of_heads, past_sequence_length, true,
+                            output_data, present_data);
+
+  RunAttentionTestWithPast(input_data, weight_data, bias_data, mask_index_data, past_data, output_data, present_data,
+                           batch_size, sequence_length, hidden_size, number_of_heads, past_sequence_length, true);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -14,6 +14,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/profiler.h"
 #include "core/framework/compute_capability.h"
+#include "core/framework/customregistry.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/kernel_registry.h"
@@ -329,6 +330,28 @@ void RunModelWithBindingMatMul(InferenceSession& session_object,
     }
     VerifyOutputs(io_binding->GetOutputs(), expected_output_dims, expected_values_mul_y);
   }
+
+  if (is_preallocate_output_vec && allocation_provider == kCudaExecutionProvider) {
+    return;
+  }
+
+  // data written to the buffer of a bound input is used by the next run, including when the input has to be copied
+  // to the device of the run provider
+  float* data_A = input_ml_value_A.GetMutable<Tensor>()->MutableData<float>();
+  for (size_t i = 0; i < values_mul_x.size(); ++i) {
+    data_A[i] *= 2.f;
+  }
+  for (auto& v : expected_values_mul_y) {
+    v *= 2.f;
+  }
+  st = session_object.Run(run_options, *io_binding.get());
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+  if (allocation_provider == kCudaExecutionProvider) {
+#ifdef USE_CUDA
+    TestCudaExecutionProvider()->Sync();
+#endif
+  }
+  VerifyOutputs(io_binding->GetOutputs(), expected_output_dims, expected_values_mul_y);
 }
 
 TEST(InferenceSessionTests, NoTimeout) {
@@ -919,6 +942,99 @@ TEST(InferenceSessionTests, ModelWithoutOpset) {
   }
 }
 
+// ZipMap(X) -> Z read by CountMaps(Z) -> C, and ZipMap(X) -> Z2, with Z, C and Z2 as graph outputs
+static void CreateZipMapModel(ModelProto& model_proto) {
+  model_proto.set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+  for (const auto& opset : std::vector<std::pair<std::string, int64_t>>{{kOnnxDomain, 11}, {kMLDomain, 1},
+                                                                          {"test.zipmap", 1}}) {
+    auto* opset_import = model_proto.add_opset_import();
+    opset_import->set_domain(opset.first);
+    opset_import->set_version(opset.second);
+  }
+
+  GraphProto& graph = *model_proto.mutable_graph();
+  graph.set_name("zipmap");
+  auto* x = graph.add_input();
+  x->set_name("X");
+  x->mutable_type()->mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  x->mutable_type()->mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("N");
+  x->mutable_type()->mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  TypeProto map_type;
+  auto* map = map_type.mutable_sequence_type()->mutable_elem_type()->mutable_map_type();
+  map->set_key_type(TensorProto_DataType_STRING);
+  map->mutable_value_type()->mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  for (const char* output_name : {"Z", "Z2"}) {
+    auto* zipmap = graph.add_node();
+    zipmap->set_op_type("ZipMap");
+    zipmap->set_domain(kMLDomain);
+    zipmap->add_input("X");
+    zipmap->add_output(output_name);
+    auto* labels = zipmap->add_attribute();
+    labels->set_name("classlabels_strings");
+    labels->set_type(AttributeProto_AttributeType_STRINGS);
+    for (const char* label : {"class1", "class2", "class3"}) {
+      labels->add_strings(label);
+    }
+    auto* output = graph.add_output();
+    output->set_name(output_name);
+    *output->mutable_type() = map_type;
+  }
+
+  auto* count = graph.add_node();
+  count->set_op_type("CountMaps");
+  count->set_domain("test.zipmap");
+  count->add_input("Z");
+  count->add_output("C");
+  auto* c = graph.add_output();
+  c->set_name("C");
+  c->mutable_type()->mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+}
+
+TEST(InferenceSessionTests, ColumnarZipMapOutputReadByNode) {
+  SessionOptions so;
+  so.session_logid = "InferenceSessionTests.ColumnarZipMapOutputReadByNode";
+  so.columnar_zipmap = true;
+  InferenceSession session_object{so, &DefaultLoggingManager()};
+
+  // no registered operator takes a sequence of maps, declare one that only needs to resolve
+  OpSchema schema("CountMaps", "unknown", 0);
+  schema.Input(0, "X", "Maps to count.", "seq(map(string, float))");
+  schema.Output(0, "Y", "Number of maps.", "tensor(int64)");
+  schema.SetDomain("test.zipmap");
+  schema.SinceVersion(1);
+  std::vector<OpSchema> schemas{schema};
+  OpSchemaRegistry::DomainToVersionRange::Instance().AddDomainToVersion("test.zipmap", 1, 1);
+  auto registry = std::make_shared<CustomRegistry>();
+  ASSERT_TRUE(registry->RegisterOpSet(schemas, "test.zipmap", 1, 1).IsOK());
+  ASSERT_TRUE(session_object.RegisterCustomRegistry(registry).IsOK());
+
+  ModelProto model_proto;
+  CreateZipMapModel(model_proto);
+  std::string model_data = model_proto.SerializeAsString();
+  Status st = session_object.Load(model_data.data(), static_cast<int>(model_data.size()));
+  ASSERT_TRUE(st.IsOK()) << st.ErrorMessage();
+
+  auto outputs = session_object.GetModelOutputs();
+  ASSERT_TRUE(outputs.first.IsOK());
+  std::unordered_map<std::string, const TypeProto*> output_types;
+  for (const auto* output : *outputs.second) {
+    output_types[output->Name()] = output->TypeAsProto();
+  }
+
+  // Z is read by CountMaps so it keeps its maps and has no labels
+  ASSERT_EQ(session_object.GetColumnarZipMapLabels("Z"), nullptr);
+  ASSERT_TRUE(output_types.at("Z")->has_sequence_type());
+
+  // Z2 is only a graph output so it returns the scores
+  const ColumnarZipMapLabels* labels = session_object.GetColumnarZipMapLabels("Z2");
+  ASSERT_NE(labels, nullptr);
+  ASSERT_EQ(labels->strings, (std::vector<std::string>{"class1", "class2", "class3"}));
+  ASSERT_TRUE(output_types.at("Z2")->has_tensor_type());
+  ASSERT_EQ(output_types.at("Z2")->tensor_type().elem_type(), TensorProto_DataType_FLOAT);
+}
+
 static common::Status RunOptionalInputTest(bool add_required_input,
                                            bool add_optional_input,
                                            bool add_invalid_input,
@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/mem_pattern_cache.h"
+
+#include <thread>
+
+#include "core/common/make_unique.h"
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+std::unique_ptr<MemoryPatternGroup> MakePatterns() {
+  return onnxruntime::make_unique<MemoryPatternGroup>();
+}
+
+MemoryPatternCache::InputShapes Shapes(const std::vector<TensorShape>& shapes) {
+  return MemoryPatternCache::InputShapes(shapes.begin(), shapes.end());
+}
+
+}  // namespace
+
+TEST(MemoryPatternCacheTest, HitsAndMisses) {
+  MemoryPatternCache cache(4, 0);
+  std::vector<TensorShape> a{TensorShape({2, 3})};
+  // the same dims in another order used to share a key
+  std::vector<TensorShape> b{TensorShape({3, 2})};
+
+  EXPECT_EQ(cache.Find(Shapes(a)), nullptr);
+  cache.Insert(Shapes(a), MakePatterns());
+  auto patterns = cache.Find(Shapes(a));
+  EXPECT_NE(patterns, nullptr);
+  EXPECT_EQ(cache.Find(Shapes(b)), nullptr);
+
+  // a second insert for the same shapes keeps the first pattern
+  cache.Insert(Shapes(a), MakePatterns());
+  EXPECT_EQ(cache.Find(Shapes(a)), patterns);
+
+  auto stats = cache.Stats();
+  EXPECT_EQ(stats.hits, 2u);
+  EXPECT_EQ(stats.misses, 2u);
+  EXPECT_EQ(stats.evictions, 0u);
+  EXPECT_EQ(stats.size, 1u);
+}
+
+TEST(MemoryPatternCacheTest, EvictsLeastRecentlyUsed) {
+  MemoryPatternCache cache(2, 0);
+  std::vector<TensorShape> a{TensorShape({1, 8})};
+  std::vector<TensorShape> b{TensorShape({2, 8})};
+  std::vector<TensorShape> c{TensorShape({3, 8})};
+
+  cache.Insert(Shapes(a), MakePatterns());
+  cache.Insert(Shapes(b), MakePatterns());
+  auto a_patterns = cache.Find(Shapes(a));
+  ASSERT_NE(a_patterns, nullptr);
+
+  // b is the least recently used
+  cache.Insert(Shapes(c), MakePatterns());
+  EXPECT_EQ(cache.Find(Shapes(b)), nullptr);
+  EXPECT_EQ(cache.Find(Shapes(a)), a_patterns);
+  EXPECT_NE(cache.Find(Shapes(c)), nullptr);
+
+  auto stats = cache.Stats();
+  EXPECT_EQ(stats.evictions, 1u);
+  EXPECT_EQ(stats.size, 2u);
+
+  // an evicted pattern stays valid for the Run using it
+  cache.Insert(Shapes(b), MakePatterns());
+  cache.Insert(Shapes(a), MakePatterns());
+  EXPECT_EQ(a_patterns.use_count(), 1);
+}
+
+TEST(MemoryPatternCacheTest, Buckets) {
+  MemoryPatternCache cache(8, 16);
+  std::vector<TensorShape> len5{TensorShape({1, 5}), TensorShape({1, 5, 5})};
+  std::vector<TensorShape> len9{TensorShape({1, 9}), TensorShape({1, 9, 9})};
+  std::vector<TensorShape> len12{TensorShape({1, 12}), TensorShape({1, 12, 12})};
+  std::vector<TensorShape> len17{TensorShape({1, 17}), TensorShape({1, 17, 17})};
+
+  cache.Insert(Shapes(len9), MakePatterns());
+  auto patterns = cache.Find(Shapes(len9));
+  ASSERT_NE(patterns, nullptr);
+  // smaller shapes of the bucket fit in the pattern
+  EXPECT_EQ(cache.Find(Shapes(len5)), patterns);
+  // larger ones need a new one, which replaces it
+  EXPECT_EQ(cache.Find(Shapes(len12)), nullptr);
+  cache.Insert(Shapes(len12), MakePatterns());
+  auto larger_patterns = cache.Find(Shapes(len5));
+  EXPECT_NE(larger_patterns, nullptr);
+  EXPECT_NE(larger_patterns, patterns);
+  EXPECT_EQ(cache.Find(Shapes(len9)), larger_patterns);
+  // next bucket
+  EXPECT_EQ(cache.Find(Shapes(len17)), nullptr);
+
+  EXPECT_EQ(cache.Stats().size, 1u);
+}
+
+TEST(MemoryPatternCacheTest, ConcurrentRuns) {
+  MemoryPatternCache cache(8, 0);
+  const int num_threads = 4;
+  const int num_runs = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < num_runs; ++i) {
+        std::vector<TensorShape> shapes{TensorShape({1, (i * (t + 1)) % 16})};
+        if (cache.Find(Shapes(shapes)) == nullptr) {
+          cache.Insert(Shapes(shapes), MakePatterns());
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto stats = cache.Stats();
+  EXPECT_EQ(stats.hits + stats.misses, static_cast<uint64_t>(num_threads * num_runs));
+  EXPECT_LE(stats.size, 8u);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,160 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/thread_caching_arena.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+std::unique_ptr<ThreadCachingArena> MakeArena() {
+  return std::unique_ptr<ThreadCachingArena>(
+      new ThreadCachingArena(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), 1 << 30));
+}
+
+size_t BytesInUse(ThreadCachingArena& arena) {
+  AllocatorStats stats;
+  arena.GetStats(&stats);
+  return static_cast<size_t>(stats.bytes_in_use);
+}
+
+}  // namespace
+
+TEST(ThreadCachingArenaTest, NoOverlap) {
+  auto arena = MakeArena();
+  EXPECT_EQ(arena->Alloc(0), nullptr);
+
+  // small and large sizes
+  std::vector<std::pair<char*, size_t>> blocks;
+  for (size_t size = 1; size < 200000; size = size * 3 + 1) {
+    for (int i = 0; i < 10; ++i) {
+      auto* p = static_cast<char*>(arena->Alloc(size));
+      ASSERT_NE(p, nullptr);
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(p) % 64, 0u);
+      memset(p, i, size);
+      blocks.emplace_back(p, size);
+    }
+  }
+
+  std::sort(blocks.begin(), blocks.end());
+  for (size_t i = 1; i < blocks.size(); ++i) {
+    ASSERT_GE(static_cast<size_t>(blocks[i].first - blocks[i - 1].first), blocks[i - 1].second);
+  }
+
+  for (auto& block : blocks) {
+    arena->Free(block.first);
+  }
+  arena->Free(nullptr);
+}
+
+TEST(ThreadCachingArenaTest, ReusesCachedBlocks) {
+  auto arena = MakeArena();
+  void* p = arena->Alloc(100);
+  arena->Free(p);
+  // the block stays in the cache of the thread, counted as used by the arena
+  EXPECT_GT(BytesInUse(*arena), 0u);
+  EXPECT_EQ(arena->Alloc(100), p);
+  arena->Free(p);
+
+  // large blocks go back to the arena
+  void* large = arena->Alloc(1 << 20);
+  ASSERT_NE(large, nullptr);
+  const size_t in_use = BytesInUse(*arena);
+  arena->Free(large);
+  EXPECT_LT(BytesInUse(*arena), in_use);
+
+  void* reserved = arena->Reserve(1000);
+  ASSERT_NE(reserved, nullptr);
+  arena->Free(reserved);
+}
+
+TEST(ThreadCachingArenaTest, ReleasesCacheOnThreadExit) {
+  auto arena = MakeArena();
+  std::thread thread([&arena]() {
+    std::vector<void*> ptrs;
+    for (int i = 0; i < 1000; ++i) {
+      ptrs.push_back(arena->Alloc(static_cast<size_t>(i % 50) * 100 + 1));
+    }
+    for (auto* p : ptrs) {
+      arena->Free(p);
+    }
+    EXPECT_GT(BytesInUse(*arena), 0u);
+  });
+  thread.join();
+  EXPECT_EQ(BytesInUse(*arena), 0u);
+}
+
+TEST(ThreadCachingArenaTest, ConcurrentAllocations) {
+  auto arena = MakeArena();
+  const int num_threads = 8;
+  std::vector<std::thread> threads;
+  // every thread frees half of its blocks and hands the other half to the next thread
+  std::vector<std::vector<void*>> handed(num_threads);
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&arena, &handed, t]() {
+      for (int i = 0; i < 2000; ++i) {
+        const size_t size = static_cast<size_t>((i * 37 + t) % 5000) + 1;
+        auto* p = static_cast<unsigned char*>(arena->Alloc(size));
+        ASSERT_NE(p, nullptr);
+        memset(p, t, size);
+        if (i % 2 == 0) {
+          ASSERT_EQ(p[size - 1], t);
+          arena->Free(p);
+        } else {
+          handed[t].push_back(p);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([&arena, &handed, t, num_threads]() {
+      for (auto* p : handed[(t + 1) % num_threads]) {
+        arena->Free(p);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(BytesInUse(*arena), 0u);
+}
+
+TEST(ThreadCachingArenaTest, OutlivedByThread) {
+  auto arena = MakeArena();
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool used = false, destroyed = false;
+  std::thread thread([&]() {
+    arena->Free(arena->Alloc(10));
+    std::unique_lock<std::mutex> lock(mutex);
+    used = true;
+    cv.notify_all();
+    // the cache of the thread is emptied when the arena is destroyed, and dropped when the thread exits
+    cv.wait(lock, [&]() { return destroyed; });
+  });
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [&]() { return used; });
+    arena.reset();
+    destroyed = true;
+  }
+  cv.notify_all();
+  thread.join();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
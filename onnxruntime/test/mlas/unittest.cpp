@@ -17,8 +17,10 @@ Abstract:
 #include <stdio.h>
 #include <memory.h>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
+#include <random>
 #include <mlas.h>
 
 #if defined(_WIN32)
@@ -461,6 +463,154 @@ public:
 
 #ifdef MLAS_HAS_QGEMM_U8X8
 
+class MlasSgemmPackedBTest : public MlasTestBase
+{
+private:
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        float beta
+        )
+    {
+        const float* A = BufferA.GetBuffer(K * M);
+        const float* B = BufferB.GetBuffer(N * K);
+        float* C = BufferC.GetBuffer(N * M);
+        float* CReference = BufferCReference.GetBuffer(N * M);
+
+        Test(CblasNoTrans, CblasNoTrans, M, N, K, alpha, A, K, B, N, beta, C, CReference, N);
+        Test(CblasNoTrans, CblasTrans, M, N, K, alpha, A, K, B, K, beta, C, CReference, N);
+        Test(CblasTrans, CblasNoTrans, M, N, K, alpha, A, M, B, N, beta, C, CReference, N);
+        Test(CblasTrans, CblasTrans, M, N, K, alpha, A, M, B, K, beta, C, CReference, N);
+    }
+
+    void
+    Test(
+        CBLAS_TRANSPOSE TransA,
+        CBLAS_TRANSPOSE TransB,
+        size_t M,
+        size_t N,
+        size_t K,
+        float alpha,
+        const float* A,
+        size_t lda,
+        const float* B,
+        size_t ldb,
+        float beta,
+        float* C,
+        float* CReference,
+        size_t ldc
+        )
+    {
+        //
+        // The packed size is a multiple of the preferred buffer alignment and
+        // the guard buffer ends on a page, so the packed buffer is aligned.
+        //
+
+        size_t PackedBSize = MlasGemmPackBSize(N, K);
+        void* PackedB = BufferPackedB.GetBuffer(PackedBSize / sizeof(float));
+
+        MlasGemmPackB(TransB, N, K, B, ldb, PackedB);
+
+        std::fill_n(C, M * N, -0.5f);
+        std::fill_n(CReference, M * N, -0.5f);
+
+        MlasGemm(TransA, M, N, K, alpha, A, lda, PackedB, beta, C, ldc, threadpool);
+        MlasGemm(TransA, TransB, M, N, K, alpha, A, lda, B, ldb, beta, CReference, ldc, threadpool);
+
+        for (size_t f = 0; f < M * N; f++) {
+            // Sensitive to comparing positive/negative zero.
+            if (C[f] != CReference[f]) {
+                printf("mismatch packed TransA=%d, TransB=%d, M=%zd, N=%zd, K=%zd, alpha=%f, beta=%f  %f %f!\n", TransA, TransB, M, N, K, alpha, beta, float(C[f]), float(CReference[f]));
+                break;
+            }
+        }
+    }
+
+    MatrixGuardBuffer<float> BufferA;
+    MatrixGuardBuffer<float> BufferB;
+    MatrixGuardBuffer<float> BufferPackedB;
+    MatrixGuardBuffer<float> BufferC;
+    MatrixGuardBuffer<float> BufferCReference;
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t b = 1; b < 16; b++) {
+            Test(b, b, b, 1.0f, 0.0f);
+        }
+        for (size_t b = 16; b <= 256; b <<= 1) {
+            Test(b, b, b, 1.0f, 0.0f);
+        }
+        for (size_t b = 256; b < 320; b += 32) {
+            Test(b, b, b, 1.0f, 0.0f);
+        }
+        // K spanning several packed slices and N not a multiple of the kernel width
+        Test(1, 1000, 600, 1.0f, 0.0f);
+        Test(8, 1000, 600, 0.5f, 1.0f);
+        Test(64, 130, 513, -1.0f, 0.25f);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+        static const float multipliers[] = { 0.0f, -0.0f, 0.25f, -0.5f, 1.0f, -1.0f };
+
+        for (size_t N = 1; N < 128; N++) {
+            for (size_t K = 1; K < 128; K++) {
+                for (size_t a = 0; a < _countof(multipliers); a++) {
+                    for (size_t b = 0; b < _countof(multipliers); b++) {
+                        Test(1, N, K, multipliers[a], multipliers[b]);
+                        Test(N, 1, K, multipliers[a], multipliers[b]);
+                    }
+                }
+            }
+        }
+
+        for (size_t a = 0; a < _countof(multipliers); a++) {
+            float alpha = multipliers[a];
+
+            for (size_t b = 0; b < _countof(multipliers); b++) {
+                float beta = multipliers[b];
+
+                for (size_t M = 16; M < 160; M += 32) {
+                    for (size_t N = 16; N < 160; N += 32) {
+
+                        static const size_t ks[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 20, 32, 48, 64, 118, 119, 120, 121, 122, 160, 240, 255, 256, 257, 320 };
+                        for (size_t k = 0; k < _countof(ks); k++) {
+                            size_t K = ks[k];
+
+                            Test(M, N, K, alpha, beta);
+                            Test(M + 1, N, K, alpha, beta);
+                            Test(M, N + 1, K, alpha, beta);
+                            Test(M + 1, N + 1, K, alpha, beta);
+                            Test(M + 3, N + 2, K, alpha, beta);
+                            Test(M + 4, N, K, alpha, beta);
+                            Test(M, N + 4, K, alpha, beta);
+                            Test(M + 4, N + 4, K, alpha, beta);
+                            Test(M + 3, N + 7, K, alpha, beta);
+                            Test(M + 8, N, K, alpha, beta);
+                            Test(M, N + 8, K, alpha, beta);
+                            Test(M + 12, N + 12, K, alpha, beta);
+                            Test(M + 13, N, K, alpha, beta);
+                            Test(M, N + 15, K, alpha, beta);
+                            Test(M + 15, N + 15, K, alpha, beta);
+                        }
+                    }
+                    printf("a %zd/%zd b %zd/%zd M %zd\n", a, _countof(multipliers), b, _countof(multipliers), M);
+                }
+            }
+        }
+    }
+};
+
 template <typename xint8_t>
 class MlasQgemmU8X8Test : public MlasTestBase
 {
@@ -1971,6 +2121,255 @@ public:
     }
 };
 
+class MlasComputeExpTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferOutput;
+
+    void
+    Test(
+        size_t N,
+        float MinimumValue,
+        float MaximumValue
+        )
+    {
+        float* Input = BufferInput.GetBuffer(N);
+        float* Output = BufferOutput.GetBuffer(N);
+
+        std::default_random_engine generator(static_cast<unsigned>(N));
+        std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+
+        for (size_t n = 0; n < N; n++) {
+            Input[n] = distribution(generator);
+        }
+
+        MlasComputeExp(Input, Output, N);
+
+        constexpr float AbsoluteTolerance = 1e-6f;
+        constexpr float RelativeTolerance = 1e-6f;
+
+        for (size_t n = 0; n < N; n++) {
+            float OutputReference = std::exp(Input[n]);
+            float diff = std::fabs(Output[n] - OutputReference);
+            if (diff > AbsoluteTolerance && diff > std::fabs(OutputReference) * RelativeTolerance) {
+                printf("mismatch exp n=%zd input=%.8e output=%.8e expected=%.8e\n", n, Input[n], Output[n], OutputReference);
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t n = 1; n < 128; n++) {
+            Test(n, -10.f, 10.f);
+        }
+
+        // Covers the denormal and overflowed results.
+        Test(1000, -110.f, 90.f);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+    }
+};
+
+class MlasSoftmaxTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<float> BufferInput;
+    MatrixGuardBuffer<float> BufferOutput;
+    MatrixGuardBuffer<float> BufferOutputReference;
+
+    void
+    Test(
+        size_t N,
+        size_t D,
+        float MinimumValue,
+        float MaximumValue
+        )
+    {
+        float* Input = BufferInput.GetBuffer(N * D);
+        float* Output = BufferOutput.GetBuffer(N * D);
+        float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+
+        std::default_random_engine generator(static_cast<unsigned>(N * D));
+        std::uniform_real_distribution<float> distribution(MinimumValue, MaximumValue);
+
+        for (size_t nd = 0; nd < N * D; nd++) {
+            Input[nd] = distribution(generator);
+        }
+
+        Test(Input, Output, OutputReference, N, D, false);
+        Test(Input, Output, OutputReference, N, D, true);
+    }
+
+    void
+    Test(
+        const float* Input,
+        float* Output,
+        float* OutputReference,
+        size_t N,
+        size_t D,
+        bool LogSoftmax
+        )
+    {
+        MlasComputeSoftmax(Input, Output, N, D, LogSoftmax, threadpool);
+        ReferenceSoftmax(Input, OutputReference, N, D, LogSoftmax);
+
+        constexpr float AbsoluteTolerance = 1e-6f;
+        constexpr float RelativeTolerance = 1e-6f;
+
+        for (size_t nd = 0; nd < N * D; nd++) {
+            float diff = std::fabs(Output[nd] - OutputReference[nd]);
+            if (diff > AbsoluteTolerance && diff > std::fabs(OutputReference[nd]) * RelativeTolerance) {
+                printf("mismatch softmax(%d) N=%zd D=%zd nd=%zd output=%.8e expected=%.8e\n",
+                    int(LogSoftmax), N, D, nd, Output[nd], OutputReference[nd]);
+                break;
+            }
+        }
+    }
+
+    static
+    void
+    ReferenceSoftmax(
+        const float* Input,
+        float* Output,
+        size_t N,
+        size_t D,
+        bool LogSoftmax
+        )
+    {
+        for (size_t n = 0; n < N; n++) {
+
+            float MaximumValue = std::numeric_limits<float>::lowest();
+
+            for (size_t d = 0; d < D; d++) {
+                MaximumValue = (std::max)(MaximumValue, Input[d]);
+            }
+
+            double Sum = 0.0;
+
+            for (size_t d = 0; d < D; d++) {
+                double e = std::exp(double(Input[d]) - double(MaximumValue));
+                Sum += e;
+                Output[d] = float(e);
+            }
+
+            if (LogSoftmax) {
+
+                float Scale = float(std::log(Sum));
+
+                for (size_t d = 0; d < D; d++) {
+                    Output[d] = Input[d] - MaximumValue - Scale;
+                }
+
+            } else {
+
+                float Scale = float(Sum);
+
+                for (size_t d = 0; d < D; d++) {
+                    Output[d] /= Scale;
+                }
+            }
+
+            Input += D;
+            Output += D;
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t d = 1; d < 128; d++) {
+            Test(1, d, -10.f, 10.f);
+        }
+
+        Test(3, 128, 20.f, 30.f);
+        Test(63, 95, -150.f, 190.f);
+        Test(16, 211, 20.f, 30.f);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+    }
+};
+
+template<typename ElementType>
+class MlasTransposeTest : public MlasTestBase
+{
+private:
+    MatrixGuardBuffer<ElementType> BufferInput;
+    MatrixGuardBuffer<ElementType> BufferOutput;
+
+    void
+    Test(
+        size_t M,
+        size_t N,
+        size_t lda,
+        size_t ldb
+        )
+    {
+        ElementType* Input = BufferInput.GetBuffer(M * lda);
+        ElementType* Output = BufferOutput.GetBuffer(N * ldb);
+
+        for (size_t m = 0; m < M * lda; m++) {
+            Input[m] = ElementType(m * 7 + 3);
+        }
+
+        std::fill_n(Output, N * ldb, ElementType(-1));
+
+        MlasTranspose(M, N, Input, lda, Output, ldb);
+
+        for (size_t n = 0; n < N; n++) {
+            for (size_t m = 0; m < ldb; m++) {
+                ElementType expected = (m < M) ? Input[m * lda + n] : ElementType(-1);
+                if (Output[n * ldb + m] != expected) {
+                    printf("mismatch transpose(%zd) M=%zd N=%zd lda=%zd ldb=%zd n=%zd m=%zd\n",
+                        sizeof(ElementType), M, N, lda, ldb, n, m);
+                    return;
+                }
+            }
+        }
+    }
+
+public:
+    void
+    ExecuteShort(
+        void
+        ) override
+    {
+        for (size_t m = 1; m <= 33; m++) {
+            for (size_t n = 1; n <= 33; n++) {
+                Test(m, n, n, m);
+                Test(m, n, n + 3, m + 5);
+            }
+        }
+
+        Test(3, 1000, 1000, 3);
+        Test(1000, 3, 3, 1000);
+    }
+
+    void
+    ExecuteLong(
+        void
+        ) override
+    {
+    }
+};
+
 int
 #if defined(_WIN32)
 __cdecl
@@ -1983,6 +2382,7 @@ main(
 
         printf("SGEMM tests.\n");
         onnxruntime::make_unique<MlasFgemmTest<float>>()->ExecuteShort();
+        onnxruntime::make_unique<MlasSgemmPackedBTest>()->ExecuteShort();
 #ifdef MLAS_HAS_DGEMM
         printf("DGEMM tests.\n");
         onnxruntime::make_unique<MlasFgemmTest<double>>()->ExecuteShort();
@@ -2012,6 +2412,16 @@ main(
         printf("Activation tests.\n");
         onnxruntime::make_unique<MlasActivationTest>()->ExecuteShort();
 
+        printf("Exp tests.\n");
+        onnxruntime::make_unique<MlasComputeExpTest>()->ExecuteShort();
+
+        printf("Softmax tests.\n");
+        onnxruntime::make_unique<MlasSoftmaxTest>()->ExecuteShort();
+
+        printf("Transpose tests.\n");
+        onnxruntime::make_unique<MlasTransposeTest<uint8_t>>()->ExecuteShort();
+        onnxruntime::make_unique<MlasTransposeTest<uint32_t>>()->ExecuteShort();
+
         printf("Done.\n");
 #if !defined(MLAS_NO_ONNXRUNTIME_THREADPOOL)
         if(threadpool != nullptr) threadpool = new onnxruntime::concurrency::ThreadPool("test", 2);
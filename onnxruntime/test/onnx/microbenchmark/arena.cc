@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <limits>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <core/framework/bfc_arena.h>
+#include <core/framework/mimalloc_arena.h>
+#include <core/framework/thread_caching_arena.h>
+
+using namespace onnxruntime;
+
+namespace {
+
+// Shared by the threads of the benchmarks of TArena and kept until the process exits, as a thread may still be
+// freeing its blocks when another one is done.
+template <typename TArena>
+IArenaAllocator& GetArena() {
+  static TArena arena(std::unique_ptr<IDeviceAllocator>(new CPUAllocator()), std::numeric_limits<size_t>::max());
+  return arena;
+}
+
+// What the kernels of a Run do: allocate the outputs of a few nodes of sizes between 64 bytes and 16KB, then free
+// them once their consumers ran.
+void AllocateAndFree(benchmark::State& state, IArenaAllocator& arena) {
+  const size_t live_blocks = 16;
+  std::vector<void*> blocks(live_blocks, nullptr);
+  uint64_t seed = std::hash<std::thread::id>()(std::this_thread::get_id());
+  size_t i = 0;
+  for (auto _ : state) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    const size_t slot = i++ % live_blocks;
+    arena.Free(blocks[slot]);
+    blocks[slot] = arena.Alloc(64 + static_cast<size_t>((seed >> 33) % (16 * 1024)));
+    benchmark::DoNotOptimize(blocks[slot]);
+  }
+  for (auto* block : blocks) {
+    arena.Free(block);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename TArena>
+void BM_ArenaAllocFree(benchmark::State& state) {
+  AllocateAndFree(state, GetArena<TArena>());
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(BM_ArenaAllocFree, BFCArena)
+    ->ThreadRange(1, 16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(BM_ArenaAllocFree, ThreadCachingArena)
+    ->ThreadRange(1, 16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+#ifdef USE_MIMALLOC
+BENCHMARK_TEMPLATE(BM_ArenaAllocFree, MiMallocArena)
+    ->ThreadRange(1, 16)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+#endif
@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+// a layer of GPT-2 small
+constexpr int64_t kHiddenSize = 768;
+constexpr int64_t kNumHeads = 12;
+constexpr int64_t kHeadSize = kHiddenSize / kNumHeads;
+
+std::vector<float> RandomData(size_t size) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> value(-0.1f, 0.1f);
+  std::vector<float> data(size);
+  for (auto& v : data) v = value(gen);
+  return data;
+}
+
+// Computes the attention output of the token following past_sequence_length tokens, either from the keys and
+// values of the previous tokens kept in the past state or by running attention over the whole sequence again.
+void RunNextToken(benchmark::State& state, bool use_past) {
+  const int64_t past_sequence_length = state.range(0);
+  const int64_t sequence_length = use_past ? 1 : past_sequence_length + 1;
+  const std::vector<int64_t> input_dims{1, sequence_length, kHiddenSize};
+  const std::vector<int64_t> weight_dims{kHiddenSize, 3 * kHiddenSize};
+  const std::vector<int64_t> bias_dims{3 * kHiddenSize};
+  const std::vector<int64_t> mask_index_dims{1};
+  const std::vector<int64_t> past_dims{2, 1, kNumHeads, past_sequence_length, kHeadSize};
+
+  std::vector<SingleNodeInput> model_inputs{
+      {"input", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, input_dims},
+      {"weight", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, weight_dims},
+      {"bias", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, bias_dims},
+      {"mask_index", ONNX_NAMESPACE::TensorProto_DataType_INT32, mask_index_dims}};
+  std::vector<std::string> model_outputs{"output"};
+  if (use_past) {
+    model_inputs.push_back({"past", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, past_dims});
+    model_outputs.push_back("present");
+  }
+  std::string model = MakeSingleNodeModel(
+      "Attention", kMSDomain, model_inputs, model_outputs,
+      [](Node& node) {
+        node.AddAttribute("num_heads", kNumHeads);
+        node.AddAttribute("unidirectional", static_cast<int64_t>(1));
+      });
+  BenchmarkSession session(model, 1);
+
+  std::vector<float> input = RandomData(static_cast<size_t>(sequence_length * kHiddenSize));
+  std::vector<float> weight = RandomData(static_cast<size_t>(kHiddenSize * 3 * kHiddenSize));
+  std::vector<float> bias = RandomData(static_cast<size_t>(3 * kHiddenSize));
+  std::vector<int32_t> mask_index{static_cast<int32_t>(past_sequence_length + 1)};
+  std::vector<float> past = RandomData(static_cast<size_t>(2 * kNumHeads * past_sequence_length * kHeadSize));
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(input, input_dims));
+  inputs.push_back(CreateInputTensor(weight, weight_dims));
+  inputs.push_back(CreateInputTensor(bias, bias_dims));
+  inputs.push_back(CreateInputTensor(mask_index, mask_index_dims));
+  if (use_past) {
+    inputs.push_back(CreateInputTensor(past, past_dims));
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+}
+
+// Encodes a batch of sequences of state.range(1) tokens, intra_op_num_threads threads.
+void RunSequence(benchmark::State& state) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  const int64_t batch_size = 8;
+  const int64_t sequence_length = state.range(1);
+  const std::vector<int64_t> input_dims{batch_size, sequence_length, kHiddenSize};
+  const std::vector<int64_t> weight_dims{kHiddenSize, 3 * kHiddenSize};
+  const std::vector<int64_t> bias_dims{3 * kHiddenSize};
+  const std::vector<int64_t> mask_index_dims{batch_size};
+
+  std::string model = MakeSingleNodeModel(
+      "Attention", kMSDomain,
+      {{"input", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, input_dims},
+       {"weight", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, weight_dims},
+       {"bias", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, bias_dims},
+       {"mask_index", ONNX_NAMESPACE::TensorProto_DataType_INT32, mask_index_dims}},
+      {"output"},
+      [](Node& node) { node.AddAttribute("num_heads", kNumHeads); });
+  BenchmarkSession session(model, intra_op_num_threads);
+
+  std::vector<float> input = RandomData(static_cast<size_t>(batch_size * sequence_length * kHiddenSize));
+  std::vector<float> weight = RandomData(static_cast<size_t>(kHiddenSize * 3 * kHiddenSize));
+  std::vector<float> bias = RandomData(static_cast<size_t>(3 * kHiddenSize));
+  // sequences padded by up to a quarter of their length
+  std::vector<int32_t> mask_index(static_cast<size_t>(batch_size));
+  for (size_t i = 0; i < mask_index.size(); i++) {
+    mask_index[i] = static_cast<int32_t>(sequence_length - (sequence_length / 4) * (i % 2));
+  }
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(input, input_dims));
+  inputs.push_back(CreateInputTensor(weight, weight_dims));
+  inputs.push_back(CreateInputTensor(bias, bias_dims));
+  inputs.push_back(CreateInputTensor(mask_index, mask_index_dims));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size * sequence_length);
+}
+
+}  // namespace
+
+// self attention of a BERT-base layer over sequences of 64 to 512 tokens
+static void BM_AttentionSequence(benchmark::State& state) {
+  RunSequence(state);
+}
+BENCHMARK(BM_AttentionSequence)
+    ->Args({1, 64})
+    ->Args({1, 128})
+    ->Args({1, 256})
+    ->Args({1, 512})
+    ->Args({4, 64})
+    ->Args({4, 128})
+    ->Args({4, 256})
+    ->Args({4, 512})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// per token latency of a generation, the keys and values of the previous tokens are cached
+static void BM_AttentionNextTokenWithPast(benchmark::State& state) {
+  RunNextToken(state, true);
+}
+BENCHMARK(BM_AttentionNextTokenWithPast)->RangeMultiplier(4)->Range(4, 1024)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// the same without the cache, the whole sequence is computed again for every token
+static void BM_AttentionNextTokenRecompute(benchmark::State& state) {
+  RunNextToken(state, false);
+}
+BENCHMARK(BM_AttentionNextTokenRecompute)->RangeMultiplier(4)->Range(4, 1024)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+std::vector<float> RandomData(const std::vector<int64_t>& dims) {
+  int64_t size = 1;
+  for (auto dim : dims) size *= dim;
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> value(-1.f, 1.f);
+  std::vector<float> data(static_cast<size_t>(size));
+  for (auto& v : data) v = value(gen);
+  return data;
+}
+
+// Runs op_type over inputs of dims_a and dims_b, intra_op_num_threads threads.
+void RunBroadcast(benchmark::State& state, const char* op_type,
+                  const std::vector<int64_t>& dims_a, const std::vector<int64_t>& dims_b) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  std::string model = MakeSingleNodeModel(
+      op_type, kOnnxDomain,
+      {{"A", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, dims_a},
+       {"B", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, dims_b}},
+      {"C"}, [](Node&) {});
+  BenchmarkSession session(model, intra_op_num_threads);
+
+  std::vector<float> a = RandomData(dims_a);
+  std::vector<float> b = RandomData(dims_b);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(a, dims_a));
+  inputs.push_back(CreateInputTensor(b, dims_b));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(std::max(a.size(), b.size())));
+}
+
+}  // namespace
+
+// same shape, a single span
+static void BM_AddSameShape(benchmark::State& state) {
+  RunBroadcast(state, "Add", {32, 128, 768}, {32, 128, 768});
+}
+BENCHMARK(BM_AddSameShape)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// tensor and scalar
+static void BM_MulScalar(benchmark::State& state) {
+  RunBroadcast(state, "Mul", {32, 128, 768}, {1});
+}
+BENCHMARK(BM_MulScalar)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// bias of the hidden units of [B, S, H] activations, one span per row
+static void BM_AddBias(benchmark::State& state) {
+  RunBroadcast(state, "Add", {32, 128, 768}, {768});
+}
+BENCHMARK(BM_AddBias)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// per channel scale of [N, C, H, W] images, a scalar per span
+static void BM_MulChannel(benchmark::State& state) {
+  RunBroadcast(state, "Mul", {8, 64, 56, 56}, {1, 64, 1, 1});
+}
+BENCHMARK(BM_MulChannel)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// attention mask of [B, heads, S, S] scores, both inputs broadcast
+static void BM_AddMask(benchmark::State& state) {
+  RunBroadcast(state, "Add", {8, 12, 128, 128}, {8, 1, 1, 128});
+}
+BENCHMARK(BM_AddMask)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// small tensors, left on the calling thread
+static void BM_AddSmall(benchmark::State& state) {
+  RunBroadcast(state, "Add", {4, 64}, {64});
+}
+BENCHMARK(BM_AddSmall)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// expensive functor
+static void BM_PowBias(benchmark::State& state) {
+  RunBroadcast(state, "Pow", {32, 128, 768}, {768});
+}
+BENCHMARK(BM_PowBias)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
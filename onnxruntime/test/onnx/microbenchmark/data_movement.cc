@@ -0,0 +1,169 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+std::vector<float> RandomData(int64_t size) {
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<float> value(-1.f, 1.f);
+  std::vector<float> x(static_cast<size_t>(size));
+  for (auto& v : x) v = value(gen);
+  return x;
+}
+
+int64_t SizeOf(const std::vector<int64_t>& dims) {
+  int64_t size = 1;
+  for (auto d : dims) size *= d;
+  return size;
+}
+
+// Runs a Gather of num_indices random rows of a [rows, cols] float table, intra_op_num_threads threads.
+void RunGather(benchmark::State& state, int64_t rows, int64_t cols, int64_t num_indices) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  std::string model = MakeSingleNodeModel(
+      "Gather", kOnnxDomain,
+      {{"data", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {rows, cols}},
+       {"indices", ONNX_NAMESPACE::TensorProto_DataType_INT64, {num_indices}}},
+      {"gathered"},
+      [](Node& node) { node.AddAttribute("axis", int64_t{0}); });
+  BenchmarkSession session(model, intra_op_num_threads);
+
+  std::vector<int64_t> data_dims{rows, cols}, indices_dims{num_indices};
+  std::vector<float> data = RandomData(rows * cols);
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int64_t> row(0, rows - 1);
+  std::vector<int64_t> indices(static_cast<size_t>(num_indices));
+  for (auto& i : indices) i = row(gen);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(data, data_dims));
+  inputs.push_back(CreateInputTensor(indices, indices_dims));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetBytesProcessed(state.iterations() * num_indices * cols * static_cast<int64_t>(sizeof(float)));
+}
+
+// Runs a GatherND of num_indices random [row, col] slices of a [rows, cols, inner] float tensor.
+void RunGatherND(benchmark::State& state, int64_t rows, int64_t cols, int64_t inner, int64_t num_indices) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  std::string model = MakeSingleNodeModel(
+      "GatherND", kOnnxDomain,
+      {{"data", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {rows, cols, inner}},
+       {"indices", ONNX_NAMESPACE::TensorProto_DataType_INT64, {num_indices, 2}}},
+      {"gathered"},
+      [](Node&) {});
+  BenchmarkSession session(model, intra_op_num_threads);
+
+  std::vector<int64_t> data_dims{rows, cols, inner}, indices_dims{num_indices, 2};
+  std::vector<float> data = RandomData(SizeOf(data_dims));
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int64_t> row(0, rows - 1), col(0, cols - 1);
+  std::vector<int64_t> indices;
+  for (int64_t i = 0; i < num_indices; ++i) {
+    indices.push_back(row(gen));
+    indices.push_back(col(gen));
+  }
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(data, data_dims));
+  inputs.push_back(CreateInputTensor(indices, indices_dims));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetBytesProcessed(state.iterations() * num_indices * inner * static_cast<int64_t>(sizeof(float)));
+}
+
+// Runs a Concat of num_inputs float inputs of dims along axis.
+void RunConcat(benchmark::State& state, const std::vector<int64_t>& dims, int64_t axis, int num_inputs) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  std::vector<SingleNodeInput> model_inputs;
+  for (int i = 0; i < num_inputs; ++i) {
+    model_inputs.push_back({"input" + std::to_string(i), ONNX_NAMESPACE::TensorProto_DataType_FLOAT, dims});
+  }
+  std::string model = MakeSingleNodeModel(
+      "Concat", kOnnxDomain, model_inputs, {"concat_result"},
+      [&](Node& node) { node.AddAttribute("axis", axis); });
+  BenchmarkSession session(model, intra_op_num_threads);
+
+  std::vector<std::vector<float>> data(static_cast<size_t>(num_inputs), RandomData(SizeOf(dims)));
+  std::vector<Ort::Value> inputs;
+  for (auto& x : data) {
+    inputs.push_back(CreateInputTensor(x, dims));
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetBytesProcessed(state.iterations() * num_inputs * SizeOf(dims) * static_cast<int64_t>(sizeof(float)));
+}
+
+// Runs an equal Split of a float input of dims into num_outputs along axis.
+void RunSplit(benchmark::State& state, const std::vector<int64_t>& dims, int64_t axis, int num_outputs) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  std::vector<std::string> outputs;
+  for (int i = 0; i < num_outputs; ++i) {
+    outputs.push_back("output" + std::to_string(i));
+  }
+  std::string model = MakeSingleNodeModel(
+      "Split", kOnnxDomain,
+      {{"input", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, dims}}, outputs,
+      [&](Node& node) { node.AddAttribute("axis", axis); });
+  BenchmarkSession session(model, intra_op_num_threads);
+
+  std::vector<float> x = RandomData(SizeOf(dims));
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, dims));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(x.size() * sizeof(float)));
+}
+
+}  // namespace
+
+// embedding lookup of a batch of tokens in a 100k row table
+static void BM_GatherEmbedding(benchmark::State& state) {
+  RunGather(state, 100000, 128, 4096);
+}
+BENCHMARK(BM_GatherEmbedding)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// narrow rows, where the random reads are the most latency bound
+static void BM_GatherNarrowRows(benchmark::State& state) {
+  RunGather(state, 1000000, 8, 65536);
+}
+BENCHMARK(BM_GatherNarrowRows)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// detection boxes features picked by (image, anchor)
+static void BM_GatherNDFeatures(benchmark::State& state) {
+  RunGatherND(state, 16, 4096, 256, 8192);
+}
+BENCHMARK(BM_GatherNDFeatures)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// feature pipeline columns joined on the innermost axis
+static void BM_ConcatInnermost(benchmark::State& state) {
+  RunConcat(state, {65536, 64}, 1, 8);
+}
+BENCHMARK(BM_ConcatInnermost)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+static void BM_ConcatOutermost(benchmark::State& state) {
+  RunConcat(state, {64, 256, 256}, 0, 4);
+}
+BENCHMARK(BM_ConcatOutermost)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// fused QKV projection split into its three parts
+static void BM_SplitQKV(benchmark::State& state) {
+  RunSplit(state, {32, 128, 3 * 768}, 2, 3);
+}
+BENCHMARK(BM_SplitQKV)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
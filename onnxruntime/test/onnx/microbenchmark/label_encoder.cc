@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+std::vector<std::string> StringKeys(int64_t count) {
+  std::vector<std::string> keys(static_cast<size_t>(count));
+  for (int64_t i = 0; i < count; ++i) keys[i] = "category_" + std::to_string(i);
+  return keys;
+}
+
+std::vector<int64_t> Int64Keys(int64_t count) {
+  std::vector<int64_t> keys(static_cast<size_t>(count));
+  for (int64_t i = 0; i < count; ++i) keys[i] = i * 7919;
+  return keys;
+}
+
+// count random picks among keys, a tenth of them replaced by keys not in the vocabulary
+template <typename T>
+std::vector<T> Lookups(const std::vector<T>& keys, int64_t count, const T& missing) {
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+  std::vector<T> lookups(static_cast<size_t>(count));
+  for (size_t i = 0; i < lookups.size(); ++i) lookups[i] = i % 10 == 0 ? missing : keys[pick(gen)];
+  return lookups;
+}
+
+}  // namespace
+
+// Args: vocabulary size, rows
+static void BM_LabelEncoderStringToInt64(benchmark::State& state) {
+  const int64_t vocabulary = state.range(0);
+  const int64_t rows = state.range(1);
+  std::vector<std::string> keys = StringKeys(vocabulary);
+  std::string model = MakeSingleNodeModel(
+      "LabelEncoder", kMLDomain,
+      {{"X", ONNX_NAMESPACE::TensorProto_DataType_STRING, {rows}}}, {"Y"},
+      [&](Node& node) {
+        node.AddAttribute("keys_strings", keys);
+        node.AddAttribute("values_int64s", Int64Keys(vocabulary));
+        node.AddAttribute("default_int64", static_cast<int64_t>(-1));
+      });
+  BenchmarkSession session(model);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateStringInputTensor(Lookups(keys, rows, std::string("unknown")), {rows}));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_LabelEncoderStringToInt64)
+    ->Args({1000, 100000})
+    ->Args({100000, 100000})
+    ->Args({1000000, 100000})
+    ->Args({1000000, 1000000})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Args: vocabulary size, rows
+static void BM_CategoryMapperInt64ToString(benchmark::State& state) {
+  const int64_t vocabulary = state.range(0);
+  const int64_t rows = state.range(1);
+  std::vector<int64_t> keys = Int64Keys(vocabulary);
+  std::string model = MakeSingleNodeModel(
+      "CategoryMapper", kMLDomain,
+      {{"X", ONNX_NAMESPACE::TensorProto_DataType_INT64, {rows}}}, {"Y"},
+      [&](Node& node) {
+        node.AddAttribute("cats_strings", StringKeys(vocabulary));
+        node.AddAttribute("cats_int64s", keys);
+        node.AddAttribute("default_string", std::string("unknown"));
+        node.AddAttribute("default_int64", static_cast<int64_t>(-1));
+      });
+  BenchmarkSession session(model);
+  std::vector<int64_t> x = Lookups(keys, rows, static_cast<int64_t>(-1));
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, {rows}));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_CategoryMapperInt64ToString)
+    ->Args({1000, 100000})
+    ->Args({100000, 100000})
+    ->Args({1000000, 100000})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
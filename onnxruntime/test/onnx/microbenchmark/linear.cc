@@ -0,0 +1,87 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+std::vector<float> RandomValues(size_t count, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> value(-1.f, 1.f);
+  std::vector<float> values(count);
+  for (auto& v : values) v = value(gen);
+  return values;
+}
+
+}  // namespace
+
+// Args: rows, features, classes
+static void BM_LinearClassifier(benchmark::State& state) {
+  const int64_t rows = state.range(0);
+  const int64_t features = state.range(1);
+  const int64_t classes = state.range(2);
+  std::vector<int64_t> labels(static_cast<size_t>(classes));
+  for (int64_t i = 0; i < classes; ++i) labels[i] = i;
+  std::string model = MakeSingleNodeModel(
+      "LinearClassifier", kMLDomain,
+      {{"X", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {rows, features}}}, {"Y", "Z"},
+      [&](Node& node) {
+        node.AddAttribute("coefficients", RandomValues(static_cast<size_t>(classes * features), 1));
+        node.AddAttribute("intercepts", RandomValues(static_cast<size_t>(classes), 2));
+        node.AddAttribute("classlabels_ints", labels);
+        node.AddAttribute("post_transform", std::string("SOFTMAX"));
+      });
+  BenchmarkSession session(model);
+  std::vector<float> x = RandomValues(static_cast<size_t>(rows * features), 3);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, {rows, features}));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_LinearClassifier)
+    ->Args({1, 5000, 3})
+    ->Args({100, 5000, 3})
+    ->Args({10000, 1000, 3})
+    ->Args({2000, 5000, 3})
+    ->Args({2000, 5000, 20})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Args: rows, features, targets
+static void BM_LinearRegressor(benchmark::State& state) {
+  const int64_t rows = state.range(0);
+  const int64_t features = state.range(1);
+  const int64_t targets = state.range(2);
+  std::string model = MakeSingleNodeModel(
+      "LinearRegressor", kMLDomain,
+      {{"X", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {rows, features}}}, {"Y"},
+      [&](Node& node) {
+        node.AddAttribute("coefficients", RandomValues(static_cast<size_t>(targets * features), 1));
+        node.AddAttribute("intercepts", RandomValues(static_cast<size_t>(targets), 2));
+        node.AddAttribute("targets", targets);
+      });
+  BenchmarkSession session(model);
+  std::vector<float> x = RandomValues(static_cast<size_t>(rows * features), 3);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, {rows, features}));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_LinearRegressor)
+    ->Args({1, 5000, 1})
+    ->Args({10000, 1000, 1})
+    ->Args({2000, 5000, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+constexpr int64_t kSeqLength = 32;
+constexpr int64_t kBatchSize = 8;
+constexpr int64_t kInputSize = 64;
+constexpr int64_t kHiddenSize = 128;
+constexpr int64_t kNumDirections = 2;
+
+std::vector<float> RandomValues(size_t count, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> value(-0.1f, 0.1f);
+  std::vector<float> values(count);
+  for (auto& v : values) v = value(gen);
+  return values;
+}
+
+std::string MakeLstmModel() {
+  return MakeSingleNodeModel(
+      "LSTM", kOnnxDomain,
+      {{"X", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {kSeqLength, kBatchSize, kInputSize}},
+       {"W", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {kNumDirections, 4 * kHiddenSize, kInputSize}},
+       {"R", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {kNumDirections, 4 * kHiddenSize, kHiddenSize}},
+       {"B", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {kNumDirections, 8 * kHiddenSize}}},
+      {"Y", "Y_h", "Y_c"},
+      [](Node& node) {
+        node.AddAttribute("hidden_size", kHiddenSize);
+        node.AddAttribute("direction", std::string("bidirectional"));
+      });
+}
+
+}  // namespace
+
+// Every benchmark thread runs its own LSTM session, like a server hosting one model per request handler.
+// The per session intra-op thread count is the first argument, 0 for the default.
+static void BM_LstmConcurrentSessions(benchmark::State& state) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  BenchmarkSession session(MakeLstmModel(), intra_op_num_threads);
+
+  std::vector<float> x = RandomValues(kSeqLength * kBatchSize * kInputSize, 1);
+  std::vector<float> w = RandomValues(kNumDirections * 4 * kHiddenSize * kInputSize, 2);
+  std::vector<float> r = RandomValues(kNumDirections * 4 * kHiddenSize * kHiddenSize, 3);
+  std::vector<float> b = RandomValues(kNumDirections * 8 * kHiddenSize, 4);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, {kSeqLength, kBatchSize, kInputSize}));
+  inputs.push_back(CreateInputTensor(w, {kNumDirections, 4 * kHiddenSize, kInputSize}));
+  inputs.push_back(CreateInputTensor(r, {kNumDirections, 4 * kHiddenSize, kHiddenSize}));
+  inputs.push_back(CreateInputTensor(b, {kNumDirections, 8 * kHiddenSize}));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  // summed over the benchmark threads, so this is the throughput of all the sessions
+  state.SetItemsProcessed(state.iterations() * kBatchSize);
+}
+BENCHMARK(BM_LstmConcurrentSessions)
+    ->Arg(0)
+    ->Arg(1)
+    ->Arg(4)
+    ->ThreadRange(1, 8)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+// Runs a NonMaxSuppression of num_boxes random boxes scored for num_classes classes, intra_op_num_threads threads.
+// Most scores are low like the ones of a detector, so the score threshold drops the bulk of the candidates.
+void RunNonMaxSuppression(benchmark::State& state, int64_t num_batches, int64_t num_classes, int64_t num_boxes,
+                          int64_t max_output_boxes_per_class, float iou_threshold, float score_threshold) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  std::vector<int64_t> boxes_dims{num_batches, num_boxes, 4};
+  std::vector<int64_t> scores_dims{num_batches, num_classes, num_boxes};
+  std::vector<int64_t> scalar_dims{1};
+  std::string model = MakeSingleNodeModel(
+      "NonMaxSuppression", kOnnxDomain,
+      {{"boxes", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, boxes_dims},
+       {"scores", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, scores_dims},
+       {"max_output_boxes_per_class", ONNX_NAMESPACE::TensorProto_DataType_INT64, scalar_dims},
+       {"iou_threshold", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, scalar_dims},
+       {"score_threshold", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, scalar_dims}},
+      {"selected_indices"},
+      [](Node&) {});
+  BenchmarkSession session(model, intra_op_num_threads);
+
+  std::mt19937 gen(13);
+  std::uniform_real_distribution<float> position(0.f, 1.f), size(0.02f, 0.3f);
+  std::vector<float> boxes;
+  for (int64_t i = 0; i < num_batches * num_boxes; ++i) {
+    const float y = position(gen), x = position(gen);
+    boxes.insert(boxes.end(), {y, x, y + size(gen), x + size(gen)});
+  }
+  std::vector<float> scores(static_cast<size_t>(num_batches * num_classes * num_boxes));
+  for (auto& score : scores) {
+    const float p = position(gen);
+    score = p * p * p * p;
+  }
+  std::vector<int64_t> max_output{max_output_boxes_per_class};
+  std::vector<float> iou{iou_threshold};
+  std::vector<float> score{score_threshold};
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(boxes, boxes_dims));
+  inputs.push_back(CreateInputTensor(scores, scores_dims));
+  inputs.push_back(CreateInputTensor(max_output, scalar_dims));
+  inputs.push_back(CreateInputTensor(iou, scalar_dims));
+  inputs.push_back(CreateInputTensor(score, scalar_dims));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * num_batches * num_classes * num_boxes);
+}
+
+}  // namespace
+
+// SSD MobileNet on COCO: 1917 anchors, 90 classes
+static void BM_NonMaxSuppressionSSD(benchmark::State& state) {
+  RunNonMaxSuppression(state, 1, 90, 1917, 100, 0.6f, 0.3f);
+}
+BENCHMARK(BM_NonMaxSuppressionSSD)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// YOLOv3 at 416x416: 10647 anchors, 80 classes
+static void BM_NonMaxSuppressionYOLO(benchmark::State& state) {
+  RunNonMaxSuppression(state, 1, 80, 10647, 100, 0.5f, 0.1f);
+}
+BENCHMARK(BM_NonMaxSuppressionYOLO)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// a batch of YOLOv3 images with a score threshold of 0 that keeps nearly every box, the IoU checks dominate
+static void BM_NonMaxSuppressionYOLOZeroScoreThreshold(benchmark::State& state) {
+  RunNonMaxSuppression(state, 4, 80, 10647, 200, 0.5f, 0.f);
+}
+BENCHMARK(BM_NonMaxSuppressionYOLOZeroScoreThreshold)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,77 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+// [B, S, H] activations of a ranking model
+constexpr int64_t kBatchSize = 32;
+constexpr int64_t kSeqLength = 128;
+constexpr int64_t kHiddenSize = 768;
+
+// Runs op_type over a [B, S, H] input reduced on axes, intra_op_num_threads threads.
+void RunReduction(benchmark::State& state, const char* op_type, const std::vector<int64_t>& axes) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  const std::vector<int64_t> dims{kBatchSize, kSeqLength, kHiddenSize};
+  std::string model = MakeSingleNodeModel(
+      op_type, kOnnxDomain,
+      {{"data", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, dims}}, {"reduced"},
+      [&](Node& node) {
+        if (!axes.empty()) node.AddAttribute("axes", axes);
+        node.AddAttribute("keepdims", static_cast<int64_t>(0));
+      });
+  BenchmarkSession session(model, intra_op_num_threads);
+
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<float> value(-1.f, 1.f);
+  std::vector<float> x(static_cast<size_t>(kBatchSize * kSeqLength * kHiddenSize));
+  for (auto& v : x) v = value(gen);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, dims));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(x.size() * sizeof(float)));
+}
+
+}  // namespace
+
+// mean over the sequence, the reduced axis is in the middle
+static void BM_ReduceMeanSequence(benchmark::State& state) {
+  RunReduction(state, "ReduceMean", {1});
+}
+BENCHMARK(BM_ReduceMeanSequence)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// mean over the hidden units, the reduced axis is innermost
+static void BM_ReduceMeanHidden(benchmark::State& state) {
+  RunReduction(state, "ReduceMean", {2});
+}
+BENCHMARK(BM_ReduceMeanHidden)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// sum over the batch, the reduced axis is outermost
+static void BM_ReduceSumBatch(benchmark::State& state) {
+  RunReduction(state, "ReduceSum", {0});
+}
+BENCHMARK(BM_ReduceSumBatch)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// max over the batch and the hidden units, two reduced axes around a kept one
+static void BM_ReduceMaxBatchHidden(benchmark::State& state) {
+  RunReduction(state, "ReduceMax", {0, 2});
+}
+BENCHMARK(BM_ReduceMaxBatchHidden)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// every axis
+static void BM_ReduceSumAll(benchmark::State& state) {
+  RunReduction(state, "ReduceSum", {});
+}
+BENCHMARK(BM_ReduceSumAll)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+// Runs a Resize of a float NCHW input of dims by scales in mode, intra_op_num_threads threads.
+void RunResize(benchmark::State& state, const std::vector<int64_t>& dims, std::vector<float> scales,
+               const std::string& mode) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  const std::vector<int64_t> roi_dims{0};
+  const std::vector<int64_t> scales_dims{static_cast<int64_t>(scales.size())};
+  std::string model = MakeSingleNodeModel(
+      "Resize", kOnnxDomain,
+      {{"X", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, dims},
+       {"roi", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, roi_dims},
+       {"scales", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, scales_dims}},
+      {"Y"},
+      [&](Node& node) { node.AddAttribute("mode", mode); });
+  BenchmarkSession session(model, intra_op_num_threads);
+
+  int64_t size = 1;
+  int64_t output_size = 1;
+  for (size_t i = 0; i < dims.size(); ++i) {
+    size *= dims[i];
+    output_size *= static_cast<int64_t>(dims[i] * scales[i]);
+  }
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<float> value(0.f, 255.f);
+  std::vector<float> x(static_cast<size_t>(size));
+  for (auto& v : x) v = value(gen);
+  std::vector<float> roi;
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, dims));
+  inputs.push_back(CreateInputTensor(roi, roi_dims));
+  inputs.push_back(CreateInputTensor(scales, scales_dims));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>((size + output_size) * sizeof(float)));
+}
+
+}  // namespace
+
+// 540p frame upscaled to 1080p
+static void BM_ResizeBilinearUpsampleFrame(benchmark::State& state) {
+  RunResize(state, {1, 3, 540, 960}, {1.f, 1.f, 2.f, 2.f}, "linear");
+}
+BENCHMARK(BM_ResizeBilinearUpsampleFrame)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// 1080p frame downscaled for a detector input
+static void BM_ResizeBilinearDownsampleFrame(benchmark::State& state) {
+  RunResize(state, {1, 3, 1080, 1920}, {1.f, 1.f, 0.3f, 0.3f}, "linear");
+}
+BENCHMARK(BM_ResizeBilinearDownsampleFrame)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// feature pyramid upsampling
+static void BM_ResizeNearestUpsample2x(benchmark::State& state) {
+  RunResize(state, {1, 256, 80, 80}, {1.f, 1.f, 2.f, 2.f}, "nearest");
+}
+BENCHMARK(BM_ResizeNearestUpsample2x)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+static void BM_ResizeNearestDownsample(benchmark::State& state) {
+  RunResize(state, {1, 3, 1080, 1920}, {1.f, 1.f, 0.5f, 0.5f}, "nearest");
+}
+BENCHMARK(BM_ResizeNearestDownsample)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
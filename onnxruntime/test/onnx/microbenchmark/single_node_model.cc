@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "single_node_model.h"
+
+#include <core/common/logging/logging.h>
+#include <core/graph/constants.h>
+#include <core/graph/model.h>
+
+namespace onnxruntime {
+namespace test {
+
+std::string MakeSingleNodeModel(const std::string& op_type, const std::string& domain,
+                                const std::vector<SingleNodeInput>& inputs,
+                                const std::vector<std::string>& outputs,
+                                const std::function<void(Node&)>& set_attributes) {
+  onnxruntime::Model model("single_node", false, logging::LoggingManager::DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+
+  std::vector<NodeArg*> input_args;
+  for (const auto& input : inputs) {
+    ONNX_NAMESPACE::TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(input.elem_type);
+    for (int64_t dim : input.dims) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+    input_args.push_back(&graph.GetOrCreateNodeArg(input.name, &type));
+  }
+  std::vector<NodeArg*> output_args;
+  for (const auto& output : outputs) {
+    output_args.push_back(&graph.GetOrCreateNodeArg(output, nullptr));
+  }
+
+  Node& node = graph.AddNode("node", op_type, "", input_args, output_args, nullptr, domain);
+  if (set_attributes) {
+    set_attributes(node);
+  }
+
+  auto status = graph.Resolve();
+  if (!status.IsOK()) {
+    ORT_THROW("Failed to resolve the ", op_type, " model: ", status.ErrorMessage());
+  }
+
+  std::string model_data;
+  model.ToProto().SerializeToString(&model_data);
+  return model_data;
+}
+
+static Ort::SessionOptions MakeSessionOptions(int intra_op_num_threads) {
+  Ort::SessionOptions session_options;
+  if (intra_op_num_threads > 0) {
+    session_options.SetIntraOpNumThreads(intra_op_num_threads);
+  }
+  return session_options;
+}
+
+BenchmarkSession::BenchmarkSession(const std::string& model_data, int intra_op_num_threads)
+    : BenchmarkSession(model_data, MakeSessionOptions(intra_op_num_threads)) {
+}
+
+BenchmarkSession::BenchmarkSession(const std::string& model_data, const Ort::SessionOptions& session_options)
+    : session_{nullptr} {
+  Ort::Unowned<Ort::Env> ort_env{env};
+  session_ = Ort::Session(ort_env, model_data.data(), model_data.size(), session_options);
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  for (size_t i = 0, end = session_.GetInputCount(); i < end; ++i) {
+    char* name = session_.GetInputName(i, allocator);
+    input_names_.emplace_back(name);
+    allocator.Free(name);
+  }
+  for (size_t i = 0, end = session_.GetOutputCount(); i < end; ++i) {
+    char* name = session_.GetOutputName(i, allocator);
+    output_names_.emplace_back(name);
+    allocator.Free(name);
+  }
+  for (const auto& name : input_names_) input_names_ptr_.push_back(name.c_str());
+  for (const auto& name : output_names_) output_names_ptr_.push_back(name.c_str());
+}
+
+std::vector<Ort::Value> BenchmarkSession::Run(const std::vector<Ort::Value>& inputs) {
+  return session_.Run(Ort::RunOptions{nullptr}, input_names_ptr_.data(), inputs.data(), inputs.size(),
+                      output_names_ptr_.data(), output_names_ptr_.size());
+}
+
+Ort::Value CreateStringInputTensor(const std::vector<std::string>& data, const std::vector<int64_t>& dims) {
+  Ort::AllocatorWithDefaultOptions allocator;
+  Ort::Value value = Ort::Value::CreateTensor(allocator, dims.data(), dims.size(), ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING);
+  std::vector<const char*> strings;
+  strings.reserve(data.size());
+  for (const auto& s : data) strings.push_back(s.c_str());
+  Ort::ThrowOnError(Ort::Global<void>::api_.FillStringTensor(value, strings.data(), strings.size()));
+  return value;
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <core/graph/graph.h>
+#include <core/session/onnxruntime_cxx_api.h>
+
+extern OrtEnv* env;
+
+namespace onnxruntime {
+namespace test {
+
+// Graph input of a single node model.
+struct SingleNodeInput {
+  std::string name;
+  ONNX_NAMESPACE::TensorProto_DataType elem_type;
+  std::vector<int64_t> dims;
+};
+
+// Builds a model made of one node and returns it serialized. The output types are inferred from the operator
+// schema, set_attributes is called on the node before the graph is resolved.
+std::string MakeSingleNodeModel(const std::string& op_type, const std::string& domain,
+                                const std::vector<SingleNodeInput>& inputs,
+                                const std::vector<std::string>& outputs,
+                                const std::function<void(Node&)>& set_attributes);
+
+// Session over a serialized model, run through the C++ API the same way an application would.
+class BenchmarkSession {
+ public:
+  // intra_op_num_threads == 0 lets the session pick its default.
+  BenchmarkSession(const std::string& model_data, int intra_op_num_threads = 0);
+  BenchmarkSession(const std::string& model_data, const Ort::SessionOptions& session_options);
+
+  // inputs are in the order of the model inputs
+  std::vector<Ort::Value> Run(const std::vector<Ort::Value>& inputs);
+
+ private:
+  Ort::Session session_;
+  std::vector<std::string> input_names_;
+  std::vector<std::string> output_names_;
+  std::vector<const char*> input_names_ptr_;
+  std::vector<const char*> output_names_ptr_;
+};
+
+template <typename T>
+Ort::Value CreateInputTensor(std::vector<T>& data, const std::vector<int64_t>& dims) {
+  static const Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+  return Ort::Value::CreateTensor<T>(memory_info, data.data(), data.size(), dims.data(), dims.size());
+}
+
+// String tensors can't wrap a caller buffer, the strings are copied into a tensor allocated by the default allocator.
+Ort::Value CreateStringInputTensor(const std::vector<std::string>& data, const std::vector<int64_t>& dims);
+
+}  // namespace test
+}  // namespace onnxruntime
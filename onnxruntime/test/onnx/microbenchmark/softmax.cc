@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+// Runs op_type over a [batch, classes] input, intra_op_num_threads threads.
+void RunSoftmax(benchmark::State& state, const char* op_type, int64_t batch_size, int64_t num_classes) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  const std::vector<int64_t> dims{batch_size, num_classes};
+  std::string model = MakeSingleNodeModel(
+      op_type, kOnnxDomain,
+      {{"input", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, dims}}, {"output"},
+      [](Node& node) { node.AddAttribute("axis", static_cast<int64_t>(1)); });
+  BenchmarkSession session(model, intra_op_num_threads);
+
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<float> value(-10.f, 10.f);
+  std::vector<float> x(static_cast<size_t>(batch_size * num_classes));
+  for (auto& v : x) v = value(gen);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, dims));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(x.size()));
+}
+
+}  // namespace
+
+// output layer of a language model over a 50k token vocabulary
+static void BM_SoftmaxVocabulary(benchmark::State& state) {
+  RunSoftmax(state, "Softmax", 8, 50000);
+}
+BENCHMARK(BM_SoftmaxVocabulary)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+static void BM_LogSoftmaxVocabulary(benchmark::State& state) {
+  RunSoftmax(state, "LogSoftmax", 8, 50000);
+}
+BENCHMARK(BM_LogSoftmaxVocabulary)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// many short rows, the attention probabilities of a 12 head encoder over 128 tokens
+static void BM_SoftmaxAttentionScores(benchmark::State& state) {
+  RunSoftmax(state, "Softmax", 12 * 128, 128);
+}
+BENCHMARK(BM_SoftmaxAttentionScores)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+constexpr int64_t kFeatures = 50;
+constexpr int64_t kClasses = 4;
+
+std::vector<float> RandomValues(size_t count, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> value(-1.f, 1.f);
+  std::vector<float> values(count);
+  for (auto& v : values) v = value(gen);
+  return values;
+}
+
+const char* KernelName(int64_t kernel) {
+  static const char* names[] = {"LINEAR", "POLY", "RBF", "SIGMOID"};
+  return names[kernel];
+}
+
+}  // namespace
+
+// Args: support vectors, rows, kernel (0 LINEAR, 1 POLY, 2 RBF, 3 SIGMOID)
+static void BM_SVMClassifier(benchmark::State& state) {
+  const int64_t vectors = state.range(0);
+  const int64_t rows = state.range(1);
+  std::vector<int64_t> vectors_per_class(kClasses, vectors / kClasses);
+  std::vector<int64_t> labels{0, 1, 2, 3};
+  std::string model = MakeSingleNodeModel(
+      "SVMClassifier", kMLDomain,
+      {{"X", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {rows, kFeatures}}}, {"Y", "Z"},
+      [&](Node& node) {
+        node.AddAttribute("kernel_type", std::string(KernelName(state.range(2))));
+        node.AddAttribute("kernel_params", std::vector<float>{0.02f, 0.f, 3.f});
+        node.AddAttribute("support_vectors", RandomValues(static_cast<size_t>(vectors * kFeatures), 1));
+        node.AddAttribute("coefficients", RandomValues(static_cast<size_t>((kClasses - 1) * vectors), 2));
+        node.AddAttribute("rho", RandomValues(kClasses * (kClasses - 1) / 2, 3));
+        node.AddAttribute("vectors_per_class", vectors_per_class);
+        node.AddAttribute("classlabels_ints", labels);
+      });
+  BenchmarkSession session(model);
+  std::vector<float> x = RandomValues(static_cast<size_t>(rows * kFeatures), 4);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, {rows, kFeatures}));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_SVMClassifier)
+    ->Args({1000, 1, 2})
+    ->Args({1000, 1000, 2})
+    ->Args({20000, 1, 2})
+    ->Args({20000, 4096, 0})
+    ->Args({20000, 4096, 1})
+    ->Args({20000, 4096, 2})
+    ->Args({20000, 4096, 3})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Args: support vectors, rows
+static void BM_SVMRegressor(benchmark::State& state) {
+  const int64_t vectors = state.range(0);
+  const int64_t rows = state.range(1);
+  std::string model = MakeSingleNodeModel(
+      "SVMRegressor", kMLDomain,
+      {{"X", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {rows, kFeatures}}}, {"Y"},
+      [&](Node& node) {
+        node.AddAttribute("kernel_type", std::string("RBF"));
+        node.AddAttribute("kernel_params", std::vector<float>{0.02f, 0.f, 3.f});
+        node.AddAttribute("support_vectors", RandomValues(static_cast<size_t>(vectors * kFeatures), 1));
+        node.AddAttribute("coefficients", RandomValues(static_cast<size_t>(vectors), 2));
+        node.AddAttribute("rho", std::vector<float>{0.5f});
+        node.AddAttribute("n_supports", vectors);
+      });
+  BenchmarkSession session(model);
+  std::vector<float> x = RandomValues(static_cast<size_t>(rows * kFeatures), 4);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, {rows, kFeatures}));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_SVMRegressor)
+    ->Args({1000, 1})
+    ->Args({1000, 1000})
+    ->Args({20000, 4096})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
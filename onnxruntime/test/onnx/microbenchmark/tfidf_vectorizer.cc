@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+constexpr int64_t kVocabulary = 50000;
+constexpr int64_t kUnigrams = 10000;
+constexpr int64_t kBigrams = 20000;
+
+// Token ids of a document, drawn so that the frequent ids are the ones in the pool.
+std::vector<int64_t> RandomTokens(size_t count, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::geometric_distribution<int64_t> token(0.0005);
+  std::vector<int64_t> tokens(count);
+  for (auto& t : tokens) t = std::min(token(gen), kVocabulary - 1);
+  return tokens;
+}
+
+// kUnigrams 1-grams followed by up to kBigrams 2-grams over the most frequent token ids.
+std::vector<int64_t> Pool() {
+  std::vector<int64_t> pool;
+  for (int64_t i = 0; i < kUnigrams; ++i) pool.push_back(i);
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int64_t> token(0, kUnigrams / 10 - 1);
+  std::vector<std::pair<int64_t, int64_t>> bigrams(kBigrams);
+  for (auto& bigram : bigrams) bigram = {token(gen), token(gen)};
+  // the pool must not hold the same n-gram twice
+  std::sort(bigrams.begin(), bigrams.end());
+  bigrams.erase(std::unique(bigrams.begin(), bigrams.end()), bigrams.end());
+  for (const auto& bigram : bigrams) {
+    pool.push_back(bigram.first);
+    pool.push_back(bigram.second);
+  }
+  return pool;
+}
+
+std::vector<std::string> ToStrings(const std::vector<int64_t>& tokens) {
+  std::vector<std::string> strings(tokens.size());
+  for (size_t i = 0; i < tokens.size(); ++i) strings[i] = "token" + std::to_string(tokens[i]);
+  return strings;
+}
+
+std::string MakeModel(ONNX_NAMESPACE::TensorProto_DataType elem_type, int64_t rows, int64_t tokens) {
+  const std::vector<int64_t> pool = Pool();
+  const int64_t ngrams = kUnigrams + static_cast<int64_t>(pool.size() - kUnigrams) / 2;
+  std::vector<int64_t> ngram_indexes(static_cast<size_t>(ngrams));
+  for (int64_t i = 0; i < ngrams; ++i) ngram_indexes[i] = i;
+  return MakeSingleNodeModel(
+      "TfIdfVectorizer", "",
+      {{"X", elem_type, {rows, tokens}}}, {"Y"},
+      [&](Node& node) {
+        node.AddAttribute("mode", std::string("TF"));
+        node.AddAttribute("min_gram_length", static_cast<int64_t>(1));
+        node.AddAttribute("max_gram_length", static_cast<int64_t>(2));
+        node.AddAttribute("max_skip_count", static_cast<int64_t>(0));
+        node.AddAttribute("ngram_counts", std::vector<int64_t>{0, kUnigrams});
+        node.AddAttribute("ngram_indexes", ngram_indexes);
+        if (elem_type == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+          node.AddAttribute("pool_strings", ToStrings(pool));
+        } else {
+          node.AddAttribute("pool_int64s", pool);
+        }
+      });
+}
+
+}  // namespace
+
+// Args: documents, tokens per document
+static void BM_TfIdfVectorizerInt64(benchmark::State& state) {
+  const int64_t rows = state.range(0);
+  const int64_t tokens = state.range(1);
+  BenchmarkSession session(MakeModel(ONNX_NAMESPACE::TensorProto_DataType_INT64, rows, tokens));
+  std::vector<int64_t> x = RandomTokens(static_cast<size_t>(rows * tokens), 2);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, {rows, tokens}));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * rows * tokens);
+}
+BENCHMARK(BM_TfIdfVectorizerInt64)
+    ->Args({1, 2048})
+    ->Args({64, 2048})
+    ->Args({512, 2048})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Args: documents, tokens per document
+static void BM_TfIdfVectorizerString(benchmark::State& state) {
+  const int64_t rows = state.range(0);
+  const int64_t tokens = state.range(1);
+  BenchmarkSession session(MakeModel(ONNX_NAMESPACE::TensorProto_DataType_STRING, rows, tokens));
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateStringInputTensor(ToStrings(RandomTokens(static_cast<size_t>(rows * tokens), 2)),
+                                           {rows, tokens}));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * rows * tokens);
+}
+BENCHMARK(BM_TfIdfVectorizerString)
+    ->Args({1, 2048})
+    ->Args({64, 2048})
+    ->Args({512, 2048})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,130 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+#include <core/platform/threadpool.h>
+
+using namespace onnxruntime::concurrency;
+
+namespace {
+
+// Elementwise loop of about 25 cycles per element, the cost of the activation functions.
+void ComputeRange(const float* x, float* y, std::ptrdiff_t first, std::ptrdiff_t last) {
+  for (std::ptrdiff_t i = first; i < last; ++i) {
+    y[i] = std::tanh(x[i]);
+  }
+}
+
+// Rows of increasing length, the shape of the work in the attention and tree kernels where the blocks are
+// not all worth the same.
+void ComputeTriangularRange(const float* x, float* y, std::ptrdiff_t n, std::ptrdiff_t first, std::ptrdiff_t last) {
+  for (std::ptrdiff_t row = first; row < last; ++row) {
+    float sum = 0;
+    for (std::ptrdiff_t j = 0; j <= row; ++j) {
+      sum += std::tanh(x[j % n]);
+    }
+    y[row] = sum;
+  }
+}
+
+}  // namespace
+
+// Baseline: BatchParallelFor with one batch per thread, what TryBatchParallelFor did.
+static void BM_ThreadPoolBatchParallelFor(benchmark::State& state) {
+  const std::ptrdiff_t n = state.range(0);
+  ThreadPool tp("bench", static_cast<int>(state.range(1)));
+  std::vector<float> x(n, 0.5f), y(n);
+  for (auto _ : state) {
+    tp.BatchParallelFor(
+        static_cast<int32_t>(n), [&](int32_t i) { ComputeRange(x.data(), y.data(), i, i + 1); },
+        tp.NumThreads() + 1);
+    benchmark::DoNotOptimize(y.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ThreadPoolBatchParallelFor)
+    ->Args({100, 4})
+    ->Args({10000, 4})
+    ->Args({1000000, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Baseline: one task per element, what TryParallelFor did.
+static void BM_ThreadPoolParallelForRange(benchmark::State& state) {
+  const std::ptrdiff_t n = state.range(0);
+  ThreadPool tp("bench", static_cast<int>(state.range(1)));
+  std::vector<float> x(n, 0.5f), y(n);
+  for (auto _ : state) {
+    tp.ParallelForRange(0, n - 1, [&](int64_t first, int64_t last) {
+      ComputeRange(x.data(), y.data(), first, last);
+    });
+    benchmark::DoNotOptimize(y.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ThreadPoolParallelForRange)
+    ->Args({100, 4})
+    ->Args({10000, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_ThreadPoolCostParallelFor(benchmark::State& state) {
+  const std::ptrdiff_t n = state.range(0);
+  ThreadPool tp("bench", static_cast<int>(state.range(1)));
+  std::vector<float> x(n, 0.5f), y(n);
+  for (auto _ : state) {
+    tp.ParallelFor(n, TensorOpCost{sizeof(float), sizeof(float), 25}, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      ComputeRange(x.data(), y.data(), first, last);
+    });
+    benchmark::DoNotOptimize(y.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ThreadPoolCostParallelFor)
+    ->Args({100, 4})
+    ->Args({10000, 4})
+    ->Args({1000000, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_ThreadPoolBatchParallelForUnbalanced(benchmark::State& state) {
+  const std::ptrdiff_t n = state.range(0);
+  ThreadPool tp("bench", static_cast<int>(state.range(1)));
+  std::vector<float> x(n, 0.5f), y(n);
+  for (auto _ : state) {
+    tp.BatchParallelFor(
+        static_cast<int32_t>(n), [&](int32_t i) { ComputeTriangularRange(x.data(), y.data(), n, i, i + 1); },
+        tp.NumThreads() + 1);
+    benchmark::DoNotOptimize(y.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ThreadPoolBatchParallelForUnbalanced)
+    ->Args({1000, 4})
+    ->Args({4000, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_ThreadPoolCostParallelForUnbalanced(benchmark::State& state) {
+  const std::ptrdiff_t n = state.range(0);
+  ThreadPool tp("bench", static_cast<int>(state.range(1)));
+  std::vector<float> x(n, 0.5f), y(n);
+  for (auto _ : state) {
+    // the average row
+    const double cost = static_cast<double>(n) / 2 * 25;
+    tp.ParallelFor(n, cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      ComputeTriangularRange(x.data(), y.data(), n, first, last);
+    });
+    benchmark::DoNotOptimize(y.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_ThreadPoolCostParallelForUnbalanced)
+    ->Args({1000, 4})
+    ->Args({4000, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,59 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+// TopK of the largest k of rows x n random scores, args are {intra_op_num_threads, rows, n, k}.
+static void BM_TopK(benchmark::State& state) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  const int64_t rows = state.range(1);
+  const int64_t n = state.range(2);
+  const int64_t k = state.range(3);
+  std::vector<int64_t> dims{rows, n};
+  std::string model = MakeSingleNodeModel(
+      "TopK", kOnnxDomain,
+      {{"X", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, dims},
+       {"K", ONNX_NAMESPACE::TensorProto_DataType_INT64, {1}}},
+      {"Values", "Indices"},
+      [](Node& node) { node.AddAttribute("axis", int64_t{-1}); });
+  BenchmarkSession session(model, intra_op_num_threads);
+
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<float> value(-1.f, 1.f);
+  std::vector<float> x(static_cast<size_t>(rows * n));
+  for (auto& v : x) v = value(gen);
+  std::vector<int64_t> k_data{k};
+  std::vector<int64_t> k_dims{1};
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, dims));
+  inputs.push_back(CreateInputTensor(k_data, k_dims));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(x.size() * sizeof(float)));
+}
+
+// Sweeps n and k over a single row and a batch of rows, up to the top-100 of 1M scores of a recommendation
+// request. Batches over 64M scores are left out to bound the memory use.
+static void TopKArgs(benchmark::internal::Benchmark* b) {
+  for (int64_t threads : {1, 4}) {
+    for (int64_t rows : {1, 256}) {
+      for (int64_t n : {1000, 100000, 1000000}) {
+        if (rows * n > 64 * 1000000) continue;
+        for (int64_t k : {1, 10, 100}) {
+          b->Args({threads, rows, n, k});
+        }
+      }
+    }
+  }
+}
+BENCHMARK(BM_TopK)->Apply(TopKArgs)->UseRealTime()->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,63 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+// Runs a Transpose of a float input of dims by perm, intra_op_num_threads threads.
+void RunTranspose(benchmark::State& state, const std::vector<int64_t>& dims, const std::vector<int64_t>& perm) {
+  const int intra_op_num_threads = static_cast<int>(state.range(0));
+  std::string model = MakeSingleNodeModel(
+      "Transpose", kOnnxDomain,
+      {{"data", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, dims}}, {"transposed"},
+      [&](Node& node) { node.AddAttribute("perm", perm); });
+  BenchmarkSession session(model, intra_op_num_threads);
+
+  int64_t size = 1;
+  for (auto d : dims) size *= d;
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<float> value(-1.f, 1.f);
+  std::vector<float> x(static_cast<size_t>(size));
+  for (auto& v : x) v = value(gen);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, dims));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(x.size() * sizeof(float)));
+}
+
+}  // namespace
+
+// image backbone activations, the channels move innermost
+static void BM_TransposeNCHW2NHWC(benchmark::State& state) {
+  RunTranspose(state, {8, 64, 56, 56}, {0, 2, 3, 1});
+}
+BENCHMARK(BM_TransposeNCHW2NHWC)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+static void BM_TransposeNHWC2NCHW(benchmark::State& state) {
+  RunTranspose(state, {8, 56, 56, 64}, {0, 3, 1, 2});
+}
+BENCHMARK(BM_TransposeNHWC2NCHW)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// attention heads of a [B, S, N, H] projection
+static void BM_TransposeSequenceHeads(benchmark::State& state) {
+  RunTranspose(state, {32, 128, 12, 64}, {0, 2, 1, 3});
+}
+BENCHMARK(BM_TransposeSequenceHeads)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// keys transposed for the scores, [B, N, S, H] -> [B, N, H, S]
+static void BM_TransposeKeys(benchmark::State& state) {
+  RunTranspose(state, {32, 12, 128, 64}, {0, 1, 3, 2});
+}
+BENCHMARK(BM_TransposeKeys)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMicrosecond);
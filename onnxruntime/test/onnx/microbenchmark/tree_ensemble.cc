@@ -0,0 +1,212 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <map>
+#include <random>
+#include <unordered_map>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+constexpr int64_t kDepth = 6;
+constexpr int64_t kFeatures = 50;
+constexpr int64_t kClasses = 3;
+
+// Synthetic gradient boosted ensemble: complete binary trees, every tree votes for one class like
+// the multi-class models exported from xgboost or lightgbm.
+struct SyntheticEnsemble {
+  std::vector<int64_t> treeids, nodeids, featureids, truenodeids, falsenodeids;
+  std::vector<float> values;
+  std::vector<std::string> modes;
+  std::vector<int64_t> weight_treeids, weight_nodeids, weight_ids;
+  std::vector<float> weights;
+
+  explicit SyntheticEnsemble(int64_t n_trees) {
+    std::mt19937 gen(1234);
+    std::uniform_int_distribution<int64_t> feature(0, kFeatures - 1);
+    std::uniform_real_distribution<float> value(-1.f, 1.f);
+    const int64_t n_internal = (int64_t(1) << kDepth) - 1;
+    const int64_t n_nodes = (int64_t(1) << (kDepth + 1)) - 1;
+    for (int64_t t = 0; t < n_trees; ++t) {
+      for (int64_t n = 0; n < n_nodes; ++n) {
+        treeids.push_back(t);
+        nodeids.push_back(n);
+        if (n < n_internal) {
+          featureids.push_back(feature(gen));
+          values.push_back(value(gen));
+          modes.push_back("BRANCH_LEQ");
+          truenodeids.push_back(2 * n + 1);
+          falsenodeids.push_back(2 * n + 2);
+        } else {
+          featureids.push_back(0);
+          values.push_back(0.f);
+          modes.push_back("LEAF");
+          truenodeids.push_back(0);
+          falsenodeids.push_back(0);
+          weight_treeids.push_back(t);
+          weight_nodeids.push_back(n);
+          weight_ids.push_back(t % kClasses);
+          weights.push_back(value(gen));
+        }
+      }
+    }
+  }
+
+  void SetAttributes(Node& node, const std::string& weights_prefix) const {
+    node.AddAttribute("nodes_treeids", treeids);
+    node.AddAttribute("nodes_nodeids", nodeids);
+    node.AddAttribute("nodes_featureids", featureids);
+    node.AddAttribute("nodes_values", values);
+    node.AddAttribute("nodes_modes", modes);
+    node.AddAttribute("nodes_truenodeids", truenodeids);
+    node.AddAttribute("nodes_falsenodeids", falsenodeids);
+    node.AddAttribute(weights_prefix + "treeids", weight_treeids);
+    node.AddAttribute(weights_prefix + "nodeids", weight_nodeids);
+    node.AddAttribute(weights_prefix + "ids", weight_ids);
+    node.AddAttribute(weights_prefix + "weights", weights);
+  }
+};
+
+std::vector<float> RandomRows(int64_t rows) {
+  std::mt19937 gen(4321);
+  std::uniform_real_distribution<float> value(-1.f, 1.f);
+  std::vector<float> x(static_cast<size_t>(rows * kFeatures));
+  for (auto& v : x) v = value(gen);
+  return x;
+}
+
+// The evaluation the kernels did before the nodes were compiled: walk the parallel attribute
+// arrays and accumulate the votes of every row in a std::map. Kept here as the baseline.
+class ReferenceTreeEnsemble {
+ public:
+  explicit ReferenceTreeEnsemble(const SyntheticEnsemble& e) : e_(e) {
+    for (size_t i = 0; i < e_.weight_nodeids.size(); ++i) {
+      leaves_.insert({e_.weight_treeids[i] * kOffset_ + e_.weight_nodeids[i], i});
+    }
+    for (size_t i = 0; i < e_.nodeids.size(); ++i) {
+      if (e_.nodeids[i] == 0) roots_.push_back(static_cast<int64_t>(i));
+      is_leaf_.push_back(e_.modes[i] == "LEAF");
+    }
+  }
+
+  void Compute(const float* x, int64_t rows, float* z) const {
+    for (int64_t i = 0; i < rows; ++i) {
+      std::map<int64_t, float> classes;
+      for (int64_t root : roots_) {
+        int64_t index = root;
+        const float* row = x + i * kFeatures;
+        while (!is_leaf_[index]) {
+          index = root + (row[e_.featureids[index]] <= e_.values[index] ? e_.truenodeids[index]
+                                                                      : e_.falsenodeids[index]);
+        }
+        auto it = leaves_.find(e_.treeids[index] * kOffset_ + e_.nodeids[index]);
+        if (it != leaves_.end()) {
+          classes[e_.weight_ids[it->second]] += e_.weights[it->second];
+        }
+      }
+      for (int64_t k = 0; k < kClasses; ++k) {
+        auto it = classes.find(k);
+        z[i * kClasses + k] = it == classes.end() ? 0.f : it->second;
+      }
+    }
+  }
+
+ private:
+  const int64_t kOffset_ = 4000000000L;
+  const SyntheticEnsemble& e_;
+  std::unordered_map<int64_t, size_t> leaves_;
+  std::vector<int64_t> roots_;
+  std::vector<bool> is_leaf_;
+};
+
+}  // namespace
+
+static void BM_TreeEnsembleClassifier(benchmark::State& state) {
+  const int64_t n_trees = state.range(0);
+  const int64_t rows = state.range(1);
+  SyntheticEnsemble ensemble(n_trees);
+  std::vector<int64_t> labels{0, 1, 2};
+  std::string model = MakeSingleNodeModel(
+      "TreeEnsembleClassifier", kMLDomain,
+      {{"X", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {rows, kFeatures}}}, {"Y", "Z"},
+      [&](Node& node) {
+        ensemble.SetAttributes(node, "class_");
+        node.AddAttribute("classlabels_int64s", labels);
+      });
+  BenchmarkSession session(model);
+  std::vector<float> x = RandomRows(rows);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, {rows, kFeatures}));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_TreeEnsembleClassifier)
+    ->Args({100, 1})
+    ->Args({100, 16})
+    ->Args({100, 1000})
+    ->Args({1000, 1})
+    ->Args({1000, 16})
+    ->Args({1000, 1000})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_TreeEnsembleRegressor(benchmark::State& state) {
+  const int64_t n_trees = state.range(0);
+  const int64_t rows = state.range(1);
+  SyntheticEnsemble ensemble(n_trees);
+  std::string model = MakeSingleNodeModel(
+      "TreeEnsembleRegressor", kMLDomain,
+      {{"X", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {rows, kFeatures}}}, {"Y"},
+      [&](Node& node) {
+        ensemble.SetAttributes(node, "target_");
+        node.AddAttribute("n_targets", kClasses);
+      });
+  BenchmarkSession session(model);
+  std::vector<float> x = RandomRows(rows);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, {rows, kFeatures}));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_TreeEnsembleRegressor)
+    ->Args({100, 1})
+    ->Args({100, 1000})
+    ->Args({1000, 1})
+    ->Args({1000, 1000})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Same ensembles evaluated the way the kernels did before, single threaded and without session overhead.
+static void BM_TreeEnsembleReference(benchmark::State& state) {
+  const int64_t n_trees = state.range(0);
+  const int64_t rows = state.range(1);
+  SyntheticEnsemble ensemble(n_trees);
+  ReferenceTreeEnsemble reference(ensemble);
+  std::vector<float> x = RandomRows(rows);
+  std::vector<float> z(static_cast<size_t>(rows * kClasses));
+  for (auto _ : state) {
+    reference.Compute(x.data(), rows, z.data());
+    benchmark::DoNotOptimize(z.data());
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+BENCHMARK(BM_TreeEnsembleReference)
+    ->Args({100, 1})
+    ->Args({100, 16})
+    ->Args({100, 1000})
+    ->Args({1000, 1})
+    ->Args({1000, 16})
+    ->Args({1000, 1000})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
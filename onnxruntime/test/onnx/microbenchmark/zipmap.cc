@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+#include <core/graph/constants.h>
+#include "single_node_model.h"
+
+using namespace onnxruntime;
+using namespace onnxruntime::test;
+
+namespace {
+
+std::vector<float> RandomValues(size_t count, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<float> value(0.f, 1.f);
+  std::vector<float> values(count);
+  for (auto& v : values) v = value(gen);
+  return values;
+}
+
+// Runs a ZipMap over rows of class scores, as produced by the classifiers converted from scikit-learn.
+// columnar returns the scores as a tensor and the labels once instead of one map per row.
+void RunZipMap(benchmark::State& state, bool columnar) {
+  const int64_t rows = state.range(0);
+  const int64_t classes = state.range(1);
+  std::vector<std::string> labels(static_cast<size_t>(classes));
+  for (int64_t i = 0; i < classes; ++i) labels[i] = "class_" + std::to_string(i);
+  std::string model = MakeSingleNodeModel(
+      "ZipMap", kMLDomain,
+      {{"X", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, {rows, classes}}}, {"Z"},
+      [&](Node& node) {
+        node.AddAttribute("classlabels_strings", labels);
+      });
+  Ort::SessionOptions session_options;
+  if (columnar) {
+    session_options.EnableColumnarZipMap();
+  }
+  BenchmarkSession session(model, session_options);
+  std::vector<float> x = RandomValues(static_cast<size_t>(rows * classes), 1);
+  std::vector<Ort::Value> inputs;
+  inputs.push_back(CreateInputTensor(x, {rows, classes}));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(session.Run(inputs));
+  }
+  state.SetItemsProcessed(state.iterations() * rows);
+}
+
+}  // namespace
+
+// Args: rows, classes
+static void BM_ZipMap(benchmark::State& state) {
+  RunZipMap(state, false);
+}
+BENCHMARK(BM_ZipMap)
+    ->Args({1, 3})
+    ->Args({1000, 3})
+    ->Args({1000, 100})
+    ->Args({100000, 3})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+// Args: rows, classes
+static void BM_ZipMapColumnar(benchmark::State& state) {
+  RunZipMap(state, true);
+}
+BENCHMARK(BM_ZipMapColumnar)
+    ->Args({1, 3})
+    ->Args({1000, 3})
+    ->Args({1000, 100})
+    ->Args({100000, 3})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
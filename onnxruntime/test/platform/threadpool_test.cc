@@ -7,9 +7,11 @@
 
 #include "gtest/gtest.h"
 #include <algorithm>
+#include <atomic>
 #include <memory>
 #include <functional>
 #include <mutex>
+#include <stdexcept>
 
 using namespace onnxruntime::concurrency;
 
@@ -66,6 +68,23 @@ void TestBatchParallelFor(const std::string& name, int num_threads, int num_task
   ValidateTestData(*test_data);
 }
 
+void IncrementRange(TestData& test_data, std::ptrdiff_t first, std::ptrdiff_t last) {
+  std::lock_guard<std::mutex> lock(test_data.mutex);
+  for (std::ptrdiff_t i = first; i < last; ++i) {
+    test_data.data[i]++;
+  }
+}
+
+void TestCostParallelFor(const std::string& name, int num_threads, int num_tasks, double cost_per_unit) {
+  auto test_data = CreateTestData(num_tasks);
+  CreateThreadPoolAndTest(name, num_threads, [&](ThreadPool* tp) {
+    tp->ParallelFor(num_tasks, cost_per_unit, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      IncrementRange(*test_data, first, last);
+    });
+  });
+  ValidateTestData(*test_data);
+}
+
 }  // namespace
 
 TEST(ThreadPoolTest, TestParallelFor_2_Thread_NoTask) {
@@ -99,3 +118,88 @@ TEST(ThreadPoolTest, TestBatchParallelFor_2_Thread_50_Task_100_Batch) {
 TEST(ThreadPoolTest, TestBatchParallelFor_2_Thread_81_Task_20_Batch) {
   TestBatchParallelFor("TestBatchParallelFor_2_Thread_81_Task_20_Batch", 2, 81, 20);
 }
+
+TEST(ThreadPoolTest, TestCostParallelFor_4_Thread_NoTask) {
+  TestCostParallelFor("TestCostParallelFor_4_Thread_NoTask", 4, 0, 1000.0);
+}
+
+TEST(ThreadPoolTest, TestCostParallelFor_4_Thread_1_Task) {
+  TestCostParallelFor("TestCostParallelFor_4_Thread_1_Task", 4, 1, 1e9);
+}
+
+TEST(ThreadPoolTest, TestCostParallelFor_4_Thread_1000_Cheap_Task) {
+  TestCostParallelFor("TestCostParallelFor_4_Thread_1000_Cheap_Task", 4, 1000, 1.0);
+}
+
+TEST(ThreadPoolTest, TestCostParallelFor_4_Thread_1000_Expensive_Task) {
+  TestCostParallelFor("TestCostParallelFor_4_Thread_1000_Expensive_Task", 4, 1000, 1e5);
+}
+
+TEST(ThreadPoolTest, TestCostParallelFor_1_Thread_81_Expensive_Task) {
+  TestCostParallelFor("TestCostParallelFor_1_Thread_81_Expensive_Task", 1, 81, 1e6);
+}
+
+TEST(ThreadPoolTest, TestCostParallelFor_TensorOpCost) {
+  auto test_data = CreateTestData(10000);
+  CreateThreadPoolAndTest("TestCostParallelFor_TensorOpCost", 3, [&](ThreadPool* tp) {
+    tp->ParallelFor(10000, TensorOpCost{64, 64, 100}, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      IncrementRange(*test_data, first, last);
+    });
+  });
+  ValidateTestData(*test_data);
+}
+
+TEST(ThreadPoolTest, TestTryParallelFor_NoThreadPool) {
+  auto test_data = CreateTestData(100);
+  ThreadPool::TryParallelFor(nullptr, 100, 1e6, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+    IncrementRange(*test_data, first, last);
+  });
+  ValidateTestData(*test_data);
+}
+
+TEST(ThreadPoolTest, TestCostParallelFor_Nested) {
+  // every thread of the pool may be busy with an outer block while inner loops are scheduled
+  const int outer = 16;
+  const int inner = 64;
+  auto test_data = CreateTestData(outer * inner);
+  CreateThreadPoolAndTest("TestCostParallelFor_Nested", 2, [&](ThreadPool* tp) {
+    tp->ParallelFor(outer, 1e6, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      for (std::ptrdiff_t i = first; i < last; ++i) {
+        tp->ParallelFor(inner, 1e5, [&](std::ptrdiff_t inner_first, std::ptrdiff_t inner_last) {
+          IncrementRange(*test_data, i * inner + inner_first, i * inner + inner_last);
+        });
+      }
+    });
+  });
+  ValidateTestData(*test_data);
+}
+
+TEST(ThreadPoolTest, TestCostParallelFor_Exception) {
+  std::atomic<int> calls{0};
+  CreateThreadPoolAndTest("TestCostParallelFor_Exception", 4, [&](ThreadPool* tp) {
+    EXPECT_THROW(tp->ParallelFor(100, 1e6,
+                                 [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                   calls += static_cast<int>(last - first);
+                                   if (first == 0) throw std::runtime_error("block failed");
+                                 }),
+                 std::runtime_error);
+  });
+  // the other blocks still ran
+  EXPECT_EQ(calls.load(), 100);
+}
+
+TEST(ThreadPoolTest, TestCalculateParallelForBlockCount) {
+  // too cheap to be worth another thread
+  EXPECT_EQ(ThreadPool::CalculateParallelForBlockCount(1000, TensorOpCost{0, 0, 1}, 8), 1);
+  // single thread or single unit
+  EXPECT_EQ(ThreadPool::CalculateParallelForBlockCount(1000, TensorOpCost{0, 0, 1e6}, 1), 1);
+  EXPECT_EQ(ThreadPool::CalculateParallelForBlockCount(1, TensorOpCost{0, 0, 1e9}, 8), 1);
+  EXPECT_EQ(ThreadPool::CalculateParallelForBlockCount(0, TensorOpCost{0, 0, 1e9}, 8), 0);
+  // expensive units are split in several blocks per thread, no more than one unit each
+  auto blocks = ThreadPool::CalculateParallelForBlockCount(1000, TensorOpCost{0, 0, 1e6}, 8);
+  EXPECT_GT(blocks, 8);
+  EXPECT_LE(blocks, 4 * 8);
+  EXPECT_EQ(ThreadPool::CalculateParallelForBlockCount(4, TensorOpCost{0, 0, 1e6}, 8), 4);
+  // memory traffic counts towards the cost
+  EXPECT_GT(ThreadPool::CalculateParallelForBlockCount(100000, TensorOpCost{64, 64, 0}, 8), 1);
+}
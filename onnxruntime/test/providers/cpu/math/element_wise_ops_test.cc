@@ -276,6 +276,52 @@ TEST(MathOpTest, Add_Broadcast_2x1x1_3x4) {
 #endif
 }
 
+// Large enough to be split across threads, in ranges which don't start at a span boundary.
+TEST(MathOpTest, Add_Broadcast_large) {
+  // [B, S, H] + [H], one span per row
+  {
+    const int64_t B = 3, S = 67, H = 131;
+    std::vector<float> a(B * S * H), b(H), c(B * S * H);
+    for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<float>(i % 101);
+    for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<float>(i) * 1000.0f;
+    for (size_t i = 0; i < c.size(); ++i) c[i] = a[i] + b[i % H];
+
+    OpTester test("Add");
+    test.AddInput<float>("A", {B, S, H}, a);
+    test.AddInput<float>("B", {H}, b);
+    test.AddOutput<float>("C", {B, S, H}, c);
+    test.Run();
+  }
+  // [N, C, H, W] + [1, C, 1, 1], a scalar of B per span
+  {
+    const int64_t N = 2, C = 5, H = 61, W = 67;
+    std::vector<float> a(N * C * H * W), b(C), c(N * C * H * W);
+    for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<float>(i % 97);
+    for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<float>(i) * 1000.0f;
+    for (size_t i = 0; i < c.size(); ++i) c[i] = a[i] + b[(i / (H * W)) % C];
+
+    OpTester test("Add");
+    test.AddInput<float>("A", {N, C, H, W}, a);
+    test.AddInput<float>("B", {1, C, 1, 1}, b);
+    test.AddOutput<float>("C", {N, C, H, W}, c);
+    test.Run();
+  }
+  // [S, 1] + [1, H], both inputs broadcast
+  {
+    const int64_t S = 257, H = 263;
+    std::vector<float> a(S), b(H), c(S * H);
+    for (size_t i = 0; i < a.size(); ++i) a[i] = static_cast<float>(i) * 1000.0f;
+    for (size_t i = 0; i < b.size(); ++i) b[i] = static_cast<float>(i);
+    for (size_t i = 0; i < c.size(); ++i) c[i] = a[i / H] + b[i % H];
+
+    OpTester test("Add");
+    test.AddInput<float>("A", {S, 1}, a);
+    test.AddInput<float>("B", {1, H}, b);
+    test.AddOutput<float>("C", {S, H}, c);
+    test.Run();
+  }
+}
+
 // Validate runtime failure has useful error message when ORT_ENFORCE is used
 TEST(MathOpTest, Add_Invalid_Broadcast) {
   OpTester test("Add");
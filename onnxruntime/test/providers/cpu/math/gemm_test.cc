@@ -257,5 +257,55 @@ TEST(GemmOpTest, GemmNoBiasOpset11) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kNGraphExecutionProvider, kTensorrtExecutionProvider});
 }
 
+// B is packed once at kernel creation when it is a constant initializer
+TEST(GemmOpTest, GemmConstantB) {
+  OpTester test("Gemm");
+
+  test.AddAttribute("transA", (int64_t)0);
+  test.AddAttribute("transB", (int64_t)0);
+  test.AddAttribute("alpha", 1.0f);
+  test.AddAttribute("beta", 1.0f);
+
+  test.AddInput<float>("A", {2, 4},
+                       {1.0f, 2.0f, 3.0f, 4.0f,
+                        -1.0f, -2.0f, -3.0f, -4.0f});
+  test.AddInput<float>("B", {4, 3},
+                       {1.0f, 2.0f, 3.0f,
+                        4.0f, 5.0f, 6.0f,
+                        7.0f, 8.0f, 9.0f,
+                        10.0f, 11.0f, 12.0f},
+                       true);
+  test.AddInput<float>("C", {3}, {1.0f, 2.0f, 3.0f});
+  test.AddOutput<float>("Y", {2, 3},
+                        {71.0f, 82.0f, 93.0f,
+                         -69.0f, -78.0f, -87.0f});
+  test.Run();
+}
+
+TEST(GemmOpTest, GemmConstantBTrans) {
+  OpTester test("Gemm");
+
+  test.AddAttribute("transA", (int64_t)1);
+  test.AddAttribute("transB", (int64_t)1);
+  test.AddAttribute("alpha", 2.0f);
+  test.AddAttribute("beta", 1.0f);
+
+  test.AddInput<float>("A", {4, 2},
+                       {1.0f, -1.0f,
+                        2.0f, -2.0f,
+                        3.0f, -3.0f,
+                        4.0f, -4.0f});
+  test.AddInput<float>("B", {3, 4},
+                       {1.0f, 4.0f, 7.0f, 10.0f,
+                        2.0f, 5.0f, 8.0f, 11.0f,
+                        3.0f, 6.0f, 9.0f, 12.0f},
+                       true);
+  test.AddInput<float>("C", {3}, {1.0f, 2.0f, 3.0f});
+  test.AddOutput<float>("Y", {2, 3},
+                        {141.0f, 162.0f, 183.0f,
+                         -139.0f, -158.0f, -177.0f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
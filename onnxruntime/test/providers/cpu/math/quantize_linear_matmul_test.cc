@@ -4,6 +4,9 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace onnxruntime {
 namespace test {
 
@@ -58,5 +61,53 @@ TEST(QuantizeLinearMatmulOpTest, QLinearMatMul) {
   test.AddOutput<uint8_t>("T3", {2, 3}, {168, 115, 255, 1, 66, 151});
   test.Run();
 }
+
+// Large enough for the output to be computed in several blocks.
+TEST(QuantizeLinearMatmulOpTest, QLinearMatMulBlocked) {
+  const int64_t M = 70;
+  const int64_t K = 40;
+  const int64_t N = 300;
+  const uint8_t a_zero_point = 131;
+  const uint8_t b_zero_point = 120;
+  const uint8_t y_zero_point = 127;
+  const float a_scale = 0.02f;
+  const float b_scale = 0.01f;
+  const float y_scale = 0.3f;
+
+  std::vector<uint8_t> a_data(M * K);
+  std::vector<uint8_t> b_data(K * N);
+  for (size_t i = 0; i < a_data.size(); i++) {
+    a_data[i] = static_cast<uint8_t>((i * 37 + 11) % 256);
+  }
+  for (size_t i = 0; i < b_data.size(); i++) {
+    b_data[i] = static_cast<uint8_t>((i * 53 + 7) % 256);
+  }
+
+  const float real_multiplier = (a_scale * b_scale) / y_scale;
+  std::vector<uint8_t> y_data(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      int32_t sum = 0;
+      for (int64_t k = 0; k < K; k++) {
+        sum += (static_cast<int32_t>(a_data[m * K + k]) - a_zero_point) *
+               (static_cast<int32_t>(b_data[k * N + n]) - b_zero_point);
+      }
+      float y = std::nearbyintf(static_cast<float>(sum) * real_multiplier) + y_zero_point;
+      y_data[m * N + n] = static_cast<uint8_t>(std::max(0.0f, std::min(255.0f, y)));
+    }
+  }
+
+  OpTester test("QLinearMatMul", 10);
+  test.AddInput<uint8_t>("T1", {M, K}, a_data);
+  test.AddInput<float>("a_scale", {}, {a_scale});
+  test.AddInput<uint8_t>("a_zero_point", {}, {a_zero_point});
+  test.AddInput<uint8_t>("T2", {K, N}, b_data);
+  test.AddInput<float>("b_scale", {}, {b_scale});
+  test.AddInput<uint8_t>("b_zero_point", {}, {b_zero_point});
+  test.AddInput<float>("y_scale", {}, {y_scale});
+  test.AddInput<uint8_t>("y_zero_point", {}, {y_zero_point});
+  test.AddOutput<uint8_t>("T3", {M, N}, y_data);
+  test.Run();
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -5,6 +5,8 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include <numeric>
+
 namespace onnxruntime {
 namespace test {
 
@@ -456,5 +458,50 @@ TEST(TopKOperator, SortedSelection) {
   RunTest(11, 5, input_vals, input_dimensions, expected_vals, expected_indices, expected_dimensions, false, axis, 0);  // smallest values
 }
 
+// Rows long enough for the threshold selection, with repeated values so ties are resolved by the lower index.
+static void top_k_large_rows(int64_t k, int64_t largest, int64_t sorted) {
+  const int64_t rows = 3, n = 5000;
+  std::vector<float> input_vals(rows * n);
+  for (int64_t i = 0; i < rows * n; ++i) {
+    input_vals[i] = static_cast<float>((i * 7919) % 1000);
+  }
+
+  std::vector<float> expected_vals;
+  std::vector<int64_t> expected_indices;
+  for (int64_t row = 0; row < rows; ++row) {
+    std::vector<int64_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    const float* values = input_vals.data() + row * n;
+    std::stable_sort(order.begin(), order.end(), [&](int64_t lhs, int64_t rhs) {
+      return largest ? values[lhs] > values[rhs] : values[lhs] < values[rhs];
+    });
+    for (int64_t l = 0; l < k; ++l) {
+      expected_vals.push_back(values[order[l]]);
+      expected_indices.push_back(order[l]);
+    }
+  }
+
+  RunTest(11, k, input_vals, {rows, n}, expected_vals, expected_indices, {rows, k}, false, 1, largest, sorted);
+}
+
+TEST(TopKOperator, ThresholdSelectionLargeRows) {
+  top_k_large_rows(100, 1, 1);
+  top_k_large_rows(100, 0, 1);
+  top_k_large_rows(1, 1, 1);
+  top_k_large_rows(37, 1, 0);  //unsorted
+}
+
+TEST(TopKOperator, Top2Int64Opset11) {
+  OpTester test("TopK", 11);
+  test.AddInput<int64_t>("X", {2, 4}, {3, 1, 4, 1,
+                                       5, 9, 2, 6});
+  test.AddInput<int64_t>("K", {1}, {2});
+  test.AddOutput<int64_t>("Values", {2, 2}, {4, 3,
+                                             9, 6});
+  test.AddOutput<int64_t>("Indices", {2, 2}, {2, 0,
+                                              1, 3});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -42,5 +42,23 @@ TEST(MLOpTest, DictVectorizerInt64Input) {
   test.Run();
 }
 
+TEST(MLOpTest, DictVectorizerDuplicatedVocabulary) {
+  OpTester test("DictVectorizer", 1, onnxruntime::kMLDomain);
+
+  test.AddAttribute("string_vocabulary", std::vector<std::string>{"a", "b", "a", "c", "a"});
+
+  // "z" isn't in the vocabulary and is ignored
+  std::map<std::string, float> map;
+  map["a"] = 1.5f;
+  map["c"] = 2.f;
+  map["z"] = 3.f;
+
+  test.AddInput<std::string, float>("X", map);
+
+  std::vector<int64_t> dims{1, 5};
+  test.AddOutput<float>("Y", dims, {1.5f, 0.f, 1.5f, 2.f, 1.5f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
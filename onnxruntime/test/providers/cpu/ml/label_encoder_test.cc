@@ -168,5 +168,39 @@ TEST(LabelEncoder, Int64ToFloatOpset2) {
   test.Run();
 }
 
+TEST(LabelEncoder, StringToInt64LargeVocabularyOpset2) {
+  // enough keys to grow the lookup table several times and enough inputs to split the lookups across threads
+  constexpr int64_t num_keys = 5000;
+  std::vector<std::string> keys;
+  std::vector<std::int64_t> values;
+  for (int64_t i = 0; i < num_keys; ++i) {
+    keys.push_back("key" + std::to_string(i));
+    values.push_back(i * 2);
+  }
+  // a key given twice keeps its last value
+  keys.push_back("key7");
+  values.push_back(-7);
+
+  std::vector<std::string> input;
+  std::vector<std::int64_t> output;
+  for (int64_t i = 0; i < 3 * num_keys; i += 3) {
+    input.push_back("key" + std::to_string(i));
+    output.push_back(i < num_keys ? i * 2 : 1234);
+  }
+  input.push_back("key7");
+  output.push_back(-7);
+
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+  test.AddAttribute("keys_strings", keys);
+  test.AddAttribute("values_int64s", values);
+  test.AddAttribute("default_int64", (std::int64_t)1234);
+
+  std::vector<std::int64_t> dims{static_cast<std::int64_t>(input.size())};
+  test.AddInput<std::string>("X", dims, input);
+  test.AddOutput<std::int64_t>("Y", dims, output);
+
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -80,6 +80,41 @@ TEST(MLOpTest, LinearClassifierMulticlassProbSigmoid) {
   test.Run();
 }
 
+TEST(MLOpTest, LinearClassifierMulticlassProbSigmoidBatch) {
+  OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> coefficients = {-0.22562418f, 0.34188559f, 0.68346153f, -0.68051993f, -0.1975279f, 0.03748541f};
+  std::vector<int64_t> classes = {1, 2, 3};
+  std::vector<float> X = {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f};
+
+  std::vector<float> predictions = {0.015647972f, 0.751983387f, 0.484950699f, 0.999971055f, 1.17855E-12f, 0.767471158f, 0.005261482f, 0.999787317f, 0.018302525f};
+  std::vector<float> intercepts = {-3.91601811f, 0.42575697f, 0.13731251f};
+  std::vector<int64_t> predicted_class = {2, 1, 2};
+
+  std::string trans("LOGISTIC");
+  test.AddAttribute("coefficients", coefficients);
+  test.AddAttribute("intercepts", intercepts);
+  test.AddAttribute("classlabels_ints", classes);
+  test.AddAttribute("post_transform", trans);
+
+  // enough rows to be split into several blocks
+  const int64_t copies = 12;
+  std::vector<float> batch_X;
+  std::vector<int64_t> batch_predicted_class;
+  std::vector<float> batch_predictions;
+  for (int64_t i = 0; i < copies; ++i) {
+    batch_X.insert(batch_X.end(), X.begin(), X.end());
+    batch_predicted_class.insert(batch_predicted_class.end(), predicted_class.begin(), predicted_class.end());
+    batch_predictions.insert(batch_predictions.end(), predictions.begin(), predictions.end());
+  }
+
+  test.AddInput<float>("X", {3 * copies, 2}, batch_X);
+  test.AddOutput<int64_t>("Y", {3 * copies}, batch_predicted_class);
+  test.AddOutput<float>("Z", {3 * copies, 3}, batch_predictions);
+  test.SetOutputAbsErr("Z", 0.0001f);
+  test.Run();
+}
+
 TEST(MLOpTest, LinearClassifierBinary) {
   OpTester test("LinearClassifier", 1, onnxruntime::kMLDomain);
 
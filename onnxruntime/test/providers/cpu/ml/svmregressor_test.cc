@@ -32,6 +32,65 @@ TEST(MLOpTest, SVMRegressorSVC) {
   test.Run();
 }
 
+TEST(MLOpTest, SVMRegressorSVCBatch) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> dual_coefficients = {-1.54236563f, 0.53485162f, -1.5170623f, 0.69771864f, 1.82685767f};
+  std::vector<float> support_vectors = {0.f, 0.5f, 32.f, 1.f, 1.5f, 1.f, 2.f, 2.9f, -32.f, 12.f, 12.9f, -312.f, 43.f, 413.3f, -114.f};
+  std::vector<float> rho = {1.96292297f};
+  std::vector<float> kernel_params = {0.001f, 0.f, 3.f};  //gamma, coef0, degree
+
+  std::vector<float> X = {1.f, 0.0f, 0.4f, 3.0f, 44.0f, -3.f, 12.0f, 12.9f, -312.f, 23.0f, 11.3f, -222.f, 23.0f, 11.3f, -222.f, 23.0f, 3311.3f, -222.f, 23.0f, 11.3f, -222.f, 43.0f, 413.3f, -114.f};
+  std::vector<float> predictions = {1.40283655f, 1.86065906f, 2.66064161f, 1.96311014f, 1.96311014f, 1.96292297f, 1.96311014f, 3.78978065f};
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(5));
+
+  // enough rows to be split into several blocks
+  const int64_t copies = 5;
+  std::vector<float> batch_X;
+  std::vector<float> batch_predictions;
+  for (int64_t i = 0; i < copies; ++i) {
+    batch_X.insert(batch_X.end(), X.begin(), X.end());
+    batch_predictions.insert(batch_predictions.end(), predictions.begin(), predictions.end());
+  }
+
+  test.AddInput<float>("X", {8 * copies, 3}, batch_X);
+  test.AddOutput<float>("Y", {8 * copies, 1}, batch_predictions);
+
+  test.Run();
+}
+
+TEST(MLOpTest, SVMRegressorSVCLargeFeatures) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  // unscaled features: the squared norms are about 2e8 while the distances are below 2, a float expansion of
+  // |x - sv|^2 would lose all of its digits
+  std::vector<float> dual_coefficients = {1.f, -0.5f, 0.25f};
+  std::vector<float> support_vectors = {10000.f, 10000.5f, 10000.25f, 10000.f, 10001.f, 9999.f};
+  std::vector<float> rho = {0.1f};
+  std::vector<float> kernel_params = {0.5f, 0.f, 3.f};  //gamma, coef0, degree
+
+  std::vector<float> X = {10000.f, 10000.5f, 10000.25f, 10000.25f, 10000.5f, 10000.f};
+  std::vector<float> predictions = {0.72155529f, 0.64119416f, 0.52799958f};
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(3));
+
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<float>("Y", {3, 1}, predictions);
+
+  test.Run();
+}
+
 TEST(MLOpTest, SVMRegressorNuSVC) {
   OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
 
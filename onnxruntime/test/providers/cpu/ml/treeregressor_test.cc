@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -130,5 +132,49 @@ TEST(MLOpTest, TreeRegressorSingleTargetSum) {
   test.Run();
 }
 
+TEST(MLOpTest, TreeRegressorUnorderedNodesMissingValues) {
+  OpTester test("TreeEnsembleRegressor", 1, onnxruntime::kMLDomain);
+
+  // the nodes of each tree are not listed in node id order
+  std::vector<int64_t> lefts = {0, 1, 0, 0, 2, 0};
+  std::vector<int64_t> rights = {0, 2, 0, 0, 1, 0};
+  std::vector<int64_t> treeids = {0, 0, 0, 1, 1, 1};
+  std::vector<int64_t> nodeids = {2, 0, 1, 1, 0, 2};
+  std::vector<int64_t> featureids = {0, 0, 0, 0, 1, 0};
+  std::vector<float> thresholds = {0, 0.5f, 0, 0, 1.5f, 0};
+  std::vector<std::string> modes = {"LEAF", "BRANCH_LT", "LEAF", "LEAF", "BRANCH_GT", "LEAF"};
+  std::vector<int64_t> missing_tracks_true = {0, 1, 0, 0, 0, 0};
+
+  std::vector<int64_t> target_treeids = {0, 0, 1, 1};
+  std::vector<int64_t> target_nodeids = {1, 2, 1, 2};
+  std::vector<int64_t> target_classids = {0, 0, 0, 0};
+  std::vector<float> target_weights = {1.f, 2.f, 10.f, 20.f};
+
+  //test data, a missing value follows the true branch of the first tree only
+  std::vector<float> X = {0.2f, 1.f, 0.7f, 2.f, std::numeric_limits<float>::quiet_NaN(), 1.f};
+  std::vector<float> results = {11.f, 22.f, 11.f};
+
+  //add attributes
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("nodes_missing_value_tracks_true", missing_tracks_true);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_classids);
+  test.AddAttribute("target_weights", target_weights);
+
+  test.AddAttribute("n_targets", (int64_t)1);
+
+  //fill input data
+  test.AddInput<float>("X", {3, 2}, X);
+  test.AddOutput<float>("Y", {3, 1}, results);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
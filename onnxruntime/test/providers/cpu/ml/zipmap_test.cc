@@ -55,6 +55,15 @@ TEST(MLOpTest, ZipMapOpInt64Float1D) {
   TestHelper<int64_t>({10, 20, 30, 40, 50, 60}, "int64_t", {6});
 }
 
+// the maps are built in label order, a label given twice keeps its last value
+TEST(MLOpTest, ZipMapOpUnsortedDuplicateLabels) {
+  OpTester test("ZipMap", 1, onnxruntime::kMLDomain);
+  test.AddAttribute("classlabels_int64s", std::vector<int64_t>{30, 10, 30, 20});
+  test.AddInput<float>("X", {2, 4}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f});
+  test.AddOutput<int64_t, float>("Z", {{{10, 2.f}, {20, 4.f}, {30, 3.f}}, {{10, 6.f}, {20, 8.f}, {30, 7.f}}});
+  test.Run();
+}
+
 // Negative test cases
 TEST(MLOpTest, ZipMapOpStringFloatStrideMoreThanNumLabels) {
   TestHelper<string>({"class1", "class2", "class3"}, "string", {1, 6}, OpTester::ExpectResult::kExpectFailure);
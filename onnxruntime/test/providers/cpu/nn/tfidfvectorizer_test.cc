@@ -669,5 +669,42 @@ TEST(TfIdfVectorizerTest, String_TFIDFWeights_onlyBigrams_Skip5) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+TEST(TfIdfVectorizerTest, Int64_TF_BatchBiAndTrigrams_Skip0) {
+  OpTester test("TfIdfVectorizer", opset_ver);
+  // s=0, Min=2, Max=3, weights empty, int64
+  // 8,8,8 is a trigram whose prefix 8,8 is not a bigram of the pool
+  InitTestAttr(test, "TF", 2, 3, 0,
+               {0, 4, 10},
+               {0, 1, 2, 3, 4, 5, 6, 7, 8},  //9 output indexes
+               {},
+               {2, 3, 5, 4,          //1-grams
+                5, 6, 7, 8, 6, 7,    //bi-grams
+                5, 6, 7, 8, 8, 8},   //tri-grams
+               {});
+
+  // enough rows to be split across threads
+  constexpr int64_t copies = 100;
+  const std::vector<int64_t> rows = {5, 6, 7, 8, 6, 7,
+                                     1, 1, 3, 3, 3, 7,
+                                     8, 8, 8, 2, 5, 6};
+  const std::vector<float> row_outputs = {0, 0, 0, 0, 1, 1, 2, 1, 0,
+                                          0, 0, 0, 0, 0, 0, 0, 0, 0,
+                                          0, 0, 0, 0, 1, 0, 0, 0, 1};
+  std::vector<int64_t> input;
+  std::vector<float> output;
+  for (int64_t i = 0; i < copies; ++i) {
+    input.insert(input.end(), rows.cbegin(), rows.cend());
+    output.insert(output.end(), row_outputs.cbegin(), row_outputs.cend());
+  }
+
+  std::vector<int64_t> dims{3 * copies, 6};
+  test.AddInput<int64_t>("T", dims, input);
+
+  std::vector<int64_t> out_dims{3 * copies, 9};
+  test.AddOutput<float>("Y", out_dims, output);
+
+  test.Run(OpTester::ExpectResult::kExpectSuccess);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
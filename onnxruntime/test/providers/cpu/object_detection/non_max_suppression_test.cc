@@ -4,6 +4,8 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
+#include <algorithm>
+
 namespace onnxruntime {
 namespace test {
 
@@ -383,5 +385,53 @@ TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   test.Run();
 }
 
+TEST(NonMaxSuppressionOpTest, ManyBatchesAndClasses) {
+  // Boxes come in overlapping pairs, far from the other pairs, so each class keeps the better box of every pair
+  // above the score threshold. The (batch, class) pairs are split across the thread pool.
+  const int64_t num_batches = 3, num_classes = 20, num_pairs = 60, max_output = 25;
+  const float score_threshold = 0.2f;
+  std::vector<float> boxes;
+  for (int64_t batch = 0; batch < num_batches; ++batch) {
+    for (int64_t pair = 0; pair < num_pairs; ++pair) {
+      const float x = static_cast<float>(pair * 10 + batch);
+      boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f, 0.0f, x + 0.1f, 1.0f, x + 1.1f});
+    }
+  }
+
+  std::vector<float> scores;
+  std::vector<int64_t> expected;
+  for (int64_t batch = 0; batch < num_batches; ++batch) {
+    for (int64_t c = 0; c < num_classes; ++c) {
+      const size_t class_offset = scores.size();
+      for (int64_t box = 0; box < num_pairs * 2; ++box) {
+        scores.push_back(static_cast<float>((box * 37 + c * 11 + batch * 5) % 100) / 100.0f);
+      }
+      const float* class_scores = scores.data() + class_offset;
+
+      std::vector<int64_t> kept;
+      for (int64_t pair = 0; pair < num_pairs; ++pair) {
+        const int64_t best = class_scores[2 * pair + 1] > class_scores[2 * pair] ? 2 * pair + 1 : 2 * pair;
+        if (class_scores[best] > score_threshold) {
+          kept.push_back(best);
+        }
+      }
+      std::stable_sort(kept.begin(), kept.end(),
+                       [&](int64_t lhs, int64_t rhs) { return class_scores[lhs] > class_scores[rhs]; });
+      for (size_t i = 0; i < kept.size() && i < static_cast<size_t>(max_output); ++i) {
+        expected.insert(expected.end(), {batch, c, kept[i]});
+      }
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_pairs * 2, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_pairs * 2}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {max_output});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {score_threshold});
+  test.AddOutput<int64_t>("selected_indices", {static_cast<int64_t>(expected.size() / 3), 3}, expected);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider});  //CUDA: ties of equal scores come in any order
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/reduction/reduction_ops.h"
+
+#include <algorithm>
+#include <limits>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/providers/cpu/reduction/reduction_test_cases.h"
@@ -1369,6 +1373,56 @@ TEST(ReductionOpTest, ArgMin_int32_neg_axis) {
   test.Run();
 }
 
+// Large enough to be split across threads, with the reduced axis between two kept ones.
+TEST(ReductionOpTest, ReduceMean_middle_axis_large) {
+  const int64_t B = 4, S = 64, H = 96;
+  std::vector<float> data(B * S * H);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i % 17) - 8.0f;
+  }
+  std::vector<float> expected(B * H, 0.0f);
+  for (int64_t b = 0; b < B; ++b) {
+    for (int64_t s = 0; s < S; ++s) {
+      for (int64_t h = 0; h < H; ++h) {
+        expected[b * H + h] += data[(b * S + s) * H + h];
+      }
+    }
+  }
+  for (auto& v : expected) {
+    v /= S;
+  }
+
+  OpTester test("ReduceMean");
+  test.AddAttribute("axes", std::vector<int64_t>{1});
+  test.AddAttribute("keepdims", (int64_t)0);
+  test.AddInput<float>("data", {B, S, H}, data);
+  test.AddOutput<float>("reduced", {B, H}, expected);
+  test.Run();
+}
+
+TEST(ReductionOpTest, ReduceMax_outer_and_inner_axes_large) {
+  const int64_t B = 8, S = 32, H = 40;
+  std::vector<float> data(B * S * H);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>((i * 7919) % 1000);
+  }
+  std::vector<float> expected(S, std::numeric_limits<float>::lowest());
+  for (int64_t b = 0; b < B; ++b) {
+    for (int64_t s = 0; s < S; ++s) {
+      for (int64_t h = 0; h < H; ++h) {
+        expected[s] = std::max(expected[s], data[(b * S + s) * H + h]);
+      }
+    }
+  }
+
+  OpTester test("ReduceMax");
+  test.AddAttribute("axes", std::vector<int64_t>{0, 2});
+  test.AddAttribute("keepdims", (int64_t)1);
+  test.AddInput<float>("data", {B, S, H}, data);
+  test.AddOutput<float>("reduced", {1, S, 1}, expected);
+  test.Run();
+}
+
 // test that PrepareForReduce handles this case. Called by all reduction ops so any op can be used in the test
 TEST(ReductionOpTest, ReduceDimWithZero) {
   auto run = [](OpTester& tester, const std::string& error_msg = "") {
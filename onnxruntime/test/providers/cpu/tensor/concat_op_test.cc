@@ -233,5 +233,30 @@ TEST(ConcatOpTest, Concat3D_3) {
   test.Run();
 }
 
+TEST(ConcatOpTest, Concat3D_large_unequal_inputs) {
+  // Many rows of unequal blocks, split across the thread pool, with an empty input in the middle.
+  const int64_t rows = 1000;
+  const std::vector<int64_t> axis_dims{3, 0, 17};
+  std::vector<std::vector<float>> inputs(axis_dims.size());
+  std::vector<float> output;
+  for (int64_t row = 0; row < rows; ++row) {
+    for (size_t input = 0; input < axis_dims.size(); ++input) {
+      for (int64_t i = 0; i < axis_dims[input] * 2; ++i) {
+        const float value = static_cast<float>(row * 1000 + static_cast<int64_t>(input) * 100 + i);
+        inputs[input].push_back(value);
+        output.push_back(value);
+      }
+    }
+  }
+
+  OpTester test("Concat");
+  test.AddAttribute("axis", int64_t{1});
+  test.AddInput<float>("input1", {rows, axis_dims[0], 2}, inputs[0]);
+  test.AddInput<float>("input2", {rows, axis_dims[1], 2}, inputs[1]);
+  test.AddInput<float>("input3", {rows, axis_dims[2], 2}, inputs[2]);
+  test.AddOutput<float>("concat_result", {rows, 20, 2}, output);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});  //TensorRT: no support for empty inputs
+}
+
 }  // namespace test
 }  // namespace onnxruntime
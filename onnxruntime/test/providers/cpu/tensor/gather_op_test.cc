@@ -306,6 +306,47 @@ TEST(GatherOpTest, Gather_perf) {
   test.Run();
 }
 
+TEST(GatherOpTest, Gather_axis0_indices2d_string_rows) {
+  OpTester test("Gather");
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<std::string>("data", {3, 2},
+                             {"0", "1",
+                              "10", "11",
+                              "20", "21"});
+  test.AddInput<int32_t>("indices", {2, 2},
+                         {2, 0,
+                          1, 2});
+  test.AddOutput<std::string>("output", {2, 2, 2},
+                              {"20", "21", "0", "1",
+                               "10", "11", "20", "21"});
+  test.Run();
+}
+
+// A table larger than the prefetch threshold read at random rows, split across the thread pool.
+TEST(GatherOpTest, Gather_axis0_large_table_random_indices) {
+  const int64_t rows = 20000, cols = 24, num_indices = 3000;
+  std::vector<float> data(rows * cols);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(i);
+  }
+
+  std::vector<int64_t> indices(num_indices);
+  std::vector<float> output;
+  output.reserve(num_indices * cols);
+  for (int64_t i = 0; i < num_indices; ++i) {
+    indices[i] = (i * 7919) % rows - (i % 3 == 0 ? rows : 0);
+    const int64_t row = indices[i] < 0 ? indices[i] + rows : indices[i];
+    output.insert(output.end(), data.begin() + row * cols, data.begin() + (row + 1) * cols);
+  }
+
+  OpTester test("Gather", 11);
+  test.AddAttribute<int64_t>("axis", 0LL);
+  test.AddInput<float>("data", {rows, cols}, data);
+  test.AddInput<int64_t>("indices", {num_indices}, indices);
+  test.AddOutput<float>("output", {num_indices, cols}, output);
+  test.Run();
+}
+
 TEST(GatherOpTest, Gather_axis1_neg_indices2d_int8) {
   OpTester test("Gather", 11);
   test.AddAttribute<int64_t>("axis", 1LL);
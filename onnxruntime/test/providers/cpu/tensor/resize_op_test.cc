@@ -415,6 +415,112 @@ TEST(ResizeOpTest, ResizeOpNearestUpSample_Floor_Align_Corners) {
   test.Run();
 }
 
+TEST(ResizeOpTest, ResizeOpLinearUpSampleTest_4DBilinear_MultiChannel) {
+  OpTester test("Resize", 11);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 1.0f, 2.5f, 1.5f};
+
+  test.AddAttribute("mode", "linear");
+
+  // large enough for the output rows to be split across the thread pool
+  const int64_t N = 2, C = 3, H = 17, W = 23;
+  const int64_t OH = static_cast<int64_t>(H * scales[2]), OW = static_cast<int64_t>(W * scales[3]);
+  std::vector<float> X(N * C * H * W);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>((i * 7) % 31);
+  }
+
+  // half_pixel reference, interpolating between the two input coordinates surrounding every output coordinate
+  auto source = [](int64_t out, float scale, int64_t in_size, int64_t& in1, int64_t& in2, float& w2) {
+    float in = std::max(0.0f, std::min((out + 0.5f) / scale - 0.5f, static_cast<float>(in_size - 1)));
+    in1 = static_cast<int64_t>(in);
+    in2 = std::min(in1 + 1, in_size - 1);
+    w2 = in1 == in2 ? 0.5f : in - in1;
+  };
+
+  std::vector<float> Y;
+  for (int64_t nc = 0; nc < N * C; ++nc) {
+    const float* image = X.data() + nc * H * W;
+    for (int64_t y = 0; y < OH; ++y) {
+      int64_t y1, y2;
+      float wy2;
+      source(y, scales[2], H, y1, y2, wy2);
+      for (int64_t x = 0; x < OW; ++x) {
+        int64_t x1, x2;
+        float wx2;
+        source(x, scales[3], W, x1, x2, wx2);
+        float top = (1 - wx2) * image[y1 * W + x1] + wx2 * image[y1 * W + x2];
+        float bottom = (1 - wx2) * image[y2 * W + x1] + wx2 * image[y2 * W + x2];
+        Y.push_back(y1 == y2 ? top : (1 - wy2) * top + wy2 * bottom);
+      }
+    }
+  }
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  test.AddOutput<float>("Y", {N, C, OH, OW}, Y);
+  test.Run();
+}
+
+TEST(ResizeOpTest, ResizeOpNearestDownSampleTest_5D_tf_half_pixel) {
+  OpTester test("Resize", 11);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 1.0f, 1.0f, 0.5f, 1.0f};
+
+  test.AddAttribute("mode", "nearest");
+  test.AddAttribute("coordinate_transformation_mode", "tf_half_pixel_for_nn");
+
+  std::vector<float> X = {
+      1.0f, 2.0f,
+      3.0f, 4.0f,
+      5.0f, 6.0f,
+      7.0f, 8.0f};
+
+  test.AddInput<float>("X", {1, 1, 1, 4, 2}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {5}, scales);
+
+  std::vector<float> Y = {3.0f, 4.0f,
+                          7.0f, 8.0f};
+
+  test.AddOutput<float>("Y", {1, 1, 1, 2, 2}, Y);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider});
+}
+
+TEST(ResizeOpTest, ResizeOpNearestUpSampleTest_int32_MultiChannel) {
+  OpTester test("Resize", 11);
+  std::vector<float> roi{};
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 3.0f};
+
+  test.AddAttribute("mode", "nearest");
+  test.AddAttribute("coordinate_transformation_mode", "asymmetric");
+  test.AddAttribute("nearest_mode", "floor");
+
+  const int64_t N = 2, C = 4, H = 9, W = 11;
+  std::vector<int32_t> X(N * C * H * W);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<int32_t>(i);
+  }
+
+  std::vector<int32_t> Y;
+  for (int64_t nc = 0; nc < N * C; ++nc) {
+    for (int64_t y = 0; y < H * 2; ++y) {
+      for (int64_t x = 0; x < W * 3; ++x) {
+        Y.push_back(X[(nc * H + y / 2) * W + x / 3]);
+      }
+    }
+  }
+
+  test.AddInput<int32_t>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  test.AddOutput<int32_t>("Y", {N, C, H * 2, W * 3}, Y);
+  test.Run();
+}
+
 TEST(ResizeOpTest, ResizeOpCubicDownSampleTest) {
   OpTester test("Resize", 11);
   std::vector<float> scales{1.0f, 1.0f, 0.8f, 0.8f};
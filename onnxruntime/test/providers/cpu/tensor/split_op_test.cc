@@ -364,6 +364,30 @@ TEST(SplitOperatorTest, Axis1SplitMiddleDimensionUnequally) {
   RunTest<float>(axis, splits, input, outputs, false);
 }
 
+TEST(SplitOperatorTest, Axis1UnequalSplitManyRows) {
+  // Many rows of unequal blocks, split across the thread pool.
+  const int64_t rows = 1000;
+  const std::vector<int64_t> split_sizes{5, 1, 10};
+  std::vector<float> input;
+  std::vector<std::vector<float>> outputs(split_sizes.size());
+  for (int64_t row = 0; row < rows; ++row) {
+    for (size_t output = 0; output < split_sizes.size(); ++output) {
+      for (int64_t i = 0; i < split_sizes[output]; ++i) {
+        const float value = static_cast<float>(row * 100 + static_cast<int64_t>(output) * 20 + i);
+        input.push_back(value);
+        outputs[output].push_back(value);
+      }
+    }
+  }
+
+  std::vector<ShapeAndFloatData> expected;
+  for (size_t output = 0; output < split_sizes.size(); ++output) {
+    expected.push_back({{rows, split_sizes[output]}, outputs[output]});
+  }
+
+  RunTest<float>(1, split_sizes, {{rows, 16}, input}, expected);
+}
+
 TEST(SplitOperatorTest, NegativeAxis) {
   const int64_t axis = -1;  // split last axis equally
   std::vector<ShapeAndFloatData> outputs;
@@ -414,5 +414,78 @@ TEST(TransposeOpTest, SingleAxisMovingInwardsBlockCopy) {
 
   TransposeTest(input_shape, input_vals, &perm, expected_shape, expected_vals, false, false);
 }
+
+// Transposes an input of input_shape filled with its element indices by perm, the expected output being computed
+// element by element.
+template <typename T>
+static void TransposeIotaTest(const std::vector<int64_t>& input_shape, const std::vector<int64_t>& perm) {
+  const size_t rank = input_shape.size();
+  std::vector<int64_t> expected_shape(rank);
+  std::vector<int64_t> input_strides(rank, 1);
+  for (size_t i = rank - 1; i > 0; --i) {
+    input_strides[i - 1] = input_strides[i] * input_shape[i];
+  }
+  for (size_t i = 0; i < rank; ++i) {
+    expected_shape[i] = input_shape[perm[i]];
+  }
+
+  const int64_t size = input_strides[0] * input_shape[0];
+  std::vector<T> input_vals(size);
+  std::vector<T> expected_vals(size);
+  std::vector<int64_t> index(rank, 0);
+  for (int64_t i = 0; i < size; ++i) {
+    input_vals[i] = static_cast<T>(i);
+    int64_t offset = 0;
+    for (size_t k = 0; k < rank; ++k) {
+      offset += index[k] * input_strides[perm[k]];
+    }
+    expected_vals[i] = static_cast<T>(offset);
+    for (size_t k = rank; k-- > 0;) {
+      if (++index[k] < expected_shape[k]) break;
+      index[k] = 0;
+    }
+  }
+
+  OpTester test("Transpose");
+  test.AddAttribute("perm", perm);
+  test.AddInput<T>("X", input_shape, input_vals);
+  test.AddOutput<T>("Y", expected_shape, expected_vals);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+}
+
+// the inner 2D transposes run in tiles, with partial tiles on both axes
+TEST(TransposeOpTest, TiledNCHW2NHWC) {
+  TransposeIotaTest<float>({2, 5, 67, 19}, {0, 2, 3, 1});
+  TransposeIotaTest<uint8_t>({2, 5, 67, 19}, {0, 2, 3, 1});
+  TransposeIotaTest<int16_t>({2, 5, 67, 19}, {0, 2, 3, 1});
+  TransposeIotaTest<int64_t>({2, 5, 67, 19}, {0, 2, 3, 1});
+}
+
+TEST(TransposeOpTest, TiledNHWC2NCHW) {
+  TransposeIotaTest<float>({2, 67, 19, 5}, {0, 3, 1, 2});
+  TransposeIotaTest<uint8_t>({2, 67, 19, 5}, {0, 3, 1, 2});
+}
+
+TEST(TransposeOpTest, TiledTwoDim) {
+  TransposeIotaTest<int32_t>({130, 77}, {1, 0});
+  TransposeIotaTest<int8_t>({9, 300}, {1, 0});
+}
+
+// [B, S, N, H] -> [B, N, S, H] moves H as a single wide element, or falls back to block copies when H is large
+TEST(TransposeOpTest, TiledSequenceHeads) {
+  TransposeIotaTest<float>({2, 70, 3, 2}, {0, 2, 1, 3});
+  TransposeIotaTest<float>({2, 70, 3, 5}, {0, 2, 1, 3});
+}
+
+// the axes of size 1 don't prevent the 2D transpose
+TEST(TransposeOpTest, TiledUnitAxes) {
+  TransposeIotaTest<float>({1, 9, 1, 70}, {3, 1, 0, 2});
+}
+
+// the generic implementation with the target blocks split across threads
+TEST(TransposeOpTest, GenericPermutation) {
+  TransposeIotaTest<float>({3, 4, 5, 6}, {2, 0, 3, 1});
+  TransposeIotaTest<float>({3, 4, 5, 6}, {1, 3, 0, 2});
+}
 }  // namespace test
 }  // namespace onnxruntime
@@ -4,6 +4,7 @@
 #include <core/common/make_unique.h>
 #include "core/session/onnxruntime_cxx_api.h"
 #include "providers.h"
+#include <array>
 #include <memory>
 #include <vector>
 #include <iostream>
@@ -11,6 +12,9 @@
 #include <sstream>
 #include <atomic>
 #include <gtest/gtest.h>
+#ifdef __linux__
+#include <dirent.h>
+#endif
 #include "test_allocator.h"
 #include "test_fixture.h"
 #include "onnx_protobuf.h"
@@ -130,6 +134,7 @@ static constexpr PATH_TYPE CUSTOM_OP_MODEL_URI = TSTR("testdata/foo_1.onnx");
 static constexpr PATH_TYPE CUSTOM_OP_LIBRARY_TEST_MODEL_URI = TSTR("testdata/custom_op_library/custom_op_test.onnx");
 static constexpr PATH_TYPE OVERRIDABLE_INITIALIZER_MODEL_URI = TSTR("testdata/overridable_initializer.onnx");
 static constexpr PATH_TYPE NAMED_AND_ANON_DIM_PARAM_URI = TSTR("testdata/capi_symbolic_dims.onnx");
+static constexpr PATH_TYPE ZIPMAP_STRING_MODEL_URI = TSTR("testdata/zipmap_stringfloat.onnx");
 
 #ifdef ENABLE_LANGUAGE_INTEROP_OPS
 static constexpr PATH_TYPE PYOP_FLOAT_MODEL_URI = TSTR("testdata/pyop_1.onnx");
@@ -424,6 +429,152 @@ TEST_F(CApiTest, override_initializer) {
   ASSERT_EQ(*output_data, f11_input_data[0]);
 }
 
+TEST_F(CApiTest, disable_per_session_threads_requires_global_thread_pools) {
+  Ort::SessionOptions session_options;
+  session_options.DisablePerSessionThreads();
+  // env_ was created without global thread pools so the session has no thread pool to use
+  EXPECT_THROW(Ort::Session(env_, MODEL_URI, session_options), Ort::Exception);
+}
+
+TEST_F(CApiTest, io_binding) {
+  Ort::Session session(env_, MODEL_URI, Ort::SessionOptions{});
+  Ort::MemoryInfo info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+
+  const std::array<int64_t, 2> dims = {3, 2};
+  std::array<float, 6> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::array<float, 6> y_values{};
+  Ort::Value x = Ort::Value::CreateTensor<float>(info, x_values.data(), x_values.size(), dims.data(), dims.size());
+  Ort::Value y = Ort::Value::CreateTensor<float>(info, y_values.data(), y_values.size(), dims.data(), dims.size());
+
+  Ort::IoBinding binding(session);
+  binding.BindInput("X", x);
+  binding.BindOutput("Y", y);
+
+  // the bound buffers are reused by every run, so changing the input data is enough to run again
+  for (int run = 0; run < 2; ++run) {
+    session.Run(Ort::RunOptions{nullptr}, binding);
+    for (size_t i = 0; i < x_values.size(); ++i) {
+      ASSERT_EQ(y_values[i], x_values[i] * x_values[i]);
+    }
+    for (auto& v : x_values) v += 1.0f;
+  }
+
+  // an output bound without a value is allocated by the run
+  binding.ClearBoundOutputs();
+  binding.BindOutput("Y");
+  session.Run(Ort::RunOptions{nullptr}, binding);
+  std::vector<Ort::Value> outputs = binding.GetOutputValues();
+  ASSERT_EQ(outputs.size(), 1U);
+  auto type_info = outputs[0].GetTensorTypeAndShapeInfo();
+  ASSERT_EQ(type_info.GetShape(), std::vector<int64_t>(dims.begin(), dims.end()));
+  const float* output_data = outputs[0].GetTensorMutableData<float>();
+  for (size_t i = 0; i < x_values.size(); ++i) {
+    ASSERT_EQ(output_data[i], x_values[i] * x_values[i]);
+  }
+
+  // an input needs a value
+  OrtStatus* status = Ort::GetApi().BindInput(binding, "X", nullptr);
+  ASSERT_NE(status, nullptr);
+  ASSERT_EQ(Ort::GetApi().GetErrorCode(status), ORT_INVALID_ARGUMENT);
+  Ort::GetApi().ReleaseStatus(status);
+}
+
+TEST_F(CApiTest, columnar_zipmap) {
+  Ort::SessionOptions session_options;
+  session_options.EnableColumnarZipMap();
+  Ort::Session session(env_, ZIPMAP_STRING_MODEL_URI, session_options);
+
+  // the output holds the scores instead of a sequence of maps
+  auto output_info = session.GetOutputTypeInfo(0);
+  ASSERT_EQ(output_info.GetONNXType(), ONNX_TYPE_TENSOR);
+  ASSERT_EQ(output_info.GetTensorTypeAndShapeInfo().GetElementType(), ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT);
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  Ort::Value labels = session.GetOutputZipMapLabels(0, allocator);
+  ASSERT_NE(static_cast<OrtValue*>(labels), nullptr);
+  ASSERT_EQ(labels.GetTensorTypeAndShapeInfo().GetElementType(), ONNX_TENSOR_ELEMENT_DATA_TYPE_STRING);
+  ASSERT_EQ(labels.GetTensorTypeAndShapeInfo().GetShape(), std::vector<int64_t>{3});
+  const size_t labels_length = labels.GetStringTensorDataLength();
+  std::string labels_data(labels_length, '\0');
+  std::array<size_t, 3> offsets{};
+  labels.GetStringTensorContent(&labels_data[0], labels_length, offsets.data(), offsets.size());
+  ASSERT_EQ(labels_data, "class1class2class3");
+  ASSERT_EQ(offsets[1], 6U);
+  ASSERT_EQ(offsets[2], 12U);
+
+  Ort::MemoryInfo info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> dims = {2, 3};
+  std::array<float, 6> x_values = {1.0f, 0.0f, 3.0f, 44.0f, 23.0f, 11.3f};
+  Ort::Value x = Ort::Value::CreateTensor<float>(info, x_values.data(), x_values.size(), dims.data(), dims.size());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Z"};
+  std::vector<Ort::Value> outputs = session.Run(Ort::RunOptions{nullptr}, input_names, &x, 1, output_names, 1);
+  ASSERT_EQ(outputs.size(), 1U);
+  ASSERT_EQ(outputs[0].GetTensorTypeAndShapeInfo().GetShape(), std::vector<int64_t>(dims.begin(), dims.end()));
+  const float* scores = outputs[0].GetTensorMutableData<float>();
+  for (size_t i = 0; i < x_values.size(); ++i) {
+    ASSERT_EQ(scores[i], x_values[i]);
+  }
+
+  // without the option the output keeps its maps and has no labels
+  Ort::Session map_session(env_, ZIPMAP_STRING_MODEL_URI, Ort::SessionOptions{});
+  ASSERT_EQ(map_session.GetOutputTypeInfo(0).GetONNXType(), ONNX_TYPE_SEQUENCE);
+  ASSERT_EQ(static_cast<OrtValue*>(map_session.GetOutputZipMapLabels(0, allocator)), nullptr);
+
+  // a ZipMap output also read by a node keeps its maps too, no operator reachable from the C API reads a sequence
+  // of maps so that graph is covered by InferenceSessionTests.ColumnarZipMapOutputReadByNode
+}
+
+#ifdef __linux__
+static size_t GetProcessThreadCount() {
+  size_t count = 0;
+  DIR* dir = opendir("/proc/self/task");
+  if (dir == nullptr) return 0;
+  while (dirent* entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') ++count;
+  }
+  closedir(dir);
+  return count;
+}
+#endif
+
+TEST(CApiGlobalThreadPoolsTest, sessions_share_env_thread_pools) {
+  Ort::ThreadingOptions tp_options;
+  tp_options.SetGlobalIntraOpNumThreads(4);
+  tp_options.SetGlobalInterOpNumThreads(2);
+  Ort::Env env(tp_options, ORT_LOGGING_LEVEL_WARNING, "GlobalThreadPools");
+#ifdef __linux__
+  const size_t threads_before = GetProcessThreadCount();
+#endif
+
+  std::vector<Input> inputs(1);
+  Input& input = inputs.back();
+  input.name = "X";
+  input.dims = {3, 2};
+  input.values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  std::vector<int64_t> expected_dims_y = {3, 2};
+  std::vector<float> expected_values_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+
+  // without the shared pools every session would add an intra-op pool, and an inter-op pool in parallel mode
+  constexpr int num_sessions = 16;
+  std::vector<Ort::Session> sessions;
+  for (int i = 0; i < num_sessions; ++i) {
+    Ort::SessionOptions session_options;
+    session_options.DisablePerSessionThreads();
+    session_options.SetExecutionMode(i % 2 == 0 ? ORT_SEQUENTIAL : ORT_PARALLEL);
+    sessions.emplace_back(env, MODEL_URI, session_options);
+  }
+
+  auto default_allocator = onnxruntime::make_unique<MockedOrtAllocator>();
+  for (auto& session : sessions) {
+    RunSession<float>(default_allocator.get(), session, inputs, "Y", expected_dims_y, expected_values_y, nullptr);
+  }
+
+#ifdef __linux__
+  EXPECT_LE(GetProcessThreadCount(), threads_before);
+#endif
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   int ret = RUN_ALL_TESTS();
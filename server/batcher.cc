@@ -0,0 +1,350 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+#include "batcher.h"
+
+namespace onnxruntime {
+namespace server {
+
+namespace {
+
+// Size in bytes of one element, 0 for the types which can't be copied with memcpy.
+size_t ElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+      return 1;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      return 2;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+      return 4;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX64:
+      return 8;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_COMPLEX128:
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+// Number of bytes of one row, the product of the dimensions past the batch one.
+size_t RowSize(ONNXTensorElementDataType type, const std::vector<int64_t>& shape) {
+  return std::accumulate(shape.begin() + 1, shape.end(), ElementSize(type),
+                         [](size_t size, int64_t dim) { return size * static_cast<size_t>(dim); });
+}
+
+}  // namespace
+
+struct Batcher::Request {
+  const Ort::RunOptions* run_options;
+  const std::vector<std::string>* input_names;
+  const std::vector<Ort::Value>* input_values;
+  const std::vector<std::string>* output_names;
+  // element type and shape of every input
+  std::vector<ONNXTensorElementDataType> types;
+  std::vector<std::vector<int64_t>> shapes;
+  // indices of the inputs sorted by name, the order of the inputs of a request is not significant
+  std::vector<size_t> order;
+  // size of the batch dimension shared by all the inputs, 0 when the request can't be batched
+  int64_t rows = 0;
+  std::chrono::steady_clock::time_point arrival;
+  std::promise<std::vector<Ort::Value>> result;
+
+  bool IsCompatible(const Request& other) const {
+    if (*output_names != *other.output_names || order.size() != other.order.size()) {
+      return false;
+    }
+    for (size_t k = 0; k < order.size(); ++k) {
+      size_t i = order[k];
+      size_t j = other.order[k];
+      if ((*input_names)[i] != (*other.input_names)[j] || types[i] != other.types[j] ||
+          shapes[i].size() != other.shapes[j].size() ||
+          !std::equal(shapes[i].begin() + 1, shapes[i].end(), other.shapes[j].begin() + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+bool Batcher::CanBatch(const Ort::Session& session) {
+  auto has_batch_dimension = [](const Ort::TypeInfo& type_info) {
+    if (type_info.GetONNXType() != ONNX_TYPE_TENSOR) {
+      return false;
+    }
+    auto shape = type_info.GetTensorTypeAndShapeInfo().GetShape();
+    // a symbolic or unknown dimension is reported as -1
+    return !shape.empty() && shape[0] < 0;
+  };
+  for (size_t i = 0; i < session.GetInputCount(); ++i) {
+    if (!has_batch_dimension(session.GetInputTypeInfo(i))) {
+      return false;
+    }
+  }
+  for (size_t i = 0; i < session.GetOutputCount(); ++i) {
+    if (!has_batch_dimension(session.GetOutputTypeInfo(i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+Batcher::Batcher(Ort::Session& session, size_t max_batch_size, std::chrono::microseconds max_batch_delay,
+                 OrtLoggingLevel severity, std::shared_ptr<spdlog::logger> logger) : session_(session),
+                                                                                      max_batch_size_(max_batch_size),
+                                                                                      max_batch_delay_(max_batch_delay),
+                                                                                      logger_(std::move(logger)) {
+  run_options_.SetRunLogVerbosityLevel(static_cast<int>(severity));
+  run_options_.SetRunTag("batch");
+  worker_ = std::thread([this]() { ProcessRequests(); });
+}
+
+Batcher::~Batcher() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  // the requests still queued are run before the worker exits
+  worker_.join();
+}
+
+std::vector<Ort::Value> Batcher::RunSession(const Ort::RunOptions& run_options,
+                                            const std::vector<std::string>& input_names,
+                                            const Ort::Value* input_values,
+                                            const std::vector<std::string>& output_names) {
+  std::vector<const char*> input_ptrs;
+  input_ptrs.reserve(input_names.size());
+  for (const auto& name : input_names) {
+    input_ptrs.push_back(name.data());
+  }
+  std::vector<const char*> output_ptrs;
+  output_ptrs.reserve(output_names.size());
+  for (const auto& name : output_names) {
+    output_ptrs.push_back(name.data());
+  }
+
+  return session_.Run(run_options, input_ptrs.data(), input_values, input_ptrs.size(),
+                      output_ptrs.data(), output_ptrs.size());
+}
+
+std::vector<Ort::Value> Batcher::Run(const Ort::RunOptions& run_options,
+                                     const std::vector<std::string>& input_names,
+                                     const std::vector<Ort::Value>& input_values,
+                                     const std::vector<std::string>& output_names) {
+  auto request = std::unique_ptr<Request>(new Request());
+  request->run_options = &run_options;
+  request->input_names = &input_names;
+  request->input_values = &input_values;
+  request->output_names = &output_names;
+
+  int64_t rows = -1;
+  bool batchable = !input_values.empty();
+  for (const auto& value : input_values) {
+    if (!value.IsTensor()) {
+      batchable = false;
+      break;
+    }
+    auto info = value.GetTensorTypeAndShapeInfo();
+    request->types.push_back(info.GetElementType());
+    request->shapes.push_back(info.GetShape());
+    const auto& shape = request->shapes.back();
+    if (ElementSize(request->types.back()) == 0 || shape.empty() || shape[0] <= 0 ||
+        (rows >= 0 && shape[0] != rows)) {
+      batchable = false;
+      break;
+    }
+    rows = shape[0];
+  }
+
+  if (!batchable) {
+    return RunSession(run_options, input_names, input_values.data(), output_names);
+  }
+
+  request->rows = rows;
+  request->order.resize(input_names.size());
+  std::iota(request->order.begin(), request->order.end(), size_t{0});
+  std::sort(request->order.begin(), request->order.end(),
+            [&input_names](size_t a, size_t b) { return input_names[a] < input_names[b]; });
+  request->arrival = std::chrono::steady_clock::now();
+
+  auto result = request->result.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(request));
+  }
+  cv_.notify_one();
+  return result.get();
+}
+
+size_t Batcher::QueuedRows() const {
+  const Request& first = *queue_.front();
+  size_t rows = 0;
+  for (const auto& request : queue_) {
+    if (request.get() == &first || first.IsCompatible(*request)) {
+      rows += static_cast<size_t>(request->rows);
+    }
+  }
+  return rows;
+}
+
+std::vector<std::unique_ptr<Batcher::Request>> Batcher::TakeBatch() {
+  // the oldest request is always taken, the later ones while they fit
+  std::vector<std::unique_ptr<Request>> batch;
+  batch.push_back(std::move(queue_.front()));
+  queue_.pop_front();
+  size_t rows = static_cast<size_t>(batch.front()->rows);
+  for (auto it = queue_.begin(); it != queue_.end() && rows < max_batch_size_;) {
+    if (rows + static_cast<size_t>((*it)->rows) <= max_batch_size_ && batch.front()->IsCompatible(**it)) {
+      rows += static_cast<size_t>((*it)->rows);
+      batch.push_back(std::move(*it));
+      it = queue_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  return batch;
+}
+
+void Batcher::ProcessRequests() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cv_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;
+    }
+
+    // give the batch of the oldest request until max_batch_delay_ after its arrival to fill up
+    const auto deadline = queue_.front()->arrival + max_batch_delay_;
+    cv_.wait_until(lock, deadline, [this]() { return stop_ || QueuedRows() >= max_batch_size_; });
+
+    auto batch = TakeBatch();
+    lock.unlock();
+    RunBatch(batch);
+    lock.lock();
+  }
+}
+
+void Batcher::RunBatch(std::vector<std::unique_ptr<Request>>& batch) {
+  auto run_alone = [this](Request& request) {
+    try {
+      request.result.set_value(RunSession(*request.run_options, *request.input_names, request.input_values->data(),
+                                          *request.output_names));
+    } catch (...) {
+      request.result.set_exception(std::current_exception());
+    }
+  };
+
+  if (batch.size() == 1) {
+    run_alone(*batch.front());
+    return;
+  }
+
+  const Request& first = *batch.front();
+  const size_t input_count = first.input_names->size();
+  int64_t total_rows = 0;
+  for (const auto& request : batch) {
+    total_rows += request->rows;
+  }
+  logger_->debug("Running a batch of {} requests, {} rows", batch.size(), total_rows);
+
+  std::vector<Ort::Value> outputs;
+  try {
+    // the concatenated inputs follow the order of the inputs of the first request, position[i] is the rank of
+    // input i in the sorted order shared by all the requests of the batch
+    std::vector<size_t> position(input_count);
+    for (size_t k = 0; k < input_count; ++k) {
+      position[first.order[k]] = k;
+    }
+
+    Ort::AllocatorWithDefaultOptions allocator;
+    std::vector<Ort::Value> inputs;
+    inputs.reserve(input_count);
+    for (size_t i = 0; i < input_count; ++i) {
+      std::vector<int64_t> shape = first.shapes[i];
+      shape[0] = total_rows;
+      auto value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), first.types[i]);
+      auto* dst = value.GetTensorMutableData<uint8_t>();
+      const size_t row_size = RowSize(first.types[i], shape);
+      for (const auto& request : batch) {
+        auto& src = const_cast<Ort::Value&>((*request->input_values)[request->order[position[i]]]);
+        const size_t size = row_size * static_cast<size_t>(request->rows);
+        memcpy(dst, src.GetTensorMutableData<uint8_t>(), size);
+        dst += size;
+      }
+      inputs.push_back(std::move(value));
+    }
+
+    outputs = RunSession(run_options_, *first.input_names, inputs.data(), *first.output_names);
+  } catch (...) {
+    // the model may reject the larger batch (a fixed batch dimension, an operator limited to one row), retry every
+    // request alone so each one gets the result it would have without batching
+    logger_->warn("Running a batch of {} requests failed, running them one by one", batch.size());
+    for (auto& request : batch) {
+      run_alone(*request);
+    }
+    return;
+  }
+
+  // every output must carry the batch dimension to be sliced back, otherwise the requests are run one by one
+  std::vector<ONNXTensorElementDataType> output_types;
+  std::vector<std::vector<int64_t>> output_shapes;
+  for (const auto& output : outputs) {
+    if (!output.IsTensor()) {
+      break;
+    }
+    auto info = output.GetTensorTypeAndShapeInfo();
+    auto shape = info.GetShape();
+    if (ElementSize(info.GetElementType()) == 0 || shape.empty() || shape[0] != total_rows) {
+      break;
+    }
+    output_types.push_back(info.GetElementType());
+    output_shapes.push_back(std::move(shape));
+  }
+  if (output_shapes.size() != outputs.size()) {
+    logger_->warn("The outputs of the model can't be split along the batch dimension, running the requests one by one");
+    for (auto& request : batch) {
+      run_alone(*request);
+    }
+    return;
+  }
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  int64_t row = 0;
+  for (auto& request : batch) {
+    try {
+      std::vector<Ort::Value> request_outputs;
+      request_outputs.reserve(outputs.size());
+      for (size_t o = 0; o < outputs.size(); ++o) {
+        std::vector<int64_t> shape = output_shapes[o];
+        shape[0] = request->rows;
+        auto value = Ort::Value::CreateTensor(allocator, shape.data(), shape.size(), output_types[o]);
+        const size_t row_size = RowSize(output_types[o], shape);
+        memcpy(value.GetTensorMutableData<uint8_t>(),
+               outputs[o].GetTensorMutableData<uint8_t>() + row_size * static_cast<size_t>(row),
+               row_size * static_cast<size_t>(request->rows));
+        request_outputs.push_back(std::move(value));
+      }
+      request->result.set_value(std::move(request_outputs));
+    } catch (...) {
+      request->result.set_exception(std::current_exception());
+    }
+    row += request->rows;
+  }
+}
+
+}  // namespace server
+}  // namespace onnxruntime
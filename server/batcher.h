@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include "onnxruntime_cxx_api.h"
+
+namespace onnxruntime {
+namespace server {
+
+// Dynamic batching of the predictions of one model.
+// Requests queued within max_batch_delay of each other are run together in a single Session::Run when they are
+// compatible: same input names, element types and dimensions past the first one, and same requested outputs.
+// Their inputs are concatenated along the first (batch) dimension and each output is sliced back along it for
+// every caller. A batch holds at most max_batch_size rows, a request bigger than that is run on its own.
+// A batch that fails as a whole, or whose outputs can't be sliced back, is retried one request at a time so a request
+// only fails when it fails on its own.
+// The batches are run one after the other by a single worker thread, the parallelism comes from the intra-op thread
+// pool of the session. A batch of several requests runs with the run options of the batcher (log verbosity of the
+// server and the run tag "batch"), the run options and run tag of each caller only apply when its request runs alone.
+class Batcher {
+ public:
+  // Returns false when a model can't be batched: an input or output which isn't a tensor, is a scalar or has a fixed
+  // first dimension.
+  static bool CanBatch(const Ort::Session& session);
+
+  Batcher(Ort::Session& session, size_t max_batch_size, std::chrono::microseconds max_batch_delay,
+          OrtLoggingLevel severity, std::shared_ptr<spdlog::logger> logger);
+  ~Batcher();
+  Batcher(const Batcher&) = delete;
+  Batcher& operator=(const Batcher&) = delete;
+
+  // Queues one request and blocks until the batch it is part of has run. Requests which can't be batched
+  // (non tensor or string inputs, scalars) are run right away on the calling thread. run_options is used whenever
+  // the request runs alone.
+  // Throws Ort::Exception if the run fails.
+  std::vector<Ort::Value> Run(const Ort::RunOptions& run_options,
+                              const std::vector<std::string>& input_names,
+                              const std::vector<Ort::Value>& input_values,
+                              const std::vector<std::string>& output_names);
+
+ private:
+  struct Request;
+
+  void ProcessRequests();
+  size_t QueuedRows() const;
+  std::vector<std::unique_ptr<Request>> TakeBatch();
+  void RunBatch(std::vector<std::unique_ptr<Request>>& batch);
+  std::vector<Ort::Value> RunSession(const Ort::RunOptions& run_options,
+                                     const std::vector<std::string>& input_names,
+                                     const Ort::Value* input_values,
+                                     const std::vector<std::string>& output_names);
+
+  Ort::Session& session_;
+  const size_t max_batch_size_;
+  const std::chrono::microseconds max_batch_delay_;
+  Ort::RunOptions run_options_;
+  std::shared_ptr<spdlog::logger> logger_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::unique_ptr<Request>> queue_;
+  bool stop_ = false;
+  std::thread worker_;
+};
+
+}  // namespace server
+}  // namespace onnxruntime
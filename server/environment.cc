@@ -149,5 +149,33 @@ void ServerEnvironment::UnloadModel(const std::string& model_name, const std::st
   sessions_.erase(it);
 }
 
+void ServerEnvironment::EnableBatching(const std::string& model_name, const std::string& model_version,
+                                       size_t max_batch_size, std::chrono::microseconds max_batch_delay) {
+  auto identifier = std::make_pair(model_name, model_version);
+  auto it = sessions_.find(identifier);
+  if (it == sessions_.end()) {
+    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  }
+
+  if (!Batcher::CanBatch(it->second.session)) {
+    default_logger_->warn("Batching disabled for model {} version {}: every input and output must be a tensor whose "
+                          "first dimension is dynamic",
+                          model_name, model_version);
+    return;
+  }
+
+  it->second.batcher.reset(new Batcher(it->second.session, max_batch_size, max_batch_delay, severity_, default_logger_));
+}
+
+Batcher* ServerEnvironment::GetBatcher(const std::string& model_name, const std::string& model_version) const {
+  auto identifier = std::make_pair(model_name, model_version);
+  auto it = sessions_.find(identifier);
+  if (it == sessions_.end()) {
+    throw Ort::Exception("No model loaded of that name.", ORT_NO_MODEL);
+  }
+
+  return it->second.batcher.get();
+}
+
 }  // namespace server
 }  // namespace onnxruntime
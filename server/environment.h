@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <vector>
 
@@ -11,6 +12,8 @@
 #include <unordered_map>
 #include <boost/functional/hash.hpp>
 
+#include "batcher.h"
+
 namespace onnxruntime {
 namespace server {
 
@@ -28,6 +31,11 @@ class ServerEnvironment {
   std::shared_ptr<spdlog::logger> GetLogger(const std::string& request_id) const;
   std::shared_ptr<spdlog::logger> GetAppLogger() const;
   void UnloadModel(const std::string& model_name, const std::string& model_version);
+  // Batches the predictions of a loaded model, see Batcher.
+  void EnableBatching(const std::string& model_name, const std::string& model_version,
+                      size_t max_batch_size, std::chrono::microseconds max_batch_delay);
+  // Returns nullptr when batching is not enabled for the model.
+  Batcher* GetBatcher(const std::string& model_name, const std::string& model_version) const;
   void RegisterExecutionProviders();
 
  private:
@@ -42,6 +50,8 @@ class ServerEnvironment {
   struct SessionHolder {
     Ort::Session session;
     std::vector<std::string> output_names;
+    // declared after the session so it is stopped before the session goes away
+    std::unique_ptr<Batcher> batcher;
     explicit SessionHolder(Ort::Env& env, std::string path, const Ort::SessionOptions& options) : session(nullptr) {
       session = Ort::Session(env, path.c_str(), options);
     };
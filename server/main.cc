@@ -67,6 +67,11 @@ int main(int argc, char* argv[]) {
   try {
     env->InitializeModel(config.model_path, config.model_name, config.model_version);
     logger->debug("Initialize Model Successfully!");
+    if (config.max_batch_size > 1) {
+      env->EnableBatching(config.model_name, config.model_version, config.max_batch_size,
+                          std::chrono::microseconds(config.max_batch_delay_micros));
+      logger->info("Batching up to {} rows, waiting at most {} us", config.max_batch_size, config.max_batch_delay_micros);
+    }
   } catch (const Ort::Exception& ex) {
     logger->critical("Initialize Model Failed: {} ---- Error: [{}]", ex.GetOrtErrorCode(), ex.what());
     exit(EXIT_FAILURE);
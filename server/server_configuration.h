@@ -45,6 +45,8 @@ class ServerConfiguration {
   unsigned short http_port = 8001;
   unsigned short grpc_port = 50051;
   int num_http_threads = std::thread::hardware_concurrency();
+  int max_batch_size = 1;
+  int max_batch_delay_micros = 1000;
   OrtLoggingLevel logging_level{};
 
   ServerConfiguration() {
@@ -57,6 +59,8 @@ class ServerConfiguration {
     desc.add_options()("http_port", po::value(&http_port)->default_value(http_port), "HTTP port to listen to requests");
     desc.add_options()("num_http_threads", po::value(&num_http_threads)->default_value(num_http_threads), "Number of http threads");
     desc.add_options()("grpc_port", po::value(&grpc_port)->default_value(grpc_port), "GRPC port to listen to requests");
+    desc.add_options()("max_batch_size", po::value(&max_batch_size)->default_value(max_batch_size), "Maximum number of rows run together by batching compatible requests along their first dimension, 1 disables batching");
+    desc.add_options()("max_batch_delay_micros", po::value(&max_batch_delay_micros)->default_value(max_batch_delay_micros), "Maximum time in microseconds a request waits for a batch to fill up");
   }
 
   // Parses argc and argv and sets the values for the class
@@ -103,6 +107,12 @@ class ServerConfiguration {
     } else if (num_http_threads <= 0) {
       PrintHelp(std::cerr, "num_http_threads must be greater than 0");
       return Result::ExitFailure;
+    } else if (max_batch_size <= 0) {
+      PrintHelp(std::cerr, "max_batch_size must be greater than 0");
+      return Result::ExitFailure;
+    } else if (max_batch_delay_micros < 0) {
+      PrintHelp(std::cerr, "max_batch_delay_micros must not be negative");
+      return Result::ExitFailure;
     } else if (!file_exists(model_path)) {
       PrintHelp(std::cerr, "model_path must be the location of a valid file");
       return Result::ExitFailure;
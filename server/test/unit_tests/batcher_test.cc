@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "executor.h"
+#include "http/json_handling.h"
+#include "test_server_environment.h"
+
+namespace onnxruntime {
+namespace server {
+namespace test {
+
+// mul_batch.onnx computes Y = X * X for X of shape [N, 2]
+class BatcherTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    const static auto model_file = "testdata/mul_batch.onnx";
+
+    onnxruntime::server::ServerEnvironment* env = ServerEnv();
+    env->InitializeModel(model_file, "Batch", "1");
+    env->EnableBatching("Batch", "1", 8, std::chrono::milliseconds(50));
+  }
+
+  void TearDown() override {
+    onnxruntime::server::ServerEnvironment* env = ServerEnv();
+    env->UnloadModel("Batch", "1");
+  }
+};
+
+namespace {
+
+std::string MakeInput(int rows, int first) {
+  std::string data;
+  for (int i = 0; i < 2 * rows; ++i) {
+    data += (i == 0 ? "" : ",") + std::to_string(first + i);
+  }
+  return R"({"inputs":{"X":{"dims":[)" + std::to_string(rows) + R"(,2],"dataType":1,"floatData":[)" + data +
+         R"(]}},"outputFilter":["Y"]})";
+}
+
+std::string MakeExpected(int rows, int first) {
+  std::string data;
+  for (int i = 0; i < 2 * rows; ++i) {
+    data += (i == 0 ? "" : ",") + std::to_string((first + i) * (first + i));
+  }
+  return R"({"outputs":{"Y":{"dims":[")" + std::to_string(rows) + R"(","2"],"dataType":1,"floatData":[)" + data +
+         R"(]}}})";
+}
+
+void Predict(const std::string& input_json, std::string& body, bool& ok) {
+  onnxruntime::server::Executor executor(ServerEnv(), "RequestId");
+  onnxruntime::server::PredictRequest request{};
+  onnxruntime::server::PredictResponse response{};
+
+  ok = onnxruntime::server::GetRequestFromJson(input_json, request).ok() &&
+       executor.Predict("Batch", "1", request, response).ok() &&
+       GenerateResponseInJson(response, body).ok();
+}
+
+}  // namespace
+
+TEST_F(BatcherTest, SingleRequest) {
+  std::string body;
+  bool ok = false;
+  Predict(MakeInput(3, 1), body, ok);
+  EXPECT_TRUE(ok);
+  EXPECT_EQ(MakeExpected(3, 1), body);
+}
+
+TEST_F(BatcherTest, ConcurrentRequests) {
+  // 1 + 2 + 3 + 4 + 5 rows, more than one batch of 8
+  const int num_requests = 5;
+  std::vector<std::string> bodies(num_requests);
+  std::vector<char> oks(num_requests, 0);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_requests; ++i) {
+    threads.emplace_back([&bodies, &oks, i]() {
+      bool ok = false;
+      Predict(MakeInput(i + 1, 10 * i), bodies[i], ok);
+      oks[i] = ok;
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < num_requests; ++i) {
+    EXPECT_TRUE(oks[i]);
+    EXPECT_EQ(MakeExpected(i + 1, 10 * i), bodies[i]);
+  }
+}
+
+TEST_F(BatcherTest, IncompatibleRequests) {
+  // the request with 3 columns can't be batched with the others and fails on its own
+  std::string good_body, bad_body;
+  bool good_ok = false, bad_ok = true;
+  std::thread good([&]() { Predict(MakeInput(2, 1), good_body, good_ok); });
+  std::thread bad([&]() {
+    Predict(R"({"inputs":{"X":{"dims":[1,3],"dataType":1,"floatData":[1,2,3]}},"outputFilter":["Y"]})", bad_body,
+            bad_ok);
+  });
+  good.join();
+  bad.join();
+
+  EXPECT_TRUE(good_ok);
+  EXPECT_EQ(MakeExpected(2, 1), good_body);
+  EXPECT_FALSE(bad_ok);
+}
+
+TEST(BatcherFixedBatchTest, BatchingDisabled) {
+  // mul_1.onnx has inputs and outputs of fixed shape [3, 2], its requests can't be concatenated
+  onnxruntime::server::ServerEnvironment* env = ServerEnv();
+  env->InitializeModel("testdata/mul_1.onnx", "Fixed", "1");
+  env->EnableBatching("Fixed", "1", 8, std::chrono::milliseconds(50));
+  EXPECT_EQ(nullptr, env->GetBatcher("Fixed", "1"));
+  env->UnloadModel("Fixed", "1");
+}
+
+}  // namespace test
+}  // namespace server
+}  // namespace onnxruntime